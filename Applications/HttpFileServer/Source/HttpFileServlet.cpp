@@ -18,7 +18,7 @@ HttpFileServlet::~HttpFileServlet() {
 std::vector<HttpRequestSlot> HttpFileServlet::GetSlots() {
   auto slots = std::vector<HttpRequestSlot>();
   slots.emplace_back(ServeIndex(m_fileStore));
-  slots.emplace_back(MatchAny(HttpMethod::GET),
+  slots.emplace_back(HttpRequestSlot::Route{HttpMethod::GET, "/**"},
     std::bind(&HttpFileServlet::OnServeFile, this, std::placeholders::_1));
   return slots;
 }
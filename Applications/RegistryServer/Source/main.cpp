@@ -7,7 +7,7 @@
 #include "Beam/Codecs/NullEncoder.hpp"
 #include "Beam/IO/SharedBuffer.hpp"
 #include "Beam/Network/TcpServerSocket.hpp"
-#include "Beam/RegistryService/FileSystemRegistryDataStore.hpp"
+#include "Beam/RegistryService/LogRegistryDataStore.hpp"
 #include "Beam/RegistryService/RegistryServlet.hpp"
 #include "Beam/Serialization/BinaryReceiver.hpp"
 #include "Beam/Serialization/BinarySender.hpp"
@@ -37,7 +37,7 @@ using namespace TCLAP;
 namespace {
   using RegistryServletContainer = ServiceProtocolServletContainer<
     MetaAuthenticationServletAdapter<
-    MetaRegistryServlet<FileSystemRegistryDataStore>,
+    MetaRegistryServlet<LogRegistryDataStore>,
     ApplicationServiceLocatorClient::Client*>, TcpServerSocket,
     BinarySender<SharedBuffer>, NullEncoder, std::shared_ptr<LiveTimer>>;
 
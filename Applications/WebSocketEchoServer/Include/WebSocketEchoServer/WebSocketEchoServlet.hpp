@@ -94,7 +94,6 @@ namespace WebSocketEchoServer {
         while(true) {
           typename WebSocketChannel::Reader::Buffer buffer;
           channel->GetReader().Read(Beam::Store(buffer));
-          std::cout << buffer << std::endl;
           channel->GetWriter().Write(buffer);
         }
       });
@@ -47,14 +47,14 @@ namespace Details {
       SharedBuffer(const BufferType& buffer, typename std::enable_if<
         ImplementsConcept<BufferType, Buffer>::value>::type* = 0);
 
-      SharedBuffer(SharedBuffer&& buffer);
+      SharedBuffer(SharedBuffer&& buffer) noexcept;
 
       SharedBuffer& operator =(const SharedBuffer& rhs);
 
       template<typename Buffer>
       SharedBuffer& operator =(const Buffer& rhs);
 
-      SharedBuffer& operator =(SharedBuffer&& rhs);
+      SharedBuffer& operator =(SharedBuffer&& rhs) noexcept;
 
       bool IsEmpty() const;
 
@@ -139,7 +139,7 @@ namespace Details {
     Append(buffer);
   }
 
-  inline SharedBuffer::SharedBuffer(SharedBuffer&& buffer)
+  inline SharedBuffer::SharedBuffer(SharedBuffer&& buffer) noexcept
       : m_size(std::move(buffer.m_size)),
         m_availableSize(std::move(buffer.m_availableSize)),
         m_data(std::move(buffer.m_data)),
@@ -160,7 +160,7 @@ namespace Details {
     return *this;
   }
 
-  inline SharedBuffer& SharedBuffer::operator =(SharedBuffer&& rhs) {
+  inline SharedBuffer& SharedBuffer::operator =(SharedBuffer&& rhs) noexcept {
     m_size = std::move(rhs.m_size);
     m_availableSize = std::move(rhs.m_availableSize);
     m_data = std::move(rhs.m_data);
@@ -5,6 +5,7 @@ namespace Beam {
   struct JsonNull;
   class JsonObject;
   class JsonParserException;
+  class JsonPullParser;
   class JsonValue;
 }
 
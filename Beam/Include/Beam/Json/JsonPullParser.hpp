@@ -0,0 +1,403 @@
+#ifndef BEAM_JSONPULLPARSER_HPP
+#define BEAM_JSONPULLPARSER_HPP
+#include <charconv>
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <boost/throw_exception.hpp>
+#include "Beam/Json/Json.hpp"
+#include "Beam/Serialization/SerializationException.hpp"
+
+namespace Beam {
+
+  /*! \class JsonPullParser
+      \brief Reads JSON tokens directly out of a contiguous range of
+             characters without building a JsonValue.
+   */
+  class JsonPullParser {
+    public:
+
+      //! Constructs a JsonPullParser over an empty range.
+      JsonPullParser();
+
+      //! Constructs a JsonPullParser.
+      /*!
+        \param first The first character to parse.
+        \param last One past the last character to parse.
+      */
+      JsonPullParser(const char* first, const char* last);
+
+      //! Resets the range to parse.
+      /*!
+        \param first The first character to parse.
+        \param last One past the last character to parse.
+      */
+      void Reset(const char* first, const char* last);
+
+      //! Returns the position of the next character to parse.
+      const char* GetPosition() const;
+
+      //! Moves to a position previously returned by GetPosition.
+      void SetPosition(const char* position);
+
+      //! Skips whitespace and returns the next character without consuming
+      //! it, or '\0' at the end of the range.
+      char Peek();
+
+      //! Skips whitespace and consumes the next character.
+      /*!
+        \param c The character expected.
+      */
+      void Expect(char c);
+
+      //! Consumes the next character iff it matches.
+      /*!
+        \param c The character to match.
+        \return <code>true</code> iff <i>c</i> was consumed.
+      */
+      bool Match(char c);
+
+      //! Reads a JSON boolean.
+      bool ReadBool();
+
+      //! Reads a JSON number as an integral type, a number written with a
+      //! fraction or exponent is accepted only if its value is integral and
+      //! representable by the type.
+      template<typename T>
+      T ReadIntegral();
+
+      //! Reads a JSON number as a floating point type.
+      template<typename T>
+      T ReadFloatingPoint();
+
+      //! Reads a JSON string.
+      /*!
+        \param value Stores the unescaped string.
+      */
+      void ReadString(std::string& value);
+
+      //! Reads an object member's name and the colon following it.
+      /*!
+        \param name The name to compare the member's name against.
+        \return <code>true</code> iff the member's name is <i>name</i>.
+      */
+      bool ReadKey(const char* name);
+
+      //! Skips over the next value, including any nested values.
+      void SkipValue();
+
+    private:
+      const char* m_cursor;
+      const char* m_last;
+      std::string m_key;
+
+      [[noreturn]] static void Fail();
+      static bool IsNumberCharacter(char c);
+      const char* ScanNumber();
+      void SkipString();
+      void AppendEscape(std::string& value);
+      void AppendCodePoint(std::string& value, std::uint32_t codePoint);
+      std::uint32_t ReadHex();
+  };
+
+  inline JsonPullParser::JsonPullParser()
+    : m_cursor(nullptr),
+      m_last(nullptr) {}
+
+  inline JsonPullParser::JsonPullParser(const char* first, const char* last)
+    : m_cursor(first),
+      m_last(last) {}
+
+  inline void JsonPullParser::Reset(const char* first, const char* last) {
+    m_cursor = first;
+    m_last = last;
+  }
+
+  inline const char* JsonPullParser::GetPosition() const {
+    return m_cursor;
+  }
+
+  inline void JsonPullParser::SetPosition(const char* position) {
+    m_cursor = position;
+  }
+
+  inline char JsonPullParser::Peek() {
+    while(m_cursor != m_last && (*m_cursor == ' ' || *m_cursor == '\n' ||
+        *m_cursor == '\r' || *m_cursor == '\t')) {
+      ++m_cursor;
+    }
+    if(m_cursor == m_last) {
+      return '\0';
+    }
+    return *m_cursor;
+  }
+
+  inline void JsonPullParser::Expect(char c) {
+    if(!Match(c)) {
+      Fail();
+    }
+  }
+
+  inline bool JsonPullParser::Match(char c) {
+    if(Peek() != c || m_cursor == m_last) {
+      return false;
+    }
+    ++m_cursor;
+    return true;
+  }
+
+  inline bool JsonPullParser::ReadBool() {
+    auto c = Peek();
+    if(c == 't' && m_last - m_cursor >= 4 &&
+        std::memcmp(m_cursor, "true", 4) == 0) {
+      m_cursor += 4;
+      return true;
+    } else if(c == 'f' && m_last - m_cursor >= 5 &&
+        std::memcmp(m_cursor, "false", 5) == 0) {
+      m_cursor += 5;
+      return false;
+    }
+    BOOST_THROW_EXCEPTION(
+      Serialization::SerializationException("JSON type mismatch."));
+  }
+
+  template<typename T>
+  T JsonPullParser::ReadIntegral() {
+    auto last = ScanNumber();
+    auto first = m_cursor;
+    auto value = T();
+    auto result = std::from_chars(first, last, value);
+    if(result.ptr == last && result.ec == std::errc()) {
+      m_cursor = last;
+      return value;
+    } else if(result.ec == std::errc::result_out_of_range) {
+      BOOST_THROW_EXCEPTION(
+        Serialization::SerializationException("Value out of range."));
+    }
+    auto position = m_cursor;
+    auto number = ReadFloatingPoint<double>();
+    if(number != std::trunc(number)) {
+      m_cursor = position;
+      BOOST_THROW_EXCEPTION(
+        Serialization::SerializationException("JSON type mismatch."));
+    }
+    auto lower = static_cast<double>(std::numeric_limits<T>::min());
+    auto upper = 2 * static_cast<double>(
+      std::numeric_limits<T>::max() / 2 + 1);
+    if(number < lower || number >= upper) {
+      m_cursor = position;
+      BOOST_THROW_EXCEPTION(
+        Serialization::SerializationException("Value out of range."));
+    }
+    return static_cast<T>(number);
+  }
+
+  template<typename T>
+  T JsonPullParser::ReadFloatingPoint() {
+    auto last = ScanNumber();
+    auto first = m_cursor;
+    auto value = T();
+    auto result = std::from_chars(first, last, value);
+    if(result.ptr != last || result.ec != std::errc()) {
+      Fail();
+    }
+    m_cursor = last;
+    return value;
+  }
+
+  inline void JsonPullParser::ReadString(std::string& value) {
+    value.clear();
+    Expect('\"');
+    while(true) {
+      auto run = m_cursor;
+      while(m_cursor != m_last && *m_cursor != '\"' && *m_cursor != '\\' &&
+          static_cast<unsigned char>(*m_cursor) >= 0x20) {
+        ++m_cursor;
+      }
+      value.append(run, m_cursor);
+      if(m_cursor == m_last) {
+        Fail();
+      } else if(*m_cursor == '\"') {
+        ++m_cursor;
+        return;
+      } else if(*m_cursor == '\\') {
+        ++m_cursor;
+        AppendEscape(value);
+      } else {
+        Fail();
+      }
+    }
+  }
+
+  inline bool JsonPullParser::ReadKey(const char* name) {
+    if(Peek() != '\"') {
+      Fail();
+    }
+    auto start = m_cursor;
+    ++m_cursor;
+    auto n = name;
+    while(m_cursor != m_last && *m_cursor != '\"' && *m_cursor != '\\' &&
+        *m_cursor == *n) {
+      ++n;
+      ++m_cursor;
+    }
+    auto isMatch = false;
+    if(m_cursor != m_last && *m_cursor == '\"') {
+      ++m_cursor;
+      isMatch = *n == '\0';
+    } else if(m_cursor != m_last && *m_cursor != '\\') {
+      m_cursor = start;
+      SkipString();
+    } else {
+      m_cursor = start;
+      ReadString(m_key);
+      isMatch = m_key == name;
+    }
+    Expect(':');
+    return isMatch;
+  }
+
+  inline void JsonPullParser::SkipValue() {
+    auto depth = 0;
+    do {
+      auto c = Peek();
+      if(c == '\"') {
+        SkipString();
+      } else if(c == '{' || c == '[') {
+        ++m_cursor;
+        ++depth;
+      } else if(c == '}' || c == ']') {
+        if(depth == 0) {
+          Fail();
+        }
+        ++m_cursor;
+        --depth;
+      } else if((c == ',' || c == ':') && depth != 0) {
+        ++m_cursor;
+      } else if(c == 't' || c == 'f') {
+        ReadBool();
+      } else if(c == 'n' && m_last - m_cursor >= 4 &&
+          std::memcmp(m_cursor, "null", 4) == 0) {
+        m_cursor += 4;
+      } else if(IsNumberCharacter(c)) {
+        m_cursor = ScanNumber();
+      } else {
+        Fail();
+      }
+    } while(depth != 0);
+  }
+
+  inline void JsonPullParser::Fail() {
+    BOOST_THROW_EXCEPTION(
+      Serialization::SerializationException("Invalid JSON format."));
+  }
+
+  inline bool JsonPullParser::IsNumberCharacter(char c) {
+    return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' ||
+      c == 'e' || c == 'E';
+  }
+
+  inline const char* JsonPullParser::ScanNumber() {
+    if(!IsNumberCharacter(Peek())) {
+      BOOST_THROW_EXCEPTION(
+        Serialization::SerializationException("JSON type mismatch."));
+    }
+    auto last = m_cursor;
+    while(last != m_last && IsNumberCharacter(*last)) {
+      ++last;
+    }
+    return last;
+  }
+
+  inline void JsonPullParser::SkipString() {
+    ++m_cursor;
+    while(m_cursor != m_last && *m_cursor != '\"') {
+      if(*m_cursor == '\\') {
+        ++m_cursor;
+        if(m_cursor == m_last) {
+          break;
+        }
+      }
+      ++m_cursor;
+    }
+    if(m_cursor == m_last) {
+      Fail();
+    }
+    ++m_cursor;
+  }
+
+  inline void JsonPullParser::AppendEscape(std::string& value) {
+    if(m_cursor == m_last) {
+      Fail();
+    }
+    auto c = *m_cursor;
+    ++m_cursor;
+    if(c == '\"' || c == '\\' || c == '/') {
+      value += c;
+    } else if(c == 'n') {
+      value += '\n';
+    } else if(c == 't') {
+      value += '\t';
+    } else if(c == 'r') {
+      value += '\r';
+    } else if(c == 'b') {
+      value += '\b';
+    } else if(c == 'f') {
+      value += '\f';
+    } else if(c == 'u') {
+      auto codePoint = ReadHex();
+      if(codePoint >= 0xD800 && codePoint < 0xDC00) {
+        if(m_last - m_cursor < 2 || m_cursor[0] != '\\' ||
+            m_cursor[1] != 'u') {
+          Fail();
+        }
+        m_cursor += 2;
+        auto low = ReadHex();
+        if(low < 0xDC00 || low >= 0xE000) {
+          Fail();
+        }
+        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+      }
+      AppendCodePoint(value, codePoint);
+    } else {
+      Fail();
+    }
+  }
+
+  inline void JsonPullParser::AppendCodePoint(std::string& value,
+      std::uint32_t codePoint) {
+    if(codePoint < 0x80) {
+      value += static_cast<char>(codePoint);
+    } else if(codePoint < 0x800) {
+      value += static_cast<char>(0xC0 | (codePoint >> 6));
+      value += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if(codePoint < 0x10000) {
+      value += static_cast<char>(0xE0 | (codePoint >> 12));
+      value += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+      value += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+      value += static_cast<char>(0xF0 | (codePoint >> 18));
+      value += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+      value += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+      value += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+  }
+
+  inline std::uint32_t JsonPullParser::ReadHex() {
+    if(m_last - m_cursor < 4) {
+      Fail();
+    }
+    auto value = std::uint32_t(0);
+    auto result = std::from_chars(m_cursor, m_cursor + 4, value, 16);
+    if(result.ptr != m_cursor + 4) {
+      Fail();
+    }
+    m_cursor += 4;
+    return value;
+  }
+}
+
+#endif
@@ -0,0 +1,285 @@
+#ifndef BEAM_DATAGRAMBATCH_HPP
+#define BEAM_DATAGRAMBATCH_HPP
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <boost/asio/ip/udp.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/throw_exception.hpp>
+#include "Beam/Network/DatagramPacket.hpp"
+#include "Beam/Network/IpAddress.hpp"
+#include "Beam/Network/Network.hpp"
+#include "Beam/Network/SocketException.hpp"
+#ifdef __linux__
+  #include <sys/socket.h>
+  #include <sys/uio.h>
+  #include <time.h>
+#endif
+
+namespace Beam {
+namespace Network {
+namespace Details {
+  struct DatagramSlot {
+    char* m_data;
+    std::size_t m_capacity;
+    std::size_t m_size;
+    bool m_isTruncated;
+    boost::asio::ip::udp::endpoint m_endpoint;
+    boost::posix_time::ptime m_timestamp;
+  };
+
+  struct DatagramHeaders {
+#ifdef __linux__
+    static constexpr auto CONTROL_SIZE =
+      std::size_t(CMSG_SPACE(sizeof(timespec)));
+    std::vector<mmsghdr> m_headers;
+    std::vector<iovec> m_vectors;
+    std::vector<char> m_control;
+#endif
+
+    void Prepare(DatagramSlot* slots, std::size_t count) {
+#ifdef __linux__
+      m_headers.resize(count);
+      m_vectors.resize(count);
+      m_control.resize(count * CONTROL_SIZE);
+      for(auto i = std::size_t(0); i != count; ++i) {
+        m_vectors[i].iov_base = slots[i].m_data;
+        m_vectors[i].iov_len = slots[i].m_capacity;
+        auto& header = m_headers[i].msg_hdr;
+        header = msghdr();
+        header.msg_name = slots[i].m_endpoint.data();
+        header.msg_iov = &m_vectors[i];
+        header.msg_iovlen = 1;
+        header.msg_control = m_control.data() + i * CONTROL_SIZE;
+      }
+#endif
+    }
+  };
+
+#ifdef __linux__
+  inline boost::posix_time::ptime GetDatagramTimestamp(const msghdr& header) {
+    for(auto message = CMSG_FIRSTHDR(&header); message != nullptr;
+        message = CMSG_NXTHDR(const_cast<msghdr*>(&header), message)) {
+      if(message->cmsg_level == SOL_SOCKET &&
+          message->cmsg_type == SCM_TIMESTAMPNS) {
+        auto time = timespec();
+        std::memcpy(&time, CMSG_DATA(message), sizeof(time));
+        return boost::posix_time::from_time_t(time.tv_sec) +
+          boost::posix_time::microseconds(time.tv_nsec / 1000);
+      }
+    }
+    return boost::posix_time::not_a_date_time;
+  }
+#endif
+
+  //! Receives as many pending datagrams as fit without blocking, using a
+  //! single recvmmsg call where it is available.
+  inline std::size_t ReceiveDatagrams(boost::asio::ip::udp::socket& socket,
+      DatagramHeaders& headers, DatagramSlot* slots, std::size_t count) {
+#ifdef __linux__
+    for(auto i = std::size_t(0); i != count; ++i) {
+      headers.m_headers[i].msg_len = 0;
+      headers.m_headers[i].msg_hdr.msg_namelen = static_cast<socklen_t>(
+        slots[i].m_endpoint.capacity());
+      headers.m_headers[i].msg_hdr.msg_controllen =
+        DatagramHeaders::CONTROL_SIZE;
+    }
+    auto result = ::recvmmsg(socket.native_handle(), headers.m_headers.data(),
+      static_cast<unsigned int>(count), MSG_DONTWAIT, nullptr);
+    if(result < 0) {
+      if(errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+        return 0;
+      }
+      BOOST_THROW_EXCEPTION(SocketException(errno, std::strerror(errno)));
+    }
+    for(auto i = 0; i != result; ++i) {
+      auto& slot = slots[i];
+      slot.m_size = headers.m_headers[i].msg_len;
+      slot.m_isTruncated =
+        (headers.m_headers[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+      slot.m_endpoint.resize(headers.m_headers[i].msg_hdr.msg_namelen);
+      slot.m_timestamp = GetDatagramTimestamp(headers.m_headers[i].msg_hdr);
+    }
+    return static_cast<std::size_t>(result);
+#else
+    auto result = std::size_t(0);
+    auto errorCode = boost::system::error_code();
+    while(result != count && socket.available(errorCode) != 0 && !errorCode) {
+      auto& slot = slots[result];
+      slot.m_size = socket.receive_from(
+        boost::asio::buffer(slot.m_data, slot.m_capacity), slot.m_endpoint, 0,
+        errorCode);
+      slot.m_isTruncated = errorCode == boost::asio::error::message_size;
+      if(slot.m_isTruncated) {
+        errorCode.clear();
+        slot.m_size = slot.m_capacity;
+      } else if(errorCode) {
+        break;
+      }
+      slot.m_timestamp = boost::posix_time::not_a_date_time;
+      ++result;
+    }
+    if(errorCode && result == 0) {
+      BOOST_THROW_EXCEPTION(SocketException(errorCode.value(),
+        errorCode.message()));
+    }
+    return result;
+#endif
+  }
+}
+
+  /*! \class DatagramBatch
+      \brief Stores a preallocated ring of datagrams received together.
+   */
+  class DatagramBatch {
+    public:
+
+      //! The default number of datagrams per batch.
+      static constexpr auto DEFAULT_CAPACITY = std::size_t(64);
+
+      //! Constructs a DatagramBatch.
+      /*!
+        \param capacity The maximum number of datagrams per batch.
+        \param maxDatagramSize The size of each datagram's buffer.
+      */
+      DatagramBatch(std::size_t capacity, std::size_t maxDatagramSize);
+
+      DatagramBatch(DatagramBatch&&) = default;
+
+      DatagramBatch& operator =(DatagramBatch&&) = default;
+
+      //! Returns the maximum number of datagrams per batch.
+      std::size_t GetCapacity() const;
+
+      //! Returns the size of each datagram's buffer.
+      std::size_t GetMaxDatagramSize() const;
+
+      //! Returns the number of datagrams received.
+      std::size_t GetSize() const;
+
+      //! Returns <code>true</code> iff no datagrams were received.
+      bool IsEmpty() const;
+
+      //! Returns the data of a received datagram.
+      /*!
+        \param index The index of the datagram.
+      */
+      const char* GetData(std::size_t index) const;
+
+      //! Returns the size of a received datagram.
+      /*!
+        \param index The index of the datagram.
+      */
+      std::size_t GetDataSize(std::size_t index) const;
+
+      //! Returns <code>true</code> iff a datagram was larger than its buffer
+      //! and only its first GetMaxDatagramSize() bytes were kept.
+      /*!
+        \param index The index of the datagram.
+      */
+      bool IsTruncated(std::size_t index) const;
+
+      //! Returns the address a datagram was received from.
+      /*!
+        \param index The index of the datagram.
+      */
+      IpAddress GetAddress(std::size_t index) const;
+
+      //! Returns the time the kernel received a datagram, or
+      //! <code>not_a_date_time</code> if timestamps are not enabled.
+      /*!
+        \param index The index of the datagram.
+      */
+      boost::posix_time::ptime GetTimestamp(std::size_t index) const;
+
+      //! Copies a received datagram into a DatagramPacket.
+      /*!
+        \param index The index of the datagram.
+      */
+      template<typename Buffer>
+      DatagramPacket<Buffer> GetPacket(std::size_t index) const;
+
+      //! Discards all received datagrams, the buffers remain allocated.
+      void Clear();
+
+    private:
+      friend class UdpSocketReceiver;
+      std::size_t m_maxDatagramSize;
+      std::size_t m_size;
+      std::unique_ptr<char[]> m_data;
+      std::vector<Details::DatagramSlot> m_slots;
+      Details::DatagramHeaders m_headers;
+  };
+
+  inline DatagramBatch::DatagramBatch(std::size_t capacity,
+      std::size_t maxDatagramSize)
+      : m_maxDatagramSize(maxDatagramSize),
+        m_size(0),
+        m_data(std::make_unique<char[]>(capacity * maxDatagramSize)),
+        m_slots(capacity) {
+    for(auto i = std::size_t(0); i != capacity; ++i) {
+      auto& slot = m_slots[i];
+      slot.m_data = m_data.get() + i * m_maxDatagramSize;
+      slot.m_capacity = m_maxDatagramSize;
+      slot.m_size = 0;
+      slot.m_isTruncated = false;
+    }
+    m_headers.Prepare(m_slots.data(), m_slots.size());
+  }
+
+  inline std::size_t DatagramBatch::GetCapacity() const {
+    return m_slots.size();
+  }
+
+  inline std::size_t DatagramBatch::GetMaxDatagramSize() const {
+    return m_maxDatagramSize;
+  }
+
+  inline std::size_t DatagramBatch::GetSize() const {
+    return m_size;
+  }
+
+  inline bool DatagramBatch::IsEmpty() const {
+    return m_size == 0;
+  }
+
+  inline const char* DatagramBatch::GetData(std::size_t index) const {
+    return m_slots[index].m_data;
+  }
+
+  inline std::size_t DatagramBatch::GetDataSize(std::size_t index) const {
+    return m_slots[index].m_size;
+  }
+
+  inline bool DatagramBatch::IsTruncated(std::size_t index) const {
+    return m_slots[index].m_isTruncated;
+  }
+
+  inline IpAddress DatagramBatch::GetAddress(std::size_t index) const {
+    auto& endpoint = m_slots[index].m_endpoint;
+    return IpAddress(endpoint.address().to_string(), endpoint.port());
+  }
+
+  inline boost::posix_time::ptime DatagramBatch::GetTimestamp(
+      std::size_t index) const {
+    return m_slots[index].m_timestamp;
+  }
+
+  template<typename Buffer>
+  DatagramPacket<Buffer> DatagramBatch::GetPacket(std::size_t index) const {
+    auto data = Buffer();
+    data.Append(GetData(index), GetDataSize(index));
+    auto packet = DatagramPacket<Buffer>(std::move(data), GetAddress(index),
+      GetTimestamp(index));
+    packet.SetTruncated(IsTruncated(index));
+    return packet;
+  }
+
+  inline void DatagramBatch::Clear() {
+    m_size = 0;
+  }
+}
+}
+
+#endif
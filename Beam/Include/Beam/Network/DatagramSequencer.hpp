@@ -0,0 +1,258 @@
+#ifndef BEAM_DATAGRAMSEQUENCER_HPP
+#define BEAM_DATAGRAMSEQUENCER_HPP
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <boost/optional/optional.hpp>
+#include "Beam/Network/Network.hpp"
+
+namespace Beam {
+namespace Network {
+
+  /*! \class DatagramSequencer
+      \brief Restores the order of datagrams carrying an application sequence
+             number, detecting gaps that can not be filled within a bounded
+             reorder window.
+      \tparam BufferType The type of buffer storing each datagram.
+   */
+  template<typename BufferType>
+  class DatagramSequencer : private boost::noncopyable {
+    public:
+
+      //! The type of buffer storing each datagram.
+      using Buffer = BufferType;
+
+      //! The callback receiving datagrams in sequence order.
+      /*!
+        \param sequence The datagram's sequence number.
+        \param datagram The datagram's data.
+      */
+      using DatagramHandler = std::function<
+        void (std::uint64_t sequence, Buffer& datagram)>;
+
+      //! The callback notified of sequence numbers that were skipped.
+      /*!
+        \param first The first missing sequence number.
+        \param count The number of consecutive missing sequence numbers.
+      */
+      using GapHandler = std::function<
+        void (std::uint64_t first, std::uint64_t count)>;
+
+      /*! \struct Statistics
+          \brief Counts the datagrams seen by a DatagramSequencer.
+       */
+      struct Statistics {
+
+        //! The number of datagrams pushed.
+        std::uint64_t m_received = 0;
+
+        //! The number of datagrams delivered in order.
+        std::uint64_t m_delivered = 0;
+
+        //! The number of datagrams that arrived ahead of a missing one.
+        std::uint64_t m_reordered = 0;
+
+        //! The number of duplicate or late datagrams discarded.
+        std::uint64_t m_discarded = 0;
+
+        //! The number of gaps reported.
+        std::uint64_t m_gaps = 0;
+
+        //! The number of sequence numbers reported missing.
+        std::uint64_t m_lost = 0;
+      };
+
+      //! Constructs a DatagramSequencer whose first sequence number is taken
+      //! from the first datagram pushed.
+      /*!
+        \param reorderWindow The maximum number of sequence numbers a datagram
+               can arrive ahead of a missing one before the missing one is
+               reported as a gap.
+        \param datagramHandler Receives datagrams in sequence order.
+        \param gapHandler Notified of skipped sequence numbers.
+      */
+      DatagramSequencer(std::size_t reorderWindow,
+        DatagramHandler datagramHandler, GapHandler gapHandler);
+
+      //! Constructs a DatagramSequencer.
+      /*!
+        \param firstSequence The first expected sequence number.
+        \param reorderWindow The maximum number of sequence numbers a datagram
+               can arrive ahead of a missing one before the missing one is
+               reported as a gap.
+        \param datagramHandler Receives datagrams in sequence order.
+        \param gapHandler Notified of skipped sequence numbers.
+      */
+      DatagramSequencer(std::uint64_t firstSequence, std::size_t reorderWindow,
+        DatagramHandler datagramHandler, GapHandler gapHandler);
+
+      //! Returns the next sequence number expected.
+      std::uint64_t GetNextSequence() const;
+
+      //! Returns the number of datagrams held waiting for a missing one.
+      std::size_t GetPendingCount() const;
+
+      //! Returns the Statistics.
+      const Statistics& GetStatistics() const;
+
+      //! Pushes a received datagram.
+      /*!
+        \param sequence The datagram's sequence number.
+        \param datagram The datagram's data.
+      */
+      void Push(std::uint64_t sequence, Buffer datagram);
+
+      //! Gives up on every missing datagram, delivering all held datagrams and
+      //! reporting the gaps between them, typically after a timeout.
+      void Flush();
+
+    private:
+      std::uint64_t m_nextSequence;
+      bool m_isInitialized;
+      std::vector<boost::optional<Buffer>> m_window;
+      std::size_t m_pendingCount;
+      std::uint64_t m_lastPending;
+      DatagramHandler m_datagramHandler;
+      GapHandler m_gapHandler;
+      Statistics m_statistics;
+
+      boost::optional<Buffer>& GetSlot(std::uint64_t sequence);
+      void Deliver(Buffer& datagram);
+      void Drain();
+      void Advance(std::uint64_t sequence);
+  };
+
+  template<typename BufferType>
+  DatagramSequencer<BufferType>::DatagramSequencer(std::size_t reorderWindow,
+      DatagramHandler datagramHandler, GapHandler gapHandler)
+      : DatagramSequencer(0, reorderWindow, std::move(datagramHandler),
+          std::move(gapHandler)) {
+    m_isInitialized = false;
+  }
+
+  template<typename BufferType>
+  DatagramSequencer<BufferType>::DatagramSequencer(std::uint64_t firstSequence,
+      std::size_t reorderWindow, DatagramHandler datagramHandler,
+      GapHandler gapHandler)
+      : m_nextSequence(firstSequence),
+        m_isInitialized(true),
+        m_window(std::max<std::size_t>(reorderWindow, 1)),
+        m_pendingCount(0),
+        m_lastPending(firstSequence),
+        m_datagramHandler(std::move(datagramHandler)),
+        m_gapHandler(std::move(gapHandler)) {}
+
+  template<typename BufferType>
+  std::uint64_t DatagramSequencer<BufferType>::GetNextSequence() const {
+    return m_nextSequence;
+  }
+
+  template<typename BufferType>
+  std::size_t DatagramSequencer<BufferType>::GetPendingCount() const {
+    return m_pendingCount;
+  }
+
+  template<typename BufferType>
+  const typename DatagramSequencer<BufferType>::Statistics&
+      DatagramSequencer<BufferType>::GetStatistics() const {
+    return m_statistics;
+  }
+
+  template<typename BufferType>
+  void DatagramSequencer<BufferType>::Push(std::uint64_t sequence,
+      Buffer datagram) {
+    ++m_statistics.m_received;
+    if(!m_isInitialized) {
+      m_nextSequence = sequence;
+      m_lastPending = sequence;
+      m_isInitialized = true;
+    }
+    if(sequence < m_nextSequence) {
+      ++m_statistics.m_discarded;
+      return;
+    }
+    if(sequence == m_nextSequence) {
+      Deliver(datagram);
+      Drain();
+      return;
+    }
+    if(sequence - m_nextSequence >= m_window.size()) {
+      Advance(sequence - m_window.size() + 1);
+      if(sequence == m_nextSequence) {
+        Deliver(datagram);
+        Drain();
+        return;
+      }
+    }
+    auto& slot = GetSlot(sequence);
+    if(slot.is_initialized()) {
+      ++m_statistics.m_discarded;
+      return;
+    }
+    slot.emplace(std::move(datagram));
+    ++m_pendingCount;
+    ++m_statistics.m_reordered;
+    m_lastPending = std::max(m_lastPending, sequence);
+  }
+
+  template<typename BufferType>
+  void DatagramSequencer<BufferType>::Flush() {
+    if(m_pendingCount != 0) {
+      Advance(m_lastPending + 1);
+    }
+  }
+
+  template<typename BufferType>
+  boost::optional<BufferType>& DatagramSequencer<BufferType>::GetSlot(
+      std::uint64_t sequence) {
+    return m_window[sequence % m_window.size()];
+  }
+
+  template<typename BufferType>
+  void DatagramSequencer<BufferType>::Deliver(Buffer& datagram) {
+    ++m_statistics.m_delivered;
+    m_datagramHandler(m_nextSequence, datagram);
+    ++m_nextSequence;
+  }
+
+  template<typename BufferType>
+  void DatagramSequencer<BufferType>::Drain() {
+    while(m_pendingCount != 0) {
+      auto& slot = GetSlot(m_nextSequence);
+      if(!slot.is_initialized()) {
+        return;
+      }
+      --m_pendingCount;
+      Deliver(*slot);
+      slot = boost::none;
+    }
+  }
+
+  template<typename BufferType>
+  void DatagramSequencer<BufferType>::Advance(std::uint64_t sequence) {
+    while(m_nextSequence < sequence) {
+      if(m_pendingCount == 0) {
+        ++m_statistics.m_gaps;
+        m_statistics.m_lost += sequence - m_nextSequence;
+        m_gapHandler(m_nextSequence, sequence - m_nextSequence);
+        m_nextSequence = sequence;
+        return;
+      }
+      auto first = m_nextSequence;
+      while(m_nextSequence < sequence &&
+          !GetSlot(m_nextSequence).is_initialized()) {
+        ++m_nextSequence;
+      }
+      ++m_statistics.m_gaps;
+      m_statistics.m_lost += m_nextSequence - first;
+      m_gapHandler(first, m_nextSequence - first);
+      Drain();
+    }
+    Drain();
+  }
+}
+}
+
+#endif
@@ -224,8 +224,7 @@ namespace Network {
     m_receiver = std::nullopt;
     m_sender = std::nullopt;
     m_socket = std::make_shared<Details::UdpSocketEntry>(
-      m_socketThreadPool->GetService(), m_socketThreadPool->GetService(),
-      boost::asio::ip::udp::v4());
+      m_socketThreadPool->GetService(), boost::asio::ip::udp::v4());
     m_receiver.emplace(m_socket);
     m_sender.emplace(m_socket);
   }
@@ -3,7 +3,9 @@
 
 namespace Beam {
 namespace Network {
+  class DatagramBatch;
   template<typename BufferType> class DatagramPacket;
+  template<typename BufferType> class DatagramSequencer;
   class IpAddress;
   class MulticastSocket;
   class MulticastSocketChannel;
@@ -29,6 +31,12 @@ namespace Network {
   class UdpSocketReceiver;
   class UdpSocketSender;
   class UdpSocketWriter;
+  class UringContext;
+  class UringTcpServerSocket;
+  class UringTcpSocketChannel;
+  class UringTcpSocketConnection;
+  class UringTcpSocketReader;
+  class UringTcpSocketWriter;
 }
 }
 
@@ -18,7 +18,7 @@ namespace Details {
   struct SocketEntry {
     using Socket = SocketType;
     Threading::Mutex m_mutex;
-    boost::asio::io_service* m_ioService;
+    std::shared_ptr<boost::asio::io_service> m_ioService;
     Socket m_socket;
     bool m_isOpen;
     bool m_isReadPending;
@@ -26,9 +26,10 @@ namespace Details {
     Threading::ConditionVariable m_isPendingCondition;
 
     template<typename... Args>
-    SocketEntry(boost::asio::io_service& ioService, Args&&... args)
-        : m_ioService(&ioService),
-          m_socket{std::forward<Args>(args)...},
+    SocketEntry(std::shared_ptr<boost::asio::io_service> ioService,
+        Args&&... args)
+        : m_ioService(std::move(ioService)),
+          m_socket{*m_ioService, std::forward<Args>(args)...},
           m_isOpen{false},
           m_isReadPending{false},
           m_pendingWrites{0} {}
@@ -79,7 +80,7 @@ namespace Details {
   struct SecureSocketEntry {
     using Socket = boost::asio::ssl::stream<boost::asio::ip::tcp::socket>;
     Threading::Mutex m_mutex;
-    boost::asio::io_service* m_ioService;
+    std::shared_ptr<boost::asio::io_service> m_ioService;
     boost::asio::ssl::context m_context;
     Socket m_socket;
     bool m_isOpen;
@@ -88,10 +89,11 @@ namespace Details {
     Threading::ConditionVariable m_isPendingCondition;
 
     template<typename... Args>
-    SecureSocketEntry(boost::asio::io_service& ioService, Args&&... args)
-        : m_ioService(&ioService),
+    SecureSocketEntry(std::shared_ptr<boost::asio::io_service> ioService,
+        Args&&... args)
+        : m_ioService(std::move(ioService)),
           m_context{boost::asio::ssl::context::sslv23},
-          m_socket{std::forward<Args>(args)..., m_context},
+          m_socket{*m_ioService, std::forward<Args>(args)..., m_context},
           m_isOpen{false},
           m_isReadPending{false},
           m_pendingWrites{0} {}
@@ -142,6 +144,11 @@ namespace Details {
   using TcpSocketEntry = SocketEntry<boost::asio::ip::tcp::socket>;
   using UdpSocketEntry = SocketEntry<boost::asio::ip::udp::socket>;
 
+#ifdef SO_REUSEPORT
+  using ReusePortOption =
+    boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+#endif
+
   inline bool IsEndOfFile(const boost::system::error_code& error) {
     return error == boost::asio::error::broken_pipe ||
       error == boost::asio::error::connection_aborted ||
@@ -5,16 +5,24 @@
 #include <boost/noncopyable.hpp>
 #include <boost/thread/thread.hpp>
 #include "Beam/Network/Network.hpp"
+#include "Beam/Threading/IoServiceGroup.hpp"
 
 namespace Beam {
 namespace Network {
 
   /*! \class SocketThreadPool
       \brief Provides the thread pool used by a group of socket Channels.
+      \details By default every thread runs a single shared io_service. In a
+               sharded mode each thread runs its own io_service and every
+               socket is assigned to one of them when it's constructed, so its
+               handlers always run on the same thread.
    */
   class SocketThreadPool : private boost::noncopyable {
     public:
 
+      //! Specifies how sockets are assigned to a thread.
+      using Assignment = Threading::IoServiceGroup::Assignment;
+
       //! Constructs a SocketThreadPool.
       SocketThreadPool();
 
@@ -24,7 +32,30 @@ namespace Network {
       */
       SocketThreadPool(std::size_t threadCount);
 
-      ~SocketThreadPool();
+      //! Constructs a SocketThreadPool.
+      /*!
+        \param threadCount The number of threads to use.
+        \param assignment How sockets are assigned to a thread.
+        \param isPinned Whether each thread is pinned to its own CPU.
+      */
+      SocketThreadPool(std::size_t threadCount, Assignment assignment,
+        bool isPinned = false);
+
+      //! Returns the number of threads used.
+      std::size_t GetThreadCount() const;
+
+      //! Returns how sockets are assigned to a thread.
+      Assignment GetAssignment() const;
+
+      //! Returns the number of shards, 1 when unsharded and one per thread
+      //! otherwise.
+      std::size_t GetShardCount() const;
+
+      //! Returns the number of sockets currently assigned to a shard.
+      /*!
+        \param shard The index of the shard.
+      */
+      std::size_t GetSocketCount(std::size_t shard) const;
 
     private:
       friend class MulticastSocket;
@@ -32,38 +63,47 @@ namespace Network {
       friend class TcpServerSocket;
       friend class TcpSocketChannel;
       friend class UdpSocket;
-      boost::asio::io_service m_service;
-      boost::asio::io_service::work m_work;
-      std::size_t m_threadCount;
-      std::unique_ptr<boost::thread[]> m_threads;
+      Threading::IoServiceGroup m_services;
 
-      boost::asio::io_service& GetService();
+      std::shared_ptr<boost::asio::io_service> GetService();
+      std::shared_ptr<boost::asio::io_service> GetService(std::size_t shard);
   };
 
   inline SocketThreadPool::SocketThreadPool()
       : SocketThreadPool(boost::thread::hardware_concurrency()) {}
 
   inline SocketThreadPool::SocketThreadPool(std::size_t threadCount)
-      : m_work(m_service),
-        m_threadCount(threadCount),
-        m_threads(std::make_unique<boost::thread[]>(m_threadCount)) {
-    for(std::size_t i = 0; i < m_threadCount; ++i) {
-      m_threads[i] = boost::thread(
-        [=] {
-          m_service.run();
-        });
-    }
+      : SocketThreadPool(threadCount, Assignment::SHARED) {}
+
+  inline SocketThreadPool::SocketThreadPool(std::size_t threadCount,
+      Assignment assignment, bool isPinned)
+      : m_services(threadCount, assignment, isPinned) {}
+
+  inline std::size_t SocketThreadPool::GetThreadCount() const {
+    return m_services.GetThreadCount();
+  }
+
+  inline SocketThreadPool::Assignment SocketThreadPool::GetAssignment() const {
+    return m_services.GetAssignment();
+  }
+
+  inline std::size_t SocketThreadPool::GetShardCount() const {
+    return m_services.GetServiceCount();
+  }
+
+  inline std::size_t SocketThreadPool::GetSocketCount(
+      std::size_t shard) const {
+    return m_services.GetLoad(shard);
   }
 
-  inline SocketThreadPool::~SocketThreadPool() {
-    m_service.stop();
-    for(std::size_t i = 0; i < m_threadCount; ++i) {
-      m_threads[i].join();
-    }
+  inline std::shared_ptr<boost::asio::io_service>
+      SocketThreadPool::GetService() {
+    return m_services.Acquire();
   }
 
-  inline boost::asio::io_service& SocketThreadPool::GetService() {
-    return m_service;
+  inline std::shared_ptr<boost::asio::io_service>
+      SocketThreadPool::GetService(std::size_t shard) {
+    return m_services.Acquire(shard);
   }
 }
 }
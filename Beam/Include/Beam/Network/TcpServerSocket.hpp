@@ -1,12 +1,18 @@
 #ifndef BEAM_SERVERSOCKET_HPP
 #define BEAM_SERVERSOCKET_HPP
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
 #include <boost/noncopyable.hpp>
 #include <boost/optional/optional.hpp>
+#include <boost/thread/locks.hpp>
 #include "Beam/IO/EndOfFileException.hpp"
 #include "Beam/IO/OpenState.hpp"
 #include "Beam/IO/ServerConnection.hpp"
 #include "Beam/Network/IpAddress.hpp"
 #include "Beam/Network/Network.hpp"
+#include "Beam/Network/NetworkDetails.hpp"
 #include "Beam/Network/SocketException.hpp"
 #include "Beam/Network/SocketThreadPool.hpp"
 #include "Beam/Network/TcpSocketChannel.hpp"
@@ -14,6 +20,8 @@
 #include "Beam/Network/TcpSocketReader.hpp"
 #include "Beam/Network/TcpSocketWriter.hpp"
 #include "Beam/Pointers/Ref.hpp"
+#include "Beam/Threading/ConditionVariable.hpp"
+#include "Beam/Threading/Mutex.hpp"
 #include "Beam/Utilities/ToString.hpp"
 
 namespace Beam {
@@ -21,6 +29,12 @@ namespace Network {
 
   /*! \class TcpServerSocket
       \brief Implements a server socket.
+      \details A TcpServerSocket normally listens with a single acceptor and
+               assigns each accepted Channel to a thread of its
+               SocketThreadPool. When the SocketThreadPool is sharded it can
+               instead open one SO_REUSEPORT acceptor per shard, letting the
+               kernel spread incoming connections across the shards and
+               keeping each accepted Channel on the shard that accepted it.
    */
   class TcpServerSocket : private boost::noncopyable {
     public:
@@ -34,6 +48,17 @@ namespace Network {
       TcpServerSocket(const IpAddress& address,
         Ref<SocketThreadPool> socketThreadPool);
 
+      //! Constructs a TcpServerSocket.
+      /*!
+        \param address The IP address to bind to.
+        \param socketThreadPool The thread pool used for the sockets.
+        \param isListenerPerShard Whether to open one SO_REUSEPORT acceptor
+               per shard of the <i>socketThreadPool</i>, ignored on platforms
+               without SO_REUSEPORT.
+      */
+      TcpServerSocket(const IpAddress& address,
+        Ref<SocketThreadPool> socketThreadPool, bool isListenerPerShard);
+
       ~TcpServerSocket();
 
       std::unique_ptr<Channel> Accept();
@@ -43,20 +68,45 @@ namespace Network {
       void Close();
 
     private:
+      struct Listener {
+        std::shared_ptr<boost::asio::io_service> m_service;
+        boost::optional<boost::asio::ip::tcp::acceptor> m_acceptor;
+        bool m_isSharded;
+        std::unique_ptr<Channel> m_channel;
+        std::exception_ptr m_exception;
+      };
       IpAddress m_address;
       SocketThreadPool* m_socketThreadPool;
-      boost::asio::io_service* m_ioService;
-      boost::optional<boost::asio::ip::tcp::acceptor> m_acceptor;
+      bool m_isListenerPerShard;
+      Threading::Mutex m_mutex;
+      std::vector<std::unique_ptr<Listener>> m_listeners;
+      bool m_isAccepting;
+      bool m_isArmed;
+      int m_pendingAccepts;
+      std::deque<Listener*> m_acceptedListeners;
+      Threading::ConditionVariable m_acceptCondition;
       IO::OpenState m_openState;
 
       void Shutdown();
+      void AddListener(
+        const boost::asio::ip::tcp::resolver::iterator& endpointIterator,
+        std::shared_ptr<boost::asio::io_service> service, bool isSharded);
+      void Arm(Listener& listener);
+      void OnAccept(Listener& listener, const boost::system::error_code& error);
   };
 
   inline TcpServerSocket::TcpServerSocket(const IpAddress& address,
       Ref<SocketThreadPool> socketThreadPool)
+      : TcpServerSocket(address, std::move(socketThreadPool), false) {}
+
+  inline TcpServerSocket::TcpServerSocket(const IpAddress& address,
+      Ref<SocketThreadPool> socketThreadPool, bool isListenerPerShard)
       : m_address(address),
         m_socketThreadPool(socketThreadPool.Get()),
-        m_ioService(&m_socketThreadPool->GetService()) {}
+        m_isListenerPerShard(isListenerPerShard),
+        m_isAccepting(false),
+        m_isArmed(false),
+        m_pendingAccepts(0) {}
 
   inline TcpServerSocket::~TcpServerSocket() {
     Close();
@@ -67,7 +117,8 @@ namespace Network {
       return;
     }
     try {
-      boost::asio::ip::tcp::resolver resolver(*m_ioService);
+      auto service = m_socketThreadPool->GetService();
+      boost::asio::ip::tcp::resolver resolver(*service);
       boost::asio::ip::tcp::resolver::query query(m_address.GetHost(),
         ToString(m_address.GetPort()));
       boost::system::error_code error;
@@ -75,7 +126,21 @@ namespace Network {
       if(error) {
         BOOST_THROW_EXCEPTION(SocketException(error.value(), error.message()));
       }
-      m_acceptor.emplace(*m_ioService, *endpointIterator);
+#ifdef SO_REUSEPORT
+      auto shardCount = m_socketThreadPool->GetShardCount();
+      if(m_isListenerPerShard && shardCount > 1) {
+        for(std::size_t i = 0; i < shardCount; ++i) {
+          AddListener(endpointIterator, m_socketThreadPool->GetService(i),
+            true);
+        }
+      } else {
+        AddListener(endpointIterator, std::move(service), false);
+      }
+#else
+      AddListener(endpointIterator, std::move(service), false);
+#endif
+      boost::lock_guard<Threading::Mutex> lock(m_mutex);
+      m_isAccepting = true;
     } catch(const SocketException&) {
       m_openState.SetOpenFailure();
       Shutdown();
@@ -92,33 +157,31 @@ namespace Network {
 
   inline std::unique_ptr<typename TcpServerSocket::Channel>
       TcpServerSocket::Accept() {
-    Routines::Async<void> acceptAsync;
-    Routines::Eval<void> acceptEval = acceptAsync.GetEval();
-    std::unique_ptr<Channel> channel(new TcpSocketChannel{
-      Ref(*m_socketThreadPool)});
-    m_acceptor->async_accept(channel->m_socket->m_socket,
-      [&] (const boost::system::error_code& error) {
-        if(error) {
-          if(Details::IsEndOfFile(error)) {
-            acceptEval.SetException(IO::EndOfFileException(error.message()));
-          } else {
-            acceptEval.SetException(SocketException(error.value(),
-              error.message()));
-          }
-          return;
-        }
-        try {
-          IpAddress address(
-            channel->m_socket->m_socket.remote_endpoint().address().to_string(),
-            channel->m_socket->m_socket.remote_endpoint().port());
-          channel->SetAddress(address);
-          channel->GetConnection().SetOpen();
-          acceptEval.SetResult();
-        } catch(const std::exception&) {
-          acceptEval.SetException(std::current_exception());
-        }
-      });
-    acceptAsync.Get();
+    boost::unique_lock<Threading::Mutex> lock(m_mutex);
+    if(!m_isArmed && m_isAccepting) {
+      m_isArmed = true;
+      for(auto& listener : m_listeners) {
+        Arm(*listener);
+      }
+    }
+    while(m_acceptedListeners.empty() &&
+        (m_isAccepting || m_pendingAccepts != 0)) {
+      m_acceptCondition.wait(lock);
+    }
+    if(m_acceptedListeners.empty()) {
+      BOOST_THROW_EXCEPTION(IO::EndOfFileException());
+    }
+    auto& listener = *m_acceptedListeners.front();
+    m_acceptedListeners.pop_front();
+    auto channel = std::move(listener.m_channel);
+    auto exception = std::exchange(listener.m_exception, nullptr);
+    if(m_isAccepting) {
+      Arm(listener);
+    }
+    lock.unlock();
+    if(exception != nullptr) {
+      std::rethrow_exception(exception);
+    }
     return channel;
   }
 
@@ -130,11 +193,93 @@ namespace Network {
   }
 
   inline void TcpServerSocket::Shutdown() {
-    if(m_acceptor.is_initialized()) {
-      m_acceptor->close();
+    boost::unique_lock<Threading::Mutex> lock(m_mutex);
+    m_isAccepting = false;
+    for(auto& listener : m_listeners) {
+      if(listener->m_acceptor.is_initialized()) {
+        boost::system::error_code error;
+        listener->m_acceptor->close(error);
+      }
     }
+    while(m_pendingAccepts != 0) {
+      m_acceptCondition.wait(lock);
+    }
+    m_acceptedListeners.clear();
+    m_listeners.clear();
     m_openState.SetClosed();
   }
+
+  inline void TcpServerSocket::AddListener(
+      const boost::asio::ip::tcp::resolver::iterator& endpointIterator,
+      std::shared_ptr<boost::asio::io_service> service, bool isSharded) {
+    auto listener = std::make_unique<Listener>();
+    listener->m_service = std::move(service);
+    listener->m_isSharded = isSharded;
+    listener->m_acceptor.emplace(*listener->m_service);
+    auto& acceptor = *listener->m_acceptor;
+    auto endpoint = endpointIterator->endpoint();
+    acceptor.open(endpoint.protocol());
+    acceptor.set_option(
+      boost::asio::ip::tcp::acceptor::reuse_address(true));
+#ifdef SO_REUSEPORT
+    if(isSharded) {
+      acceptor.set_option(Details::ReusePortOption(true));
+    }
+#endif
+    acceptor.bind(endpoint);
+    acceptor.listen();
+    m_listeners.push_back(std::move(listener));
+  }
+
+  inline void TcpServerSocket::Arm(Listener& listener) {
+
+    // Sharded acceptors keep the connection on their own shard, otherwise
+    // the SocketThreadPool assigns it one.
+    auto service = [&] {
+      if(listener.m_isSharded) {
+        return listener.m_service;
+      }
+      return m_socketThreadPool->GetService();
+    }();
+    listener.m_channel.reset(new TcpSocketChannel{std::move(service)});
+    ++m_pendingAccepts;
+    listener.m_acceptor->async_accept(listener.m_channel->m_socket->m_socket,
+      [this, &listener] (const boost::system::error_code& error) {
+        OnAccept(listener, error);
+      });
+  }
+
+  inline void TcpServerSocket::OnAccept(Listener& listener,
+      const boost::system::error_code& error) {
+    auto exception = std::exception_ptr();
+    if(error) {
+      if(Details::IsEndOfFile(error)) {
+        exception = std::make_exception_ptr(
+          IO::EndOfFileException(error.message()));
+      } else {
+        exception = std::make_exception_ptr(
+          SocketException(error.value(), error.message()));
+      }
+    } else {
+      try {
+        auto& socket = listener.m_channel->m_socket->m_socket;
+        IpAddress address(socket.remote_endpoint().address().to_string(),
+          socket.remote_endpoint().port());
+        listener.m_channel->SetAddress(address);
+        listener.m_channel->GetConnection().SetOpen();
+      } catch(const std::exception&) {
+        exception = std::current_exception();
+      }
+    }
+    boost::lock_guard<Threading::Mutex> lock(m_mutex);
+    if(exception != nullptr) {
+      listener.m_channel.reset();
+      listener.m_exception = exception;
+    }
+    m_acceptedListeners.push_back(&listener);
+    --m_pendingAccepts;
+    m_acceptCondition.notify_all();
+  }
 }
 
   template<>
@@ -75,14 +75,14 @@ namespace Network {
       Reader m_reader;
       Writer m_writer;
 
-      TcpSocketChannel(Ref<SocketThreadPool> socketThreadPool);
+      TcpSocketChannel(std::shared_ptr<boost::asio::io_service> service);
       void SetAddress(const IpAddress& address);
   };
 
   inline TcpSocketChannel::TcpSocketChannel(const IpAddress& address,
       Ref<SocketThreadPool> socketThreadPool)
       : m_socket(std::make_shared<Details::TcpSocketEntry>(
-          socketThreadPool->GetService(), socketThreadPool->GetService())),
+          socketThreadPool->GetService())),
         m_identifier(address),
         m_connection(m_socket, address),
         m_reader(m_socket),
@@ -91,7 +91,7 @@ namespace Network {
   inline TcpSocketChannel::TcpSocketChannel(const IpAddress& address,
       const IpAddress& interface, Ref<SocketThreadPool> socketThreadPool)
       : m_socket(std::make_shared<Details::TcpSocketEntry>(
-          socketThreadPool->GetService(), socketThreadPool->GetService())),
+          socketThreadPool->GetService())),
         m_identifier(address),
         m_connection(m_socket, address, interface),
         m_reader(m_socket),
@@ -101,7 +101,7 @@ namespace Network {
       const std::vector<IpAddress>& addresses,
       Ref<SocketThreadPool> socketThreadPool)
       : m_socket(std::make_shared<Details::TcpSocketEntry>(
-          socketThreadPool->GetService(), socketThreadPool->GetService())),
+          socketThreadPool->GetService())),
         m_identifier(addresses.front()),
         m_connection(m_socket, addresses),
         m_reader(m_socket),
@@ -111,7 +111,7 @@ namespace Network {
       const std::vector<IpAddress>& addresses, const IpAddress& interface,
       Ref<SocketThreadPool> socketThreadPool)
       : m_socket(std::make_shared<Details::TcpSocketEntry>(
-          socketThreadPool->GetService(), socketThreadPool->GetService())),
+          socketThreadPool->GetService())),
         m_identifier(addresses.front()),
         m_connection(m_socket, addresses, interface),
         m_reader(m_socket),
@@ -135,9 +135,9 @@ namespace Network {
   }
 
   inline TcpSocketChannel::TcpSocketChannel(
-      Ref<SocketThreadPool> socketThreadPool)
+      std::shared_ptr<boost::asio::io_service> service)
       : m_socket(std::make_shared<Details::TcpSocketEntry>(
-          socketThreadPool->GetService(), socketThreadPool->GetService())),
+          std::move(service))),
         m_connection(m_socket),
         m_reader(m_socket),
         m_writer(m_socket) {}
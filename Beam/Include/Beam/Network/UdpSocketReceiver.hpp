@@ -4,6 +4,7 @@
 #include <boost/asio/steady_timer.hpp>
 #include <boost/noncopyable.hpp>
 #include "Beam/IO/EndOfFileException.hpp"
+#include "Beam/Network/DatagramBatch.hpp"
 #include "Beam/Network/DatagramPacket.hpp"
 #include "Beam/Network/Network.hpp"
 #include "Beam/Network/NetworkDetails.hpp"
@@ -43,6 +44,9 @@ namespace Network {
         //! The default size of the receive buffer.
         std::size_t m_receiveBufferSize;
 
+        //! Whether the kernel timestamps received datagrams.
+        bool m_isTimestampEnabled;
+
         //! Constructs default settings.
         Settings();
       };
@@ -109,6 +113,15 @@ namespace Network {
       std::size_t Receive(Out<Buffer> destination, std::size_t size,
         Out<IpAddress> address);
 
+      //! Receives every pending datagram that fits into a DatagramBatch,
+      //! waiting only if none are pending.
+      /*!
+        \param batch The DatagramBatch to fill, any previous contents are
+               discarded.
+        \return The number of datagrams received.
+      */
+      std::size_t Receive(Out<DatagramBatch> batch);
+
     private:
       mutable Threading::Mutex m_mutex;
       bool m_isOpen;
@@ -118,13 +131,18 @@ namespace Network {
       boost::asio::basic_waitable_timer<boost::chrono::steady_clock> m_deadline;
       Settings m_settings;
 
+      template<typename Operation>
+      std::size_t Await(Operation&& operation);
+      std::size_t Receive(Details::DatagramSlot* slots, std::size_t count,
+        Details::DatagramHeaders& headers);
       void CheckDeadline(const boost::system::error_code& error);
   };
 
   inline UdpSocketReceiver::Settings::Settings()
       : m_timeout{boost::posix_time::pos_infin},
         m_maxDatagramSize{DEFAULT_DATAGRAM_SIZE},
-        m_receiveBufferSize{DEFAULT_RECEIVE_BUFFER_SIZE} {}
+        m_receiveBufferSize{DEFAULT_RECEIVE_BUFFER_SIZE},
+        m_isTimestampEnabled{false} {}
 
   inline UdpSocketReceiver::UdpSocketReceiver(
       const std::shared_ptr<Details::UdpSocketEntry>& socket)
@@ -153,6 +171,15 @@ namespace Network {
     {
       boost::lock_guard<Threading::Mutex> lock{m_socket->m_mutex};
       m_socket->m_socket.set_option(bufferSize, errorCode);
+#ifdef __linux__
+      if(!errorCode && m_settings.m_isTimestampEnabled) {
+        auto enable = 1;
+        if(::setsockopt(m_socket->m_socket.native_handle(), SOL_SOCKET,
+            SO_TIMESTAMPNS, &enable, sizeof(enable)) != 0) {
+          errorCode.assign(errno, boost::system::system_category());
+        }
+      }
+#endif
     }
     if(errorCode) {
       BOOST_THROW_EXCEPTION(SocketException(errorCode.value(),
@@ -168,16 +195,88 @@ namespace Network {
 
   inline std::size_t UdpSocketReceiver::Receive(char* destination,
       std::size_t size, Out<IpAddress> address) {
-    Routines::Async<std::size_t> readResult;
     boost::asio::ip::udp::endpoint senderEndpoint;
+    auto result = Await(
+      [&] (auto&& handler) {
+        m_socket->m_socket.async_receive_from(
+          boost::asio::buffer(destination, size), senderEndpoint,
+          std::move(handler));
+      });
+    *address = IpAddress(senderEndpoint.address().to_string(),
+      senderEndpoint.port());
+    return result;
+  }
+
+  template<typename Buffer>
+  std::size_t UdpSocketReceiver::Receive(Out<DatagramPacket<Buffer>> packet,
+      std::size_t size) {
+    if(!m_settings.m_isTimestampEnabled) {
+      return Receive(Store(packet->GetData()), size,
+        Store(packet->GetAddress()));
+    }
+    auto& data = packet->GetData();
+    auto initialSize = data.GetSize();
+    auto readSize = std::min(m_settings.m_maxDatagramSize, size);
+    data.Grow(readSize);
+    auto slot = Details::DatagramSlot();
+    slot.m_data = data.GetMutableData() + initialSize;
+    slot.m_capacity = readSize;
+    slot.m_size = 0;
+    slot.m_isTruncated = false;
+
+    // The headers are local so that concurrent Receive calls don't share them.
+    auto headers = Details::DatagramHeaders();
+    headers.Prepare(&slot, 1);
+    try {
+      Receive(&slot, 1, headers);
+    } catch(...) {
+      data.Shrink(readSize);
+      BOOST_RETHROW;
+    }
+    data.Shrink(readSize - slot.m_size);
+    packet->GetAddress() = IpAddress(slot.m_endpoint.address().to_string(),
+      slot.m_endpoint.port());
+    packet->SetTimestamp(slot.m_timestamp);
+    packet->SetTruncated(slot.m_isTruncated);
+    return slot.m_size;
+  }
+
+  template<typename Buffer>
+  std::size_t UdpSocketReceiver::Receive(Out<Buffer> destination,
+      Out<IpAddress> address) {
+    return Receive(Store(destination), m_settings.m_maxDatagramSize,
+      Store(address));
+  }
+
+  template<typename Buffer>
+  std::size_t UdpSocketReceiver::Receive(Out<Buffer> destination,
+      std::size_t size, Out<IpAddress> address) {
+    auto initialSize = destination->GetSize();
+    auto readSize = std::min(m_settings.m_maxDatagramSize, size);
+    destination->Grow(readSize);
+    auto result = Receive(destination->GetMutableData() + initialSize, readSize,
+      Store(address));
+    destination->Shrink(readSize - result);
+    return result;
+  }
+
+  inline std::size_t UdpSocketReceiver::Receive(Out<DatagramBatch> batch) {
+    batch->Clear();
+    batch->m_size = Receive(batch->m_slots.data(), batch->m_slots.size(),
+      batch->m_headers);
+    return batch->m_size;
+  }
+
+  template<typename Operation>
+  std::size_t UdpSocketReceiver::Await(Operation&& operation) {
+    Routines::Async<std::size_t> readResult;
     {
       boost::lock_guard<Threading::Mutex> lock{m_socket->m_mutex};
       if(!m_socket->m_isOpen) {
         BOOST_THROW_EXCEPTION(IO::EndOfFileException{});
       }
       m_socket->m_isReadPending = true;
-      m_socket->m_socket.async_receive_from(
-          boost::asio::buffer(destination, size), senderEndpoint,
+      operation(
         [&] (const boost::system::error_code& error, std::size_t readSize) {
           if(error) {
             if(Details::IsEndOfFile(error)) {
@@ -188,8 +287,6 @@ namespace Network {
               error.message()));
             return;
           }
-          *address = IpAddress(senderEndpoint.address().to_string(),
-            senderEndpoint.port());
           readResult.GetEval().SetResult(readSize);
         });
     }
@@ -215,29 +312,30 @@ namespace Network {
     }
   }
 
-  template<typename Buffer>
-  std::size_t UdpSocketReceiver::Receive(Out<DatagramPacket<Buffer>> packet,
-      std::size_t size) {
-    return Receive(Store(packet->GetData()), size, Store(packet->GetAddress()));
-  }
-
-  template<typename Buffer>
-  std::size_t UdpSocketReceiver::Receive(Out<Buffer> destination,
-      Out<IpAddress> address) {
-    return Receive(Store(destination), m_settings.m_maxDatagramSize,
-      Store(address));
-  }
-
-  template<typename Buffer>
-  std::size_t UdpSocketReceiver::Receive(Out<Buffer> destination,
-      std::size_t size, Out<IpAddress> address) {
-    auto initialSize = destination->GetSize();
-    auto readSize = std::min(m_settings.m_maxDatagramSize, size);
-    destination->Grow(readSize);
-    auto result = Receive(destination->GetMutableData() + initialSize, readSize,
-      Store(address));
-    destination->Shrink(readSize - result);
-    return result;
+  inline std::size_t UdpSocketReceiver::Receive(Details::DatagramSlot* slots,
+      std::size_t count, Details::DatagramHeaders& headers) {
+    while(true) {
+      {
+        boost::lock_guard<Threading::Mutex> lock{m_socket->m_mutex};
+        if(!m_socket->m_isOpen) {
+          BOOST_THROW_EXCEPTION(IO::EndOfFileException{});
+        }
+        auto result = Details::ReceiveDatagrams(m_socket->m_socket, headers,
+          slots, count);
+        if(result != 0) {
+          return result;
+        }
+      }
+      Await(
+        [&] (auto&& handler) {
+          m_socket->m_socket.async_wait(
+            boost::asio::ip::udp::socket::wait_read,
+            [handler = std::move(handler)] (
+                const boost::system::error_code& error) mutable {
+              handler(error, 0);
+            });
+        });
+    }
   }
 
   inline void UdpSocketReceiver::CheckDeadline(
@@ -0,0 +1,440 @@
+#ifndef BEAM_URING_CONTEXT_HPP
+#define BEAM_URING_CONTEXT_HPP
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <boost/noncopyable.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include "Beam/Network/Network.hpp"
+#include "Beam/Network/SocketException.hpp"
+
+namespace Beam {
+namespace Network {
+namespace Details {
+  struct UringSocketEntry;
+
+  /*! \struct UringOperation
+      \brief Base class for an operation submitted to a UringContext, its
+             address is used as the submission's user data.
+   */
+  struct UringOperation {
+    virtual ~UringOperation() = default;
+
+    //! Called from the UringContext's completion thread for every
+    //! completion posted for this operation.
+    /*!
+      \param result The completion's result.
+      \param flags The completion's flags.
+    */
+    virtual void Complete(int result, std::uint32_t flags) = 0;
+  };
+
+  /*! \struct UringResource
+      \brief Base class for an object with operations outstanding on a
+             UringContext, notified if the context stops completing them.
+   */
+  struct UringResource {
+    virtual ~UringResource() = default;
+
+    //! Called when the UringContext fails, every outstanding operation must be
+    //! resolved with the <i>exception</i>.
+    /*!
+      \param exception The reason the UringContext failed.
+    */
+    virtual void Fail(const std::exception_ptr& exception) = 0;
+  };
+}
+
+  /*! \class UringContext
+      \brief Provides the io_uring instance used by a group of
+             UringTcpSocketChannels.
+      \details Submissions are made directly from the calling Routine and a
+               single thread reaps completions, resuming the waiting Routine
+               on its own scheduler context. Receives draw from a ring of
+               buffers registered with the kernel that is shared by every
+               socket using this context. If waiting for completions fails
+               the context stops, every outstanding operation fails with the
+               error and further submissions throw it.
+   */
+  class UringContext : private boost::noncopyable {
+    public:
+
+      //! The default number of submission queue entries.
+      static constexpr std::size_t DEFAULT_QUEUE_DEPTH = 1024;
+
+      //! The default number of registered receive buffers.
+      static constexpr std::size_t DEFAULT_BUFFER_COUNT = 1024;
+
+      //! The default size of each registered receive buffer.
+      static constexpr std::size_t DEFAULT_BUFFER_SIZE = 16 * 1024;
+
+      //! Constructs a UringContext using the default sizes.
+      UringContext();
+
+      //! Constructs a UringContext.
+      /*!
+        \param queueDepth The number of submission queue entries.
+        \param bufferCount The number of registered receive buffers, rounded up
+               to a power of 2.
+        \param bufferSize The size of each registered receive buffer.
+      */
+      UringContext(std::size_t queueDepth, std::size_t bufferCount,
+        std::size_t bufferSize);
+
+      ~UringContext();
+
+      //! Returns the number of submission queue entries, which bounds how many
+      //! operations can be submitted together.
+      std::size_t GetQueueDepth() const;
+
+      //! Returns the number of registered receive buffers.
+      std::size_t GetBufferCount() const;
+
+      //! Returns the size of each registered receive buffer.
+      std::size_t GetBufferSize() const;
+
+    private:
+      friend struct Details::UringSocketEntry;
+      friend class UringTcpServerSocket;
+      static constexpr std::uint16_t BUFFER_GROUP = 0;
+      int m_fd;
+      std::size_t m_bufferCount;
+      std::size_t m_bufferSize;
+      std::uint32_t m_sqEntries;
+      void* m_sqRing;
+      std::size_t m_sqRingSize;
+      void* m_cqRing;
+      std::size_t m_cqRingSize;
+      io_uring_sqe* m_sqes;
+      std::uint32_t* m_sqHead;
+      std::uint32_t* m_sqTail;
+      std::uint32_t m_sqMask;
+      std::uint32_t* m_sqArray;
+      std::uint32_t* m_cqHead;
+      std::uint32_t* m_cqTail;
+      std::uint32_t m_cqMask;
+      io_uring_cqe* m_cqes;
+      boost::mutex m_submitMutex;
+      std::exception_ptr m_exception;
+      boost::mutex m_resourceMutex;
+      std::vector<Details::UringResource*> m_resources;
+      std::unique_ptr<char[]> m_buffers;
+      io_uring_buf_ring* m_bufferRing;
+      boost::mutex m_bufferMutex;
+      std::uint16_t m_bufferTail;
+      std::uint64_t m_recycleCount;
+      std::vector<std::function<void ()>> m_starvedCallbacks;
+      boost::thread m_completionThread;
+
+      template<typename F>
+      void Submit(std::size_t count, F&& prepare);
+      void Add(Details::UringResource& resource);
+      void Remove(Details::UringResource& resource);
+      void Fail(const std::exception_ptr& exception);
+      const char* GetBuffer(std::uint16_t id) const;
+      std::uint64_t GetRecycleCount();
+      void Recycle(const std::uint16_t* ids, std::size_t count);
+      bool AddStarved(std::uint64_t recycleCount,
+        std::function<void ()> callback);
+      void PushBuffer(std::uint16_t id);
+      void Shutdown();
+      void RunCompletions();
+  };
+
+  inline UringContext::UringContext()
+      : UringContext(DEFAULT_QUEUE_DEPTH, DEFAULT_BUFFER_COUNT,
+          DEFAULT_BUFFER_SIZE) {}
+
+  inline UringContext::UringContext(std::size_t queueDepth,
+      std::size_t bufferCount, std::size_t bufferSize)
+      : m_fd(-1),
+        m_bufferCount(1),
+        m_bufferSize(bufferSize),
+        m_sqRing(MAP_FAILED),
+        m_cqRing(MAP_FAILED),
+        m_sqes(static_cast<io_uring_sqe*>(MAP_FAILED)),
+        m_bufferRing(static_cast<io_uring_buf_ring*>(MAP_FAILED)),
+        m_bufferTail(0),
+        m_recycleCount(0) {
+    while(m_bufferCount < bufferCount && m_bufferCount < 32768) {
+      m_bufferCount <<= 1;
+    }
+    auto params = io_uring_params();
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = static_cast<std::uint32_t>(
+      4 * std::max(queueDepth, m_bufferCount));
+    m_fd = static_cast<int>(::syscall(__NR_io_uring_setup,
+      static_cast<unsigned int>(queueDepth), &params));
+    if(m_fd < 0) {
+      BOOST_THROW_EXCEPTION(SocketException(errno, std::strerror(errno)));
+    }
+    try {
+      m_sqEntries = params.sq_entries;
+      m_sqRingSize = params.sq_off.array +
+        params.sq_entries * sizeof(std::uint32_t);
+      m_cqRingSize = params.cq_off.cqes +
+        params.cq_entries * sizeof(io_uring_cqe);
+      auto isSingleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+      if(isSingleMap) {
+        m_sqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+      }
+      m_sqRing = ::mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+      if(m_sqRing == MAP_FAILED) {
+        BOOST_THROW_EXCEPTION(SocketException(errno, std::strerror(errno)));
+      }
+      if(isSingleMap) {
+        m_cqRing = m_sqRing;
+      } else {
+        m_cqRing = ::mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE,
+          MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+        if(m_cqRing == MAP_FAILED) {
+          BOOST_THROW_EXCEPTION(SocketException(errno, std::strerror(errno)));
+        }
+      }
+      m_sqes = static_cast<io_uring_sqe*>(::mmap(nullptr,
+        params.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES));
+      if(m_sqes == MAP_FAILED) {
+        BOOST_THROW_EXCEPTION(SocketException(errno, std::strerror(errno)));
+      }
+      auto sqRing = static_cast<char*>(m_sqRing);
+      m_sqHead = reinterpret_cast<std::uint32_t*>(sqRing + params.sq_off.head);
+      m_sqTail = reinterpret_cast<std::uint32_t*>(sqRing + params.sq_off.tail);
+      m_sqMask = *reinterpret_cast<std::uint32_t*>(
+        sqRing + params.sq_off.ring_mask);
+      m_sqArray = reinterpret_cast<std::uint32_t*>(
+        sqRing + params.sq_off.array);
+      auto cqRing = static_cast<char*>(m_cqRing);
+      m_cqHead = reinterpret_cast<std::uint32_t*>(cqRing + params.cq_off.head);
+      m_cqTail = reinterpret_cast<std::uint32_t*>(cqRing + params.cq_off.tail);
+      m_cqMask = *reinterpret_cast<std::uint32_t*>(
+        cqRing + params.cq_off.ring_mask);
+      m_cqes = reinterpret_cast<io_uring_cqe*>(cqRing + params.cq_off.cqes);
+
+      // Register the ring of receive buffers the kernel selects from.
+      m_bufferRing = static_cast<io_uring_buf_ring*>(::mmap(nullptr,
+        m_bufferCount * sizeof(io_uring_buf), PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+      if(m_bufferRing == MAP_FAILED) {
+        BOOST_THROW_EXCEPTION(SocketException(errno, std::strerror(errno)));
+      }
+      auto registration = io_uring_buf_reg();
+      registration.ring_addr = reinterpret_cast<std::uint64_t>(m_bufferRing);
+      registration.ring_entries = static_cast<std::uint32_t>(m_bufferCount);
+      registration.bgid = BUFFER_GROUP;
+      if(::syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_PBUF_RING,
+          &registration, 1) < 0) {
+        BOOST_THROW_EXCEPTION(SocketException(errno, std::strerror(errno)));
+      }
+      m_buffers = std::make_unique<char[]>(m_bufferCount * m_bufferSize);
+      for(std::size_t i = 0; i < m_bufferCount; ++i) {
+        PushBuffer(static_cast<std::uint16_t>(i));
+      }
+      __atomic_store_n(&m_bufferRing->tail, m_bufferTail, __ATOMIC_RELEASE);
+      m_completionThread = boost::thread(
+        [=] {
+          RunCompletions();
+        });
+    } catch(...) {
+      Shutdown();
+      throw;
+    }
+  }
+
+  inline UringContext::~UringContext() {
+    try {
+      Submit(1,
+        [] (io_uring_sqe& sqe, std::size_t) {
+          sqe.opcode = IORING_OP_NOP;
+          sqe.user_data = 0;
+        });
+    } catch(const std::exception&) {
+
+      // Submissions throw once the completion thread has failed and exited.
+    }
+    m_completionThread.join();
+    Shutdown();
+  }
+
+  inline std::size_t UringContext::GetQueueDepth() const {
+    return m_sqEntries;
+  }
+
+  inline std::size_t UringContext::GetBufferCount() const {
+    return m_bufferCount;
+  }
+
+  inline std::size_t UringContext::GetBufferSize() const {
+    return m_bufferSize;
+  }
+
+  template<typename F>
+  void UringContext::Submit(std::size_t count, F&& prepare) {
+    boost::lock_guard<boost::mutex> lock(m_submitMutex);
+    if(m_exception != nullptr) {
+      std::rethrow_exception(m_exception);
+    }
+    auto tail = *m_sqTail;
+    for(std::size_t i = 0; i < count; ++i) {
+      auto index = (tail + static_cast<std::uint32_t>(i)) & m_sqMask;
+      auto& sqe = m_sqes[index];
+      std::memset(&sqe, 0, sizeof(sqe));
+      prepare(sqe, i);
+      m_sqArray[index] = index;
+    }
+    __atomic_store_n(m_sqTail, tail + static_cast<std::uint32_t>(count),
+      __ATOMIC_RELEASE);
+
+    // Without SQPOLL the kernel consumes every entry within the call, so the
+    // submission queue is always empty again once this returns.
+    auto submitted = std::size_t(0);
+    while(submitted < count) {
+      auto result = ::syscall(__NR_io_uring_enter, m_fd,
+        static_cast<unsigned int>(count - submitted), 0, 0, nullptr, 0);
+      if(result < 0) {
+        if(errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+          boost::this_thread::yield();
+          continue;
+        }
+        BOOST_THROW_EXCEPTION(SocketException(errno, std::strerror(errno)));
+      }
+      submitted += static_cast<std::size_t>(result);
+    }
+  }
+
+  inline void UringContext::Add(Details::UringResource& resource) {
+    boost::lock_guard<boost::mutex> lock(m_resourceMutex);
+    m_resources.push_back(&resource);
+  }
+
+  inline void UringContext::Remove(Details::UringResource& resource) {
+    boost::lock_guard<boost::mutex> lock(m_resourceMutex);
+    m_resources.erase(std::find(m_resources.begin(), m_resources.end(),
+      &resource));
+  }
+
+  inline void UringContext::Fail(const std::exception_ptr& exception) {
+    {
+      boost::lock_guard<boost::mutex> lock(m_submitMutex);
+      m_exception = exception;
+    }
+    boost::lock_guard<boost::mutex> lock(m_resourceMutex);
+    for(auto resource : m_resources) {
+      resource->Fail(exception);
+    }
+  }
+
+  inline const char* UringContext::GetBuffer(std::uint16_t id) const {
+    return m_buffers.get() + id * m_bufferSize;
+  }
+
+  inline std::uint64_t UringContext::GetRecycleCount() {
+    boost::lock_guard<boost::mutex> lock(m_bufferMutex);
+    return m_recycleCount;
+  }
+
+  inline void UringContext::Recycle(const std::uint16_t* ids,
+      std::size_t count) {
+    if(count == 0) {
+      return;
+    }
+    auto starvedCallbacks = std::vector<std::function<void ()>>();
+    {
+      boost::lock_guard<boost::mutex> lock(m_bufferMutex);
+      for(std::size_t i = 0; i < count; ++i) {
+        PushBuffer(ids[i]);
+      }
+      __atomic_store_n(&m_bufferRing->tail, m_bufferTail, __ATOMIC_RELEASE);
+      ++m_recycleCount;
+      starvedCallbacks.swap(m_starvedCallbacks);
+    }
+    for(auto& callback : starvedCallbacks) {
+      callback();
+    }
+  }
+
+  inline bool UringContext::AddStarved(std::uint64_t recycleCount,
+      std::function<void ()> callback) {
+    boost::lock_guard<boost::mutex> lock(m_bufferMutex);
+    if(recycleCount != m_recycleCount) {
+      return false;
+    }
+    m_starvedCallbacks.push_back(std::move(callback));
+    return true;
+  }
+
+  inline void UringContext::PushBuffer(std::uint16_t id) {
+
+    // The ring's entries start at its base, index them directly since C++
+    // compilers lay out the header's flexible bufs member at a non-zero
+    // offset.
+    auto& buffer = reinterpret_cast<io_uring_buf*>(m_bufferRing)[
+      m_bufferTail & static_cast<std::uint16_t>(m_bufferCount - 1)];
+    buffer.addr = reinterpret_cast<std::uint64_t>(GetBuffer(id));
+    buffer.len = static_cast<std::uint32_t>(m_bufferSize);
+    buffer.bid = id;
+    ++m_bufferTail;
+  }
+
+  inline void UringContext::Shutdown() {
+    if(m_bufferRing != MAP_FAILED) {
+      ::munmap(m_bufferRing, m_bufferCount * sizeof(io_uring_buf));
+    }
+    if(m_sqes != MAP_FAILED) {
+      ::munmap(m_sqes, m_sqEntries * sizeof(io_uring_sqe));
+    }
+    if(m_cqRing != MAP_FAILED && m_cqRing != m_sqRing) {
+      ::munmap(m_cqRing, m_cqRingSize);
+    }
+    if(m_sqRing != MAP_FAILED) {
+      ::munmap(m_sqRing, m_sqRingSize);
+    }
+    if(m_fd >= 0) {
+      ::close(m_fd);
+    }
+  }
+
+  inline void UringContext::RunCompletions() {
+    auto isRunning = true;
+    while(isRunning) {
+      if(::syscall(__NR_io_uring_enter, m_fd, 0, 1, IORING_ENTER_GETEVENTS,
+          nullptr, 0) < 0 && errno != EINTR) {
+        Fail(std::make_exception_ptr(
+          SocketException(errno, std::strerror(errno))));
+        return;
+      }
+      auto head = *m_cqHead;
+      auto tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+      while(head != tail) {
+
+        // The entry is released before its callback runs, since callbacks
+        // submit further operations that need room to complete into.
+        auto cqe = m_cqes[head & m_cqMask];
+        ++head;
+        __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+        if(cqe.user_data == 0) {
+          isRunning = false;
+        } else {
+          reinterpret_cast<Details::UringOperation*>(cqe.user_data)->Complete(
+            cqe.res, cqe.flags);
+        }
+      }
+    }
+  }
+}
+}
+
+#endif
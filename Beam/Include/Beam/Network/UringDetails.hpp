@@ -0,0 +1,484 @@
+#ifndef BEAM_URING_DETAILS_HPP
+#define BEAM_URING_DETAILS_HPP
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <boost/container/static_vector.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/throw_exception.hpp>
+#include "Beam/IO/EndOfFileException.hpp"
+#include "Beam/Network/Network.hpp"
+#include "Beam/Network/SocketException.hpp"
+#include "Beam/Network/UringContext.hpp"
+#include "Beam/Pointers/Ref.hpp"
+#include "Beam/Routines/Async.hpp"
+#include "Beam/Threading/ConditionVariable.hpp"
+#include "Beam/Threading/Mutex.hpp"
+
+namespace Beam {
+namespace Network {
+namespace Details {
+  inline std::exception_ptr MakeUringException(int error) {
+    if(error == EPIPE || error == ECONNABORTED || error == ECONNRESET ||
+        error == ESHUTDOWN || error == ETIMEDOUT || error == ECANCELED) {
+      return std::make_exception_ptr(
+        IO::EndOfFileException(std::strerror(error)));
+    }
+    return std::make_exception_ptr(
+      SocketException(error, std::strerror(error)));
+  }
+
+  struct UringSocketEntry : UringResource,
+      std::enable_shared_from_this<UringSocketEntry> {
+    struct Segment {
+      std::uint16_t m_buffer;
+      std::uint32_t m_offset;
+      std::uint32_t m_size;
+    };
+
+    struct ReceiveOperation final : UringOperation {
+      UringSocketEntry* m_entry;
+
+      void Complete(int result, std::uint32_t flags) override {
+        m_entry->OnReceive(result, flags);
+      }
+    };
+
+    struct CancelOperation final : UringOperation {
+      UringSocketEntry* m_entry;
+
+      void Complete(int result, std::uint32_t flags) override {
+        m_entry->OnCancel();
+      }
+    };
+
+    struct ConnectOperation final : UringOperation {
+      UringSocketEntry* m_entry;
+      Routines::Eval<int> m_result;
+
+      void Complete(int result, std::uint32_t flags) override {
+        m_entry->OnConnect(*this, result);
+      }
+    };
+
+    struct WriteOperation final : UringOperation {
+      UringSocketEntry* m_entry;
+      const char* m_data;
+      std::size_t m_size;
+      std::size_t m_written;
+      Routines::Eval<void> m_result;
+
+      void Complete(int result, std::uint32_t flags) override {
+        m_entry->OnSend(*this, result);
+      }
+    };
+
+    //! The maximum number of buffers a single Read returns to the context.
+    static constexpr std::size_t MAX_READ_BUFFERS = 16;
+
+    UringContext* m_context;
+    Threading::Mutex m_mutex;
+    int m_fd;
+    bool m_isOpen;
+    ConnectOperation* m_connectOperation;
+    ReceiveOperation m_receiveOperation;
+    CancelOperation m_cancelOperation;
+    bool m_isReceiveArmed;
+    std::uint64_t m_armRecycleCount;
+    std::deque<Segment> m_segments;
+    bool m_isEndOfFile;
+    std::exception_ptr m_readException;
+    std::vector<WriteOperation*> m_queuedWrites;
+    std::vector<WriteOperation*> m_sendingWrites;
+    std::size_t m_pendingSends;
+    std::exception_ptr m_writeException;
+    int m_pendingOperations;
+    Threading::ConditionVariable m_readCondition;
+    Threading::ConditionVariable m_pendingCondition;
+
+    explicit UringSocketEntry(Ref<UringContext> context)
+        : m_context(context.Get()),
+          m_fd(-1),
+          m_isOpen(false),
+          m_connectOperation(nullptr),
+          m_isReceiveArmed(false),
+          m_armRecycleCount(0),
+          m_isEndOfFile(false),
+          m_pendingSends(0),
+          m_pendingOperations(0) {
+      m_receiveOperation.m_entry = this;
+      m_cancelOperation.m_entry = this;
+      m_context->Add(*this);
+    }
+
+    ~UringSocketEntry() override {
+      Close();
+      m_context->Remove(*this);
+    }
+
+    int Connect(int fd, const sockaddr* address, socklen_t length) {
+      Routines::Async<int> result;
+      ConnectOperation operation;
+      operation.m_entry = this;
+      operation.m_result = result.GetEval();
+      {
+        boost::lock_guard<Threading::Mutex> lock(m_mutex);
+        m_connectOperation = &operation;
+        try {
+          m_context->Submit(1,
+            [&] (io_uring_sqe& sqe, std::size_t) {
+              sqe.opcode = IORING_OP_CONNECT;
+              sqe.fd = fd;
+              sqe.addr = reinterpret_cast<std::uint64_t>(address);
+              sqe.off = length;
+              sqe.user_data = reinterpret_cast<std::uint64_t>(&operation);
+            });
+        } catch(const std::exception&) {
+          m_connectOperation = nullptr;
+          throw;
+        }
+      }
+      return result.Get();
+    }
+
+    void Open(int fd) {
+      boost::lock_guard<Threading::Mutex> lock(m_mutex);
+      m_fd = fd;
+      m_isOpen = true;
+      m_isEndOfFile = false;
+      m_readException = nullptr;
+      m_writeException = nullptr;
+      ArmReceive();
+    }
+
+    void Close() {
+      auto buffers = std::vector<std::uint16_t>();
+      {
+        boost::unique_lock<Threading::Mutex> lock(m_mutex);
+        if(!m_isOpen) {
+          return;
+        }
+        m_isOpen = false;
+        ::shutdown(m_fd, SHUT_RDWR);
+        if(m_isReceiveArmed) {
+          ++m_pendingOperations;
+          try {
+            m_context->Submit(1,
+              [&] (io_uring_sqe& sqe, std::size_t) {
+                sqe.opcode = IORING_OP_ASYNC_CANCEL;
+                sqe.addr = reinterpret_cast<std::uint64_t>(
+                  &m_receiveOperation);
+                sqe.user_data = reinterpret_cast<std::uint64_t>(
+                  &m_cancelOperation);
+              });
+          } catch(const std::exception&) {
+
+            // The shutdown still ends the receive.
+            --m_pendingOperations;
+          }
+        }
+        while(m_pendingOperations != 0) {
+          m_pendingCondition.wait(lock);
+        }
+        ::close(m_fd);
+        m_fd = -1;
+        for(auto& segment : m_segments) {
+          buffers.push_back(segment.m_buffer);
+        }
+        m_segments.clear();
+        m_readCondition.notify_all();
+      }
+      m_context->Recycle(buffers.data(), buffers.size());
+    }
+
+    bool IsDataAvailable() {
+      boost::lock_guard<Threading::Mutex> lock(m_mutex);
+      return !m_segments.empty();
+    }
+
+    std::size_t Read(char* destination, std::size_t size) {
+      auto buffers = boost::container::static_vector<std::uint16_t,
+        MAX_READ_BUFFERS>();
+      auto readSize = std::size_t(0);
+      {
+        boost::unique_lock<Threading::Mutex> lock(m_mutex);
+        while(m_segments.empty() && m_isOpen && !m_isEndOfFile &&
+            m_readException == nullptr) {
+          m_readCondition.wait(lock);
+        }
+        if(m_segments.empty()) {
+          if(m_readException != nullptr) {
+            std::rethrow_exception(m_readException);
+          }
+          BOOST_THROW_EXCEPTION(IO::EndOfFileException());
+        }
+        while(readSize != size && !m_segments.empty() &&
+            buffers.size() != buffers.capacity()) {
+          auto& segment = m_segments.front();
+          auto copySize = std::min<std::size_t>(size - readSize,
+            segment.m_size);
+          std::memcpy(destination + readSize,
+            m_context->GetBuffer(segment.m_buffer) + segment.m_offset,
+            copySize);
+          readSize += copySize;
+          segment.m_offset += static_cast<std::uint32_t>(copySize);
+          segment.m_size -= static_cast<std::uint32_t>(copySize);
+          if(segment.m_size == 0) {
+            buffers.push_back(segment.m_buffer);
+            m_segments.pop_front();
+          }
+        }
+      }
+      m_context->Recycle(buffers.data(), buffers.size());
+      return readSize;
+    }
+
+    void Write(const char* data, std::size_t size) {
+      Routines::Async<void> result;
+      WriteOperation operation;
+      operation.m_entry = this;
+      operation.m_data = data;
+      operation.m_size = size;
+      operation.m_written = 0;
+      operation.m_result = result.GetEval();
+      {
+        boost::lock_guard<Threading::Mutex> lock(m_mutex);
+        if(!m_isOpen) {
+          BOOST_THROW_EXCEPTION(IO::EndOfFileException());
+        }
+        if(m_writeException != nullptr) {
+          std::rethrow_exception(m_writeException);
+        }
+        m_queuedWrites.push_back(&operation);
+        if(m_pendingSends == 0) {
+          SubmitWrites();
+        }
+      }
+      result.Get();
+    }
+
+    void ArmReceive() {
+      m_isReceiveArmed = true;
+      ++m_pendingOperations;
+      m_armRecycleCount = m_context->GetRecycleCount();
+      try {
+        m_context->Submit(1,
+          [&] (io_uring_sqe& sqe, std::size_t) {
+            sqe.opcode = IORING_OP_RECV;
+            sqe.fd = m_fd;
+            sqe.flags = IOSQE_BUFFER_SELECT;
+            sqe.buf_group = UringContext::BUFFER_GROUP;
+            sqe.ioprio = IORING_RECV_MULTISHOT;
+            sqe.user_data = reinterpret_cast<std::uint64_t>(
+              &m_receiveOperation);
+          });
+      } catch(const std::exception&) {
+
+        // Re-arming runs on the completion thread, so a failure is reported
+        // to the reader rather than thrown.
+        m_isReceiveArmed = false;
+        --m_pendingOperations;
+        m_readException = std::current_exception();
+        m_readCondition.notify_all();
+        m_pendingCondition.notify_all();
+      }
+    }
+
+    void OnReceive(int result, std::uint32_t flags) {
+      auto isBufferReleased = false;
+      auto buffer = std::uint16_t(0);
+      {
+        boost::lock_guard<Threading::Mutex> lock(m_mutex);
+        if((flags & IORING_CQE_F_BUFFER) != 0) {
+          buffer = static_cast<std::uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+          if(result > 0 && m_isOpen) {
+            m_segments.push_back(
+              {buffer, 0, static_cast<std::uint32_t>(result)});
+          } else {
+            isBufferReleased = true;
+          }
+        }
+        if(result == 0) {
+          m_isEndOfFile = true;
+        } else if(result < 0 && result != -ENOBUFS && result != -ECANCELED) {
+          m_readException = MakeUringException(-result);
+        }
+        if((flags & IORING_CQE_F_MORE) == 0) {
+
+          // The multishot receive ended, either for good or because the
+          // kernel ran out of registered buffers.
+          m_isReceiveArmed = false;
+          --m_pendingOperations;
+          if(m_isOpen && !m_isEndOfFile && m_readException == nullptr) {
+            if(result != -ENOBUFS) {
+              ArmReceive();
+            } else if(!m_context->AddStarved(m_armRecycleCount,
+                [entry = std::weak_ptr<UringSocketEntry>(shared_from_this())] {
+                  if(auto self = entry.lock()) {
+                    self->OnBuffersAvailable();
+                  }
+                })) {
+              ArmReceive();
+            }
+          }
+          m_pendingCondition.notify_all();
+        }
+        m_readCondition.notify_all();
+      }
+      if(isBufferReleased) {
+        m_context->Recycle(&buffer, 1);
+      }
+    }
+
+    void OnBuffersAvailable() {
+      boost::lock_guard<Threading::Mutex> lock(m_mutex);
+      if(m_isOpen && !m_isReceiveArmed && !m_isEndOfFile &&
+          m_readException == nullptr) {
+        ArmReceive();
+      }
+    }
+
+    void OnConnect(ConnectOperation& operation, int result) {
+      {
+        boost::lock_guard<Threading::Mutex> lock(m_mutex);
+        if(m_connectOperation != &operation) {
+          return;
+        }
+        m_connectOperation = nullptr;
+      }
+      operation.m_result.SetResult(result);
+    }
+
+    void OnCancel() {
+      boost::lock_guard<Threading::Mutex> lock(m_mutex);
+      --m_pendingOperations;
+      m_pendingCondition.notify_all();
+    }
+
+    void SubmitWrites() {
+
+      // Every write queued while the previous chain was in flight goes out as
+      // one linked chain, so they reach the socket in order. A chain can't
+      // outgrow the submission queue, writes past its end stay in
+      // m_sendingWrites and lead the next chain.
+      m_sendingWrites.insert(m_sendingWrites.end(), m_queuedWrites.begin(),
+        m_queuedWrites.end());
+      m_queuedWrites.clear();
+      if(m_sendingWrites.empty()) {
+        return;
+      }
+      m_pendingSends = std::min(m_sendingWrites.size(),
+        m_context->GetQueueDepth());
+      m_pendingOperations += static_cast<int>(m_pendingSends);
+      try {
+        m_context->Submit(m_pendingSends,
+          [&] (io_uring_sqe& sqe, std::size_t index) {
+            auto& operation = *m_sendingWrites[index];
+            sqe.opcode = IORING_OP_SEND;
+            sqe.fd = m_fd;
+            sqe.addr = reinterpret_cast<std::uint64_t>(
+              operation.m_data + operation.m_written);
+            sqe.len = static_cast<std::uint32_t>(std::min<std::size_t>(
+              operation.m_size - operation.m_written, 1 << 30));
+            sqe.msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+            if(index + 1 != m_pendingSends) {
+              sqe.flags = IOSQE_IO_LINK;
+            }
+            sqe.user_data = reinterpret_cast<std::uint64_t>(&operation);
+          });
+      } catch(const std::exception&) {
+        m_pendingOperations -= static_cast<int>(m_pendingSends);
+        m_pendingSends = 0;
+        FailWrites(std::current_exception());
+      }
+    }
+
+    void FailWrites(const std::exception_ptr& exception) {
+      m_writeException = exception;
+      for(auto write : m_sendingWrites) {
+        write->m_result.SetException(exception);
+      }
+      m_sendingWrites.clear();
+      for(auto write : m_queuedWrites) {
+        write->m_result.SetException(exception);
+      }
+      m_queuedWrites.clear();
+      m_pendingCondition.notify_all();
+    }
+
+    void Fail(const std::exception_ptr& exception) override {
+      auto connectOperation = static_cast<ConnectOperation*>(nullptr);
+      {
+        boost::lock_guard<Threading::Mutex> lock(m_mutex);
+        connectOperation = std::exchange(m_connectOperation, nullptr);
+
+        // No completion will arrive for anything still in flight.
+        m_isReceiveArmed = false;
+        m_pendingSends = 0;
+        m_pendingOperations = 0;
+        if(m_readException == nullptr) {
+          m_readException = exception;
+        }
+        FailWrites(exception);
+        m_readCondition.notify_all();
+      }
+      if(connectOperation != nullptr) {
+        connectOperation->m_result.SetException(exception);
+      }
+    }
+
+    void OnSend(WriteOperation& operation, int result) {
+      boost::lock_guard<Threading::Mutex> lock(m_mutex);
+      --m_pendingSends;
+      --m_pendingOperations;
+      if(result > 0) {
+        operation.m_written += static_cast<std::size_t>(result);
+      } else if(result < 0 && result != -ECANCELED) {
+        m_writeException = MakeUringException(-result);
+      } else if(result == 0 && operation.m_written != operation.m_size) {
+        m_writeException = MakeUringException(EPIPE);
+      }
+      if(m_pendingSends != 0) {
+        return;
+      }
+
+      // A short send breaks the chain and cancels the rest of it, so whatever
+      // is left unwritten is resubmitted along with any newly queued writes.
+      auto exception = m_writeException;
+      if(exception == nullptr && !m_isOpen) {
+        exception = std::make_exception_ptr(IO::EndOfFileException());
+      }
+      auto sendingWrites = std::move(m_sendingWrites);
+      m_sendingWrites.clear();
+      for(auto write : sendingWrites) {
+        if(write->m_written == write->m_size) {
+          write->m_result.SetResult();
+        } else if(exception != nullptr) {
+          write->m_result.SetException(exception);
+        } else {
+          m_sendingWrites.push_back(write);
+        }
+      }
+      if(exception != nullptr) {
+        for(auto write : m_queuedWrites) {
+          write->m_result.SetException(exception);
+        }
+        m_queuedWrites.clear();
+      } else {
+        SubmitWrites();
+      }
+      m_pendingCondition.notify_all();
+    }
+  };
+}
+}
+}
+
+#endif
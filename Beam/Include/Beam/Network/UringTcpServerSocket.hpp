@@ -0,0 +1,292 @@
+#ifndef BEAM_URING_TCP_SERVER_SOCKET_HPP
+#define BEAM_URING_TCP_SERVER_SOCKET_HPP
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <boost/noncopyable.hpp>
+#include <boost/throw_exception.hpp>
+#include "Beam/IO/EndOfFileException.hpp"
+#include "Beam/IO/OpenState.hpp"
+#include "Beam/IO/ServerConnection.hpp"
+#include "Beam/Network/IpAddress.hpp"
+#include "Beam/Network/Network.hpp"
+#include "Beam/Network/SocketException.hpp"
+#include "Beam/Network/UringContext.hpp"
+#include "Beam/Network/UringDetails.hpp"
+#include "Beam/Network/UringTcpSocketChannel.hpp"
+#include "Beam/Pointers/Ref.hpp"
+#include "Beam/Routines/Async.hpp"
+#include "Beam/Threading/ConditionVariable.hpp"
+#include "Beam/Threading/Mutex.hpp"
+#include "Beam/Utilities/ToString.hpp"
+
+namespace Beam {
+namespace Network {
+
+  /*! \class UringTcpServerSocket
+      \brief Implements a server socket that accepts through io_uring,
+             available on Linux only.
+      \details Each Accept submits an accept on the listening socket and
+               wraps the accepted socket in a UringTcpSocketChannel on the
+               same UringContext.
+   */
+  class UringTcpServerSocket : private Details::UringResource,
+      private boost::noncopyable {
+    public:
+      using Channel = UringTcpSocketChannel;
+
+      //! Constructs a UringTcpServerSocket.
+      /*!
+        \param address The IP address to bind to.
+        \param context The UringContext used for the listening socket and
+               every accepted Channel.
+      */
+      UringTcpServerSocket(const IpAddress& address,
+        Ref<UringContext> context);
+
+      ~UringTcpServerSocket() override;
+
+      std::unique_ptr<Channel> Accept();
+
+      void Open();
+
+      void Close();
+
+    private:
+      struct AcceptOperation final : Details::UringOperation {
+        UringTcpServerSocket* m_server;
+        sockaddr_in m_address;
+        socklen_t m_addressLength;
+        Routines::Eval<int> m_result;
+
+        void Complete(int result, std::uint32_t flags) override {
+          m_server->OnAccept(*this, result);
+        }
+      };
+      struct CancelOperation final : Details::UringOperation {
+        UringTcpServerSocket* m_server;
+
+        void Complete(int result, std::uint32_t flags) override {
+          m_server->OnCancel();
+        }
+      };
+      IpAddress m_address;
+      UringContext* m_context;
+      Threading::Mutex m_mutex;
+      int m_fd;
+      bool m_isAccepting;
+      std::vector<AcceptOperation*> m_acceptOperations;
+      CancelOperation m_cancelOperation;
+      int m_pendingOperations;
+      std::exception_ptr m_exception;
+      Threading::ConditionVariable m_pendingCondition;
+      IO::OpenState m_openState;
+
+      void Shutdown();
+      void Listen();
+      void OnAccept(AcceptOperation& operation, int result);
+      void OnCancel();
+      void Fail(const std::exception_ptr& exception) override;
+  };
+
+  inline UringTcpServerSocket::UringTcpServerSocket(const IpAddress& address,
+      Ref<UringContext> context)
+      : m_address(address),
+        m_context(context.Get()),
+        m_fd(-1),
+        m_isAccepting(false),
+        m_pendingOperations(0) {
+    m_cancelOperation.m_server = this;
+    m_context->Add(*this);
+  }
+
+  inline UringTcpServerSocket::~UringTcpServerSocket() {
+    Close();
+    m_context->Remove(*this);
+  }
+
+  inline std::unique_ptr<typename UringTcpServerSocket::Channel>
+      UringTcpServerSocket::Accept() {
+    Routines::Async<int> result;
+    AcceptOperation operation;
+    operation.m_server = this;
+    operation.m_addressLength = sizeof(operation.m_address);
+    operation.m_result = result.GetEval();
+    {
+      boost::lock_guard<Threading::Mutex> lock(m_mutex);
+      if(m_exception != nullptr) {
+        std::rethrow_exception(m_exception);
+      }
+      if(!m_isAccepting) {
+        BOOST_THROW_EXCEPTION(IO::EndOfFileException());
+      }
+      m_acceptOperations.push_back(&operation);
+      ++m_pendingOperations;
+      try {
+        m_context->Submit(1,
+          [&] (io_uring_sqe& sqe, std::size_t) {
+            sqe.opcode = IORING_OP_ACCEPT;
+            sqe.fd = m_fd;
+            sqe.addr = reinterpret_cast<std::uint64_t>(&operation.m_address);
+            sqe.addr2 = reinterpret_cast<std::uint64_t>(
+              &operation.m_addressLength);
+            sqe.accept_flags = SOCK_CLOEXEC;
+            sqe.user_data = reinterpret_cast<std::uint64_t>(&operation);
+          });
+      } catch(const std::exception&) {
+        m_acceptOperations.pop_back();
+        --m_pendingOperations;
+        throw;
+      }
+    }
+    auto fd = result.Get();
+    if(fd < 0) {
+      if(fd == -ECANCELED || fd == -EINVAL) {
+        BOOST_THROW_EXCEPTION(IO::EndOfFileException());
+      }
+      std::rethrow_exception(Details::MakeUringException(-fd));
+    }
+    char host[INET_ADDRSTRLEN];
+    ::inet_ntop(AF_INET, &operation.m_address.sin_addr, host, sizeof(host));
+    try {
+      return std::unique_ptr<Channel>(new Channel(fd,
+        IpAddress(host, ntohs(operation.m_address.sin_port)),
+        Ref(*m_context)));
+    } catch(const std::exception&) {
+      ::close(fd);
+      throw;
+    }
+  }
+
+  inline void UringTcpServerSocket::Open() {
+    if(m_openState.SetOpening()) {
+      return;
+    }
+    try {
+      Listen();
+    } catch(const std::exception&) {
+      m_openState.SetOpenFailure();
+      Shutdown();
+    }
+    m_openState.SetOpen();
+  }
+
+  inline void UringTcpServerSocket::Close() {
+    if(m_openState.SetClosing()) {
+      return;
+    }
+    Shutdown();
+  }
+
+  inline void UringTcpServerSocket::Shutdown() {
+    {
+      boost::unique_lock<Threading::Mutex> lock(m_mutex);
+      m_isAccepting = false;
+      if(m_fd >= 0) {
+        for(auto operation : m_acceptOperations) {
+          ++m_pendingOperations;
+          try {
+            m_context->Submit(1,
+              [&] (io_uring_sqe& sqe, std::size_t) {
+                sqe.opcode = IORING_OP_ASYNC_CANCEL;
+                sqe.addr = reinterpret_cast<std::uint64_t>(operation);
+                sqe.user_data = reinterpret_cast<std::uint64_t>(
+                  &m_cancelOperation);
+              });
+          } catch(const std::exception&) {
+            --m_pendingOperations;
+          }
+        }
+        while(m_pendingOperations != 0) {
+          m_pendingCondition.wait(lock);
+        }
+        ::close(m_fd);
+        m_fd = -1;
+      }
+    }
+    m_openState.SetClosed();
+  }
+
+  inline void UringTcpServerSocket::Listen() {
+    auto hints = addrinfo();
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    auto endpoints = static_cast<addrinfo*>(nullptr);
+    if(auto result = ::getaddrinfo(m_address.GetHost().c_str(),
+        ToString(m_address.GetPort()).c_str(), &hints, &endpoints)) {
+      BOOST_THROW_EXCEPTION(SocketException(result, ::gai_strerror(result)));
+    }
+    auto fd = ::socket(endpoints->ai_family, SOCK_STREAM | SOCK_CLOEXEC,
+      IPPROTO_TCP);
+    auto reuseAddress = 1;
+    if(fd < 0 || ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuseAddress,
+        sizeof(reuseAddress)) != 0 || ::bind(fd, endpoints->ai_addr,
+        endpoints->ai_addrlen) != 0 || ::listen(fd, SOMAXCONN) != 0) {
+      auto error = errno;
+      ::freeaddrinfo(endpoints);
+      if(fd >= 0) {
+        ::close(fd);
+      }
+      BOOST_THROW_EXCEPTION(SocketException(error, std::strerror(error)));
+    }
+    ::freeaddrinfo(endpoints);
+    boost::lock_guard<Threading::Mutex> lock(m_mutex);
+    m_fd = fd;
+    m_isAccepting = true;
+  }
+
+  inline void UringTcpServerSocket::OnAccept(AcceptOperation& operation,
+      int result) {
+    {
+      boost::lock_guard<Threading::Mutex> lock(m_mutex);
+      auto i = std::find(m_acceptOperations.begin(),
+        m_acceptOperations.end(), &operation);
+      if(i == m_acceptOperations.end()) {
+        return;
+      }
+      m_acceptOperations.erase(i);
+      --m_pendingOperations;
+      m_pendingCondition.notify_all();
+    }
+    operation.m_result.SetResult(result);
+  }
+
+  inline void UringTcpServerSocket::OnCancel() {
+    boost::lock_guard<Threading::Mutex> lock(m_mutex);
+    --m_pendingOperations;
+    m_pendingCondition.notify_all();
+  }
+
+  inline void UringTcpServerSocket::Fail(
+      const std::exception_ptr& exception) {
+    auto acceptOperations = std::vector<AcceptOperation*>();
+    {
+      boost::lock_guard<Threading::Mutex> lock(m_mutex);
+      m_exception = exception;
+      acceptOperations.swap(m_acceptOperations);
+      m_pendingOperations = 0;
+      m_pendingCondition.notify_all();
+    }
+    for(auto operation : acceptOperations) {
+      operation->m_result.SetException(exception);
+    }
+  }
+}
+
+  template<>
+  struct ImplementsConcept<Network::UringTcpServerSocket,
+    IO::ServerConnection<Network::UringTcpServerSocket::Channel>> :
+    std::true_type {};
+}
+
+#endif
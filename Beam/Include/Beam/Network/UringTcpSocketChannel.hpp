@@ -0,0 +1,147 @@
+#ifndef BEAM_URING_TCP_SOCKET_CHANNEL_HPP
+#define BEAM_URING_TCP_SOCKET_CHANNEL_HPP
+#include <memory>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include "Beam/IO/Channel.hpp"
+#include "Beam/Network/Network.hpp"
+#include "Beam/Network/SocketIdentifier.hpp"
+#include "Beam/Network/UringContext.hpp"
+#include "Beam/Network/UringDetails.hpp"
+#include "Beam/Network/UringTcpSocketConnection.hpp"
+#include "Beam/Network/UringTcpSocketReader.hpp"
+#include "Beam/Network/UringTcpSocketWriter.hpp"
+#include "Beam/Pointers/Ref.hpp"
+
+namespace Beam {
+namespace Network {
+
+  /*! \class UringTcpSocketChannel
+      \brief Implements the Channel interface using a TCP socket driven by
+             io_uring, available on Linux only.
+   */
+  class UringTcpSocketChannel : private boost::noncopyable {
+    public:
+      using Identifier = SocketIdentifier;
+      using Connection = UringTcpSocketConnection;
+      using Reader = UringTcpSocketReader;
+      using Writer = UringTcpSocketWriter;
+
+      //! Constructs a UringTcpSocketChannel.
+      /*!
+        \param address The IP address to connect to.
+        \param context The UringContext used for the socket.
+      */
+      UringTcpSocketChannel(const IpAddress& address,
+        Ref<UringContext> context);
+
+      //! Constructs a UringTcpSocketChannel.
+      /*!
+        \param address The IP address to connect to.
+        \param interface The interface to bind to.
+        \param context The UringContext used for the socket.
+      */
+      UringTcpSocketChannel(const IpAddress& address,
+        const IpAddress& interface, Ref<UringContext> context);
+
+      //! Constructs a UringTcpSocketChannel.
+      /*!
+        \param addresses The list of IP addresses to try to connect to.
+        \param context The UringContext used for the socket.
+      */
+      UringTcpSocketChannel(const std::vector<IpAddress>& addresses,
+        Ref<UringContext> context);
+
+      //! Constructs a UringTcpSocketChannel.
+      /*!
+        \param addresses The list of IP addresses to try to connect to.
+        \param interface The interface to bind to.
+        \param context The UringContext used for the socket.
+      */
+      UringTcpSocketChannel(const std::vector<IpAddress>& addresses,
+        const IpAddress& interface, Ref<UringContext> context);
+
+      const Identifier& GetIdentifier() const;
+
+      Connection& GetConnection();
+
+      Reader& GetReader();
+
+      Writer& GetWriter();
+
+    private:
+      friend class UringTcpServerSocket;
+      std::shared_ptr<Details::UringSocketEntry> m_socket;
+      Identifier m_identifier;
+      Connection m_connection;
+      Reader m_reader;
+      Writer m_writer;
+
+      UringTcpSocketChannel(int fd, const IpAddress& address,
+        Ref<UringContext> context);
+  };
+
+  inline UringTcpSocketChannel::UringTcpSocketChannel(
+      const IpAddress& address, Ref<UringContext> context)
+      : UringTcpSocketChannel(std::vector<IpAddress>{address},
+          Ref(*context.Get())) {}
+
+  inline UringTcpSocketChannel::UringTcpSocketChannel(
+      const IpAddress& address, const IpAddress& interface,
+      Ref<UringContext> context)
+      : UringTcpSocketChannel(std::vector<IpAddress>{address}, interface,
+          Ref(*context.Get())) {}
+
+  inline UringTcpSocketChannel::UringTcpSocketChannel(
+      const std::vector<IpAddress>& addresses, Ref<UringContext> context)
+      : m_socket(std::make_shared<Details::UringSocketEntry>(
+          Ref(*context.Get()))),
+        m_identifier(addresses.front()),
+        m_connection(m_socket, addresses, boost::none),
+        m_reader(m_socket),
+        m_writer(m_socket) {}
+
+  inline UringTcpSocketChannel::UringTcpSocketChannel(
+      const std::vector<IpAddress>& addresses, const IpAddress& interface,
+      Ref<UringContext> context)
+      : m_socket(std::make_shared<Details::UringSocketEntry>(
+          Ref(*context.Get()))),
+        m_identifier(addresses.front()),
+        m_connection(m_socket, addresses, interface),
+        m_reader(m_socket),
+        m_writer(m_socket) {}
+
+  inline UringTcpSocketChannel::UringTcpSocketChannel(int fd,
+      const IpAddress& address, Ref<UringContext> context)
+      : UringTcpSocketChannel(address, Ref(*context.Get())) {
+    m_connection.SetOpen(fd);
+  }
+
+  inline const UringTcpSocketChannel::Identifier&
+      UringTcpSocketChannel::GetIdentifier() const {
+    return m_identifier;
+  }
+
+  inline UringTcpSocketChannel::Connection&
+      UringTcpSocketChannel::GetConnection() {
+    return m_connection;
+  }
+
+  inline UringTcpSocketChannel::Reader& UringTcpSocketChannel::GetReader() {
+    return m_reader;
+  }
+
+  inline UringTcpSocketChannel::Writer& UringTcpSocketChannel::GetWriter() {
+    return m_writer;
+  }
+}
+
+  template<>
+  struct ImplementsConcept<Network::UringTcpSocketChannel, IO::Channel<
+    Network::UringTcpSocketChannel::Identifier,
+    Network::UringTcpSocketChannel::Connection,
+    Network::UringTcpSocketChannel::Reader,
+    Network::UringTcpSocketChannel::Writer>> : std::true_type {};
+}
+
+#endif
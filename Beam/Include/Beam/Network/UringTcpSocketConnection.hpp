@@ -0,0 +1,234 @@
+#ifndef BEAM_URING_TCP_SOCKET_CONNECTION_HPP
+#define BEAM_URING_TCP_SOCKET_CONNECTION_HPP
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <boost/noncopyable.hpp>
+#include <boost/optional/optional.hpp>
+#include <boost/throw_exception.hpp>
+#include "Beam/IO/Connection.hpp"
+#include "Beam/IO/ConnectException.hpp"
+#include "Beam/IO/OpenState.hpp"
+#include "Beam/Network/IpAddress.hpp"
+#include "Beam/Network/SocketException.hpp"
+#include "Beam/Network/UringDetails.hpp"
+#include "Beam/Pointers/Out.hpp"
+#include "Beam/Utilities/ToString.hpp"
+
+namespace Beam {
+namespace Network {
+
+  /*! \class UringTcpSocketConnection
+      \brief Implements a Connection using a TCP socket driven by io_uring.
+   */
+  class UringTcpSocketConnection : private boost::noncopyable {
+    public:
+      ~UringTcpSocketConnection();
+
+      //! Returns the write buffer size.
+      int GetWriteBufferSize() const;
+
+      //! Sets the write buffer size.
+      /*!
+        \param size The size to set the write buffer to.
+      */
+      void SetWriteBufferSize(int size);
+
+      //! Sets the TCP no delay option.
+      /*!
+        \param noDelay <code>true</code> iff the TCP no delay option should be
+                       enabled.
+      */
+      void SetNoDelay(bool noDelay);
+
+      //! Gets the TCP no delay option.
+      bool GetNoDelay() const;
+
+      void Open();
+
+      void Close();
+
+    private:
+      friend class UringTcpSocketChannel;
+      friend class UringTcpServerSocket;
+      static const std::size_t DEFAULT_WRITE_BUFFER_SIZE = 8 * 1024;
+      std::shared_ptr<Details::UringSocketEntry> m_socket;
+      std::vector<IpAddress> m_addresses;
+      boost::optional<IpAddress> m_interface;
+      bool m_noDelayEnabled;
+      int m_writeBufferSize;
+      IO::OpenState m_openState;
+
+      UringTcpSocketConnection(
+        const std::shared_ptr<Details::UringSocketEntry>& socket,
+        const std::vector<IpAddress>& addresses,
+        const boost::optional<IpAddress>& interface);
+      void Shutdown();
+      void SetOpen(int fd);
+      void SetOption(int level, int name, int value);
+      int Connect(const IpAddress& address, Out<std::string> error);
+  };
+
+  inline UringTcpSocketConnection::~UringTcpSocketConnection() {
+    Close();
+  }
+
+  inline int UringTcpSocketConnection::GetWriteBufferSize() const {
+    return m_writeBufferSize;
+  }
+
+  inline void UringTcpSocketConnection::SetWriteBufferSize(int size) {
+    m_writeBufferSize = size;
+    if(m_openState.IsOpen()) {
+      SetOption(SOL_SOCKET, SO_SNDBUF, m_writeBufferSize);
+    }
+  }
+
+  inline void UringTcpSocketConnection::SetNoDelay(bool noDelay) {
+    m_noDelayEnabled = noDelay;
+    if(m_openState.IsOpen()) {
+      SetOption(IPPROTO_TCP, TCP_NODELAY, m_noDelayEnabled ? 1 : 0);
+    }
+  }
+
+  inline bool UringTcpSocketConnection::GetNoDelay() const {
+    return m_noDelayEnabled;
+  }
+
+  inline void UringTcpSocketConnection::Open() {
+    if(m_openState.SetOpening()) {
+      return;
+    }
+    auto error = std::string("No address to connect to.");
+    auto fd = -1;
+    for(auto& address : m_addresses) {
+      fd = Connect(address, Store(error));
+      if(fd >= 0) {
+        break;
+      }
+    }
+    if(fd < 0) {
+      m_openState.SetOpenFailure(IO::ConnectException(error));
+      Shutdown();
+    }
+    auto noDelay = m_noDelayEnabled ? 1 : 0;
+    if(::setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &m_writeBufferSize,
+        sizeof(m_writeBufferSize)) != 0 || ::setsockopt(fd, IPPROTO_TCP,
+        TCP_NODELAY, &noDelay, sizeof(noDelay)) != 0) {
+      m_openState.SetOpenFailure(IO::ConnectException(std::strerror(errno)));
+      ::close(fd);
+      Shutdown();
+    }
+    m_socket->Open(fd);
+    m_openState.SetOpen();
+  }
+
+  inline void UringTcpSocketConnection::Close() {
+    if(m_openState.SetClosing()) {
+      return;
+    }
+    Shutdown();
+  }
+
+  inline UringTcpSocketConnection::UringTcpSocketConnection(
+      const std::shared_ptr<Details::UringSocketEntry>& socket,
+      const std::vector<IpAddress>& addresses,
+      const boost::optional<IpAddress>& interface)
+      : m_socket(socket),
+        m_addresses(addresses),
+        m_interface(interface),
+        m_noDelayEnabled(false),
+        m_writeBufferSize(DEFAULT_WRITE_BUFFER_SIZE) {}
+
+  inline void UringTcpSocketConnection::Shutdown() {
+    m_socket->Close();
+    m_openState.SetClosed();
+  }
+
+  inline void UringTcpSocketConnection::SetOpen(int fd) {
+    m_socket->Open(fd);
+    m_openState.SetOpen();
+  }
+
+  inline void UringTcpSocketConnection::SetOption(int level, int name,
+      int value) {
+    boost::lock_guard<Threading::Mutex> lock(m_socket->m_mutex);
+    if(::setsockopt(m_socket->m_fd, level, name, &value, sizeof(value)) !=
+        0) {
+      BOOST_THROW_EXCEPTION(SocketException(errno, std::strerror(errno)));
+    }
+  }
+
+  inline int UringTcpSocketConnection::Connect(const IpAddress& address,
+      Out<std::string> error) {
+    auto hints = addrinfo();
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    auto endpoints = static_cast<addrinfo*>(nullptr);
+    if(auto result = ::getaddrinfo(address.GetHost().c_str(),
+        ToString(address.GetPort()).c_str(), &hints, &endpoints)) {
+      *error = ::gai_strerror(result);
+      return -1;
+    }
+    auto fd = -1;
+    for(auto endpoint = endpoints; endpoint != nullptr;
+        endpoint = endpoint->ai_next) {
+      fd = ::socket(endpoint->ai_family, SOCK_STREAM | SOCK_CLOEXEC,
+        IPPROTO_TCP);
+      if(fd < 0) {
+        *error = std::strerror(errno);
+        continue;
+      }
+      if(m_interface.is_initialized()) {
+        auto localEndpoint = sockaddr_in();
+        localEndpoint.sin_family = AF_INET;
+        localEndpoint.sin_port = htons(m_interface->GetPort());
+        if(::inet_pton(AF_INET, m_interface->GetHost().c_str(),
+            &localEndpoint.sin_addr) != 1 || ::bind(fd,
+            reinterpret_cast<const sockaddr*>(&localEndpoint),
+            sizeof(localEndpoint)) != 0) {
+          *error = "Unable to bind to " + m_interface->GetHost() + ":" +
+            ToString(m_interface->GetPort()) + ".";
+          ::close(fd);
+          fd = -1;
+          continue;
+        }
+      }
+      auto result = [&] {
+        try {
+          auto result = m_socket->Connect(fd, endpoint->ai_addr,
+            endpoint->ai_addrlen);
+          if(result != 0) {
+            *error = std::strerror(-result);
+          }
+          return result;
+        } catch(const std::exception& e) {
+          *error = e.what();
+          return -1;
+        }
+      }();
+      if(result == 0) {
+        break;
+      }
+      ::close(fd);
+      fd = -1;
+    }
+    ::freeaddrinfo(endpoints);
+    return fd;
+  }
+}
+
+  template<>
+  struct ImplementsConcept<Network::UringTcpSocketConnection,
+    IO::Connection> : std::true_type {};
+}
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef BEAM_URING_TCP_SOCKET_READER_HPP
+#define BEAM_URING_TCP_SOCKET_READER_HPP
+#include <algorithm>
+#include <memory>
+#include <boost/noncopyable.hpp>
+#include "Beam/IO/IO.hpp"
+#include "Beam/IO/Reader.hpp"
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Network/Network.hpp"
+#include "Beam/Network/UringDetails.hpp"
+
+namespace Beam {
+namespace Network {
+
+  /*! \class UringTcpSocketReader
+      \brief Reads from a TCP socket using io_uring.
+      \details Data arrives through a multishot receive into the
+               UringContext's registered buffers and is copied out of them as
+               it's read.
+   */
+  class UringTcpSocketReader : private boost::noncopyable {
+    public:
+      using Buffer = IO::SharedBuffer;
+
+      bool IsDataAvailable() const;
+
+      template<typename BufferType>
+      std::size_t Read(Out<BufferType> destination);
+
+      std::size_t Read(char* destination, std::size_t size);
+
+      template<typename BufferType>
+      std::size_t Read(Out<BufferType> destination, std::size_t size);
+
+    private:
+      friend class UringTcpSocketChannel;
+      static constexpr std::size_t DEFAULT_READ_SIZE = 8 * 1024;
+      std::shared_ptr<Details::UringSocketEntry> m_socket;
+
+      UringTcpSocketReader(
+        const std::shared_ptr<Details::UringSocketEntry>& socket);
+  };
+
+  inline bool UringTcpSocketReader::IsDataAvailable() const {
+    return m_socket->IsDataAvailable();
+  }
+
+  template<typename BufferType>
+  std::size_t UringTcpSocketReader::Read(Out<BufferType> destination) {
+    return Read(Store(destination), DEFAULT_READ_SIZE);
+  }
+
+  inline std::size_t UringTcpSocketReader::Read(char* destination,
+      std::size_t size) {
+    return m_socket->Read(destination, size);
+  }
+
+  template<typename BufferType>
+  std::size_t UringTcpSocketReader::Read(Out<BufferType> destination,
+      std::size_t size) {
+    auto initialSize = destination->GetSize();
+    auto readSize = std::min(DEFAULT_READ_SIZE, size);
+    destination->Grow(readSize);
+    auto result = Read(destination->GetMutableData() + initialSize, readSize);
+    destination->Shrink(readSize - result);
+    return result;
+  }
+
+  inline UringTcpSocketReader::UringTcpSocketReader(
+      const std::shared_ptr<Details::UringSocketEntry>& socket)
+      : m_socket(socket) {}
+}
+
+  template<typename BufferType>
+  struct ImplementsConcept<Network::UringTcpSocketReader,
+    IO::Reader<BufferType>> : std::true_type {};
+}
+
+#endif
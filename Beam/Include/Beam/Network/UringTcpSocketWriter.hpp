@@ -0,0 +1,55 @@
+#ifndef BEAM_URING_TCP_SOCKET_WRITER_HPP
+#define BEAM_URING_TCP_SOCKET_WRITER_HPP
+#include <memory>
+#include <boost/noncopyable.hpp>
+#include "Beam/IO/IO.hpp"
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/IO/Writer.hpp"
+#include "Beam/Network/Network.hpp"
+#include "Beam/Network/UringDetails.hpp"
+
+namespace Beam {
+namespace Network {
+
+  /*! \class UringTcpSocketWriter
+      \brief Writes to a TCP socket using io_uring.
+      \details Writes made while earlier ones are still in flight are
+               submitted together as a single linked chain of sends.
+   */
+  class UringTcpSocketWriter : private boost::noncopyable {
+    public:
+      using Buffer = IO::SharedBuffer;
+
+      void Write(const void* data, std::size_t size);
+
+      template<typename BufferType>
+      void Write(const BufferType& data);
+
+    private:
+      friend class UringTcpSocketChannel;
+      std::shared_ptr<Details::UringSocketEntry> m_socket;
+
+      UringTcpSocketWriter(
+        const std::shared_ptr<Details::UringSocketEntry>& socket);
+  };
+
+  inline void UringTcpSocketWriter::Write(const void* data, std::size_t size) {
+    m_socket->Write(static_cast<const char*>(data), size);
+  }
+
+  template<typename BufferType>
+  void UringTcpSocketWriter::Write(const BufferType& data) {
+    Write(data.GetData(), data.GetSize());
+  }
+
+  inline UringTcpSocketWriter::UringTcpSocketWriter(
+      const std::shared_ptr<Details::UringSocketEntry>& socket)
+      : m_socket(socket) {}
+}
+
+  template<typename BufferType>
+  struct ImplementsConcept<Network::UringTcpSocketWriter,
+    IO::Writer<BufferType>> : std::true_type {};
+}
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef BEAM_CHARACTERSCANNER_HPP
+#define BEAM_CHARACTERSCANNER_HPP
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define BEAM_PARSERS_USE_SSE2
+  #include <emmintrin.h>
+  #ifdef _MSC_VER
+    #include <intrin.h>
+  #endif
+#endif
+#include "Beam/Parsers/Parsers.hpp"
+
+namespace Beam {
+namespace Parsers {
+namespace Details {
+
+  /** Returns a pointer to the first character in [first, last) that is not
+      part of a character class, or last if every character is. */
+  using Scanner = const char* (*)(const char* first, const char* last);
+
+  /** Returns the Scanner that matches runs of a Parser's character class, or
+      nullptr if the Parser can not be scanned. */
+  template<typename P, typename = void>
+  struct CharacterClassScanner {
+    static constexpr Scanner value = nullptr;
+  };
+
+  template<typename P>
+  struct CharacterClassScanner<P, std::void_t<decltype(&P::Scan)>> {
+    static constexpr Scanner value = &P::Scan;
+  };
+
+  //! Whether a Parser's character class can be scanned.
+  template<typename P>
+  constexpr auto IsScannable = CharacterClassScanner<P>::value != nullptr;
+
+  template<typename S, typename = void>
+  struct HasScan : std::false_type {};
+
+  template<typename S>
+  struct HasScan<S, std::void_t<decltype(std::declval<S&>().Scan(
+    std::declval<Scanner>(), std::declval<std::string*>()))>> :
+    std::true_type {};
+
+  inline bool IsSpace(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+  }
+
+  inline bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+  }
+
+  inline bool IsAlpha(char c) {
+    auto lower = static_cast<char>(c | 0x20);
+    return lower >= 'a' && lower <= 'z';
+  }
+
+#ifdef BEAM_PARSERS_USE_SSE2
+  inline int CountTrailingZeros(std::uint32_t mask) {
+    #ifdef _MSC_VER
+      auto index = static_cast<unsigned long>(0);
+      _BitScanForward(&index, mask);
+      return static_cast<int>(index);
+    #else
+      return __builtin_ctz(mask);
+    #endif
+  }
+
+  /** Applies a 16 byte wide test to [first, last), finishing the tail one
+      character at a time. */
+  template<typename Block, typename Single>
+  const char* ScanBlocks(const char* first, const char* last, Block block,
+      Single single) {
+    while(last - first >= 16) {
+      auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+      auto mask = static_cast<std::uint32_t>(
+        _mm_movemask_epi8(block(chunk))) ^ 0xFFFF;
+      if(mask != 0) {
+        return first + CountTrailingZeros(mask);
+      }
+      first += 16;
+    }
+    while(first != last && single(*first)) {
+      ++first;
+    }
+    return first;
+  }
+
+  inline __m128i InRange(__m128i chunk, char low, char high) {
+    return _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8(low - 1)),
+      _mm_cmplt_epi8(chunk, _mm_set1_epi8(high + 1)));
+  }
+#endif
+
+  //! Scans a run of characters matched by std::isspace in the C locale.
+  inline const char* ScanSpaces(const char* first, const char* last) {
+#ifdef BEAM_PARSERS_USE_SSE2
+    return ScanBlocks(first, last,
+      [] (__m128i chunk) {
+        return _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')),
+          InRange(chunk, '\t', '\r'));
+      }, IsSpace);
+#else
+    while(first != last && IsSpace(*first)) {
+      ++first;
+    }
+    return first;
+#endif
+  }
+
+  //! Scans a run of characters matched by std::isdigit.
+  inline const char* ScanDigits(const char* first, const char* last) {
+#ifdef BEAM_PARSERS_USE_SSE2
+    return ScanBlocks(first, last,
+      [] (__m128i chunk) {
+        return InRange(chunk, '0', '9');
+      }, IsDigit);
+#else
+    while(first != last && IsDigit(*first)) {
+      ++first;
+    }
+    return first;
+#endif
+  }
+
+  //! Scans a run of characters matched by std::isalpha in the C locale.
+  inline const char* ScanAlphas(const char* first, const char* last) {
+#ifdef BEAM_PARSERS_USE_SSE2
+    return ScanBlocks(first, last,
+      [] (__m128i chunk) {
+        return InRange(_mm_or_si128(chunk, _mm_set1_epi8(0x20)), 'a', 'z');
+      }, IsAlpha);
+#else
+    while(first != last && IsAlpha(*first)) {
+      ++first;
+    }
+    return first;
+#endif
+  }
+
+  //! Scans a run one character at a time, for streams without a buffer.
+  template<typename ParserStreamType>
+  std::size_t ScanEach(ParserStreamType& source, Scanner scanner,
+      std::string* run) {
+    auto count = std::size_t(0);
+    while(source.Read()) {
+      auto c = source.GetChar();
+      if(scanner(&c, &c + 1) == &c) {
+        source.Undo();
+        break;
+      }
+      if(run) {
+        run->push_back(c);
+      }
+      ++count;
+    }
+    return count;
+  }
+
+  //! Consumes the longest run of characters accepted by a Scanner.
+  /*!
+    \param source The ParserStream to consume the run from.
+    \param scanner The Scanner accepting the characters in the run.
+    \param run If not null, the characters consumed are appended to it.
+    \return The number of characters consumed.
+  */
+  template<typename ParserStreamType>
+  std::size_t ScanRun(ParserStreamType& source, Scanner scanner,
+      std::string* run = nullptr) {
+    if constexpr(HasScan<ParserStreamType>::value) {
+      return source.Scan(scanner, run);
+    } else {
+      return ScanEach(source, scanner, run);
+    }
+  }
+
+  //! Consumes the longest run of characters matched by a scannable Parser.
+  template<typename P, typename ParserStreamType>
+  std::size_t ScanRun(ParserStreamType& source, std::string* run = nullptr) {
+    return ScanRun(source, CharacterClassScanner<P>::value, run);
+  }
+}
+}
+}
+
+#endif
@@ -1,5 +1,6 @@
 #ifndef BEAM_DISCARDPARSER_HPP
 #define BEAM_DISCARDPARSER_HPP
+#include "Beam/Parsers/CharacterScanner.hpp"
 #include "Beam/Parsers/Parser.hpp"
 #include "Beam/Parsers/Parsers.hpp"
 #include "Beam/Parsers/SubParserStream.hpp"
@@ -45,6 +46,12 @@ namespace Parsers {
   bool DiscardParser<SubParserType>::Read(ParserStreamType& source) {
     return m_subParser.Read(source);
   }
+
+namespace Details {
+  template<typename SubParserType>
+  struct CharacterClassScanner<DiscardParser<SubParserType>> :
+    CharacterClassScanner<SubParserType> {};
+}
 }
 }
 
@@ -0,0 +1,124 @@
+#ifndef BEAM_MEMOIZEDPARSER_HPP
+#define BEAM_MEMOIZEDPARSER_HPP
+#include <any>
+#include <cstddef>
+#include <memory>
+#include "Beam/Parsers/PackratContext.hpp"
+#include "Beam/Parsers/Parser.hpp"
+#include "Beam/Parsers/Parsers.hpp"
+
+namespace Beam {
+namespace Parsers {
+
+  /*! \class MemoizedParser
+      \brief Remembers the outcome of a Parser at each offset of a
+             PackratParserStream, so that alternatives of an OrParser that
+             backtrack over the same input do not parse it again. Over any
+             other ParserStream the sub-parser is read directly.
+      \tparam SubParserType The parser to memoize, its Result must be copyable.
+   */
+  template<typename SubParserType>
+  class MemoizedParser : public ParserOperators {
+    public:
+      using SubParser = SubParserType;
+      using Result = typename SubParser::Result;
+
+      //! Constructs a MemoizedParser.
+      /*!
+        \param subParser The parser to memoize.
+      */
+      MemoizedParser(const SubParser& subParser);
+
+      template<typename ParserStreamType>
+      bool Read(ParserStreamType& source, Result& value);
+
+      template<typename ParserStreamType>
+      bool Read(ParserStreamType& source);
+
+    private:
+      SubParser m_subParser;
+      std::shared_ptr<char> m_id;
+
+      template<typename ParserStreamType>
+      static void Skip(ParserStreamType& source, std::size_t count);
+  };
+
+  //! Builds a MemoizedParser.
+  /*!
+    \param subParser The parser to memoize.
+  */
+  template<typename SubParser>
+  MemoizedParser<typename GetParserType<SubParser>::type> Memoize(
+      const SubParser& subParser) {
+    return MemoizedParser<typename GetParserType<SubParser>::type>(subParser);
+  }
+
+  template<typename SubParserType>
+  MemoizedParser<SubParserType>::MemoizedParser(const SubParser& subParser)
+    : m_subParser(subParser),
+      m_id(std::make_shared<char>()) {}
+
+  template<typename SubParserType>
+  template<typename ParserStreamType>
+  bool MemoizedParser<SubParserType>::Read(ParserStreamType& source,
+      Result& value) {
+    auto context = Details::GetPackratContext(source);
+    if(!context) {
+      return m_subParser.Read(source, value);
+    }
+    auto offset = context->GetOffset();
+    if(auto entry = context->Find(m_id.get(), offset)) {
+      if(!entry->m_isMatch) {
+        return false;
+      } else if(entry->m_hasValue) {
+        value = std::any_cast<const Result&>(entry->m_value);
+        Skip(source, entry->m_size);
+        return true;
+      }
+    }
+    auto isMatch = m_subParser.Read(source, value);
+    auto& entry = context->Store(m_id.get(), offset);
+    entry.m_isMatch = isMatch;
+    entry.m_size = context->GetOffset() - offset;
+    entry.m_hasValue = isMatch;
+    if(isMatch) {
+      entry.m_value = value;
+    }
+    return isMatch;
+  }
+
+  template<typename SubParserType>
+  template<typename ParserStreamType>
+  bool MemoizedParser<SubParserType>::Read(ParserStreamType& source) {
+    auto context = Details::GetPackratContext(source);
+    if(!context) {
+      return m_subParser.Read(source);
+    }
+    auto offset = context->GetOffset();
+    if(auto entry = context->Find(m_id.get(), offset)) {
+      if(!entry->m_isMatch) {
+        return false;
+      }
+      Skip(source, entry->m_size);
+      return true;
+    }
+    auto isMatch = m_subParser.Read(source);
+    auto& entry = context->Store(m_id.get(), offset);
+    entry.m_isMatch = isMatch;
+    entry.m_size = context->GetOffset() - offset;
+    entry.m_hasValue = false;
+    return isMatch;
+  }
+
+  template<typename SubParserType>
+  template<typename ParserStreamType>
+  void MemoizedParser<SubParserType>::Skip(ParserStreamType& source,
+      std::size_t count) {
+    for(auto i = std::size_t(0); i != count; ++i) {
+      source.Read();
+    }
+  }
+}
+}
+
+#endif
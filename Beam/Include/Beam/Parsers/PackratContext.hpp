@@ -0,0 +1,144 @@
+#ifndef BEAM_PACKRATCONTEXT_HPP
+#define BEAM_PACKRATCONTEXT_HPP
+#include <any>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include "Beam/Parsers/Parsers.hpp"
+
+namespace Beam {
+namespace Parsers {
+
+  /*! \class PackratContext
+      \brief Stores the outcome of MemoizedParsers at each offset of a
+             ParserStream so that backtracking does not parse the same input
+             twice.
+   */
+  class PackratContext {
+    public:
+
+      //! The memoized outcome of a parser at an offset.
+      struct Entry {
+
+        //! Whether the parser matched.
+        bool m_isMatch;
+
+        //! The number of characters the match consumed.
+        std::size_t m_size;
+
+        //! Whether m_value stores the parsed value.
+        bool m_hasValue;
+
+        //! The parsed value.
+        std::any m_value;
+      };
+
+      //! Constructs an empty PackratContext.
+      PackratContext();
+
+      //! Returns the number of characters read from the start of the stream.
+      std::size_t GetOffset() const;
+
+      //! Moves the offset forward.
+      /*!
+        \param count The number of characters read.
+      */
+      void Advance(std::size_t count);
+
+      //! Moves the offset backward.
+      /*!
+        \param count The number of characters undone.
+      */
+      void Retreat(std::size_t count);
+
+      //! Finds a memoized outcome.
+      /*!
+        \param parser Identifies the parser.
+        \param offset The offset the parser started reading from.
+        \return The memoized outcome or <code>nullptr</code>.
+      */
+      Entry* Find(const void* parser, std::size_t offset);
+
+      //! Returns the entry storing an outcome, creating it if needed.
+      /*!
+        \param parser Identifies the parser.
+        \param offset The offset the parser started reading from.
+      */
+      Entry& Store(const void* parser, std::size_t offset);
+
+      //! Removes all memoized outcomes.
+      void Clear();
+
+    private:
+      using Key = std::pair<const void*, std::size_t>;
+      struct KeyHash {
+        std::size_t operator ()(const Key& key) const;
+      };
+      std::size_t m_offset;
+      std::unordered_map<Key, Entry, KeyHash> m_entries;
+  };
+
+namespace Details {
+  template<typename S, typename = void>
+  struct HasPackratContext : std::false_type {};
+
+  template<typename S>
+  struct HasPackratContext<S, std::void_t<
+    decltype(std::declval<S&>().GetPackratContext())>> : std::true_type {};
+
+  //! Returns a ParserStream's PackratContext, or nullptr if it has none.
+  template<typename ParserStreamType>
+  PackratContext* GetPackratContext(ParserStreamType& source) {
+    if constexpr(HasPackratContext<ParserStreamType>::value) {
+      return source.GetPackratContext();
+    } else {
+      return nullptr;
+    }
+  }
+}
+
+  inline PackratContext::PackratContext()
+    : m_offset(0) {}
+
+  inline std::size_t PackratContext::GetOffset() const {
+    return m_offset;
+  }
+
+  inline void PackratContext::Advance(std::size_t count) {
+    m_offset += count;
+  }
+
+  inline void PackratContext::Retreat(std::size_t count) {
+    m_offset -= count;
+  }
+
+  inline PackratContext::Entry* PackratContext::Find(const void* parser,
+      std::size_t offset) {
+    auto entry = m_entries.find(Key(parser, offset));
+    if(entry == m_entries.end()) {
+      return nullptr;
+    }
+    return &entry->second;
+  }
+
+  inline PackratContext::Entry& PackratContext::Store(const void* parser,
+      std::size_t offset) {
+    return m_entries[Key(parser, offset)];
+  }
+
+  inline void PackratContext::Clear() {
+    m_entries.clear();
+  }
+
+  inline std::size_t PackratContext::KeyHash::operator ()(
+      const Key& key) const {
+    auto seed = std::hash<const void*>()(key.first);
+    return seed ^ (std::hash<std::size_t>()(key.second) + 0x9e3779b9 +
+      (seed << 6) + (seed >> 2));
+  }
+}
+}
+
+#endif
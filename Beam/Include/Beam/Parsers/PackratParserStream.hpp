@@ -0,0 +1,101 @@
+#ifndef BEAM_PACKRATPARSERSTREAM_HPP
+#define BEAM_PACKRATPARSERSTREAM_HPP
+#include <cstddef>
+#include <string>
+#include "Beam/Parsers/CharacterScanner.hpp"
+#include "Beam/Parsers/PackratContext.hpp"
+#include "Beam/Parsers/Parsers.hpp"
+#include "Beam/Parsers/ParserStream.hpp"
+
+namespace Beam {
+namespace Parsers {
+
+  /*! \class PackratParserStream
+      \brief Wraps a ParserStream to enable memoization of MemoizedParsers,
+             making heavily backtracking grammars parse in linear time.
+      \tparam ParserStreamType The ParserStream to wrap.
+  */
+  template<typename ParserStreamType>
+  class PackratParserStream {
+    public:
+
+      //! The ParserStream to wrap.
+      using ParserStream = ParserStreamType;
+
+      //! Constructs a PackratParserStream.
+      /*!
+        \param stream The ParserStream to wrap.
+      */
+      PackratParserStream(ParserStream& stream);
+
+      char GetChar() const;
+
+      bool Read();
+
+      void Undo();
+
+      void Undo(std::size_t count);
+
+      void Accept();
+
+      std::size_t Scan(Details::Scanner scanner, std::string* run);
+
+      //! Returns the memoized outcomes of the parsers read so far.
+      PackratContext* GetPackratContext();
+
+    private:
+      ParserStream* m_stream;
+      PackratContext m_context;
+  };
+
+  template<typename ParserStreamType>
+  PackratParserStream<ParserStreamType>::PackratParserStream(
+      ParserStream& stream)
+      : m_stream(&stream) {}
+
+  template<typename ParserStreamType>
+  char PackratParserStream<ParserStreamType>::GetChar() const {
+    return m_stream->GetChar();
+  }
+
+  template<typename ParserStreamType>
+  bool PackratParserStream<ParserStreamType>::Read() {
+    if(!m_stream->Read()) {
+      return false;
+    }
+    m_context.Advance(1);
+    return true;
+  }
+
+  template<typename ParserStreamType>
+  void PackratParserStream<ParserStreamType>::Undo() {
+    Undo(1);
+  }
+
+  template<typename ParserStreamType>
+  void PackratParserStream<ParserStreamType>::Undo(std::size_t count) {
+    m_context.Retreat(count);
+    m_stream->Undo(count);
+  }
+
+  template<typename ParserStreamType>
+  void PackratParserStream<ParserStreamType>::Accept() {
+    m_stream->Accept();
+  }
+
+  template<typename ParserStreamType>
+  std::size_t PackratParserStream<ParserStreamType>::Scan(
+      Details::Scanner scanner, std::string* run) {
+    auto count = Details::ScanRun(*m_stream, scanner, run);
+    m_context.Advance(count);
+    return count;
+  }
+
+  template<typename ParserStreamType>
+  PackratContext* PackratParserStream<ParserStreamType>::GetPackratContext() {
+    return &m_context;
+  }
+}
+}
+
+#endif
@@ -25,8 +25,11 @@ namespace Parsers {
     typename Enabled = void> class ForListParser;
   template<typename IntegralType> class IntegralParser;
   template<typename ParserType> class ListParser;
+  template<typename SubParserType> class MemoizedParser;
   template<typename LeftParserType, typename RightParserType,
     typename Enabled = void> class OrParser;
+  class PackratContext;
+  template<typename ParserStreamType> class PackratParserStream;
   template<typename ResultType> struct Parser;
   class ParserException;
   template<typename ReaderType, typename ParserType> class ParserPublisher;
@@ -4,6 +4,7 @@
 #include <type_traits>
 #include <vector>
 #include <boost/variant/variant.hpp>
+#include "Beam/Parsers/CharacterScanner.hpp"
 #include "Beam/Parsers/SubParserStream.hpp"
 #include "Beam/Parsers/Parser.hpp"
 #include "Beam/Parsers/Parsers.hpp"
@@ -41,6 +42,9 @@ namespace Parsers {
       template<typename ParserStreamType>
       bool Read(ParserStreamType& source, Result& value) {
         value.clear();
+        if constexpr(Details::IsScannable<SubParser>) {
+          return Details::ScanRun<SubParser>(source, &value) != 0;
+        }
         char nextChar;
         if(m_subParser.Read(source, nextChar)) {
           value += nextChar;
@@ -55,6 +59,9 @@ namespace Parsers {
 
       template<typename ParserStreamType>
       bool Read(ParserStreamType& source) {
+        if constexpr(Details::IsScannable<SubParser>) {
+          return Details::ScanRun<SubParser>(source) != 0;
+        }
         if(!m_subParser.Read(source)) {
           return false;
         }
@@ -119,6 +126,9 @@ namespace Parsers {
 
       template<typename ParserStreamType>
       bool Read(ParserStreamType& source) {
+        if constexpr(Details::IsScannable<SubParser>) {
+          return Details::ScanRun<SubParser>(source) != 0;
+        }
         if(!m_subParser.Read(source)) {
           return false;
         }
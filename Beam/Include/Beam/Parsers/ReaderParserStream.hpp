@@ -2,6 +2,7 @@
 #define BEAM_READERPARSERSTREAM_HPP
 #include "Beam/IO/BufferReader.hpp"
 #include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Parsers/CharacterScanner.hpp"
 #include "Beam/Parsers/Parsers.hpp"
 #include "Beam/Parsers/ParserStream.hpp"
 #include "Beam/Pointers/Dereference.hpp"
@@ -38,6 +39,14 @@ namespace Parsers {
 
       void Accept();
 
+      //! Consumes the longest run of characters accepted by a Scanner.
+      /*!
+        \param scanner The Scanner accepting the characters in the run.
+        \param run If not null, the characters consumed are appended to it.
+        \return The number of characters consumed.
+      */
+      std::size_t Scan(Details::Scanner scanner, std::string* run);
+
     private:
       typename OptionalLocalPtr<ReaderType>::type m_source;
       typename Reader::Buffer m_buffer;
@@ -45,8 +54,13 @@ namespace Parsers {
       std::size_t m_sizeRemaining;
   };
 
-  inline ReaderParserStream<IO::BufferReader<IO::SharedBuffer>>
-      ParserStreamFromString(const std::string& source) {
+  //! The ParserStream parsed by RuleParsers without a virtual call per
+  //! character.
+  using DefaultParserStream =
+    ReaderParserStream<IO::BufferReader<IO::SharedBuffer>>;
+
+  inline DefaultParserStream ParserStreamFromString(
+      const std::string& source) {
     return IO::BufferFromString<IO::SharedBuffer>(source);
   }
 
@@ -102,6 +116,40 @@ namespace Parsers {
       m_buffer.Reset();
     }
   }
+
+  template<typename ReaderType>
+  std::size_t ReaderParserStream<ReaderType>::Scan(Details::Scanner scanner,
+      std::string* run) {
+    auto count = std::size_t(0);
+    while(true) {
+      if(m_sizeRemaining == 0) {
+        if(!Read()) {
+          return count;
+        }
+        if(scanner(m_position, m_position + 1) == m_position) {
+          Undo();
+          return count;
+        }
+        if(run) {
+          run->push_back(*m_position);
+        }
+        ++count;
+      }
+      auto first = m_position + 1;
+      auto last = first + m_sizeRemaining;
+      auto end = scanner(first, last);
+      auto size = static_cast<std::size_t>(end - first);
+      if(run) {
+        run->append(first, end);
+      }
+      m_position += size;
+      m_sizeRemaining -= size;
+      count += size;
+      if(end != last) {
+        return count;
+      }
+    }
+  }
 }
 }
 
@@ -4,6 +4,7 @@
 #include "Beam/Parsers/Operators.hpp"
 #include "Beam/Parsers/Parser.hpp"
 #include "Beam/Parsers/Parsers.hpp"
+#include "Beam/Parsers/ReaderParserStream.hpp"
 #include "Beam/Parsers/VirtualParser.hpp"
 #include "Beam/Parsers/VirtualParserStream.hpp"
 #include "Beam/Pointers/UniquePtr.hpp"
@@ -13,6 +14,10 @@ namespace Parsers {
 
   /*! \class RuleParser
       \brief Used to represent any generic Parser.
+             Reading from a DefaultParserStream runs the definition directly
+             on that stream, and a rule read from within another rule shares
+             the enclosing rule's VirtualParserStream, so only streams of
+             any other type pay for a virtual call per character.
       \tparam ResultType The data type storing the parsed value.
    */
   template<typename ResultType>
@@ -107,15 +112,25 @@ namespace Parsers {
   template<typename ResultType>
   template<typename ParserStreamType>
   bool RuleParser<ResultType>::Read(ParserStreamType& source, Result& value) {
-    WrapperParserStream<ParserStreamType> context(source);
-    return (*m_source)->Read(context, value);
+    if constexpr(std::is_same_v<ParserStreamType, DefaultParserStream> ||
+        std::is_base_of_v<VirtualParserStream, ParserStreamType>) {
+      return (*m_source)->Read(source, value);
+    } else {
+      WrapperParserStream<ParserStreamType> context(source);
+      return (*m_source)->Read(context, value);
+    }
   }
 
   template<typename ResultType>
   template<typename ParserStreamType>
   bool RuleParser<ResultType>::Read(ParserStreamType& source) {
-    WrapperParserStream<ParserStreamType> context(source);
-    return (*m_source)->Read(context);
+    if constexpr(std::is_same_v<ParserStreamType, DefaultParserStream> ||
+        std::is_base_of_v<VirtualParserStream, ParserStreamType>) {
+      return (*m_source)->Read(source);
+    } else {
+      WrapperParserStream<ParserStreamType> context(source);
+      return (*m_source)->Read(context);
+    }
   }
 
   template<typename ResultType>
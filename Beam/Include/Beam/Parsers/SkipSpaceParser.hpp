@@ -1,6 +1,6 @@
 #ifndef BEAM_SKIPSPACEPARSER_HPP
 #define BEAM_SKIPSPACEPARSER_HPP
-#include <cctype>
+#include "Beam/Parsers/CharacterScanner.hpp"
 #include "Beam/Parsers/Parser.hpp"
 #include "Beam/Parsers/Parsers.hpp"
 
@@ -20,15 +20,7 @@ namespace Parsers {
 
   template<typename ParserStreamType>
   bool SkipSpaceParser::Read(ParserStreamType& source) {
-    while(true) {
-      if(!source.Read()) {
-        return true;
-      }
-      if(!std::isspace(source.GetChar())) {
-        source.Undo();
-        return true;
-      }
-    }
+    Details::ScanRun(source, Details::ScanSpaces);
     return true;
   }
 }
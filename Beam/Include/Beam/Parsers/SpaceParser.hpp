@@ -1,6 +1,7 @@
 #ifndef BEAM_SPACEPARSER_HPP
 #define BEAM_SPACEPARSER_HPP
 #include <cctype>
+#include "Beam/Parsers/CharacterScanner.hpp"
 #include "Beam/Parsers/Parser.hpp"
 #include "Beam/Parsers/Parsers.hpp"
 
@@ -19,6 +20,9 @@ namespace Parsers {
 
       template<typename ParserStreamType>
       bool Read(ParserStreamType& source);
+
+      //! Returns the end of the run of matching characters in [first, last).
+      static const char* Scan(const char* first, const char* last);
   };
 
   template<typename ParserStreamType>
@@ -45,6 +49,10 @@ namespace Parsers {
     source.Undo();
     return false;
   }
+
+  inline const char* SpaceParser::Scan(const char* first, const char* last) {
+    return Details::ScanSpaces(first, last);
+  }
 }
 }
 
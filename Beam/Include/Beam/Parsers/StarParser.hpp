@@ -4,6 +4,7 @@
 #include <type_traits>
 #include <vector>
 #include <boost/variant/variant.hpp>
+#include "Beam/Parsers/CharacterScanner.hpp"
 #include "Beam/Parsers/SubParserStream.hpp"
 #include "Beam/Parsers/Parser.hpp"
 #include "Beam/Parsers/Parsers.hpp"
@@ -51,6 +52,10 @@ namespace Parsers {
       template<typename ParserStreamType>
       bool Read(ParserStreamType& source, Result& value) {
         value.clear();
+        if constexpr(Details::IsScannable<SubParser>) {
+          Details::ScanRun<SubParser>(source, &value);
+          return true;
+        }
         char nextChar;
         while(m_subParser.Read(source, nextChar)) {
           value += nextChar;
@@ -60,6 +65,10 @@ namespace Parsers {
 
       template<typename ParserStreamType>
       bool Read(ParserStreamType& source) {
+        if constexpr(Details::IsScannable<SubParser>) {
+          Details::ScanRun<SubParser>(source);
+          return true;
+        }
         while(m_subParser.Read(source)) {}
         return true;
       }
@@ -91,6 +100,10 @@ namespace Parsers {
 
       template<typename ParserStreamType>
       bool Read(ParserStreamType& source) {
+        if constexpr(Details::IsScannable<SubParser>) {
+          Details::ScanRun<SubParser>(source);
+          return true;
+        }
         while(m_subParser.Read(source)) {}
         return true;
       }
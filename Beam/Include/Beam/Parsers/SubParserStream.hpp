@@ -1,5 +1,9 @@
 #ifndef BEAM_SUBPARSERSTREAM_HPP
 #define BEAM_SUBPARSERSTREAM_HPP
+#include <cstddef>
+#include <string>
+#include "Beam/Parsers/CharacterScanner.hpp"
+#include "Beam/Parsers/PackratContext.hpp"
 #include "Beam/Parsers/Parsers.hpp"
 #include "Beam/Parsers/ParserStream.hpp"
 
@@ -36,6 +40,10 @@ namespace Parsers {
 
       void Accept();
 
+      std::size_t Scan(Details::Scanner scanner, std::string* run);
+
+      PackratContext* GetPackratContext();
+
     private:
       ParserStream* m_stream;
       std::size_t m_sizeRead;
@@ -80,6 +88,19 @@ namespace Parsers {
   void SubParserStream<ParserStreamType>::Accept() {
     m_sizeRead = 0;
   }
+
+  template<typename ParserStreamType>
+  std::size_t SubParserStream<ParserStreamType>::Scan(
+      Details::Scanner scanner, std::string* run) {
+    auto count = Details::ScanRun(*m_stream, scanner, run);
+    m_sizeRead += count;
+    return count;
+  }
+
+  template<typename ParserStreamType>
+  PackratContext* SubParserStream<ParserStreamType>::GetPackratContext() {
+    return Details::GetPackratContext(*m_stream);
+  }
 }
 }
 
@@ -3,6 +3,7 @@
 #include <memory>
 #include "Beam/Parsers/Parser.hpp"
 #include "Beam/Parsers/Parsers.hpp"
+#include "Beam/Parsers/ReaderParserStream.hpp"
 #include "Beam/Parsers/VirtualParserStream.hpp"
 
 namespace Beam {
@@ -22,6 +23,10 @@ namespace Parsers {
       virtual bool Read(VirtualParserStream& source, Result& value) = 0;
 
       virtual bool Read(VirtualParserStream& source) = 0;
+
+      virtual bool Read(DefaultParserStream& source, Result& value) = 0;
+
+      virtual bool Read(DefaultParserStream& source) = 0;
   };
 
   template<>
@@ -32,6 +37,8 @@ namespace Parsers {
       virtual ~VirtualParser();
 
       virtual bool Read(VirtualParserStream& source) = 0;
+
+      virtual bool Read(DefaultParserStream& source) = 0;
   };
 
   template<typename ParserType, typename Enabled>
@@ -52,6 +59,10 @@ namespace Parsers {
         return m_parser.Read(source);
       }
 
+      virtual bool Read(DefaultParserStream& source) {
+        return m_parser.Read(source);
+      }
+
     private:
       Parser m_parser;
   };
@@ -75,6 +86,14 @@ namespace Parsers {
         return m_parser.Read(source);
       }
 
+      virtual bool Read(DefaultParserStream& source, Result& value) {
+        return m_parser.Read(source, value);
+      }
+
+      virtual bool Read(DefaultParserStream& source) {
+        return m_parser.Read(source);
+      }
+
     private:
       Parser m_parser;
   };
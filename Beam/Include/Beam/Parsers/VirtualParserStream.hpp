@@ -1,5 +1,9 @@
 #ifndef BEAM_VIRTUALPARSERSTREAM_HPP
 #define BEAM_VIRTUALPARSERSTREAM_HPP
+#include <cstddef>
+#include <string>
+#include "Beam/Parsers/CharacterScanner.hpp"
+#include "Beam/Parsers/PackratContext.hpp"
 #include "Beam/Parsers/Parsers.hpp"
 #include "Beam/Parsers/ParserStream.hpp"
 
@@ -22,6 +26,10 @@ namespace Parsers {
       virtual void Undo(std::size_t count) = 0;
 
       virtual void Accept() = 0;
+
+      virtual std::size_t Scan(Details::Scanner scanner, std::string* run);
+
+      virtual PackratContext* GetPackratContext();
   };
 
   template<typename ParserStreamType>
@@ -41,12 +49,25 @@ namespace Parsers {
 
       virtual void Accept();
 
+      virtual std::size_t Scan(Details::Scanner scanner, std::string* run);
+
+      virtual PackratContext* GetPackratContext();
+
     private:
       ParserStream* m_stream;
   };
 
   inline VirtualParserStream::~VirtualParserStream() {}
 
+  inline std::size_t VirtualParserStream::Scan(Details::Scanner scanner,
+      std::string* run) {
+    return Details::ScanEach(*this, scanner, run);
+  }
+
+  inline PackratContext* VirtualParserStream::GetPackratContext() {
+    return nullptr;
+  }
+
   template<typename ParserStreamType>
   WrapperParserStream<ParserStreamType>::WrapperParserStream(
       ParserStream& stream)
@@ -76,6 +97,17 @@ namespace Parsers {
   void WrapperParserStream<ParserStreamType>::Accept() {
     m_stream->Accept();
   }
+
+  template<typename ParserStreamType>
+  std::size_t WrapperParserStream<ParserStreamType>::Scan(
+      Details::Scanner scanner, std::string* run) {
+    return Details::ScanRun(*m_stream, scanner, run);
+  }
+
+  template<typename ParserStreamType>
+  PackratContext* WrapperParserStream<ParserStreamType>::GetPackratContext() {
+    return Details::GetPackratContext(*m_stream);
+  }
 }
 }
 
@@ -1,9 +1,11 @@
 #ifndef BEAM_PYTHON_QUEUE_WRITER_HPP
 #define BEAM_PYTHON_QUEUE_WRITER_HPP
 #include <type_traits>
+#include <vector>
 #include <boost/throw_exception.hpp>
 #include <pybind11/pybind11.h>
 #include "Beam/Python/GilLock.hpp"
+#include "Beam/Python/GilRelease.hpp"
 #include "Beam/Queues/QueueWriter.hpp"
 
 namespace Beam::Python {
@@ -25,6 +27,16 @@ namespace Details {
       return value.cast<T>();
     }
   };
+
+  /**
+   * Implemented by QueueWriters of Python objects that can push a whole
+   * Python iterable at once.
+   */
+  struct IterableWriter {
+    virtual ~IterableWriter() = default;
+
+    virtual void PushAll(const pybind11::iterable& values) = 0;
+  };
 }
 
   /**
@@ -73,6 +85,15 @@ namespace Details {
 
       void Push(Source&& value) override;
 
+      /**
+       * Pushes a range of values, converting all of them under a single
+       * acquisition of the GIL.
+       * @param first The first value to push.
+       * @param last One past the last value to push.
+       */
+      template<typename I>
+      void PushAll(I first, I last);
+
       void Break(const std::exception_ptr& e) override;
 
     private:
@@ -104,7 +125,8 @@ namespace Details {
    * @param <T> The type of data to push onto the queue.
    */
   template<typename T>
-  class ToPythonQueueWriter final : public QueueWriter<pybind11::object> {
+  class ToPythonQueueWriter final : public QueueWriter<pybind11::object>,
+      public Details::IterableWriter {
     public:
       using Source = typename QueueWriter<pybind11::object>::Source;
 
@@ -123,6 +145,14 @@ namespace Details {
 
       void Push(Source&& value) override;
 
+      /**
+       * Converts every value of a Python iterable while holding the GIL and
+       * then pushes them all onto the wrapped QueueWriter with the GIL
+       * released once.
+       * @param values The Python values to push.
+       */
+      void PushAll(const pybind11::iterable& values) override;
+
       void Break(const std::exception_ptr& e) override;
 
     private:
@@ -186,6 +216,27 @@ namespace Details {
     }
   }
 
+  template<typename T>
+  template<typename I>
+  void FromPythonQueueWriter<T>::PushAll(I first, I last) {
+    if(first == last) {
+      return;
+    }
+    auto lock = GilLock();
+    if(m_target == nullptr) {
+      BOOST_THROW_EXCEPTION(PipeBrokenException());
+    }
+    try {
+      for(; first != last; ++first) {
+        m_target->Push(pybind11::cast(*first));
+      }
+    } catch(const std::exception&) {
+      m_target = nullptr;
+      m_self.reset();
+      throw;
+    }
+  }
+
   template<typename T>
   void FromPythonQueueWriter<T>::Break(const std::exception_ptr& e) {
     auto lock = GilLock();
@@ -223,6 +274,19 @@ namespace Details {
     m_target->Push(Details::Extractor<Type>()(value));
   }
 
+  template<typename T>
+  void ToPythonQueueWriter<T>::PushAll(const pybind11::iterable& values) {
+    auto extractedValues = std::vector<Type>();
+    for(auto value : values) {
+      extractedValues.push_back(Details::Extractor<Type>()(
+        pybind11::reinterpret_borrow<pybind11::object>(value)));
+    }
+    auto release = GilRelease();
+    for(auto& value : extractedValues) {
+      m_target->Push(std::move(value));
+    }
+  }
+
   template<typename T>
   void ToPythonQueueWriter<T>::Break(const std::exception_ptr& e) {
     m_target->Break(e);
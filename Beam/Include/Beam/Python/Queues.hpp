@@ -1,6 +1,9 @@
 #ifndef BEAM_PYTHON_QUEUES_HPP
 #define BEAM_PYTHON_QUEUES_HPP
 #include <string>
+#include <type_traits>
+#include <vector>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include "Beam/Python/AbstractQueue.hpp"
 #include "Beam/Python/GilLock.hpp"
@@ -13,6 +16,110 @@
 
 namespace Beam::Python {
 
+  /**
+   * Pops up to a maximum number of values from a QueueReader, blocking only
+   * until the first value is available, and converts them into a Python list
+   * under a single acquisition of the GIL.
+   * @param queue The QueueReader to drain.
+   * @param maxCount The maximum number of values to pop.
+   * @return The list of values popped from the <i>queue</i>.
+   */
+  template<typename T>
+  pybind11::list Drain(QueueReader<T>& queue, std::size_t maxCount) {
+    auto result = pybind11::list();
+    if(maxCount == 0) {
+      return result;
+    }
+    if constexpr(std::is_same_v<T, pybind11::object>) {
+      if(queue.IsEmpty()) {
+        auto release = GilRelease();
+        queue.Wait();
+      }
+      result.append(queue.Top());
+      queue.Pop();
+      while(result.size() < maxCount && !queue.IsEmpty()) {
+        result.append(queue.Top());
+        queue.Pop();
+      }
+    } else {
+      auto values = std::vector<T>();
+      {
+        auto release = GilRelease();
+        values.push_back(queue.Top());
+        queue.Pop();
+        while(values.size() < maxCount && !queue.IsEmpty()) {
+          values.push_back(queue.Top());
+          queue.Pop();
+        }
+      }
+      for(auto& value : values) {
+        result.append(pybind11::cast(std::move(value)));
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Pushes every value of a Python iterable onto a QueueWriter. The values
+   * are converted while the GIL is held and then pushed with the GIL released
+   * once, rather than handing the GIL off for every value.
+   * @param queue The QueueWriter to push onto.
+   * @param values The values to push.
+   */
+  template<typename T>
+  void PushAll(QueueWriter<T>& queue, const pybind11::iterable& values) {
+    if constexpr(std::is_same_v<T, pybind11::object>) {
+      if(auto writer = dynamic_cast<Details::IterableWriter*>(&queue)) {
+        writer->PushAll(values);
+        return;
+      }
+      for(auto value : values) {
+        queue.Push(pybind11::reinterpret_borrow<pybind11::object>(value));
+      }
+    } else {
+      auto extractedValues = std::vector<T>();
+      for(auto value : values) {
+        extractedValues.push_back(Details::Extractor<T>()(
+          pybind11::reinterpret_borrow<pybind11::object>(value)));
+      }
+      if(auto writer = dynamic_cast<FromPythonQueueWriter<T>*>(&queue)) {
+        writer->PushAll(extractedValues.begin(), extractedValues.end());
+        return;
+      }
+      auto release = GilRelease();
+      for(auto& value : extractedValues) {
+        queue.Push(std::move(value));
+      }
+    }
+  }
+
+  /**
+   * Pops up to a maximum number of values from a QueueReader into a NumPy
+   * structured array, the type T must have its dtype registered using
+   * PYBIND11_NUMPY_DTYPE.
+   * @param queue The QueueReader to drain.
+   * @param maxCount The maximum number of values to pop.
+   * @return The array of values popped from the <i>queue</i>.
+   */
+  template<typename T>
+  pybind11::array_t<T> DrainArray(QueueReader<T>& queue,
+      std::size_t maxCount) {
+    static_assert(std::is_trivially_copyable_v<T>,
+      "NumPy structured arrays require trivially copyable records.");
+    auto values = std::vector<T>();
+    if(maxCount != 0) {
+      auto release = GilRelease();
+      values.reserve(maxCount);
+      values.push_back(queue.Top());
+      queue.Pop();
+      while(values.size() < maxCount && !queue.IsEmpty()) {
+        values.push_back(queue.Top());
+        queue.Pop();
+      }
+    }
+    return pybind11::array_t<T>(values.size(), values.data());
+  }
+
   /**
    * Exports the BasePublisher class.
    * @param module The module to export to.
@@ -164,7 +271,25 @@ namespace Beam::Python {
       .def("wait", static_cast<void (T::*)() const>(&T::Wait),
         pybind11::call_guard<pybind11::gil_scoped_release>())
       .def("top", &T::Top,
-        pybind11::call_guard<pybind11::gil_scoped_release>());
+        pybind11::call_guard<pybind11::gil_scoped_release>())
+      .def("drain",
+        [] (T& self, std::size_t maxCount) {
+          return Drain<typename T::Target>(self, maxCount);
+        });
+  }
+
+  /**
+   * Exports a drain_array function that pops values from a Queue of simple
+   * records into a NumPy structured array, the dtype of T must already be
+   * registered using PYBIND11_NUMPY_DTYPE.
+   * @param module The module to export to.
+   */
+  template<typename T>
+  void ExportQueueArrayDrain(pybind11::module& module) {
+    module.def("drain_array",
+      [] (QueueReader<T>& queue, std::size_t maxCount) {
+        return DrainArray(queue, maxCount);
+      });
   }
 
   /**
@@ -183,7 +308,11 @@ namespace Beam::Python {
         pybind11::multiple_inheritance())
       .def("is_empty", &T::IsEmpty)
       .def("top", &T::Top)
-      .def("pop", &T::Pop);
+      .def("pop", &T::Pop)
+      .def("drain",
+        [] (T& self, std::size_t maxCount) {
+          return Drain<typename T::Target>(self, maxCount);
+        });
     if constexpr(!std::is_same_v<typename T::Target, pybind11::object>) {
       binding.def(pybind11::init(
         [] (std::shared_ptr<QueueReader<pybind11::object>> queue) {
@@ -209,7 +338,8 @@ namespace Beam::Python {
         std::shared_ptr<T>, BaseQueue>(module, name.c_str(),
         pybind11::multiple_inheritance())
       .def("push", static_cast<void (T::*)(const typename T::Source&)>(
-        &T::Push));
+        &T::Push))
+      .def("push_all", &PushAll<typename T::Source>);
     if constexpr(!std::is_same_v<typename T::Source, pybind11::object>) {
       binding.def(pybind11::init(
         [] (std::shared_ptr<QueueWriter<pybind11::object>> queue) {
@@ -0,0 +1,345 @@
+#ifndef BEAM_AGGREGATE_QUERY_HPP
+#define BEAM_AGGREGATE_QUERY_HPP
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <typeinfo>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/throw_exception.hpp>
+#include "Beam/Queries/ConstantExpression.hpp"
+#include "Beam/Queries/Expression.hpp"
+#include "Beam/Queries/FilteredQuery.hpp"
+#include "Beam/Queries/IndexedQuery.hpp"
+#include "Beam/Queries/Queries.hpp"
+#include "Beam/Queries/RangedQuery.hpp"
+#include "Beam/Queries/TypeCompatibilityException.hpp"
+#include "Beam/Serialization/DataShuttle.hpp"
+#include "Beam/Serialization/SerializationException.hpp"
+#include "Beam/Serialization/ShuttleDateTime.hpp"
+
+namespace Beam::Queries {
+
+  /** Stores the reduction of the values falling within a single time bucket.
+   */
+  struct Aggregate {
+
+    /** The start of the time bucket, or the timestamp of the earliest value
+        when the query isn't bucketed.
+     */
+    boost::posix_time::ptime m_timestamp;
+
+    /** The number of values reduced. */
+    std::uint64_t m_count;
+
+    /** The smallest value. */
+    double m_min;
+
+    /** The largest value. */
+    double m_max;
+
+    /** The sum of the values. */
+    double m_sum;
+
+    /** The sum of the weights. */
+    double m_weight;
+
+    /** The sum of each value multiplied by its weight. */
+    double m_weightedSum;
+
+    bool operator ==(const Aggregate& rhs) const;
+
+    bool operator !=(const Aggregate& rhs) const;
+  };
+
+  /** Queries for the count, minimum, maximum, sum and weighted average of an
+      expression over a range, optionally grouped into fixed time buckets, so
+      that only the reduced rows leave the data store.
+      \tparam T The type used as the index.
+   */
+  template<typename T>
+  class AggregateQuery : public IndexedQuery<T>, public RangedQuery,
+      public FilteredQuery {
+    public:
+
+      /** Constructs an AggregateQuery that counts every value in a single
+          bucket.
+       */
+      AggregateQuery();
+
+      /** Returns the expression whose values are reduced. */
+      const Expression& GetValue() const;
+
+      /**
+       * Sets the expression whose values are reduced.
+       * @param value A numeric expression evaluated against each value.
+       */
+      void SetValue(const Expression& value);
+
+      /** Returns the expression used to weigh each value. */
+      const Expression& GetWeight() const;
+
+      /**
+       * Sets the expression used to weigh each value, for example the
+       * quantity when computing a VWAP.
+       * @param weight A numeric expression evaluated against each value.
+       */
+      void SetWeight(const Expression& weight);
+
+      /** Returns the width of each time bucket. */
+      boost::posix_time::time_duration GetBucket() const;
+
+      /**
+       * Sets the width of each time bucket, buckets are aligned to the UNIX
+       * epoch.
+       * @param bucket The bucket width, or <code>pos_infin</code> to reduce the
+       *        entire range into a single Aggregate.
+       */
+      void SetBucket(boost::posix_time::time_duration bucket);
+
+    protected:
+      template<typename Shuttler>
+      void Shuttle(Shuttler& shuttle, unsigned int version);
+
+    private:
+      friend struct Serialization::DataShuttle;
+      Expression m_value;
+      Expression m_weight;
+      boost::posix_time::time_duration m_bucket;
+  };
+
+  /** Returns <code>true</code> iff an expression evaluates to a type that can
+      be aggregated.
+   */
+  inline bool IsAggregatable(const Expression& expression) {
+    auto& type = expression->GetType()->GetNativeType();
+    return type == typeid(int) || type == typeid(double) ||
+      type == typeid(std::uint64_t);
+  }
+
+  /** Returns the arithmetic mean of an Aggregate's values. */
+  inline double GetAverage(const Aggregate& aggregate) {
+    if(aggregate.m_count == 0) {
+      return 0;
+    }
+    return aggregate.m_sum / aggregate.m_count;
+  }
+
+  /** Returns the weighted average of an Aggregate's values. */
+  inline double GetWeightedAverage(const Aggregate& aggregate) {
+    if(aggregate.m_weight == 0) {
+      return 0;
+    }
+    return aggregate.m_weightedSum / aggregate.m_weight;
+  }
+
+  /** Returns the start of the bucket containing a timestamp. */
+  inline boost::posix_time::ptime GetBucketStart(
+      boost::posix_time::ptime timestamp,
+      boost::posix_time::time_duration bucket) {
+    static const auto EPOCH = boost::posix_time::ptime(
+      boost::gregorian::date(1970, boost::gregorian::Jan, 1));
+    if(bucket.is_special() || timestamp.is_special()) {
+      return timestamp;
+    }
+    auto width = bucket.total_milliseconds();
+    auto offset = (timestamp - EPOCH).total_milliseconds();
+    auto remainder = offset % width;
+    if(remainder < 0) {
+      remainder += width;
+    }
+    return EPOCH + boost::posix_time::milliseconds(offset - remainder);
+  }
+
+  /** Accumulates values into time bucketed Aggregates. */
+  class AggregateBuilder {
+    public:
+
+      /**
+       * Constructs an AggregateBuilder.
+       * @param bucket The width of each time bucket.
+       */
+      explicit AggregateBuilder(boost::posix_time::time_duration bucket);
+
+      /**
+       * Adds a value.
+       * @param timestamp The value's timestamp.
+       * @param value The value to reduce.
+       * @param weight The value's weight.
+       */
+      void Add(boost::posix_time::ptime timestamp, double value,
+        double weight);
+
+      /** Returns the Aggregates in order of their timestamp. */
+      std::vector<Aggregate> Build();
+
+    private:
+      boost::posix_time::time_duration m_bucket;
+      std::vector<Aggregate> m_aggregates;
+  };
+
+  inline std::ostream& operator <<(std::ostream& out,
+      const Aggregate& aggregate) {
+    return out << "(" << aggregate.m_timestamp << " " << aggregate.m_count <<
+      " " << aggregate.m_min << " " << aggregate.m_max << " " <<
+      aggregate.m_sum << " " << aggregate.m_weight << " " <<
+      aggregate.m_weightedSum << ")";
+  }
+
+  template<typename T>
+  std::ostream& operator <<(std::ostream& out,
+      const AggregateQuery<T>& query) {
+    return out << "(" << query.GetIndex() << " " << query.GetRange() << " " <<
+      query.GetFilter() << " " << query.GetValue() << " " <<
+      query.GetWeight() << " " << query.GetBucket() << ")";
+  }
+
+  inline bool Aggregate::operator ==(const Aggregate& rhs) const {
+    return m_timestamp == rhs.m_timestamp && m_count == rhs.m_count &&
+      m_min == rhs.m_min && m_max == rhs.m_max && m_sum == rhs.m_sum &&
+      m_weight == rhs.m_weight && m_weightedSum == rhs.m_weightedSum;
+  }
+
+  inline bool Aggregate::operator !=(const Aggregate& rhs) const {
+    return !(*this == rhs);
+  }
+
+  template<typename T>
+  AggregateQuery<T>::AggregateQuery()
+    : m_value(ConstantExpression(1)),
+      m_weight(ConstantExpression(1)),
+      m_bucket(boost::posix_time::pos_infin) {}
+
+  template<typename T>
+  const Expression& AggregateQuery<T>::GetValue() const {
+    return m_value;
+  }
+
+  template<typename T>
+  void AggregateQuery<T>::SetValue(const Expression& value) {
+    if(!IsAggregatable(value)) {
+      BOOST_THROW_EXCEPTION(
+        TypeCompatibilityException("Value is not numeric."));
+    }
+    m_value = value;
+  }
+
+  template<typename T>
+  const Expression& AggregateQuery<T>::GetWeight() const {
+    return m_weight;
+  }
+
+  template<typename T>
+  void AggregateQuery<T>::SetWeight(const Expression& weight) {
+    if(!IsAggregatable(weight)) {
+      BOOST_THROW_EXCEPTION(
+        TypeCompatibilityException("Weight is not numeric."));
+    }
+    m_weight = weight;
+  }
+
+  template<typename T>
+  boost::posix_time::time_duration AggregateQuery<T>::GetBucket() const {
+    return m_bucket;
+  }
+
+  template<typename T>
+  void AggregateQuery<T>::SetBucket(boost::posix_time::time_duration bucket) {
+    if(bucket != boost::posix_time::pos_infin &&
+        (bucket.is_special() || bucket.total_milliseconds() <= 0)) {
+      BOOST_THROW_EXCEPTION(std::out_of_range("Invalid bucket."));
+    }
+    m_bucket = bucket;
+  }
+
+  template<typename T>
+  template<typename Shuttler>
+  void AggregateQuery<T>::Shuttle(Shuttler& shuttle, unsigned int version) {
+    Beam::Serialization::Shuttle<IndexedQuery<T>>()(shuttle, *this, version);
+    Beam::Serialization::Shuttle<RangedQuery>()(shuttle, *this, version);
+    Beam::Serialization::Shuttle<FilteredQuery>()(shuttle, *this, version);
+    shuttle.Shuttle("value", m_value);
+    shuttle.Shuttle("weight", m_weight);
+    shuttle.Shuttle("bucket", m_bucket);
+    if(Serialization::IsReceiver<Shuttler>::value) {
+      if(!IsAggregatable(m_value) || !IsAggregatable(m_weight)) {
+        m_value = ConstantExpression(1);
+        m_weight = ConstantExpression(1);
+        BOOST_THROW_EXCEPTION(Serialization::SerializationException(
+          "Aggregate is not numeric."));
+      }
+      if(m_bucket != boost::posix_time::pos_infin &&
+          (m_bucket.is_special() || m_bucket.total_milliseconds() <= 0)) {
+        m_bucket = boost::posix_time::pos_infin;
+        BOOST_THROW_EXCEPTION(Serialization::SerializationException(
+          "Invalid bucket."));
+      }
+    }
+  }
+
+  inline AggregateBuilder::AggregateBuilder(
+    boost::posix_time::time_duration bucket)
+    : m_bucket(bucket) {}
+
+  inline void AggregateBuilder::Add(boost::posix_time::ptime timestamp,
+      double value, double weight) {
+    auto start = GetBucketStart(timestamp, m_bucket);
+    auto aggregate = [&] {
+      if(m_bucket.is_special()) {
+        if(m_aggregates.empty()) {
+          return m_aggregates.insert(m_aggregates.end(), Aggregate{start});
+        }
+        auto& aggregate = m_aggregates.front();
+        aggregate.m_timestamp = std::min(aggregate.m_timestamp, start);
+        return m_aggregates.begin();
+      }
+      if(!m_aggregates.empty() && m_aggregates.back().m_timestamp == start) {
+        return m_aggregates.end() - 1;
+      }
+      auto i = std::lower_bound(m_aggregates.begin(), m_aggregates.end(),
+        start,
+        [] (const Aggregate& aggregate, boost::posix_time::ptime start) {
+          return aggregate.m_timestamp < start;
+        });
+      if(i == m_aggregates.end() || i->m_timestamp != start) {
+        i = m_aggregates.insert(i, Aggregate{start});
+      }
+      return i;
+    }();
+    if(aggregate->m_count == 0) {
+      aggregate->m_min = value;
+      aggregate->m_max = value;
+    } else {
+      aggregate->m_min = std::min(aggregate->m_min, value);
+      aggregate->m_max = std::max(aggregate->m_max, value);
+    }
+    ++aggregate->m_count;
+    aggregate->m_sum += value;
+    aggregate->m_weight += weight;
+    aggregate->m_weightedSum += value * weight;
+  }
+
+  inline std::vector<Aggregate> AggregateBuilder::Build() {
+    return std::move(m_aggregates);
+  }
+}
+
+namespace Beam::Serialization {
+  template<>
+  struct Shuttle<Queries::Aggregate> {
+    template<typename Shuttler>
+    void operator ()(Shuttler& shuttle, Queries::Aggregate& value,
+        unsigned int version) {
+      shuttle.Shuttle("timestamp", value.m_timestamp);
+      shuttle.Shuttle("count", value.m_count);
+      shuttle.Shuttle("min", value.m_min);
+      shuttle.Shuttle("max", value.m_max);
+      shuttle.Shuttle("sum", value.m_sum);
+      shuttle.Shuttle("weight", value.m_weight);
+      shuttle.Shuttle("weighted_sum", value.m_weightedSum);
+    }
+  };
+}
+
+#endif
@@ -59,7 +59,8 @@ namespace Queries {
         ExpressionQuery::UpdatePolicy updatePolicy,
         std::unique_ptr<Evaluator> expression);
 
-      //! Commits a previously initialized subscription.
+      //! Commits a previously initialized subscription, encoding its snapshot
+      //! according to the capabilities of the client's session.
       /*!
         \param client The client committing the subscription.
         \param snapshotLimit The limits used when calculating the snapshot.
@@ -241,6 +242,7 @@ namespace Queries {
           result.m_snapshot = std::move(headBuffer);
         }
         subscriptionEntry.m_state = SubscriptionEntry::State::COMMITTED;
+        result.m_encoding = GetSnapshotEncoding(client);
         f(std::move(result));
       });
   }
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <vector>
 #include <boost/noncopyable.hpp>
+#include "Beam/Queries/AggregateQuery.hpp"
 #include "Beam/Queries/IndexedValue.hpp"
 #include "Beam/Queries/LocalDataStoreEntry.hpp"
 #include "Beam/Queries/Queries.hpp"
@@ -40,6 +41,9 @@ namespace Queries {
       using IndexedValue = ::Beam::Queries::SequencedValue<
         ::Beam::Queries::IndexedValue<Value, Index>>;
 
+      //! The type of query used to load Aggregates.
+      using AggregateQuery = ::Beam::Queries::AggregateQuery<Index>;
+
       //! The type of EvaluatorTranslator used for filtering values.
       using EvaluatorTranslatorFilter = EvaluatorTranslatorFilterType;
 
@@ -57,6 +61,13 @@ namespace Queries {
       */
       std::vector<SequencedValue> Load(const Query& query) const;
 
+      //! Reduces the values matching a query in place.
+      /*!
+        \param query The aggregate query to execute.
+        \return The Aggregates of the values that satisfy the <i>query</i>.
+      */
+      std::vector<Aggregate> LoadAggregates(const AggregateQuery& query) const;
+
       //! Stores a Value.
       /*!
         \param value The Value to store.
@@ -128,6 +139,18 @@ namespace Queries {
     return entry->Load(query);
   }
 
+  template<typename QueryType, typename ValueType,
+    typename EvaluatorTranslatorFilterType>
+  std::vector<Aggregate> LocalDataStore<QueryType, ValueType,
+      EvaluatorTranslatorFilterType>::LoadAggregates(
+      const AggregateQuery& query) const {
+    auto entry = m_entries.Find(query.GetIndex());
+    if(!entry.is_initialized()) {
+      return {};
+    }
+    return entry->LoadAggregates(query);
+  }
+
   template<typename QueryType, typename ValueType,
     typename EvaluatorTranslatorFilterType>
   void LocalDataStore<QueryType, ValueType, EvaluatorTranslatorFilterType>::
@@ -6,6 +6,7 @@
 #include <vector>
 #include <boost/date_time/posix_time/ptime.hpp>
 #include <boost/range/adaptor/reversed.hpp>
+#include "Beam/Queries/AggregateQuery.hpp"
 #include "Beam/Queries/Evaluator.hpp"
 #include "Beam/Queries/EvaluatorTranslator.hpp"
 #include "Beam/Queries/Queries.hpp"
@@ -40,6 +41,10 @@ namespace Queries {
       //! The SequencedValue to store.
       using SequencedValue = ::Beam::Queries::SequencedValue<Value>;
 
+      //! The type of query used to load Aggregates.
+      using AggregateQuery =
+        ::Beam::Queries::AggregateQuery<typename Query::Index>;
+
       //! The type of EvaluatorTranslator used for filtering values.
       using EvaluatorTranslatorFilter = EvaluatorTranslatorFilterType;
 
@@ -70,6 +75,14 @@ namespace Queries {
       */
       std::vector<SequencedValue> Load(const Query& query) const;
 
+      //! Reduces the values matching a query in place, an error evaluating
+      //! the value or weight of any matching value fails the whole query.
+      /*!
+        \param query The aggregate query to execute.
+        \return The Aggregates of the values that satisfy the <i>query</i>.
+      */
+      std::vector<Aggregate> LoadAggregates(const AggregateQuery& query) const;
+
       //! Stores a Value.
       /*!
         \param value The Value to store.
@@ -86,6 +99,9 @@ namespace Queries {
       using ValueList = SynchronizedVector<SequencedValue>;
       ValueList m_values;
       Translator m_translator;
+
+      static double EvalNumeric(Evaluator& evaluator,
+        const std::type_info& type, const Value& value);
   };
 
   template<typename QueryType, typename ValueType,
@@ -163,6 +179,55 @@ namespace Queries {
     return matches;
   }
 
+  template<typename QueryType, typename ValueType,
+    typename EvaluatorTranslatorFilterType>
+  std::vector<Aggregate> LocalDataStoreEntry<QueryType, ValueType,
+      EvaluatorTranslatorFilterType>::LoadAggregates(
+      const AggregateQuery& query) const {
+    if(query.GetRange().GetStart() == Sequence::Present() ||
+        query.GetRange().GetStart() == Sequence::Last()) {
+      return {};
+    }
+    auto& startPoint = query.GetRange().GetStart();
+    auto& endPoint = query.GetRange().GetEnd();
+    auto filter = m_translator(query.GetFilter());
+    auto valueEvaluator = m_translator(query.GetValue());
+    auto weightEvaluator = m_translator(query.GetWeight());
+    auto& valueType = query.GetValue()->GetType()->GetNativeType();
+    auto& weightType = query.GetWeight()->GetType()->GetNativeType();
+    auto builder = AggregateBuilder(query.GetBucket());
+    m_values.With(
+      [&] (const typename ValueList::List& values) {
+        auto i = values.begin();
+        if(auto start = boost::get<Sequence>(&startPoint)) {
+          i = std::lower_bound(values.begin(), values.end(), *start,
+            [] (const SequencedValue& value, const Sequence& sequence) {
+              return value.GetSequence() < sequence;
+            });
+        }
+        auto isSequencedEnd = boost::get<Sequence>(&endPoint) != nullptr;
+        for(; i != values.end(); ++i) {
+          auto& value = *i;
+          if(!RangePointLesserOrEqual(value, endPoint)) {
+            if(isSequencedEnd) {
+              break;
+            }
+            continue;
+          }
+          if(!RangePointGreaterOrEqual(value, startPoint)) {
+            continue;
+          }
+          if(!TestFilter(*filter, *value)) {
+            continue;
+          }
+          builder.Add(GetTimestamp(*value),
+            EvalNumeric(*valueEvaluator, valueType, *value),
+            EvalNumeric(*weightEvaluator, weightType, *value));
+        }
+      });
+    return builder.Build();
+  }
+
   template<typename QueryType, typename ValueType,
     typename EvaluatorTranslatorFilterType>
   void LocalDataStoreEntry<QueryType, ValueType,
@@ -194,6 +259,19 @@ namespace Queries {
       Store(value);
     }
   }
+
+  template<typename QueryType, typename ValueType,
+    typename EvaluatorTranslatorFilterType>
+  double LocalDataStoreEntry<QueryType, ValueType,
+      EvaluatorTranslatorFilterType>::EvalNumeric(Evaluator& evaluator,
+      const std::type_info& type, const Value& value) {
+    if(type == typeid(int)) {
+      return evaluator.Eval<int>(value);
+    } else if(type == typeid(std::uint64_t)) {
+      return static_cast<double>(evaluator.Eval<std::uint64_t>(value));
+    }
+    return evaluator.Eval<double>(value);
+  }
 }
 }
 
@@ -0,0 +1,708 @@
+#ifndef BEAM_PARTITIONED_DATA_STORE_HPP
+#define BEAM_PARTITIONED_DATA_STORE_HPP
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/throw_exception.hpp>
+#include "Beam/IO/IOException.hpp"
+#include "Beam/IO/OpenState.hpp"
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Queries/LocalDataStoreEntry.hpp"
+#include "Beam/Queries/Queries.hpp"
+#include "Beam/Queries/Range.hpp"
+#include "Beam/Queries/Sequence.hpp"
+#include "Beam/Queries/Sequencer.hpp"
+#include "Beam/Queries/SnapshotLimit.hpp"
+#include "Beam/Serialization/BinaryReceiver.hpp"
+#include "Beam/Serialization/BinarySender.hpp"
+#include "Beam/Serialization/ColumnarReceiver.hpp"
+#include "Beam/Serialization/ColumnarSender.hpp"
+
+namespace Beam::Queries {
+
+  /**
+   * Returns the start of the partition a timestamp belongs to when partitions
+   * span multiple days, partitions are aligned to the UNIX epoch.
+   * @param timestamp The timestamp whose partition is to be returned.
+   * @param days The number of days spanned by each partition.
+   * @return A timestamp representing the partition that the
+   *         <i>timestamp</i> belongs to.
+   */
+  inline boost::posix_time::ptime GetPartition(
+      const boost::posix_time::ptime& timestamp, int days) {
+    if(timestamp.is_special()) {
+      return timestamp;
+    } else if(days <= 1) {
+      return GetPartition(timestamp);
+    }
+    static const auto EPOCH = boost::gregorian::date(1970, 1, 1);
+    auto offset = (timestamp.date() - EPOCH).days();
+    auto remainder = offset % days;
+    if(remainder < 0) {
+      remainder += days;
+    }
+    return boost::posix_time::ptime(
+      timestamp.date() - boost::gregorian::days(remainder));
+  }
+
+  /**
+   * Splits a data store into one data store per partition of days, writes are
+   * routed by each value's timestamp and queries only visit the partitions
+   * their Range can overlap. Partitions that will no longer be written to can
+   * be frozen, their values are moved out of the partition's data store into
+   * a file of read-only columnar blocks, only the range covered by each block
+   * is kept in memory and a query reads and decodes just the blocks its Range
+   * can overlap.
+   * Sequence Range points are mapped onto partitions using the date that a
+   * Sequencer encodes into them, points that don't encode a date visit every
+   * partition.
+   * @param <D> The type of data store used for each partition.
+   * @param <E> The type of EvaluatorTranslator used for filtering values.
+   */
+  template<typename D, typename E = typename D::EvaluatorTranslatorFilter>
+  class PartitionedDataStore : private boost::noncopyable {
+    public:
+
+      /** The type of data store used for each partition. */
+      using DataStore = D;
+
+      /** The type of query used to load values. */
+      using Query = typename DataStore::Query;
+
+      /** The type of index used. */
+      using Index = typename DataStore::Index;
+
+      /** The type of value to store. */
+      using Value = typename DataStore::Value;
+
+      /** The SequencedValue to store. */
+      using SequencedValue = typename DataStore::SequencedValue;
+
+      /** The IndexedValue to store. */
+      using IndexedValue = typename DataStore::IndexedValue;
+
+      /** The type of EvaluatorTranslator used for filtering values. */
+      using EvaluatorTranslatorFilter = E;
+
+      /**
+       * Builds the data store holding a partition.
+       * @param partition The start of the partition.
+       * @return The data store holding the values within the <i>partition</i>.
+       */
+      using PartitionBuilder = std::function<
+        std::unique_ptr<DataStore> (boost::posix_time::ptime partition)>;
+
+      /**
+       * Constructs a PartitionedDataStore.
+       * @param partitionBuilder Builds the data store for a partition.
+       * @param days The number of days spanned by each partition.
+       * @param partitions The partitions that already hold data.
+       */
+      PartitionedDataStore(PartitionBuilder partitionBuilder, int days,
+        const std::vector<boost::posix_time::ptime>& partitions = {});
+
+      /**
+       * Constructs a PartitionedDataStore that can freeze partitions.
+       * @param partitionBuilder Builds the data store for a partition.
+       * @param days The number of days spanned by each partition.
+       * @param frozenRoot The directory storing frozen partitions.
+       * @param partitions The partitions that already hold data, those with a
+       *        file in the <i>frozenRoot</i> are opened frozen.
+       */
+      PartitionedDataStore(PartitionBuilder partitionBuilder, int days,
+        std::filesystem::path frozenRoot,
+        const std::vector<boost::posix_time::ptime>& partitions = {});
+
+      ~PartitionedDataStore();
+
+      /** Returns the start of every partition, in ascending order. */
+      std::vector<boost::posix_time::ptime> GetPartitions() const;
+
+      /**
+       * Returns <code>true</code> iff a partition has been frozen.
+       * @param partition The start of the partition.
+       */
+      bool IsFrozen(boost::posix_time::ptime partition) const;
+
+      /** The maximum number of values encoded into a frozen block. */
+      static constexpr auto FROZEN_BLOCK_SIZE = 256;
+
+      /**
+       * Freezes every partition ending on or before a timestamp. A frozen
+       * partition's values are paged out of its data store into a file of
+       * columnar blocks for each index written through this data store, after
+       * which the data store is released, further writes are rejected and
+       * queries are served from the file. Partitions that were opened from
+       * existing data can't be enumerated and are left as they are.
+       * @param threshold The timestamp before which partitions are frozen.
+       */
+      void Freeze(boost::posix_time::ptime threshold);
+
+      std::vector<SequencedValue> Load(const Query& query);
+
+      void Store(const IndexedValue& value);
+
+      void Store(const std::vector<IndexedValue>& values);
+
+      void Open();
+
+      void Close();
+
+    private:
+      using Entry =
+        LocalDataStoreEntry<Query, Value, EvaluatorTranslatorFilter>;
+      struct FrozenBlock {
+        Sequence m_firstSequence;
+        Sequence m_lastSequence;
+        boost::posix_time::ptime m_firstTimestamp;
+        boost::posix_time::ptime m_lastTimestamp;
+        int m_count;
+        std::uint64_t m_offset;
+        std::uint32_t m_size;
+      };
+      struct Partition {
+        boost::posix_time::ptime m_start;
+        std::unique_ptr<DataStore> m_dataStore;
+        std::unordered_set<Index> m_indexes;
+        bool m_isEnumerable;
+        bool m_isFrozen;
+        std::unordered_map<Index, std::vector<FrozenBlock>> m_frozenBlocks;
+        boost::mutex m_mutex;
+      };
+      mutable boost::mutex m_mutex;
+      PartitionBuilder m_partitionBuilder;
+      int m_days;
+      std::filesystem::path m_frozenRoot;
+      std::map<boost::posix_time::ptime, std::shared_ptr<Partition>>
+        m_partitions;
+      IO::OpenState m_openState;
+
+      static boost::posix_time::ptime GetBound(const Range::Point& point,
+        bool isStart);
+      static FrozenBlock WriteBlock(std::ofstream& file,
+        std::uint64_t& position, const Index& index,
+        const std::vector<SequencedValue>& values);
+      static std::unordered_map<Index, std::vector<FrozenBlock>>
+        ReadBlockIndex(const std::filesystem::path& path);
+      static std::vector<SequencedValue> ReadBlock(
+        const std::filesystem::path& path, const FrozenBlock& block);
+      static bool IsOverlapping(const FrozenBlock& block, const Range& range);
+      template<typename T, typename F>
+      static std::vector<SequencedValue> LoadSegments(
+        const std::vector<T>& segments, const Query& query, F&& load);
+      void Shutdown();
+      std::filesystem::path GetFrozenPath(
+        boost::posix_time::ptime partition) const;
+      void Freeze(Partition& partition, Partition& frozenPartition);
+      std::shared_ptr<Partition> LoadPartition(
+        boost::posix_time::ptime partition, bool isEnumerable);
+      std::vector<std::shared_ptr<Partition>> SelectPartitions(
+        const Range& range) const;
+      std::vector<SequencedValue> Load(Partition& partition,
+        const Query& query) const;
+  };
+
+  template<typename D, typename E>
+  PartitionedDataStore<D, E>::PartitionedDataStore(
+      PartitionBuilder partitionBuilder, int days,
+      const std::vector<boost::posix_time::ptime>& partitions)
+      : PartitionedDataStore(std::move(partitionBuilder), days, {},
+          partitions) {}
+
+  template<typename D, typename E>
+  PartitionedDataStore<D, E>::PartitionedDataStore(
+      PartitionBuilder partitionBuilder, int days,
+      std::filesystem::path frozenRoot,
+      const std::vector<boost::posix_time::ptime>& partitions)
+      : m_partitionBuilder(std::move(partitionBuilder)),
+        m_days(std::max(1, days)),
+        m_frozenRoot(std::move(frozenRoot)) {
+    for(auto& partition : partitions) {
+      auto start = GetPartition(partition, m_days);
+      if(m_frozenRoot.empty() ||
+          !std::filesystem::exists(GetFrozenPath(start))) {
+        LoadPartition(start, false);
+        continue;
+      }
+      auto frozenPartition = std::make_shared<Partition>();
+      frozenPartition->m_start = start;
+      frozenPartition->m_isEnumerable = true;
+      frozenPartition->m_isFrozen = true;
+      frozenPartition->m_frozenBlocks = ReadBlockIndex(GetFrozenPath(start));
+      for(auto& blocks : frozenPartition->m_frozenBlocks) {
+        frozenPartition->m_indexes.insert(blocks.first);
+      }
+      m_partitions[start] = std::move(frozenPartition);
+    }
+  }
+
+  template<typename D, typename E>
+  PartitionedDataStore<D, E>::~PartitionedDataStore() {
+    Close();
+  }
+
+  template<typename D, typename E>
+  std::vector<boost::posix_time::ptime>
+      PartitionedDataStore<D, E>::GetPartitions() const {
+    auto lock = boost::lock_guard(m_mutex);
+    auto partitions = std::vector<boost::posix_time::ptime>();
+    for(auto& partition : m_partitions) {
+      partitions.push_back(partition.first);
+    }
+    return partitions;
+  }
+
+  template<typename D, typename E>
+  bool PartitionedDataStore<D, E>::IsFrozen(
+      boost::posix_time::ptime partition) const {
+    auto lock = boost::lock_guard(m_mutex);
+    auto i = m_partitions.find(GetPartition(partition, m_days));
+    return i != m_partitions.end() && i->second->m_isFrozen;
+  }
+
+  template<typename D, typename E>
+  void PartitionedDataStore<D, E>::Freeze(
+      boost::posix_time::ptime threshold) {
+    if(m_frozenRoot.empty()) {
+      BOOST_THROW_EXCEPTION(IO::IOException(
+        "No directory to store frozen partitions."));
+    }
+    auto partitions = [&] {
+      auto lock = boost::lock_guard(m_mutex);
+      auto partitions = std::vector<std::shared_ptr<Partition>>();
+      for(auto& partition : m_partitions) {
+        if(partition.first + boost::gregorian::days(m_days) > threshold) {
+          break;
+        }
+        if(!partition.second->m_isFrozen &&
+            partition.second->m_isEnumerable) {
+          partitions.push_back(partition.second);
+        }
+      }
+      return partitions;
+    }();
+    std::filesystem::create_directories(m_frozenRoot);
+    for(auto& partition : partitions) {
+      auto frozenPartition = std::make_shared<Partition>();
+      frozenPartition->m_start = partition->m_start;
+      frozenPartition->m_isEnumerable = true;
+      frozenPartition->m_isFrozen = true;
+      Freeze(*partition, *frozenPartition);
+      auto lock = boost::lock_guard(m_mutex);
+      m_partitions[partition->m_start] = std::move(frozenPartition);
+    }
+  }
+
+  template<typename D, typename E>
+  std::vector<typename PartitionedDataStore<D, E>::SequencedValue>
+      PartitionedDataStore<D, E>::Load(const Query& query) {
+    if(query.GetSnapshotLimit().GetSize() == 0) {
+      return {};
+    }
+    return LoadSegments(SelectPartitions(query.GetRange()), query,
+      [&] (const std::shared_ptr<Partition>& partition, const Query& query) {
+        return Load(*partition, query);
+      });
+  }
+
+  template<typename D, typename E>
+  void PartitionedDataStore<D, E>::Store(const IndexedValue& value) {
+    auto partition = LoadPartition(
+      GetPartition(GetTimestamp(value), m_days), true);
+    auto lock = boost::lock_guard(partition->m_mutex);
+    if(partition->m_isFrozen) {
+      BOOST_THROW_EXCEPTION(IO::IOException("Partition is frozen."));
+    }
+    partition->m_indexes.insert(value->GetIndex());
+    partition->m_dataStore->Store(value);
+  }
+
+  template<typename D, typename E>
+  void PartitionedDataStore<D, E>::Store(
+      const std::vector<IndexedValue>& values) {
+    auto batches = std::map<boost::posix_time::ptime,
+      std::vector<IndexedValue>>();
+    for(auto& value : values) {
+      batches[GetPartition(GetTimestamp(value), m_days)].push_back(value);
+    }
+    for(auto& batch : batches) {
+      auto partition = LoadPartition(batch.first, true);
+      auto lock = boost::lock_guard(partition->m_mutex);
+      if(partition->m_isFrozen) {
+        BOOST_THROW_EXCEPTION(IO::IOException("Partition is frozen."));
+      }
+      for(auto& value : batch.second) {
+        partition->m_indexes.insert(value->GetIndex());
+      }
+      partition->m_dataStore->Store(batch.second);
+    }
+  }
+
+  template<typename D, typename E>
+  void PartitionedDataStore<D, E>::Open() {
+    if(m_openState.SetOpening()) {
+      return;
+    }
+    try {
+      auto lock = boost::lock_guard(m_mutex);
+      for(auto& partition : m_partitions) {
+        if(partition.second->m_dataStore) {
+          partition.second->m_dataStore->Open();
+        }
+      }
+    } catch(const std::exception&) {
+      m_openState.SetOpenFailure();
+      Shutdown();
+    }
+    m_openState.SetOpen();
+  }
+
+  template<typename D, typename E>
+  void PartitionedDataStore<D, E>::Close() {
+    if(m_openState.SetClosing()) {
+      return;
+    }
+    Shutdown();
+  }
+
+  template<typename D, typename E>
+  boost::posix_time::ptime PartitionedDataStore<D, E>::GetBound(
+      const Range::Point& point, bool isStart) {
+    if(auto timestamp = boost::get<boost::posix_time::ptime>(&point)) {
+      if(timestamp->is_not_a_date_time()) {
+        return isStart ? boost::posix_time::neg_infin :
+          boost::posix_time::pos_infin;
+      }
+      return *timestamp;
+    }
+    auto& sequence = boost::get<Sequence>(point);
+    if(sequence == Sequence::First()) {
+      return boost::posix_time::neg_infin;
+    } else if(sequence == Sequence::Present() ||
+        sequence == Sequence::Last()) {
+      return boost::posix_time::pos_infin;
+    }
+    try {
+      return DecodeTimestamp(sequence);
+    } catch(const std::exception&) {
+      return isStart ? boost::posix_time::neg_infin :
+        boost::posix_time::pos_infin;
+    }
+  }
+
+  template<typename D, typename E>
+  typename PartitionedDataStore<D, E>::FrozenBlock
+      PartitionedDataStore<D, E>::WriteBlock(std::ofstream& file,
+      std::uint64_t& position, const Index& index,
+      const std::vector<SequencedValue>& values) {
+    auto block = FrozenBlock();
+    block.m_firstSequence = values.front().GetSequence();
+    block.m_lastSequence = values.back().GetSequence();
+    block.m_firstTimestamp = GetTimestamp(values.front());
+    block.m_lastTimestamp = block.m_firstTimestamp;
+    block.m_count = static_cast<int>(values.size());
+    auto columns = IO::SharedBuffer();
+    {
+      auto sender = Serialization::ColumnarSender<IO::SharedBuffer>();
+      sender.SetSink(Ref(columns));
+      for(auto& value : values) {
+        auto timestamp = GetTimestamp(value);
+        block.m_firstTimestamp = std::min(block.m_firstTimestamp, timestamp);
+        block.m_lastTimestamp = std::max(block.m_lastTimestamp, timestamp);
+        sender.StartRow();
+        sender.Shuttle(value);
+      }
+      sender.Flush();
+    }
+    block.m_size = static_cast<std::uint32_t>(columns.GetSize());
+    auto header = IO::SharedBuffer();
+    auto sender = Serialization::BinarySender<IO::SharedBuffer>();
+    sender.SetProtocolVersion(Serialization::COMPACT_BINARY_PROTOCOL);
+    sender.SetSink(Ref(header));
+    sender.Shuttle(index);
+    sender.Shuttle(block.m_firstSequence);
+    sender.Shuttle(block.m_lastSequence);
+    sender.Shuttle(block.m_firstTimestamp);
+    sender.Shuttle(block.m_lastTimestamp);
+    sender.Shuttle(block.m_count);
+    sender.Shuttle(block.m_size);
+    auto frame = IO::SharedBuffer();
+    frame.Append(static_cast<std::uint32_t>(header.GetSize()));
+    frame.Append(header);
+    block.m_offset = position + frame.GetSize();
+    frame.Append(columns);
+    file.write(frame.GetData(), frame.GetSize());
+    position += frame.GetSize();
+    return block;
+  }
+
+  template<typename D, typename E>
+  std::unordered_map<typename PartitionedDataStore<D, E>::Index,
+      std::vector<typename PartitionedDataStore<D, E>::FrozenBlock>>
+      PartitionedDataStore<D, E>::ReadBlockIndex(
+      const std::filesystem::path& path) {
+    auto blocks = std::unordered_map<Index, std::vector<FrozenBlock>>();
+    auto file = std::ifstream(path, std::ios::binary);
+    auto size = std::filesystem::file_size(path);
+    auto position = std::uint64_t(0);
+    while(position != size) {
+      auto headerSize = std::uint32_t();
+      if(!file.read(reinterpret_cast<char*>(&headerSize), sizeof(headerSize))
+          || size - position - sizeof(headerSize) < headerSize) {
+        BOOST_THROW_EXCEPTION(IO::IOException(
+          "Unable to read frozen partition."));
+      }
+      auto header = IO::SharedBuffer(headerSize);
+      file.read(header.GetMutableData(), headerSize);
+      auto receiver = Serialization::BinaryReceiver<IO::SharedBuffer>();
+      receiver.SetSource(Ref(header));
+      auto index = Index();
+      auto block = FrozenBlock();
+      receiver.Shuttle(index);
+      receiver.Shuttle(block.m_firstSequence);
+      receiver.Shuttle(block.m_lastSequence);
+      receiver.Shuttle(block.m_firstTimestamp);
+      receiver.Shuttle(block.m_lastTimestamp);
+      receiver.Shuttle(block.m_count);
+      receiver.Shuttle(block.m_size);
+      block.m_offset = position + sizeof(headerSize) + headerSize;
+      if(!file || size - block.m_offset < block.m_size) {
+        BOOST_THROW_EXCEPTION(IO::IOException(
+          "Unable to read frozen partition."));
+      }
+      file.seekg(block.m_size, std::ios::cur);
+      position = block.m_offset + block.m_size;
+      blocks[index].push_back(block);
+    }
+    return blocks;
+  }
+
+  template<typename D, typename E>
+  std::vector<typename PartitionedDataStore<D, E>::SequencedValue>
+      PartitionedDataStore<D, E>::ReadBlock(const std::filesystem::path& path,
+      const FrozenBlock& block) {
+    auto columns = IO::SharedBuffer(block.m_size);
+    {
+      auto file = std::ifstream(path, std::ios::binary);
+      file.seekg(block.m_offset);
+      file.read(columns.GetMutableData(), block.m_size);
+      if(!file) {
+        BOOST_THROW_EXCEPTION(IO::IOException(
+          "Unable to read frozen partition."));
+      }
+    }
+    auto receiver = Serialization::ColumnarReceiver<IO::SharedBuffer>();
+    receiver.SetSource(Ref(columns));
+    auto values = std::vector<SequencedValue>();
+    values.reserve(block.m_count);
+    for(auto i = 0; i != block.m_count; ++i) {
+      receiver.StartRow();
+      values.emplace_back();
+      receiver.Shuttle(values.back());
+    }
+    return values;
+  }
+
+  template<typename D, typename E>
+  bool PartitionedDataStore<D, E>::IsOverlapping(const FrozenBlock& block,
+      const Range& range) {
+    if(auto start = boost::get<Sequence>(&range.GetStart())) {
+      if(block.m_lastSequence < *start) {
+        return false;
+      }
+    } else if(block.m_lastTimestamp <
+        boost::get<boost::posix_time::ptime>(range.GetStart())) {
+      return false;
+    }
+    if(auto end = boost::get<Sequence>(&range.GetEnd())) {
+      return block.m_firstSequence <= *end;
+    }
+    return block.m_firstTimestamp <=
+      boost::get<boost::posix_time::ptime>(range.GetEnd());
+  }
+
+  template<typename D, typename E>
+  template<typename T, typename F>
+  std::vector<typename PartitionedDataStore<D, E>::SequencedValue>
+      PartitionedDataStore<D, E>::LoadSegments(const std::vector<T>& segments,
+      const Query& query, F&& load) {
+    auto limit = query.GetSnapshotLimit();
+    auto remainingQuery = query;
+    auto matches = std::vector<SequencedValue>();
+    if(limit.GetType() == SnapshotLimit::Type::HEAD) {
+      for(auto& segment : segments) {
+        auto segmentMatches = load(segment, remainingQuery);
+        matches.insert(matches.end(), segmentMatches.begin(),
+          segmentMatches.end());
+        if(static_cast<int>(matches.size()) >= limit.GetSize()) {
+          break;
+        }
+        remainingQuery.SetSnapshotLimit(limit.GetType(),
+          limit.GetSize() - static_cast<int>(matches.size()));
+      }
+    } else {
+      for(auto i = segments.rbegin(); i != segments.rend(); ++i) {
+        auto segmentMatches = load(*i, remainingQuery);
+        matches.insert(matches.begin(), segmentMatches.begin(),
+          segmentMatches.end());
+        if(static_cast<int>(matches.size()) >= limit.GetSize()) {
+          break;
+        }
+        remainingQuery.SetSnapshotLimit(limit.GetType(),
+          limit.GetSize() - static_cast<int>(matches.size()));
+      }
+    }
+    return matches;
+  }
+
+  template<typename D, typename E>
+  void PartitionedDataStore<D, E>::Shutdown() {
+    {
+      auto lock = boost::lock_guard(m_mutex);
+      for(auto& partition : m_partitions) {
+        if(partition.second->m_dataStore) {
+          partition.second->m_dataStore->Close();
+        }
+      }
+    }
+    m_openState.SetClosed();
+  }
+
+  template<typename D, typename E>
+  std::filesystem::path PartitionedDataStore<D, E>::GetFrozenPath(
+      boost::posix_time::ptime partition) const {
+    return m_frozenRoot /
+      (boost::gregorian::to_iso_string(partition.date()) + ".frozen");
+  }
+
+  template<typename D, typename E>
+  void PartitionedDataStore<D, E>::Freeze(Partition& partition,
+      Partition& frozenPartition) {
+    auto lock = boost::lock_guard(partition.m_mutex);
+    partition.m_isFrozen = true;
+    auto path = GetFrozenPath(partition.m_start);
+    auto temporaryPath = path;
+    temporaryPath += ".tmp";
+    try {
+      {
+        auto file = std::ofstream(temporaryPath,
+          std::ios::binary | std::ios::trunc);
+        auto position = std::uint64_t(0);
+        for(auto& index : partition.m_indexes) {
+          auto& blocks = frozenPartition.m_frozenBlocks[index];
+          auto query = Query();
+          query.SetIndex(index);
+          query.SetSnapshotLimit(SnapshotLimit::Type::HEAD,
+            FROZEN_BLOCK_SIZE);
+          auto start = Sequence::First();
+          while(true) {
+            query.SetRange(start, Sequence::Last());
+            auto values = partition.m_dataStore->Load(query);
+            if(values.empty()) {
+              break;
+            }
+            blocks.push_back(WriteBlock(file, position, index, values));
+            if(static_cast<int>(values.size()) < FROZEN_BLOCK_SIZE) {
+              break;
+            }
+            start = Increment(values.back().GetSequence());
+          }
+          frozenPartition.m_indexes.insert(index);
+        }
+        file.flush();
+        if(!file) {
+          BOOST_THROW_EXCEPTION(IO::IOException(
+            "Unable to write frozen partition."));
+        }
+      }
+      std::filesystem::rename(temporaryPath, path);
+    } catch(const std::exception&) {
+      partition.m_isFrozen = false;
+      std::filesystem::remove(temporaryPath);
+      throw;
+    }
+  }
+
+  template<typename D, typename E>
+  std::shared_ptr<typename PartitionedDataStore<D, E>::Partition>
+      PartitionedDataStore<D, E>::LoadPartition(
+      boost::posix_time::ptime partition, bool isEnumerable) {
+    auto lock = boost::lock_guard(m_mutex);
+    auto& entry = m_partitions[partition];
+    if(!entry) {
+      entry = std::make_shared<Partition>();
+      entry->m_start = partition;
+      entry->m_dataStore = m_partitionBuilder(partition);
+      entry->m_isEnumerable = isEnumerable;
+      entry->m_isFrozen = false;
+      if(m_openState.IsOpen()) {
+        entry->m_dataStore->Open();
+      }
+    }
+    return entry;
+  }
+
+  template<typename D, typename E>
+  std::vector<std::shared_ptr<typename PartitionedDataStore<D, E>::Partition>>
+      PartitionedDataStore<D, E>::SelectPartitions(const Range& range) const {
+    auto start = GetBound(range.GetStart(), true);
+    auto end = GetBound(range.GetEnd(), false);
+    auto partitions = std::vector<std::shared_ptr<Partition>>();
+    if(start > end) {
+      return partitions;
+    }
+    auto lock = boost::lock_guard(m_mutex);
+    auto i = [&] {
+      if(start.is_special()) {
+        return m_partitions.begin();
+      }
+      return m_partitions.lower_bound(GetPartition(start, m_days));
+    }();
+    auto last = [&] {
+      if(end.is_special()) {
+        return m_partitions.end();
+      }
+      return m_partitions.upper_bound(GetPartition(end, m_days));
+    }();
+    for(; i != last; ++i) {
+      partitions.push_back(i->second);
+    }
+    return partitions;
+  }
+
+  template<typename D, typename E>
+  std::vector<typename PartitionedDataStore<D, E>::SequencedValue>
+      PartitionedDataStore<D, E>::Load(Partition& partition,
+      const Query& query) const {
+    if(partition.m_dataStore) {
+      return partition.m_dataStore->Load(query);
+    }
+    auto blocks = partition.m_frozenBlocks.find(query.GetIndex());
+    if(blocks == partition.m_frozenBlocks.end()) {
+      return {};
+    }
+    auto path = GetFrozenPath(partition.m_start);
+    return LoadSegments(blocks->second, query,
+      [&] (const FrozenBlock& block, const Query& query) {
+        if(!IsOverlapping(block, query.GetRange())) {
+          return std::vector<SequencedValue>();
+        }
+        auto entry = Entry();
+        entry.Store(ReadBlock(path, block));
+        return entry.Load(query);
+      });
+  }
+}
+
+#endif
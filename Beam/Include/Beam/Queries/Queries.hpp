@@ -3,6 +3,9 @@
 #include "Beam/Pointers/ClonePtr.hpp"
 
 namespace Beam::Queries {
+  struct Aggregate;
+  class AggregateBuilder;
+  template<typename T> class AggregateQuery;
   template<typename D, typename E> class AsyncDataStore;
   class BaseEvaluatorNode;
   class BaseParameterEvaluatorNode;
@@ -48,6 +51,7 @@ namespace Beam::Queries {
   class OrEvaluatorNode;
   template<typename ResultType> class ParameterEvaluatorNode;
   class ParameterExpression;
+  template<typename D, typename E> class PartitionedDataStore;
   template<typename ValueType, typename QueryType,
     typename EvaluatorTranslatorType, typename ServiceProtocolClientHandlerType,
     typename QueryServiceType, typename EndQueryMessageType>
@@ -69,6 +73,7 @@ namespace Beam::Queries {
   template<typename DataStoreType, typename EvaluatorTranslatorFilterType>
     class SessionCachedDataStoreEntry;
   class SetVariableExpression;
+  enum class SnapshotEncoding;
   class SnapshotLimit;
   class SnapshotLimitedQuery;
   template<typename C, typename V, typename I, typename T> class SqlDataStore;
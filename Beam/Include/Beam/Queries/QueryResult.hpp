@@ -1,12 +1,23 @@
 #ifndef BEAM_QUERYRESULT_HPP
 #define BEAM_QUERYRESULT_HPP
+#include <algorithm>
 #include <vector>
+#include "Beam/IO/SharedBuffer.hpp"
 #include "Beam/Queries/Queries.hpp"
+#include "Beam/Queries/SnapshotEncoding.hpp"
+#include "Beam/Serialization/ColumnarReceiver.hpp"
+#include "Beam/Serialization/ColumnarSender.hpp"
 #include "Beam/Serialization/DataShuttle.hpp"
 #include "Beam/Serialization/ShuttleVector.hpp"
 
 namespace Beam {
 namespace Queries {
+namespace Details {
+  /* Sent in place of the snapshot's length to mark a columnar snapshot, only
+     to sessions that negotiated COLUMNAR_SNAPSHOT_CAPABILITY since a legacy
+     receiver would take it for an empty snapshot. */
+  constexpr auto COLUMNAR_SNAPSHOT_MARKER = -1;
+}
 
   /*! \struct QueryResult
       \brief Stores the result of a query.
@@ -24,6 +35,10 @@ namespace Queries {
     //! A snapshot of available data from the query.
     std::vector<Type> m_snapshot;
 
+    //! How the snapshot is encoded when sent, set by the server from the
+    //! capabilities the client's session negotiated at login.
+    SnapshotEncoding m_encoding;
+
     //! Constructs a default QueryResult.
     QueryResult();
 
@@ -31,18 +46,23 @@ namespace Queries {
     /*!
       \param queryId The query's unique id.
       \param snapshot The snapshot of available data from the query.
+      \param encoding How the snapshot is encoded when sent.
     */
-    QueryResult(int queryId, std::vector<Type> snapshot);
+    QueryResult(int queryId, std::vector<Type> snapshot,
+      SnapshotEncoding encoding = SnapshotEncoding::NONE);
   };
 
   template<typename T>
   QueryResult<T>::QueryResult()
-      : m_queryId{-1} {}
+      : m_queryId{-1},
+        m_encoding{SnapshotEncoding::NONE} {}
 
   template<typename T>
-  QueryResult<T>::QueryResult(int queryId, std::vector<Type> snapshot)
+  QueryResult<T>::QueryResult(int queryId, std::vector<Type> snapshot,
+      SnapshotEncoding encoding)
       : m_queryId{queryId},
-        m_snapshot(std::move(snapshot)) {}
+        m_snapshot(std::move(snapshot)),
+        m_encoding{encoding} {}
 }
 }
 
@@ -54,7 +74,59 @@ namespace Serialization {
     void operator ()(Shuttler& shuttle, Queries::QueryResult<T>& value,
         unsigned int version) {
       shuttle.Shuttle("query_id", value.m_queryId);
-      shuttle.Shuttle("snapshot", value.m_snapshot);
+      if constexpr(IsReceiver<Shuttler>::value) {
+        auto size = int();
+        shuttle.StartSequence("snapshot", size);
+        value.m_snapshot.clear();
+        if(size == Queries::Details::COLUMNAR_SNAPSHOT_MARKER &&
+            IsBinaryShuttler<Shuttler>::value) {
+          value.m_encoding = Queries::SnapshotEncoding::COLUMNAR;
+          auto count = int();
+          auto columns = IO::SharedBuffer();
+          shuttle.Shuttle("count", count);
+          shuttle.Shuttle("columns", columns);
+          if(count < 0) {
+            BOOST_THROW_EXCEPTION(SerializationException(
+              "Snapshot length out of range."));
+          }
+          auto receiver = ColumnarReceiver<IO::SharedBuffer>();
+          receiver.SetSource(Ref(columns));
+          value.m_snapshot.reserve(std::min(static_cast<std::size_t>(count),
+            columns.GetSize()));
+          for(auto i = 0; i != count; ++i) {
+            receiver.StartRow();
+            value.m_snapshot.emplace_back();
+            receiver.Shuttle(value.m_snapshot.back());
+          }
+        } else if(size >= 0) {
+          value.m_encoding = Queries::SnapshotEncoding::NONE;
+          for(auto i = 0; i != size; ++i) {
+            value.m_snapshot.emplace_back();
+            shuttle.Shuttle(value.m_snapshot.back());
+          }
+        } else {
+          BOOST_THROW_EXCEPTION(SerializationException(
+            "Snapshot length out of range."));
+        }
+        shuttle.EndSequence();
+      } else if(!IsBinaryShuttler<Shuttler>::value ||
+          value.m_encoding == Queries::SnapshotEncoding::NONE) {
+        shuttle.Shuttle("snapshot", value.m_snapshot);
+      } else {
+        auto columns = IO::SharedBuffer();
+        auto sender = ColumnarSender<IO::SharedBuffer>();
+        sender.SetSink(Ref(columns));
+        for(auto& entry : value.m_snapshot) {
+          sender.StartRow();
+          sender.Shuttle(entry);
+        }
+        sender.Flush();
+        shuttle.StartSequence("snapshot",
+          Queries::Details::COLUMNAR_SNAPSHOT_MARKER);
+        shuttle.Shuttle("count", static_cast<int>(value.m_snapshot.size()));
+        shuttle.Shuttle("columns", columns);
+        shuttle.EndSequence();
+      }
     }
   };
 }
@@ -0,0 +1,69 @@
+#ifndef BEAM_SNAPSHOTENCODING_HPP
+#define BEAM_SNAPSHOTENCODING_HPP
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include "Beam/Queries/Queries.hpp"
+
+namespace Beam {
+namespace Queries {
+
+  /*! \enum SnapshotEncoding
+      \brief Enumerates the ways a QueryResult's snapshot is sent.
+   */
+  enum class SnapshotEncoding {
+
+    //! Each value is sent in full.
+    NONE,
+
+    //! Values are sent column by column, with integers and timestamps delta
+    //! encoded and repeated strings sent through a dictionary.
+    COLUMNAR
+  };
+
+  //! The session capability bit advertising support for COLUMNAR snapshots.
+  constexpr auto COLUMNAR_SNAPSHOT_CAPABILITY = 1;
+
+namespace Details {
+  template<typename Client, typename = void>
+  struct HasSessionCapabilities : std::false_type {};
+
+  template<typename Client>
+  struct HasSessionCapabilities<Client, std::void_t<decltype(
+    std::declval<const Client&>().GetSession().GetCapabilities())>> :
+    std::true_type {};
+}
+
+  //! Returns the SnapshotEncoding to use when sending to a client.
+  /*!
+    \param client The client receiving the QueryResult.
+    \return COLUMNAR iff the client's session negotiated
+            COLUMNAR_SNAPSHOT_CAPABILITY, otherwise NONE.
+  */
+  template<typename ServiceProtocolClient>
+  SnapshotEncoding GetSnapshotEncoding(
+      const ServiceProtocolClient& client) {
+    if constexpr(Details::HasSessionCapabilities<
+        ServiceProtocolClient>::value) {
+      if(client.GetSession().GetCapabilities() &
+          COLUMNAR_SNAPSHOT_CAPABILITY) {
+        return SnapshotEncoding::COLUMNAR;
+      }
+    }
+    return SnapshotEncoding::NONE;
+  }
+
+  inline std::ostream& operator <<(std::ostream& out,
+      SnapshotEncoding encoding) {
+    if(encoding == SnapshotEncoding::NONE) {
+      return out << "NONE";
+    } else if(encoding == SnapshotEncoding::COLUMNAR) {
+      return out << "COLUMNAR";
+    } else {
+      return out << "UNKNOWN";
+    }
+  }
+}
+}
+
+#endif
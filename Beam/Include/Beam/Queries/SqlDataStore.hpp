@@ -6,6 +6,7 @@
 #include <boost/noncopyable.hpp>
 #include <Viper/Viper.hpp>
 #include "Beam/Pointers/Ref.hpp"
+#include "Beam/Queries/AggregateQuery.hpp"
 #include "Beam/Queries/BasicQuery.hpp"
 #include "Beam/Queries/IndexedValue.hpp"
 #include "Beam/Queries/Queries.hpp"
@@ -49,6 +50,9 @@ namespace Beam::Queries {
       //! The type of query used to load values.
       using Query = BasicQuery<Index>;
 
+      //! The type of query used to load Aggregates.
+      using AggregateQuery = ::Beam::Queries::AggregateQuery<Index>;
+
       //! The SequencedValue to store.
       using SequencedValue = ::Beam::Queries::SequencedValue<Value>;
 
@@ -86,6 +90,13 @@ namespace Beam::Queries {
       */
       std::vector<SequencedValue> Load(const Viper::Expression& query);
 
+      //! Reduces the values matching a query using SQL aggregates.
+      /*!
+        \param query The aggregate query to execute.
+        \return The Aggregates of the values that satisfy the <i>query</i>.
+      */
+      std::vector<Aggregate> LoadAggregates(const AggregateQuery& query);
+
       //! Stores a Value.
       /*!
         \param value The Value to store.
@@ -111,6 +122,8 @@ namespace Beam::Queries {
       DatabaseConnectionPool<Connection>* m_readerPool;
       DatabaseConnectionPool<Connection>* m_writerPool;
       Threading::ThreadPool* m_threadPool;
+
+      Viper::Expression BuildIndexExpression(const Index& index) const;
   };
 
   template<typename C, typename V, typename I, typename T>
@@ -192,24 +205,8 @@ namespace Beam::Queries {
   template<typename C, typename V, typename I, typename T>
   std::vector<typename SqlDataStore<C, V, I, T>::SequencedValue>
       SqlDataStore<C, V, I, T>::Load(const Query& query) {
-    std::optional<Viper::Expression> index;
-    std::string column;
-    for(auto i = std::size_t(0); i != m_indexRow.get_columns().size(); ++i) {
-      m_indexRow.append_value(query.GetIndex(), i, column);
-      auto term = Viper::sym(m_indexRow.get_columns()[i].m_name) ==
-        Viper::sym(column);
-      if(index.has_value()) {
-        *index = *index && term;
-      } else {
-        index.emplace(std::move(term));
-      }
-      column.clear();
-    }
-    if(!index.has_value()) {
-      index.emplace();
-    }
-    return LoadSqlQuery<SqlTranslator>(query, m_sequencedRow, m_table, *index,
-      *m_threadPool, *m_readerPool);
+    return LoadSqlQuery<SqlTranslator>(query, m_sequencedRow, m_table,
+      BuildIndexExpression(query.GetIndex()), *m_threadPool, *m_readerPool);
   }
 
   template<typename C, typename V, typename I, typename T>
@@ -219,6 +216,13 @@ namespace Beam::Queries {
       *m_readerPool);
   }
 
+  template<typename C, typename V, typename I, typename T>
+  std::vector<Aggregate> SqlDataStore<C, V, I, T>::LoadAggregates(
+      const AggregateQuery& query) {
+    return LoadSqlAggregates<SqlTranslator>(query, m_table,
+      BuildIndexExpression(query.GetIndex()), *m_threadPool, *m_readerPool);
+  }
+
   template<typename C, typename V, typename I, typename T>
   void SqlDataStore<C, V, I, T>::Store(const IndexedValue& value) {
     auto result =  Routines::Async<void>();
@@ -226,7 +230,7 @@ namespace Beam::Queries {
     m_threadPool->Queue(
       [&] {
         connection->execute(Viper::insert(m_row, m_table, &value));
-      }, result.GetEval());
+      }, result.GetEval(), Threading::ThreadPool::Priority::LOW);
     result.Get();
   }
 
@@ -239,7 +243,7 @@ namespace Beam::Queries {
       [&] {
         connection->execute(Viper::insert(m_row, m_table, values.begin(),
           values.end()));
-      }, result.GetEval());
+      }, result.GetEval(), Threading::ThreadPool::Priority::LOW);
     result.Get();
   }
 
@@ -256,6 +260,28 @@ namespace Beam::Queries {
 
   template<typename C, typename V, typename I, typename T>
   void SqlDataStore<C, V, I, T>::Close() {}
+
+  template<typename C, typename V, typename I, typename T>
+  Viper::Expression SqlDataStore<C, V, I, T>::BuildIndexExpression(
+      const Index& index) const {
+    std::optional<Viper::Expression> expression;
+    std::string column;
+    for(auto i = std::size_t(0); i != m_indexRow.get_columns().size(); ++i) {
+      m_indexRow.append_value(index, i, column);
+      auto term = Viper::sym(m_indexRow.get_columns()[i].m_name) ==
+        Viper::sym(column);
+      if(expression.has_value()) {
+        *expression = *expression && term;
+      } else {
+        expression.emplace(std::move(term));
+      }
+      column.clear();
+    }
+    if(!expression.has_value()) {
+      expression.emplace();
+    }
+    return std::move(*expression);
+  }
 }
 
 #endif
@@ -8,6 +8,7 @@
 #include "Beam/Queries/ExpressionTranslationException.hpp"
 #include "Beam/Queries/ExpressionVisitor.hpp"
 #include "Beam/Queries/GlobalVariableDeclarationExpression.hpp"
+#include "Beam/Queries/MemberAccessExpression.hpp"
 #include "Beam/Queries/OrExpression.hpp"
 #include "Beam/Queries/ParameterExpression.hpp"
 #include "Beam/Queries/Queries.hpp"
@@ -36,6 +37,8 @@ namespace Beam::Queries {
 
       void Visit(const FunctionExpression& expression) override;
 
+      void Visit(const MemberAccessExpression& expression) override;
+
       void Visit(const OrExpression& expression) override;
 
       void Visit(const ParameterExpression& expression) override;
@@ -124,6 +127,15 @@ namespace Beam::Queries {
     }
   }
 
+  inline void SqlTranslator::Visit(const MemberAccessExpression& expression) {
+    if(dynamic_cast<const ParameterExpression*>(
+        &*expression.GetExpression()) == nullptr) {
+      BOOST_THROW_EXCEPTION(ExpressionTranslationException(
+        "Member access not supported."));
+    }
+    GetTranslation() = Viper::sym(expression.GetName());
+  }
+
   inline void SqlTranslator::Visit(const OrExpression& expression) {
     expression.GetLeftExpression()->Apply(*this);
     auto leftTranslation = GetTranslation();
@@ -1,11 +1,13 @@
 #ifndef BEAM_QUERIES_SQL_UTILITIES_HPP
 #define BEAM_QUERIES_SQL_UTILITIES_HPP
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
 #include <boost/range/adaptor/reversed.hpp>
 #include <Viper/Expressions/Expression.hpp>
 #include <Viper/Expressions/SqlFunctions.hpp>
+#include "Beam/Queries/AggregateQuery.hpp"
 #include "Beam/Queries/Queries.hpp"
 #include "Beam/Queries/Range.hpp"
 #include "Beam/Queries/RangedQuery.hpp"
@@ -29,6 +31,41 @@ namespace Beam::Queries {
       Viper::sym("query_sequence") <= end;
   }
 
+  //! Builds the SQL row used to select a query's Aggregates.
+  /*!
+    \param table The table to query.
+    \param query The AggregateQuery whose value and weight are translated.
+    \return A row whose columns compute the Aggregates in SQL, grouped by the
+            first column when the <i>query</i> is bucketed.
+  */
+  template<typename Translator, typename Query>
+  auto BuildSqlAggregateRow(const std::string& table, const Query& query) {
+    auto toSql = [&] (const Expression& expression) {
+      auto sql = std::string("(");
+      BuildSqlQuery<Translator>(table, expression).append_query(sql);
+      sql += ")";
+      return sql;
+    };
+    auto value = toSql(query.GetValue());
+    auto weight = toSql(query.GetWeight());
+    auto bucket = [&] {
+      if(query.GetBucket().is_special()) {
+        return std::string("COALESCE(MIN(timestamp), 0)");
+      }
+      auto width = std::to_string(query.GetBucket().total_milliseconds());
+      return "timestamp - timestamp % " + width;
+    }();
+    return Viper::Row<Aggregate>().
+      add_column(bucket, &Aggregate::m_timestamp).
+      add_column("COUNT(*)", &Aggregate::m_count).
+      add_column("COALESCE(MIN(" + value + "), 0)", &Aggregate::m_min).
+      add_column("COALESCE(MAX(" + value + "), 0)", &Aggregate::m_max).
+      add_column("COALESCE(SUM(" + value + "), 0)", &Aggregate::m_sum).
+      add_column("COALESCE(SUM(" + weight + "), 0)", &Aggregate::m_weight).
+      add_column("COALESCE(SUM(" + value + " * " + weight + "), 0)",
+        &Aggregate::m_weightedSum);
+  }
+
   //! Sanitizes a query for use with an SQL database.
   /*!
     \param query The query to sanitize.
@@ -100,7 +137,7 @@ namespace Beam::Queries {
           Viper::order_by("query_sequence", Viper::Order::ASC),
           std::back_inserter(rows)));
         return rows;
-      }, result.GetEval());
+      }, result.GetEval(), Threading::ThreadPool::Priority::HIGH);
     return result.Get();
   }
 
@@ -156,7 +193,7 @@ namespace Beam::Queries {
               Viper::order_by("query_sequence", Viper::Order::ASC),
               std::back_inserter(rows)));
             return rows;
-          }, result.GetEval());
+          }, result.GetEval(), Threading::ThreadPool::Priority::HIGH);
         partitions.push_back(std::move(result.Get()));
         remainingLimit -= partitions.back().size();
         if(partitions.back().empty() ||
@@ -192,7 +229,7 @@ namespace Beam::Queries {
               Viper::order_by("query_sequence", Viper::Order::ASC),
               Viper::limit(limit), std::back_inserter(rows)));
             return rows;
-          }, result.GetEval());
+          }, result.GetEval(), Threading::ThreadPool::Priority::HIGH);
         auto partition = std::move(result.Get());
         if(sanitizedQuery.GetSnapshotLimit() != SnapshotLimit::Unlimited()) {
           remainingLimit -= partition.size();
@@ -208,6 +245,63 @@ namespace Beam::Queries {
     }
     return records;
   }
+
+  //! Reduces the values matching a query within an SQL database so that only
+  //! the aggregated rows are read back.
+  /*!
+    \param query The AggregateQuery to submit.
+    \param table The name of the table to select from.
+    \param index The expression used to identify the index.
+    \param threadPool The ThreadPool used to perform the read.
+    \param connectionPool Contains the pool of SQL connections to use.
+    \return The Aggregates of the values satisfying the <i>query</i>.
+  */
+  template<typename Translator, typename Query, typename ConnectionPool>
+  std::vector<Aggregate> LoadSqlAggregates(Query query,
+      const std::string& table, const Viper::Expression& index,
+      Threading::ThreadPool& threadPool, ConnectionPool& connectionPool) {
+    if(query.GetRange().GetStart() == Sequence::Present() ||
+        query.GetRange().GetStart() == Sequence::Last()) {
+      return {};
+    }
+    auto sanitizedQuery = SanitizeSqlQuery(std::move(query), table, index,
+      connectionPool);
+    if(boost::get<Sequence>(sanitizedQuery.GetRange().GetStart()) >
+        boost::get<Sequence>(sanitizedQuery.GetRange().GetEnd())) {
+      return {};
+    }
+    auto result = Routines::Async<std::vector<Aggregate>>();
+    auto connection = connectionPool.Acquire();
+    threadPool.Queue(
+      [&] {
+        auto filter = BuildSqlQuery<Translator>(table,
+          sanitizedQuery.GetFilter());
+        auto range = BuildRangeExpression(sanitizedQuery.GetRange());
+        auto row = BuildSqlAggregateRow<Translator>(table, sanitizedQuery);
+        auto rows = std::vector<Aggregate>();
+        if(sanitizedQuery.GetBucket().is_special()) {
+          connection->execute(Viper::select(row, table,
+            index && range && filter, std::back_inserter(rows)));
+        } else {
+
+          // Viper has no GROUP BY clause, so it follows the WHERE clause's
+          // condition instead.
+          auto& bucket = row.get_columns().front().m_name;
+          auto where = std::string();
+          (index && range && filter).append_query(where);
+          connection->execute(Viper::select(row, table,
+            Viper::sym(where + " GROUP BY " + bucket),
+            Viper::order_by(bucket, Viper::Order::ASC),
+            std::back_inserter(rows)));
+        }
+        rows.erase(std::remove_if(rows.begin(), rows.end(),
+          [] (const Aggregate& aggregate) {
+            return aggregate.m_count == 0;
+          }), rows.end());
+        return rows;
+      }, result.GetEval(), Threading::ThreadPool::Priority::HIGH);
+    return std::move(result.Get());
+  }
 }
 
 #endif
@@ -57,7 +57,8 @@ namespace Queries {
       int Initialize(ServiceProtocolClient& client, const Range& range,
         std::unique_ptr<Evaluator> filter);
 
-      //! Commits a previously initialized subscription.
+      //! Commits a previously initialized subscription, encoding its snapshot
+      //! according to the capabilities of the subscribing client's session.
       /*!
         \param result The result of the query.
       */
@@ -200,6 +201,7 @@ namespace Queries {
       std::vector<Value>().swap(subscriptionEntry.m_writeLog);
     }
     subscriptionEntry.m_state = SubscriptionEntry::State::COMMITTED;
+    result.m_encoding = GetSnapshotEncoding(*subscriptionEntry.m_client);
     f(std::move(result));
   }
 
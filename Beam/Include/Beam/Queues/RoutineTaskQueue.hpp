@@ -1,13 +1,25 @@
 #ifndef BEAM_ROUTINETASKQUEUE_HPP
 #define BEAM_ROUTINETASKQUEUE_HPP
+#include <iostream>
+#include <type_traits>
+#include <vector>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include "Beam/Queues/CallbackQueue.hpp"
 #include "Beam/Queues/Queues.hpp"
-#include "Beam/Queues/TaskQueue.hpp"
+#include "Beam/Queues/QueueWriter.hpp"
 #include "Beam/Routines/RoutineHandler.hpp"
+#include "Beam/Threading/ConditionVariable.hpp"
+#include "Beam/Utilities/ReportException.hpp"
+#include "Beam/Utilities/Task.hpp"
 
 namespace Beam {
 
   /*! \class RoutineTaskQueue
       \brief Runs pushed tasks within a Routine.
+      \details Tasks are stored as a Task, so small callables are queued
+               without allocating, and every task pending when the Routine
+               wakes up is run as a single batch.
    */
   class RoutineTaskQueue : public QueueWriter<std::function<void ()>> {
     public:
@@ -43,6 +55,14 @@ namespace Beam {
       //! Waits for this queue to be broken and all tasks to complete.
       void Wait();
 
+      //! Pushes a task without first converting it to a Source.
+      /*!
+        \param task The task to run.
+      */
+      template<typename F, typename = std::enable_if_t<
+        !std::is_same_v<std::decay_t<F>, Source>>>
+      void Push(F&& task);
+
       virtual void Push(const Source& value);
 
       virtual void Push(Source&& value);
@@ -51,12 +71,22 @@ namespace Beam {
 
       using QueueWriter<std::function<void ()>>::Break;
     private:
-      TaskQueue m_tasks;
+      boost::mutex m_mutex;
+      std::vector<Task> m_pendingTasks;
+      std::exception_ptr m_breakException;
+      Threading::ConditionVariable m_tasksAvailableCondition;
+      CallbackQueue m_callbacks;
       Routines::RoutineHandler m_routine;
+
+      void PushTask(Task&& task);
+      void RunTasks();
   };
 
   inline RoutineTaskQueue::RoutineTaskQueue()
-      : m_routine(SpawnTaskRoutine(&m_tasks)) {}
+      : m_routine(Routines::Spawn(
+          [=] {
+            RunTasks();
+          })) {}
 
   inline RoutineTaskQueue::~RoutineTaskQueue() {
     Break();
@@ -65,30 +95,89 @@ namespace Beam {
   template<typename T>
   std::shared_ptr<CallbackWriterQueue<T>> RoutineTaskQueue::GetSlot(
       const std::function<void (const T& value)>& slot) {
-    return m_tasks.GetSlot(slot);
+    return this->GetSlot<T>(slot, [] (const std::exception_ptr&) {});
   }
 
   template<typename T>
   std::shared_ptr<CallbackWriterQueue<T>> RoutineTaskQueue::GetSlot(
       const std::function<void (const T& value)>& slot,
       const std::function<void (const std::exception_ptr& e)>& breakSlot) {
-    return m_tasks.GetSlot(slot, breakSlot);
+    return m_callbacks.GetSlot<T>(
+      [=] (const T& value) {
+        PushTask(
+          [=] {
+            slot(value);
+          });
+      },
+      [=] (const std::exception_ptr& e) {
+        PushTask(
+          [=] {
+            breakSlot(e);
+          });
+      });
   }
 
   inline void RoutineTaskQueue::Wait() {
     m_routine.Wait();
   }
 
+  template<typename F, typename>
+  void RoutineTaskQueue::Push(F&& task) {
+    PushTask(Task(std::forward<F>(task)));
+  }
+
   inline void RoutineTaskQueue::Push(const Source& value) {
-    m_tasks.Push(value);
+    PushTask(Task(value));
   }
 
   inline void RoutineTaskQueue::Push(Source&& value) {
-    m_tasks.Push(std::move(value));
+    PushTask(Task(std::move(value)));
   }
 
   inline void RoutineTaskQueue::Break(const std::exception_ptr& exception) {
-    m_tasks.Break(exception);
+    m_callbacks.Break(exception);
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+    if(m_breakException != nullptr) {
+      return;
+    }
+    m_breakException = exception;
+    m_tasksAvailableCondition.notify_all();
+  }
+
+  inline void RoutineTaskQueue::PushTask(Task&& task) {
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+    if(m_breakException != nullptr) {
+      std::rethrow_exception(m_breakException);
+    }
+    m_pendingTasks.push_back(std::move(task));
+    if(m_pendingTasks.size() == 1) {
+      m_tasksAvailableCondition.notify_one();
+    }
+  }
+
+  inline void RoutineTaskQueue::RunTasks() {
+    std::vector<Task> tasks;
+    while(true) {
+      {
+        boost::unique_lock<boost::mutex> lock(m_mutex);
+        while(m_pendingTasks.empty() && m_breakException == nullptr) {
+          m_tasksAvailableCondition.wait(lock);
+        }
+        if(m_pendingTasks.empty()) {
+          return;
+        }
+        tasks.swap(m_pendingTasks);
+      }
+      try {
+        for(auto& task : tasks) {
+          task();
+        }
+      } catch(const std::exception&) {
+        std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
+        return;
+      }
+      tasks.clear();
+    }
   }
 }
 
@@ -4,8 +4,7 @@
 #include <Aspen/Lift.hpp>
 #include "Beam/Pointers/Dereference.hpp"
 #include "Beam/Queues/Publisher.hpp"
-#include "Beam/Queues/Queue.hpp"
-#include "Beam/Reactors/QueueReactor.hpp"
+#include "Beam/Reactors/QueueWriterReactor.hpp"
 
 namespace Beam::Reactors {
 namespace Details {
@@ -31,9 +30,9 @@ namespace Details {
    */
   template<typename Type>
   auto PublisherReactor(const Publisher<Type>& publisher) {
-    auto queue = std::make_shared<Queue<Type>>();
-    publisher.Monitor(queue);
-    return QueueReactor(queue);
+    auto reactor = QueueWriterReactor<Type>();
+    publisher.Monitor(reactor.GetWriter());
+    return reactor;
   }
 
   /**
@@ -3,8 +3,7 @@
 #include <Aspen/Lift.hpp>
 #include <Aspen/Override.hpp>
 #include "Beam/Queries/BasicQuery.hpp"
-#include "Beam/Queues/Queue.hpp"
-#include "Beam/Reactors/QueueReactor.hpp"
+#include "Beam/Reactors/QueueWriterReactor.hpp"
 
 namespace Beam::Reactors {
 
@@ -18,9 +17,9 @@ namespace Beam::Reactors {
     return Aspen::override(Aspen::lift(
       [submissionFunction = std::forward<F>(submissionFunction)]
           (const Aspen::reactor_result_t<Query>& query) {
-        auto queue = std::make_shared<Queue<T>>();
-        submissionFunction(query, queue);
-        return Aspen::Shared(QueueReactor(std::move(queue)));
+        auto reactor = QueueWriterReactor<T>();
+        submissionFunction(query, reactor.GetWriter());
+        return Aspen::Shared(std::move(reactor));
       }, std::forward<Query>(query)));
   }
 
@@ -0,0 +1,208 @@
+#ifndef BEAM_QUEUE_WRITER_REACTOR_HPP
+#define BEAM_QUEUE_WRITER_REACTOR_HPP
+#include <deque>
+#include <memory>
+#include <optional>
+#include <Aspen/Queue.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/throw_exception.hpp>
+#include "Beam/Queues/PipeBrokenException.hpp"
+#include "Beam/Queues/QueueWriter.hpp"
+
+namespace Beam::Reactors {
+
+  /**
+   * Evaluates to values pushed onto a QueueWriter. Unlike the QueueReactor, no
+   * routine is used to monitor the values, instead each push is stored
+   * directly by the writer and the Reactor is signalled once for every batch
+   * of pending values.
+   * @param <T> The type of values to publish.
+   */
+  template<typename T>
+  class QueueWriterReactor {
+    public:
+      using Type = T;
+
+      //! Constructs a QueueWriterReactor.
+      QueueWriterReactor();
+
+      QueueWriterReactor(QueueWriterReactor&&) = default;
+
+      ~QueueWriterReactor();
+
+      //! Returns the QueueWriter that pushes values to this Reactor.
+      const std::shared_ptr<QueueWriter<Type>>& GetWriter() const;
+
+      Aspen::State commit(int sequence) noexcept;
+
+      Aspen::eval_result_t<Type> eval() const;
+
+      QueueWriterReactor& operator =(QueueWriterReactor&&) = default;
+
+    private:
+      struct Entry {
+        boost::mutex m_mutex;
+        Aspen::Queue<bool> m_signal;
+        std::deque<Type> m_pending;
+        std::exception_ptr m_breakException;
+        bool m_isBroken;
+        bool m_isSignalled;
+        bool m_isClosed;
+
+        Entry();
+        void Push(Type&& value);
+        void Break(const std::exception_ptr& e);
+      };
+      class Writer final : public QueueWriter<Type> {
+        public:
+          Writer(std::shared_ptr<Entry> entry);
+
+          void Push(const Type& value) override;
+
+          void Push(Type&& value) override;
+
+          void Break(const std::exception_ptr& e) override;
+
+          using QueueWriter<Type>::Break;
+
+        private:
+          std::shared_ptr<Entry> m_entry;
+      };
+      std::shared_ptr<Entry> m_entry;
+      std::shared_ptr<QueueWriter<Type>> m_writer;
+      std::deque<Type> m_batch;
+      std::optional<Type> m_value;
+      std::exception_ptr m_exception;
+      bool m_isBroken;
+      int m_previousSequence;
+      Aspen::State m_state;
+  };
+
+  template<typename T>
+  QueueWriterReactor<T>::Entry::Entry()
+    : m_isBroken(false),
+      m_isSignalled(false),
+      m_isClosed(false) {}
+
+  template<typename T>
+  void QueueWriterReactor<T>::Entry::Push(Type&& value) {
+    auto lock = boost::lock_guard(m_mutex);
+    if(m_isBroken || m_isClosed) {
+      BOOST_THROW_EXCEPTION(PipeBrokenException());
+    }
+    m_pending.push_back(std::move(value));
+    if(!m_isSignalled) {
+      m_isSignalled = true;
+      m_signal.push(true);
+    }
+  }
+
+  template<typename T>
+  void QueueWriterReactor<T>::Entry::Break(const std::exception_ptr& e) {
+    auto lock = boost::lock_guard(m_mutex);
+    if(m_isBroken || m_isClosed) {
+      return;
+    }
+    m_isBroken = true;
+    try {
+      std::rethrow_exception(e);
+    } catch(const PipeBrokenException&) {
+    } catch(const std::exception&) {
+      m_breakException = e;
+    }
+    if(!m_isSignalled) {
+      m_isSignalled = true;
+      m_signal.push(true);
+    }
+  }
+
+  template<typename T>
+  QueueWriterReactor<T>::Writer::Writer(std::shared_ptr<Entry> entry)
+    : m_entry(std::move(entry)) {}
+
+  template<typename T>
+  void QueueWriterReactor<T>::Writer::Push(const Type& value) {
+    m_entry->Push(Type(value));
+  }
+
+  template<typename T>
+  void QueueWriterReactor<T>::Writer::Push(Type&& value) {
+    m_entry->Push(std::move(value));
+  }
+
+  template<typename T>
+  void QueueWriterReactor<T>::Writer::Break(const std::exception_ptr& e) {
+    m_entry->Break(e);
+  }
+
+  template<typename T>
+  QueueWriterReactor<T>::QueueWriterReactor()
+    : m_entry(std::make_shared<Entry>()),
+      m_writer(std::make_shared<Writer>(m_entry)),
+      m_isBroken(false),
+      m_previousSequence(-1),
+      m_state(Aspen::State::NONE) {}
+
+  template<typename T>
+  QueueWriterReactor<T>::~QueueWriterReactor() {
+    if(m_entry != nullptr) {
+      auto lock = boost::lock_guard(m_entry->m_mutex);
+      m_entry->m_isClosed = true;
+      m_entry->m_pending.clear();
+    }
+  }
+
+  template<typename T>
+  const std::shared_ptr<QueueWriter<typename QueueWriterReactor<T>::Type>>&
+      QueueWriterReactor<T>::GetWriter() const {
+    return m_writer;
+  }
+
+  template<typename T>
+  Aspen::State QueueWriterReactor<T>::commit(int sequence) noexcept {
+    if(sequence == m_previousSequence || Aspen::is_complete(m_state)) {
+      return m_state;
+    }
+    m_previousSequence = sequence;
+    if(m_batch.empty() && !m_isBroken) {
+      m_entry->m_signal.commit(sequence);
+      auto lock = boost::lock_guard(m_entry->m_mutex);
+      m_batch.swap(m_entry->m_pending);
+      m_isBroken = m_entry->m_isBroken;
+      m_entry->m_isSignalled = false;
+    }
+    if(!m_batch.empty()) {
+      m_value.emplace(std::move(m_batch.front()));
+      m_batch.pop_front();
+      if(!m_batch.empty() || m_isBroken && m_entry->m_breakException) {
+        m_state = Aspen::State::CONTINUE_EVALUATED;
+      } else if(m_isBroken) {
+        m_state = Aspen::State::COMPLETE_EVALUATED;
+      } else {
+        m_state = Aspen::State::EVALUATED;
+      }
+    } else if(m_isBroken) {
+      if(m_entry->m_breakException) {
+        m_exception = m_entry->m_breakException;
+        m_state = Aspen::State::COMPLETE_EVALUATED;
+      } else {
+        m_state = Aspen::State::COMPLETE;
+      }
+    } else {
+      m_state = Aspen::State::NONE;
+    }
+    return m_state;
+  }
+
+  template<typename T>
+  Aspen::eval_result_t<typename QueueWriterReactor<T>::Type>
+      QueueWriterReactor<T>::eval() const {
+    if(m_exception) {
+      std::rethrow_exception(m_exception);
+    }
+    return *m_value;
+  }
+}
+
+#endif
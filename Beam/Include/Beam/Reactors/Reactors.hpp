@@ -5,6 +5,7 @@
 #include "Beam/Reactors/PublisherReactor.hpp"
 #include "Beam/Reactors/QueryReactor.hpp"
 #include "Beam/Reactors/QueueReactor.hpp"
+#include "Beam/Reactors/QueueWriterReactor.hpp"
 #include "Beam/Reactors/TimerReactor.hpp"
 
 #endif
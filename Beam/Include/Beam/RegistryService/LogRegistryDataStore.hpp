@@ -0,0 +1,462 @@
+#ifndef BEAM_LOGREGISTRYDATASTORE_HPP
+#define BEAM_LOGREGISTRYDATASTORE_HPP
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+#include <boost/crc.hpp>
+#include <boost/throw_exception.hpp>
+#include "Beam/IO/OpenState.hpp"
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/RegistryService/LogRegistryDataStoreDetails.hpp"
+#include "Beam/RegistryService/RegistryDataStore.hpp"
+#include "Beam/RegistryService/RegistryDataStoreException.hpp"
+#include "Beam/RegistryService/RegistryEntry.hpp"
+#include "Beam/Serialization/BinaryReceiver.hpp"
+#include "Beam/Serialization/BinarySender.hpp"
+#include "Beam/Threading/Mutex.hpp"
+
+namespace Beam {
+namespace RegistryService {
+
+  /*! \class LogRegistryDataStore
+      \brief Implements the RegistryDataStore using an in-memory index backed
+             by an append-only log on the local file system.
+      \details Every modification, including the copy, move or deletion of an
+               entire subtree, is appended to the log as a single checksummed
+               batch. A batch only partially written to disk is discarded upon
+               recovery. The log is compacted into a snapshot once its size
+               grows well past the size of the live data. On first use, the
+               records of a FileSystemRegistryDataStore found in the same
+               directory are imported.
+   */
+  class LogRegistryDataStore : public RegistryDataStore {
+    public:
+
+      //! Constructs a LogRegistryDataStore.
+      /*!
+        \param root The directory storing the log.
+      */
+      LogRegistryDataStore(const std::filesystem::path& root);
+
+      ~LogRegistryDataStore() override;
+
+      RegistryEntry LoadParent(const RegistryEntry& registryEntry) override;
+
+      std::vector<RegistryEntry> LoadChildren(
+        const RegistryEntry& directory) override;
+
+      RegistryEntry LoadRegistryEntry(std::uint64_t id) override;
+
+      RegistryEntry Copy(const RegistryEntry& source,
+        const RegistryEntry& destination) override;
+
+      void Move(const RegistryEntry& source,
+        const RegistryEntry& destination) override;
+
+      void Delete(const RegistryEntry& registryEntry) override;
+
+      IO::SharedBuffer Load(const RegistryEntry& registryEntry) override;
+
+      RegistryEntry Store(const RegistryEntry& registryEntry,
+        const IO::SharedBuffer& value) override;
+
+      void WithTransaction(const std::function<void ()>& transaction) override;
+
+      void Open() override;
+
+      void Close() override;
+
+    private:
+      struct Batch {
+        std::unordered_map<std::uint64_t, Details::RegistryEntryRecord>
+          m_records;
+        std::vector<std::uint64_t> m_deletions;
+        std::uint64_t m_lastId;
+      };
+      static constexpr auto HEADER_SIZE = 2 * sizeof(std::uint32_t);
+      static constexpr auto MINIMUM_COMPACTION_SIZE =
+        std::uintmax_t(1024 * 1024);
+      static constexpr auto COMPACTION_FACTOR = 4;
+      mutable Threading::Mutex m_mutex;
+      std::filesystem::path m_root;
+      std::uint64_t m_lastId;
+      std::unordered_map<std::uint64_t, Details::RegistryEntryRecord>
+        m_records;
+      std::ofstream m_log;
+      std::uintmax_t m_logSize;
+      std::uintmax_t m_snapshotSize;
+      IO::OpenState m_openState;
+
+      std::filesystem::path GetLogPath() const;
+      const Details::RegistryEntryRecord& LoadRecord(std::uint64_t id) const;
+      Details::RegistryEntryRecord& LoadRecord(Batch& batch, std::uint64_t id);
+      Batch MakeBatch() const;
+      RegistryEntry Copy(Batch& batch,
+        const Details::RegistryEntryRecord& source, std::uint64_t parent);
+      void Delete(Batch& batch, std::uint64_t id);
+      void Commit(Batch batch);
+      void Apply(Details::RegistryLogBatch batch);
+      static IO::SharedBuffer Encode(Details::RegistryLogBatch& batch);
+      void Replay();
+      void Import();
+      void Compact();
+      void Shutdown();
+  };
+
+  inline LogRegistryDataStore::LogRegistryDataStore(
+    const std::filesystem::path& root)
+    : m_root(root),
+      m_lastId(0),
+      m_logSize(0),
+      m_snapshotSize(0) {}
+
+  inline LogRegistryDataStore::~LogRegistryDataStore() {
+    Close();
+  }
+
+  inline RegistryEntry LogRegistryDataStore::LoadParent(
+      const RegistryEntry& registryEntry) {
+    auto& record = LoadRecord(registryEntry.m_id);
+    return LoadRecord(record.m_parent).m_registryEntry;
+  }
+
+  inline std::vector<RegistryEntry> LogRegistryDataStore::LoadChildren(
+      const RegistryEntry& directory) {
+    auto& record = LoadRecord(directory.m_id);
+    auto children = std::vector<RegistryEntry>();
+    std::transform(record.m_children.begin(), record.m_children.end(),
+      std::back_inserter(children),
+      [&] (auto id) {
+        return LoadRecord(id).m_registryEntry;
+      });
+    return children;
+  }
+
+  inline RegistryEntry LogRegistryDataStore::LoadRegistryEntry(
+      std::uint64_t id) {
+    return LoadRecord(id).m_registryEntry;
+  }
+
+  inline RegistryEntry LogRegistryDataStore::Copy(const RegistryEntry& source,
+      const RegistryEntry& destination) {
+    auto batch = MakeBatch();
+    LoadRecord(batch, destination.m_id);
+    auto sourceRecord = Details::RegistryEntryRecord();
+    auto sourceIterator = m_records.find(source.m_id);
+    if(sourceIterator == m_records.end()) {
+      sourceRecord.m_registryEntry = source;
+    } else {
+      sourceRecord = sourceIterator->second;
+    }
+    auto entry = Copy(batch, sourceRecord, destination.m_id);
+    Commit(std::move(batch));
+    return entry;
+  }
+
+  inline void LogRegistryDataStore::Move(const RegistryEntry& source,
+      const RegistryEntry& destination) {
+    auto batch = MakeBatch();
+    auto& sourceRecord = LoadRecord(batch, source.m_id);
+    auto& destinationRecord = LoadRecord(batch, destination.m_id);
+    auto& parentRecord = LoadRecord(batch, sourceRecord.m_parent);
+    parentRecord.m_children.erase(std::find(parentRecord.m_children.begin(),
+      parentRecord.m_children.end(), source.m_id));
+    destinationRecord.m_children.push_back(source.m_id);
+    sourceRecord.m_parent = destination.m_id;
+    Commit(std::move(batch));
+  }
+
+  inline void LogRegistryDataStore::Delete(
+      const RegistryEntry& registryEntry) {
+    auto batch = MakeBatch();
+    auto parent = LoadRecord(registryEntry.m_id).m_parent;
+    auto& parentRecord = LoadRecord(batch, parent);
+    parentRecord.m_children.erase(std::find(parentRecord.m_children.begin(),
+      parentRecord.m_children.end(), registryEntry.m_id));
+    Delete(batch, registryEntry.m_id);
+    Commit(std::move(batch));
+  }
+
+  inline IO::SharedBuffer LogRegistryDataStore::Load(
+      const RegistryEntry& registryEntry) {
+    auto& record = LoadRecord(registryEntry.m_id);
+    if(record.m_registryEntry.m_type != RegistryEntry::Type::VALUE) {
+      BOOST_THROW_EXCEPTION(RegistryDataStoreException("Entry not found."));
+    }
+    return record.m_value;
+  }
+
+  inline RegistryEntry LogRegistryDataStore::Store(
+      const RegistryEntry& registryEntry, const IO::SharedBuffer& value) {
+    auto batch = MakeBatch();
+    auto& record = LoadRecord(batch, registryEntry.m_id);
+    if(record.m_registryEntry.m_type != RegistryEntry::Type::VALUE) {
+      BOOST_THROW_EXCEPTION(RegistryDataStoreException("Entry not found."));
+    }
+    record.m_value = value;
+    ++record.m_registryEntry.m_version;
+    auto entry = record.m_registryEntry;
+    Commit(std::move(batch));
+    return entry;
+  }
+
+  inline void LogRegistryDataStore::WithTransaction(
+      const std::function<void ()>& transaction) {
+    auto lock = boost::lock_guard(m_mutex);
+    transaction();
+  }
+
+  inline void LogRegistryDataStore::Open() {
+    if(m_openState.SetOpening()) {
+      return;
+    }
+    try {
+      std::filesystem::create_directories(m_root);
+      if(std::filesystem::exists(GetLogPath())) {
+        Replay();
+      } else {
+        Import();
+      }
+      if(m_records.find(RegistryEntry::GetRoot().m_id) == m_records.end()) {
+        auto root = Details::RegistryEntryRecord();
+        root.m_registryEntry = RegistryEntry::GetRoot();
+        root.m_parent = 0;
+        m_records.insert(std::pair(root.m_registryEntry.m_id, root));
+      }
+      Compact();
+    } catch(const std::exception&) {
+      m_openState.SetOpenFailure();
+      Shutdown();
+    }
+    m_openState.SetOpen();
+  }
+
+  inline void LogRegistryDataStore::Close() {
+    if(m_openState.SetClosing()) {
+      return;
+    }
+    Shutdown();
+  }
+
+  inline void LogRegistryDataStore::Shutdown() {
+    m_log.close();
+    m_openState.SetClosed();
+  }
+
+  inline std::filesystem::path LogRegistryDataStore::GetLogPath() const {
+    return m_root / "registry.log";
+  }
+
+  inline const Details::RegistryEntryRecord&
+      LogRegistryDataStore::LoadRecord(std::uint64_t id) const {
+    auto recordIterator = m_records.find(id);
+    if(recordIterator == m_records.end()) {
+      BOOST_THROW_EXCEPTION(RegistryDataStoreException(
+        "Unable to load entry."));
+    }
+    return recordIterator->second;
+  }
+
+  inline Details::RegistryEntryRecord& LogRegistryDataStore::LoadRecord(
+      Batch& batch, std::uint64_t id) {
+    auto recordIterator = batch.m_records.find(id);
+    if(recordIterator != batch.m_records.end()) {
+      return recordIterator->second;
+    }
+    return batch.m_records.insert(std::pair(id, LoadRecord(id))).first->second;
+  }
+
+  inline LogRegistryDataStore::Batch LogRegistryDataStore::MakeBatch() const {
+    auto batch = Batch();
+    batch.m_lastId = m_lastId;
+    return batch;
+  }
+
+  inline RegistryEntry LogRegistryDataStore::Copy(Batch& batch,
+      const Details::RegistryEntryRecord& source, std::uint64_t parent) {
+    auto record = source;
+    ++batch.m_lastId;
+    record.m_registryEntry.m_id = batch.m_lastId;
+    record.m_parent = parent;
+    record.m_children.clear();
+    LoadRecord(batch, parent).m_children.push_back(batch.m_lastId);
+    auto& copy = batch.m_records.insert(
+      std::pair(record.m_registryEntry.m_id, std::move(record))).first->second;
+    auto entry = copy.m_registryEntry;
+    for(auto child : source.m_children) {
+      Copy(batch, LoadRecord(child), entry.m_id);
+    }
+    return entry;
+  }
+
+  inline void LogRegistryDataStore::Delete(Batch& batch, std::uint64_t id) {
+    auto& record = LoadRecord(id);
+    for(auto child : record.m_children) {
+      Delete(batch, child);
+    }
+    batch.m_records.erase(id);
+    batch.m_deletions.push_back(id);
+  }
+
+  inline void LogRegistryDataStore::Commit(Batch batch) {
+    auto logBatch = Details::RegistryLogBatch();
+    logBatch.m_lastId = batch.m_lastId;
+    logBatch.m_deletions = std::move(batch.m_deletions);
+    for(auto& record : batch.m_records) {
+      logBatch.m_records.push_back(std::move(record.second));
+    }
+    auto frame = Encode(logBatch);
+    m_log.write(frame.GetData(), frame.GetSize());
+    m_log.flush();
+    if(!m_log) {
+      BOOST_THROW_EXCEPTION(RegistryDataStoreException(
+        "Unable to save entry."));
+    }
+    m_logSize += frame.GetSize();
+    Apply(std::move(logBatch));
+    if(m_logSize >= MINIMUM_COMPACTION_SIZE &&
+        m_logSize >= COMPACTION_FACTOR * m_snapshotSize) {
+      Compact();
+    }
+  }
+
+  inline void LogRegistryDataStore::Apply(Details::RegistryLogBatch batch) {
+    for(auto id : batch.m_deletions) {
+      m_records.erase(id);
+    }
+    for(auto& record : batch.m_records) {
+      auto id = record.m_registryEntry.m_id;
+      m_records[id] = std::move(record);
+    }
+    m_lastId = std::max(m_lastId, batch.m_lastId);
+  }
+
+  inline IO::SharedBuffer LogRegistryDataStore::Encode(
+      Details::RegistryLogBatch& batch) {
+    auto payload = IO::SharedBuffer();
+    auto sender = Serialization::BinarySender<IO::SharedBuffer>();
+    sender.SetSink(Ref(payload));
+    sender.Shuttle(batch);
+    auto checksum = boost::crc_32_type();
+    checksum.process_bytes(payload.GetData(), payload.GetSize());
+    auto frame = IO::SharedBuffer();
+    frame.Append(static_cast<std::uint32_t>(payload.GetSize()));
+    frame.Append(static_cast<std::uint32_t>(checksum.checksum()));
+    frame.Append(payload);
+    return frame;
+  }
+
+  inline void LogRegistryDataStore::Replay() {
+    auto log = IO::SharedBuffer();
+    {
+      auto size = std::filesystem::file_size(GetLogPath());
+      auto reader = std::ifstream(GetLogPath(), std::ios::binary);
+      log.Grow(static_cast<std::size_t>(size));
+      reader.read(log.GetMutableData(), log.GetSize());
+      if(!reader) {
+        BOOST_THROW_EXCEPTION(RegistryDataStoreException(
+          "Unable to read registry log."));
+      }
+    }
+    auto position = std::size_t(0);
+    while(log.GetSize() - position >= HEADER_SIZE) {
+      auto size = log.Extract<std::uint32_t>(position);
+      auto checksum = log.Extract<std::uint32_t>(
+        position + sizeof(std::uint32_t));
+      if(log.GetSize() - position - HEADER_SIZE < size) {
+        break;
+      }
+      auto payload = IO::SharedBuffer(log.GetData() + position + HEADER_SIZE,
+        size);
+      auto expectedChecksum = boost::crc_32_type();
+      expectedChecksum.process_bytes(payload.GetData(), payload.GetSize());
+      if(expectedChecksum.checksum() != checksum) {
+        break;
+      }
+      auto batch = Details::RegistryLogBatch();
+      try {
+        auto receiver = Serialization::BinaryReceiver<IO::SharedBuffer>();
+        receiver.SetSource(Ref(payload));
+        receiver.Shuttle(batch);
+      } catch(const std::exception&) {
+        break;
+      }
+      Apply(std::move(batch));
+      position += HEADER_SIZE + size;
+    }
+  }
+
+  inline void LogRegistryDataStore::Import() {
+    auto settingsPath = m_root / "settings.dat";
+    if(!std::filesystem::exists(settingsPath)) {
+      return;
+    }
+    auto readFile = [] (const std::filesystem::path& path) {
+      auto reader = std::ifstream(path, std::ios::binary);
+      auto buffer = IO::SharedBuffer(
+        static_cast<std::size_t>(std::filesystem::file_size(path)));
+      reader.read(buffer.GetMutableData(), buffer.GetSize());
+      if(!reader) {
+        BOOST_THROW_EXCEPTION(RegistryDataStoreException(
+          "Unable to import entry."));
+      }
+      return buffer;
+    };
+    {
+      auto buffer = readFile(settingsPath);
+      auto receiver = Serialization::BinaryReceiver<IO::SharedBuffer>();
+      receiver.SetSource(Ref(buffer));
+      receiver.Shuttle(m_lastId);
+    }
+    for(auto& file : std::filesystem::directory_iterator(m_root)) {
+      auto name = file.path().filename().string();
+      if(!file.is_regular_file() || name.empty() ||
+          !std::all_of(name.begin(), name.end(),
+            [] (auto c) { return std::isdigit(c); })) {
+        continue;
+      }
+      auto buffer = readFile(file.path());
+      auto record = Details::RegistryEntryRecord();
+      auto receiver = Serialization::BinaryReceiver<IO::SharedBuffer>();
+      receiver.SetSource(Ref(buffer));
+      receiver.Shuttle(record);
+      m_lastId = std::max(m_lastId, record.m_registryEntry.m_id);
+      auto id = record.m_registryEntry.m_id;
+      m_records[id] = std::move(record);
+    }
+  }
+
+  inline void LogRegistryDataStore::Compact() {
+    auto snapshot = Details::RegistryLogBatch();
+    snapshot.m_lastId = m_lastId;
+    for(auto& record : m_records) {
+      snapshot.m_records.push_back(record.second);
+    }
+    auto frame = Encode(snapshot);
+    auto compactedPath = m_root / "registry.log.compact";
+    {
+      auto writer = std::ofstream(compactedPath,
+        std::ios::binary | std::ios::trunc);
+      writer.write(frame.GetData(), frame.GetSize());
+      writer.flush();
+      if(!writer) {
+        BOOST_THROW_EXCEPTION(RegistryDataStoreException(
+          "Unable to compact registry log."));
+      }
+    }
+    m_log.close();
+    std::filesystem::rename(compactedPath, GetLogPath());
+    m_log.open(GetLogPath(), std::ios::binary | std::ios::app);
+    if(!m_log) {
+      BOOST_THROW_EXCEPTION(RegistryDataStoreException(
+        "Unable to open registry log."));
+    }
+    m_logSize = frame.GetSize();
+    m_snapshotSize = frame.GetSize();
+  }
+}
+}
+
+#endif
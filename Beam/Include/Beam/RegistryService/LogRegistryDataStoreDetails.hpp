@@ -0,0 +1,37 @@
+#ifndef BEAM_LOGREGISTRYDATASTOREDETAILS_HPP
+#define BEAM_LOGREGISTRYDATASTOREDETAILS_HPP
+#include <cstdint>
+#include <vector>
+#include "Beam/RegistryService/FileSystemRegistryDataStoreDetails.hpp"
+#include "Beam/Serialization/DataShuttle.hpp"
+#include "Beam/Serialization/ShuttleVector.hpp"
+
+namespace Beam {
+namespace RegistryService {
+namespace Details {
+  struct RegistryLogBatch {
+    std::vector<RegistryEntryRecord> m_records;
+    std::vector<std::uint64_t> m_deletions;
+    std::uint64_t m_lastId;
+  };
+}
+}
+}
+
+namespace Beam {
+namespace Serialization {
+  template<>
+  struct Shuttle<RegistryService::Details::RegistryLogBatch> {
+    template<typename Shuttler>
+    void operator ()(Shuttler& shuttle,
+        RegistryService::Details::RegistryLogBatch& value,
+        unsigned int version) const {
+      shuttle.Shuttle("records", value.m_records);
+      shuttle.Shuttle("deletions", value.m_deletions);
+      shuttle.Shuttle("last_id", value.m_lastId);
+    }
+  };
+}
+}
+
+#endif
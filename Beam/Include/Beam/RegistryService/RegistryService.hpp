@@ -6,6 +6,7 @@ namespace Beam::RegistryService {
   class ApplicationRegistryClient;
   class FileSystemRegistryDataStore;
   class LocalRegistryDataStore;
+  class LogRegistryDataStore;
   template<typename ServiceProtocolClientBuilderType> class RegistryClient;
   class RegistryDataStore;
   class RegistryDataStoreException;
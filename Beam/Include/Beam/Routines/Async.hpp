@@ -1,16 +1,16 @@
 #ifndef BEAM_ASYNC_HPP
 #define BEAM_ASYNC_HPP
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <optional>
 #include <type_traits>
 #include <boost/call_traits.hpp>
 #include <boost/noncopyable.hpp>
-#include <boost/thread/mutex.hpp>
 #include "Beam/Pointers/Out.hpp"
 #include "Beam/Pointers/Ref.hpp"
 #include "Beam/Routines/Routines.hpp"
-#include "Beam/Routines/SuspendedRoutineQueue.hpp"
-#include "Beam/Threading/Sync.hpp"
 #include "Beam/Utilities/StorageType.hpp"
 
 namespace Beam {
@@ -18,6 +18,11 @@ namespace Routines {
 
   /*! \class BaseAsync
       \brief Stores details common to all the Async templates.
+      \details The state of an operation is kept in a single atomic word that
+               holds either the final state or the list of Routines waiting
+               on the operation. Completing an operation that no Routine is
+               waiting on, and getting the result of a completed operation,
+               take no locks and never suspend.
    */
   class BaseAsync : private boost::noncopyable {
     public:
@@ -36,6 +41,48 @@ namespace Routines {
         //! The operation resulted in an exception.
         EXCEPTION
       };
+
+      //! Returns the state of this Async.
+      State GetState() const;
+
+      //! Suspends the current Routine until this Async is no longer pending.
+      void Wait();
+
+      //! Suspends the current Routine until a list of Asyncs are no longer
+      //! pending.
+      /*!
+        \param asyncs The Asyncs to wait for.
+        \param count The number of Asyncs to wait for.
+      */
+      static void Wait(BaseAsync* const* asyncs, std::size_t count);
+
+    protected:
+
+      //! Constructs a pending BaseAsync.
+      BaseAsync();
+
+      //! Sets the final state, resuming all waiting Routines.
+      /*!
+        \param state The final state, either COMPLETE or EXCEPTION.
+      */
+      void Complete(State state);
+
+      //! Returns this BaseAsync to the PENDING state.
+      void ResetState();
+
+    private:
+      struct Waiter {
+        Routine* m_routine;
+        Waiter* m_next;
+        std::atomic_int* m_counter;
+      };
+      static constexpr auto PENDING_STATUS = std::uintptr_t(0);
+      static constexpr auto COMPLETE_STATUS = std::uintptr_t(1);
+      static constexpr auto EXCEPTION_STATUS = std::uintptr_t(2);
+      std::atomic<std::uintptr_t> m_status;
+
+      static bool IsFinal(std::uintptr_t status);
+      bool Register(Waiter& waiter);
   };
 
   /*! \class Async
@@ -59,23 +106,36 @@ namespace Routines {
       //! Returns the exception.
       const std::exception_ptr& GetException() const;
 
-      //! Returns the state of this Async.
-      State GetState() const;
-
       //! Resets this Async so that it can be reused.
       void Reset();
 
     private:
       friend class Eval<T>;
-      mutable boost::mutex m_mutex;
-      State m_state;
-      Threading::Sync<SuspendedRoutineQueue> m_suspendedRoutines;
       std::optional<typename StorageType<T>::type> m_result;
       std::exception_ptr m_exception;
-
-      void SetState(State state);
   };
 
+  //! Suspends the current Routine until a set of Asyncs are no longer
+  //! pending, the Routine is suspended at most once regardless of the number
+  //! of Asyncs.
+  /*!
+    \param asyncs The Asyncs to wait for.
+  */
+  template<typename... A, typename = std::enable_if_t<
+    std::conjunction_v<std::is_base_of<BaseAsync, A>...>>>
+  void WaitAll(A&... asyncs);
+
+  //! Suspends the current Routine until a range of Asyncs are no longer
+  //! pending, the Routine is suspended at most once regardless of the number
+  //! of Asyncs.
+  /*!
+    \param first An iterator to the first Async to wait for.
+    \param last An iterator to one past the last Async to wait for.
+  */
+  template<typename Iterator, typename = std::enable_if_t<
+    !std::is_base_of_v<BaseAsync, Iterator>>>
+  void WaitAll(Iterator first, Iterator last);
+
   /*! \class BaseEval
       \brief Base class for the Eval template.
    */
@@ -1,13 +1,107 @@
 #ifndef BEAM_ASYNC_INL
 #define BEAM_ASYNC_INL
+#include <memory>
+#include <vector>
 #include "Beam/Routines/Async.hpp"
-#include "Beam/Routines/SuspendedRoutineQueue.hpp"
 
 namespace Beam {
 namespace Routines {
+  inline BaseAsync::BaseAsync()
+    : m_status(PENDING_STATUS) {}
+
+  inline BaseAsync::State BaseAsync::GetState() const {
+    auto status = m_status.load(std::memory_order_acquire);
+    if(status == COMPLETE_STATUS) {
+      return State::COMPLETE;
+    } else if(status == EXCEPTION_STATUS) {
+      return State::EXCEPTION;
+    }
+    return State::PENDING;
+  }
+
+  inline void BaseAsync::Wait() {
+    auto async = this;
+    Wait(&async, 1);
+  }
+
+  inline void BaseAsync::Wait(BaseAsync* const* asyncs, std::size_t count) {
+    auto remaining = std::size_t(0);
+    for(auto i = std::size_t(0); i != count; ++i) {
+      if(!IsFinal(asyncs[i]->m_status.load(std::memory_order_acquire))) {
+        ++remaining;
+      }
+    }
+    if(remaining == 0) {
+      return;
+    }
+    auto& routine = GetCurrentRoutine();
+    auto counter = std::atomic_int(static_cast<int>(count) + 1);
+    auto localWaiters = std::array<Waiter, 4>();
+    auto waiters = std::unique_ptr<Waiter[]>();
+    auto waiterList = localWaiters.data();
+    if(count > localWaiters.size()) {
+      waiters = std::make_unique<Waiter[]>(count);
+      waiterList = waiters.get();
+    }
+    routine.PendingSuspend();
+    auto completed = 1;
+    for(auto i = std::size_t(0); i != count; ++i) {
+      auto& waiter = waiterList[i];
+      waiter.m_routine = &routine;
+      waiter.m_counter = &counter;
+      if(!asyncs[i]->Register(waiter)) {
+        ++completed;
+      }
+    }
+    if(counter.fetch_sub(completed) == completed) {
+      auto resumedRoutine = &routine;
+      Routines::Resume(resumedRoutine);
+    }
+    Suspend();
+  }
+
+  inline void BaseAsync::Complete(State state) {
+    assert(state != State::PENDING);
+    auto status = m_status.exchange(state == State::COMPLETE ?
+      COMPLETE_STATUS : EXCEPTION_STATUS, std::memory_order_acq_rel);
+    assert(!IsFinal(status));
+    auto waiter = reinterpret_cast<Waiter*>(status);
+    while(waiter != nullptr) {
+      auto next = waiter->m_next;
+      auto routine = waiter->m_routine;
+      if(waiter->m_counter->fetch_sub(1) == 1) {
+        Routines::Resume(routine);
+      }
+      waiter = next;
+    }
+  }
+
+  inline void BaseAsync::ResetState() {
+    assert(IsFinal(m_status.load(std::memory_order_relaxed)));
+    m_status.store(PENDING_STATUS, std::memory_order_release);
+  }
+
+  inline bool BaseAsync::IsFinal(std::uintptr_t status) {
+    return status == COMPLETE_STATUS || status == EXCEPTION_STATUS;
+  }
+
+  inline bool BaseAsync::Register(Waiter& waiter) {
+    auto status = m_status.load(std::memory_order_acquire);
+    while(true) {
+      if(IsFinal(status)) {
+        return false;
+      }
+      waiter.m_next = reinterpret_cast<Waiter*>(status);
+      if(m_status.compare_exchange_weak(status,
+          reinterpret_cast<std::uintptr_t>(&waiter), std::memory_order_acq_rel,
+          std::memory_order_acquire)) {
+        return true;
+      }
+    }
+  }
+
   template<typename T>
-  Async<T>::Async()
-      : m_state{State::PENDING} {}
+  Async<T>::Async() = default;
 
   template<typename T>
   Eval<T> Async<T>::GetEval() {
@@ -23,38 +117,37 @@ namespace Routines {
   template<typename T>
   typename boost::call_traits<typename StorageType<T>::type>::reference
       Async<T>::Get() {
-    boost::unique_lock<boost::mutex> lock{m_mutex};
-    while(m_state == State::PENDING) {
-      Routines::Suspend(Store(m_suspendedRoutines), lock);
-    }
-    if(m_state == State::EXCEPTION) {
+    Wait();
+    if(GetState() == State::EXCEPTION) {
       std::rethrow_exception(m_exception);
     }
     return VoidReturn(*m_result);
   }
 
-  template<typename T>
-  BaseAsync::State Async<T>::GetState() const {
-    return m_state;
-  }
-
   template<typename T>
   void Async<T>::Reset() {
-    if(m_state == State::PENDING) {
+    if(GetState() == State::PENDING) {
       return;
     }
     m_exception = nullptr;
-    m_state = State::PENDING;
     m_result = std::nullopt;
+    ResetState();
   }
 
-  template<typename T>
-  void Async<T>::SetState(State state) {
-    boost::lock_guard<boost::mutex> lock{m_mutex};
-    assert(m_state == State::PENDING);
-    assert(state != State::PENDING);
-    m_state = state;
-    Routines::Resume(Store(m_suspendedRoutines));
+  template<typename... A, typename>
+  void WaitAll(A&... asyncs) {
+    auto list = std::array<BaseAsync*, sizeof...(A)>{&asyncs...};
+    BaseAsync::Wait(list.data(), list.size());
+  }
+
+  template<typename Iterator, typename>
+  void WaitAll(Iterator first, Iterator last) {
+    auto list = std::vector<BaseAsync*>();
+    for(; first != last; ++first) {
+      BaseAsync& async = *first;
+      list.push_back(&async);
+    }
+    BaseAsync::Wait(list.data(), list.size());
   }
 
   template<typename E>
@@ -94,9 +187,9 @@ namespace Routines {
     }
     auto async = m_async;
     m_async = nullptr;
-    assert(async->m_state == BaseAsync::State::PENDING);
+    assert(async->GetState() == BaseAsync::State::PENDING);
     async->m_result.emplace(std::forward<R>(result));
-    async->SetState(BaseAsync::State::COMPLETE);
+    async->Complete(BaseAsync::State::COMPLETE);
   }
 
   template<typename T>
@@ -106,9 +199,9 @@ namespace Routines {
     }
     auto async = m_async;
     m_async = nullptr;
-    assert(async->m_state == BaseAsync::State::PENDING);
+    assert(async->GetState() == BaseAsync::State::PENDING);
     async->m_result.emplace();
-    async->SetState(BaseAsync::State::COMPLETE);
+    async->Complete(BaseAsync::State::COMPLETE);
   }
 
   template<typename T>
@@ -118,9 +211,9 @@ namespace Routines {
     }
     auto async = m_async;
     m_async = nullptr;
-    assert(async->m_state == BaseAsync::State::PENDING);
+    assert(async->GetState() == BaseAsync::State::PENDING);
     async->m_exception = e;
-    async->SetState(BaseAsync::State::EXCEPTION);
+    async->Complete(BaseAsync::State::EXCEPTION);
   }
 
   template<typename T>
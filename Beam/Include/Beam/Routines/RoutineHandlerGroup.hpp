@@ -1,25 +1,57 @@
 #ifndef BEAM_ROUTINEHANDLERGROUP_HPP
 #define BEAM_ROUTINEHANDLERGROUP_HPP
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <unordered_set>
 #include <vector>
 #include <boost/noncopyable.hpp>
-#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
 #include "Beam/Routines/RoutineHandler.hpp"
 #include "Beam/Routines/Routines.hpp"
+#include "Beam/Threading/ConditionVariable.hpp"
+#include "Beam/Threading/Mutex.hpp"
 
 namespace Beam {
 namespace Routines {
 
   /*! \class RoutineHandlerGroup
       \brief Stores a collection of RoutineHandlers.
+      \details Routines spawned by the group remove themselves upon
+               completion, so a long lived group only keeps track of the
+               Routines that are still running. The number of Routines
+               running at once can be capped, in which case Spawn suspends
+               until a running Routine completes.
    */
   class RoutineHandlerGroup : private boost::noncopyable {
     public:
 
+      //! Constructs an empty RoutineHandlerGroup with no concurrency limit.
+      RoutineHandlerGroup();
+
       //! Constructs an empty RoutineHandlerGroup.
-      RoutineHandlerGroup() = default;
+      /*!
+        \param maxConcurrency The maximum number of spawned Routines allowed
+               to run at once.
+      */
+      explicit RoutineHandlerGroup(std::size_t maxConcurrency);
 
       ~RoutineHandlerGroup();
 
+      //! Returns the number of spawned Routines that are still running.
+      std::size_t GetSize() const;
+
+      //! Returns the largest number of spawned Routines that ran at once.
+      std::size_t GetPeakSize() const;
+
+      //! Returns the maximum number of spawned Routines allowed to run at once.
+      std::size_t GetMaxConcurrency() const;
+
+      //! Returns <code>true</code> iff this group has been cancelled.
+      bool IsCancelled() const;
+
       //! Adds a RoutineHandler to this group.
       /*!
         \param handler The RoutineHandler to add.
@@ -33,42 +65,139 @@ namespace Routines {
       */
       void Add(Routine::Id id);
 
-      //! Spawns a Routine and adds it to this group.
+      //! Spawns a Routine and adds it to this group, suspending until the
+      //! number of running Routines is below the concurrency limit.
+      /*!
+        \param f The callable to run in the spawned Routine.
+        \return <code>true</code> iff the Routine was spawned,
+                <code>false</code> iff this group has been cancelled.
+      */
       template<typename F>
-      void Spawn(F&& f);
+      bool Spawn(F&& f);
+
+      //! Cancels this group, no further Routines are spawned and any pending
+      //! calls to Spawn return without spawning. Running Routines can poll
+      //! IsCancelled to stop early.
+      void Cancel();
 
       //! Waits for the completion of all Routines in this group.
       void Wait();
 
     private:
-      mutable boost::mutex m_mutex;
-      std::vector<RoutineHandler> m_routines;
+      struct State {
+        mutable Threading::Mutex m_mutex;
+        Threading::ConditionVariable m_availableCondition;
+        std::size_t m_maxConcurrency;
+        std::size_t m_peakSize;
+        bool m_isCancelled;
+        std::unordered_set<Routine::Id> m_routines;
+        std::vector<RoutineHandler> m_handlers;
+
+        State(std::size_t maxConcurrency);
+      };
+      std::shared_ptr<State> m_state;
+
+      static void Remove(State& state);
   };
 
+  inline RoutineHandlerGroup::State::State(std::size_t maxConcurrency)
+    : m_maxConcurrency(std::max<std::size_t>(maxConcurrency, 1)),
+      m_peakSize(0),
+      m_isCancelled(false) {}
+
+  inline RoutineHandlerGroup::RoutineHandlerGroup()
+    : RoutineHandlerGroup(std::numeric_limits<std::size_t>::max()) {}
+
+  inline RoutineHandlerGroup::RoutineHandlerGroup(std::size_t maxConcurrency)
+    : m_state(std::make_shared<State>(maxConcurrency)) {}
+
   inline RoutineHandlerGroup::~RoutineHandlerGroup() {
     Wait();
   }
 
+  inline std::size_t RoutineHandlerGroup::GetSize() const {
+    auto lock = boost::lock_guard(m_state->m_mutex);
+    return m_state->m_routines.size();
+  }
+
+  inline std::size_t RoutineHandlerGroup::GetPeakSize() const {
+    auto lock = boost::lock_guard(m_state->m_mutex);
+    return m_state->m_peakSize;
+  }
+
+  inline std::size_t RoutineHandlerGroup::GetMaxConcurrency() const {
+    return m_state->m_maxConcurrency;
+  }
+
+  inline bool RoutineHandlerGroup::IsCancelled() const {
+    auto lock = boost::lock_guard(m_state->m_mutex);
+    return m_state->m_isCancelled;
+  }
+
   inline void RoutineHandlerGroup::Add(RoutineHandler&& handler) {
-    boost::lock_guard<boost::mutex> lock{m_mutex};
-    m_routines.push_back(std::move(handler));
+    auto lock = boost::lock_guard(m_state->m_mutex);
+    m_state->m_handlers.push_back(std::move(handler));
   }
 
   inline void RoutineHandlerGroup::Add(Routine::Id id) {
-    RoutineHandler routine{id};
+    auto routine = RoutineHandler(id);
     Add(std::move(routine));
   }
 
   template<typename F>
-  void RoutineHandlerGroup::Spawn(F&& f) {
-    Add(Routines::Spawn(std::forward<F>(f)));
+  bool RoutineHandlerGroup::Spawn(F&& f) {
+    auto lock = boost::unique_lock(m_state->m_mutex);
+    while(!m_state->m_isCancelled &&
+        m_state->m_routines.size() >= m_state->m_maxConcurrency) {
+      m_state->m_availableCondition.wait(lock);
+    }
+    if(m_state->m_isCancelled) {
+      return false;
+    }
+    auto id = Routines::Spawn(
+      [state = m_state,
+          f = std::optional<std::decay_t<F>>(std::forward<F>(f))] () mutable {
+        try {
+          (*f)();
+        } catch(...) {
+          f.reset();
+          Remove(*state);
+          throw;
+        }
+        f.reset();
+        Remove(*state);
+      });
+    m_state->m_routines.insert(id);
+    m_state->m_peakSize = std::max(m_state->m_peakSize,
+      m_state->m_routines.size());
+    return true;
+  }
+
+  inline void RoutineHandlerGroup::Remove(State& state) {
+    auto lock = boost::lock_guard(state.m_mutex);
+    state.m_routines.erase(GetCurrentRoutine().GetId());
+    state.m_availableCondition.notify_all();
+  }
+
+  inline void RoutineHandlerGroup::Cancel() {
+    auto lock = boost::lock_guard(m_state->m_mutex);
+    m_state->m_isCancelled = true;
+    m_state->m_availableCondition.notify_all();
   }
 
   inline void RoutineHandlerGroup::Wait() {
-    std::vector<RoutineHandler> routines;
+    auto routines = std::vector<Routine::Id>();
+    auto handlers = std::vector<RoutineHandler>();
     {
-      boost::lock_guard<boost::mutex> lock{m_mutex};
-      routines.swap(m_routines);
+      auto lock = boost::lock_guard(m_state->m_mutex);
+      routines.assign(m_state->m_routines.begin(), m_state->m_routines.end());
+      handlers.swap(m_state->m_handlers);
+    }
+    auto currentId = GetCurrentRoutine().GetId();
+    for(auto id : routines) {
+      if(id != currentId) {
+        Routines::Wait(id);
+      }
     }
   }
 }
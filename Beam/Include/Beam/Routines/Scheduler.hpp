@@ -12,6 +12,7 @@
 #include "Beam/Routines/FunctionRoutine.hpp"
 #include "Beam/Routines/Routines.hpp"
 #include "Beam/Threading/Sync.hpp"
+#include "Beam/Threading/ThreadAffinity.hpp"
 #include "Beam/Utilities/ReportException.hpp"
 #include "Beam/Utilities/Singleton.hpp"
 
@@ -23,6 +24,10 @@
   #endif
 #endif
 
+#ifndef BEAM_SCHEDULER_PIN_THREADS
+  #define BEAM_SCHEDULER_PIN_THREADS 0
+#endif
+
 namespace Beam {
 namespace Routines {
 namespace Details {
@@ -37,6 +42,9 @@ namespace Details {
       static constexpr std::size_t DEFAULT_STACK_SIZE =
         BEAM_SCHEDULER_DEFAULT_STACK_SIZE;
 
+      //! Whether each thread is pinned to the CPU matching its context id.
+      static constexpr bool PIN_THREADS = BEAM_SCHEDULER_PIN_THREADS;
+
       //! Constructs a Scheduler with a number of threads equal to the system's
       //! concurrency.
       Scheduler();
@@ -107,6 +115,9 @@ namespace Details {
         [=] {
           Run(m_contexts[i]);
         });
+      if(PIN_THREADS) {
+        Threading::SetThreadAffinity(m_threads[i], i);
+      }
     }
   }
 
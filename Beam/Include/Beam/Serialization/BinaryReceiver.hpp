@@ -2,15 +2,25 @@
 #define BEAM_BINARY_RECEIVER_HPP
 #include <cstdint>
 #include <cstring>
+#include <string>
 #include <type_traits>
 #include "Beam/IO/Buffer.hpp"
 #include "Beam/Serialization/DataShuttle.hpp"
 #include "Beam/Serialization/ReceiverMixin.hpp"
 #include "Beam/Serialization/SerializationException.hpp"
+#include "Beam/Serialization/ShuttleDateTime.hpp"
 #include "Beam/Utilities/FixedString.hpp"
 
 namespace Beam {
 namespace Serialization {
+namespace Details {
+
+  /* Receives a value whose binary form begins with a word that has its high
+     bit set, otherwise parses the value from its legacy text form. */
+  template<typename SourceType, typename F, typename P>
+  auto ReceiveBinaryOrText(BinaryReceiver<SourceType>& receiver,
+    F&& receiveBinary, P&& parse);
+}
 
   /** Implements a Receiver using a binary format.
       \tparam SourceType The type of Buffer to receive the data from.
@@ -46,6 +56,10 @@ namespace Serialization {
       template<std::size_t N>
       void Shuttle(const char* name, FixedString<N>& value);
 
+      void Shuttle(const char* name, boost::posix_time::ptime& value);
+
+      void Shuttle(const char* name, boost::posix_time::time_duration& value);
+
       void StartStructure(const char* name);
 
       void EndStructure();
@@ -59,6 +73,9 @@ namespace Serialization {
       using ReceiverMixin<BinaryReceiver<SourceType>>::Shuttle;
 
     private:
+      template<typename S, typename F, typename P>
+      friend auto Details::ReceiveBinaryOrText(BinaryReceiver<S>& receiver,
+        F&& receiveBinary, P&& parse);
       std::size_t m_remainingSize;
       const char* m_readIterator;
   };
@@ -130,6 +147,58 @@ namespace Serialization {
     m_remainingSize -= N;
   }
 
+  template<typename SourceType>
+  void BinaryReceiver<SourceType>::Shuttle(const char* name,
+      boost::posix_time::ptime& value) {
+    value = Details::ReceiveBinaryOrText(*this,
+      [&] (std::uint32_t head) {
+        auto low = std::uint32_t();
+        Shuttle(low);
+        return Details::TimestampFromBinaryTicks(
+          Details::DecodeBinaryTicks(head, low));
+      },
+      [] (const std::string& source) {
+        return Details::ParseTimestamp(source);
+      });
+  }
+
+  template<typename SourceType>
+  void BinaryReceiver<SourceType>::Shuttle(const char* name,
+      boost::posix_time::time_duration& value) {
+    value = Details::ReceiveBinaryOrText(*this,
+      [&] (std::uint32_t head) {
+        auto low = std::uint32_t();
+        Shuttle(low);
+        return Details::DurationFromBinaryTicks(
+          Details::DecodeBinaryTicks(head, low));
+      },
+      [] (const std::string& source) {
+        return Details::ParseTimeDuration(source);
+      });
+  }
+
+  template<typename SourceType, typename F, typename P>
+  auto Details::ReceiveBinaryOrText(BinaryReceiver<SourceType>& receiver,
+      F&& receiveBinary, P&& parse) {
+    auto head = std::uint32_t();
+    receiver.Shuttle(head);
+    if(head & 0x80000000) {
+      return receiveBinary(head);
+    }
+    if(head > receiver.m_remainingSize) {
+      BOOST_THROW_EXCEPTION(SerializationException(
+        "String length out of range."));
+    }
+    auto source = std::string(receiver.m_readIterator, head);
+    receiver.m_readIterator += head;
+    receiver.m_remainingSize -= head;
+    try {
+      return parse(source);
+    } catch(const std::exception&) {
+      BOOST_THROW_EXCEPTION(SerializationException("Invalid text value."));
+    }
+  }
+
   template<typename SourceType>
   void BinaryReceiver<SourceType>::StartStructure(const char* name) {}
 
@@ -6,11 +6,21 @@
 #include "Beam/IO/Buffer.hpp"
 #include "Beam/Serialization/DataShuttle.hpp"
 #include "Beam/Serialization/SenderMixin.hpp"
+#include "Beam/Serialization/ShuttleDateTime.hpp"
 #include "Beam/Utilities/FixedString.hpp"
 
 namespace Beam {
 namespace Serialization {
 
+  //! The BinarySender protocol version sending dates, times and decimals as
+  //! text, readable by every BinaryReceiver.
+  constexpr auto LEGACY_BINARY_PROTOCOL = 0;
+
+  //! The BinarySender protocol version sending dates, times and decimals in
+  //! their binary form, only to be used once the receiving end is known to
+  //! support it.
+  constexpr auto COMPACT_BINARY_PROTOCOL = 1;
+
   /*! \class BinarySender
       \brief Implements a Sender using a binary format.
       \tparam SinkType The type of Buffer to send the data to.
@@ -33,6 +43,16 @@ namespace Serialization {
 
       void SetSink(Ref<Sink> sink);
 
+      //! Returns the protocol version used to send values.
+      int GetProtocolVersion() const;
+
+      //! Sets the protocol version used to send values, defaults to
+      //! LEGACY_BINARY_PROTOCOL.
+      /*!
+        \param version The protocol version negotiated with the receiver.
+      */
+      void SetProtocolVersion(int version);
+
       template<typename T>
       typename std::enable_if<std::is_fundamental<T>::value>::type Send(
         const char* name, const T& value);
@@ -48,6 +68,11 @@ namespace Serialization {
       void Send(const char* name, const FixedString<N>& value,
         unsigned int version);
 
+      void Send(const char* name, const boost::posix_time::ptime& value);
+
+      void Send(const char* name,
+        const boost::posix_time::time_duration& value);
+
       void StartStructure(const char* name);
 
       void EndStructure();
@@ -64,6 +89,9 @@ namespace Serialization {
     private:
       Sink* m_sink;
       std::size_t m_size;
+      int m_protocolVersion = LEGACY_BINARY_PROTOCOL;
+
+      void SendTicks(std::int64_t ticks);
   };
 
   template<typename SinkType>
@@ -77,6 +105,16 @@ namespace Serialization {
     m_size = m_sink->GetSize();
   }
 
+  template<typename SinkType>
+  int BinarySender<SinkType>::GetProtocolVersion() const {
+    return m_protocolVersion;
+  }
+
+  template<typename SinkType>
+  void BinarySender<SinkType>::SetProtocolVersion(int version) {
+    m_protocolVersion = version;
+  }
+
   template<typename SinkType>
   template<typename T>
   typename std::enable_if<std::is_fundamental<T>::value>::type
@@ -117,6 +155,27 @@ namespace Serialization {
     m_size += N;
   }
 
+  template<typename SinkType>
+  void BinarySender<SinkType>::Send(const char* name,
+      const boost::posix_time::ptime& value) {
+    if(m_protocolVersion < COMPACT_BINARY_PROTOCOL) {
+      Serialization::Send<boost::posix_time::ptime>()(*this, name, value);
+    } else {
+      SendTicks(Details::ToBinaryTicks(value));
+    }
+  }
+
+  template<typename SinkType>
+  void BinarySender<SinkType>::Send(const char* name,
+      const boost::posix_time::time_duration& value) {
+    if(m_protocolVersion < COMPACT_BINARY_PROTOCOL) {
+      Serialization::Send<boost::posix_time::time_duration>()(*this, name,
+        value);
+    } else {
+      SendTicks(Details::ToBinaryTicks(value));
+    }
+  }
+
   template<typename SinkType>
   void BinarySender<SinkType>::StartStructure(const char* name) {}
 
@@ -135,6 +194,13 @@ namespace Serialization {
   template<typename SinkType>
   void BinarySender<SinkType>::EndSequence() {}
 
+  template<typename SinkType>
+  void BinarySender<SinkType>::SendTicks(std::int64_t ticks) {
+    auto words = Details::EncodeBinaryTicks(ticks);
+    Shuttle(words.first);
+    Shuttle(words.second);
+  }
+
   template<typename SinkType>
   struct Inverse<BinarySender<SinkType>> {
     using type = BinaryReceiver<SinkType>;
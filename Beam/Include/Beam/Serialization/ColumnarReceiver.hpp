@@ -0,0 +1,294 @@
+#ifndef BEAM_COLUMNAR_RECEIVER_HPP
+#define BEAM_COLUMNAR_RECEIVER_HPP
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include "Beam/IO/Buffer.hpp"
+#include "Beam/Serialization/DataShuttle.hpp"
+#include "Beam/Serialization/ReceiverMixin.hpp"
+#include "Beam/Serialization/SerializationException.hpp"
+#include "Beam/Serialization/ShuttleDateTime.hpp"
+#include "Beam/Utilities/FixedString.hpp"
+
+namespace Beam {
+namespace Serialization {
+namespace Details {
+  inline std::uint64_t ReadVarint(const char*& cursor, const char* end) {
+    auto value = std::uint64_t(0);
+    for(auto shift = 0; shift < 64; shift += 7) {
+      if(cursor == end) {
+        BOOST_THROW_EXCEPTION(SerializationException(
+          "Varint out of range."));
+      }
+      auto byte = static_cast<unsigned char>(*cursor);
+      ++cursor;
+      value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+      if((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    BOOST_THROW_EXCEPTION(SerializationException("Varint too long."));
+  }
+
+  inline std::int64_t ZigZagDecode(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^
+      -static_cast<std::int64_t>(value & 1);
+  }
+}
+
+  /** Implements a Receiver for data laid out by a ColumnarSender.
+      \tparam SourceType The type of Buffer to receive the data from.
+   */
+  template<typename SourceType>
+  class ColumnarReceiver : public ReceiverMixin<ColumnarReceiver<SourceType>> {
+    public:
+      static_assert(ImplementsConcept<SourceType, IO::Buffer>::value,
+        "SourceType must implement the Buffer Concept.");
+      using Source = SourceType;
+
+      //! Constructs a ColumnarReceiver.
+      ColumnarReceiver() = default;
+
+      //! Constructs a ColumnarReceiver.
+      /*!
+        \param registry The TypeRegistry used for receiving polymorphic types.
+      */
+      ColumnarReceiver(Ref<TypeRegistry<ColumnarSender<SourceType>>> registry);
+
+      //! Sets the source and reads its column layout.
+      void SetSource(Ref<const Source> source);
+
+      //! Begins receiving the next row.
+      void StartRow();
+
+      template<typename T>
+      std::enable_if_t<std::is_integral_v<T>> Shuttle(const char* name,
+        T& value);
+
+      template<typename T>
+      std::enable_if_t<std::is_floating_point_v<T>> Shuttle(const char* name,
+        T& value);
+
+      template<typename T>
+      std::enable_if_t<ImplementsConcept<T, IO::Buffer>::value> Shuttle(
+        const char* name, T& value);
+
+      void Shuttle(const char* name, std::string& value);
+
+      template<std::size_t N>
+      void Shuttle(const char* name, FixedString<N>& value);
+
+      void Shuttle(const char* name, boost::posix_time::ptime& value);
+
+      void Shuttle(const char* name, boost::posix_time::time_duration& value);
+
+      void StartStructure(const char* name);
+
+      void EndStructure();
+
+      void StartSequence(const char* name, int& size);
+
+      void StartSequence(const char* name);
+
+      void EndSequence();
+
+      using ReceiverMixin<ColumnarReceiver<SourceType>>::Shuttle;
+
+    private:
+      struct Column {
+        const char* m_readIterator;
+        const char* m_end;
+        std::uint64_t m_previous;
+      };
+      std::vector<Column> m_columns;
+      std::size_t m_column;
+      std::vector<std::string> m_dictionary;
+
+      Column& NextColumn();
+      const char* Read(Column& column, std::size_t size);
+      std::uint64_t ReceiveInteger();
+  };
+
+  template<typename SourceType>
+  ColumnarReceiver<SourceType>::ColumnarReceiver(Ref<TypeRegistry<
+      ColumnarSender<SourceType>>> registry)
+      : ReceiverMixin<ColumnarReceiver<SourceType>>(Ref(registry)) {}
+
+  template<typename SourceType>
+  void ColumnarReceiver<SourceType>::SetSource(Ref<const Source> source) {
+    auto cursor = source->GetData();
+    auto end = cursor + source->GetSize();
+    m_columns.clear();
+    m_column = 0;
+    m_dictionary.clear();
+    auto count = Details::ReadVarint(cursor, end);
+    if(count > static_cast<std::uint64_t>(end - cursor)) {
+      BOOST_THROW_EXCEPTION(SerializationException(
+        "Column count out of range."));
+    }
+    auto sizes = std::vector<std::uint64_t>();
+    sizes.reserve(static_cast<std::size_t>(count));
+    for(auto i = std::uint64_t(0); i != count; ++i) {
+      sizes.push_back(Details::ReadVarint(cursor, end));
+    }
+    for(auto size : sizes) {
+      if(size > static_cast<std::uint64_t>(end - cursor)) {
+        BOOST_THROW_EXCEPTION(SerializationException(
+          "Column length out of range."));
+      }
+      m_columns.push_back(Column{cursor, cursor + size, 0});
+      cursor += size;
+    }
+  }
+
+  template<typename SourceType>
+  void ColumnarReceiver<SourceType>::StartRow() {
+    m_column = 0;
+  }
+
+  template<typename SourceType>
+  template<typename T>
+  std::enable_if_t<std::is_integral_v<T>> ColumnarReceiver<SourceType>::
+      Shuttle(const char* name, T& value) {
+    value = static_cast<T>(ReceiveInteger());
+  }
+
+  template<typename SourceType>
+  template<typename T>
+  std::enable_if_t<std::is_floating_point_v<T>> ColumnarReceiver<SourceType>::
+      Shuttle(const char* name, T& value) {
+    auto& column = NextColumn();
+    std::memcpy(reinterpret_cast<char*>(&value), Read(column, sizeof(T)),
+      sizeof(T));
+  }
+
+  template<typename SourceType>
+  template<typename T>
+  std::enable_if_t<ImplementsConcept<T, IO::Buffer>::value>
+      ColumnarReceiver<SourceType>::Shuttle(const char* name, T& value) {
+    auto& column = NextColumn();
+    auto size = Details::ReadVarint(column.m_readIterator, column.m_end);
+    if(size > static_cast<std::uint64_t>(
+        column.m_end - column.m_readIterator)) {
+      BOOST_THROW_EXCEPTION(SerializationException(
+        "Buffer length out of range."));
+    }
+    value.Reset();
+    value.Append(Read(column, static_cast<std::size_t>(size)),
+      static_cast<std::size_t>(size));
+  }
+
+  template<typename SourceType>
+  void ColumnarReceiver<SourceType>::Shuttle(const char* name,
+      std::string& value) {
+    auto& column = NextColumn();
+    auto index = Details::ReadVarint(column.m_readIterator, column.m_end);
+    if(index != 0) {
+      if(index > m_dictionary.size()) {
+        BOOST_THROW_EXCEPTION(SerializationException(
+          "String index out of range."));
+      }
+      value = m_dictionary[static_cast<std::size_t>(index - 1)];
+      return;
+    }
+    auto size = Details::ReadVarint(column.m_readIterator, column.m_end);
+    if(size > static_cast<std::uint64_t>(
+        column.m_end - column.m_readIterator)) {
+      BOOST_THROW_EXCEPTION(SerializationException(
+        "String length out of range."));
+    }
+    value = std::string(Read(column, static_cast<std::size_t>(size)),
+      static_cast<std::size_t>(size));
+    m_dictionary.push_back(value);
+  }
+
+  template<typename SourceType>
+  template<std::size_t N>
+  void ColumnarReceiver<SourceType>::Shuttle(const char* name,
+      FixedString<N>& value) {
+    auto& column = NextColumn();
+    value = FixedString<N>(Read(column, N), N);
+  }
+
+  template<typename SourceType>
+  void ColumnarReceiver<SourceType>::Shuttle(const char* name,
+      boost::posix_time::ptime& value) {
+    value = Details::TimestampFromBinaryTicks(
+      static_cast<std::int64_t>(ReceiveInteger()));
+  }
+
+  template<typename SourceType>
+  void ColumnarReceiver<SourceType>::Shuttle(const char* name,
+      boost::posix_time::time_duration& value) {
+    value = Details::DurationFromBinaryTicks(
+      static_cast<std::int64_t>(ReceiveInteger()));
+  }
+
+  template<typename SourceType>
+  void ColumnarReceiver<SourceType>::StartStructure(const char* name) {}
+
+  template<typename SourceType>
+  void ColumnarReceiver<SourceType>::EndStructure() {}
+
+  template<typename SourceType>
+  void ColumnarReceiver<SourceType>::StartSequence(const char* name,
+      int& size) {
+    Shuttle(size);
+    if(size < 0) {
+      BOOST_THROW_EXCEPTION(SerializationException(
+        "Sequence length out of range."));
+    }
+  }
+
+  template<typename SourceType>
+  void ColumnarReceiver<SourceType>::StartSequence(const char* name) {}
+
+  template<typename SourceType>
+  void ColumnarReceiver<SourceType>::EndSequence() {}
+
+  template<typename SourceType>
+  typename ColumnarReceiver<SourceType>::Column&
+      ColumnarReceiver<SourceType>::NextColumn() {
+    if(m_column == m_columns.size()) {
+      BOOST_THROW_EXCEPTION(SerializationException(
+        "Column out of range."));
+    }
+    return m_columns[m_column++];
+  }
+
+  template<typename SourceType>
+  const char* ColumnarReceiver<SourceType>::Read(Column& column,
+      std::size_t size) {
+    if(size > static_cast<std::size_t>(column.m_end - column.m_readIterator)) {
+      BOOST_THROW_EXCEPTION(SerializationException(
+        "Data length out of range."));
+    }
+    auto data = column.m_readIterator;
+    column.m_readIterator += size;
+    return data;
+  }
+
+  template<typename SourceType>
+  std::uint64_t ColumnarReceiver<SourceType>::ReceiveInteger() {
+    auto& column = NextColumn();
+    auto delta = Details::ZigZagDecode(
+      Details::ReadVarint(column.m_readIterator, column.m_end));
+    column.m_previous += static_cast<std::uint64_t>(delta);
+    return column.m_previous;
+  }
+
+  template<typename SourceType>
+  struct Inverse<ColumnarReceiver<SourceType>> {
+    using type = ColumnarSender<SourceType>;
+  };
+}
+
+  template<typename SourceType>
+  struct ImplementsConcept<Serialization::ColumnarReceiver<SourceType>,
+    Serialization::Receiver<SourceType>> : std::true_type {};
+}
+
+#endif
@@ -0,0 +1,261 @@
+#ifndef BEAM_COLUMNAR_SENDER_HPP
+#define BEAM_COLUMNAR_SENDER_HPP
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include "Beam/IO/Buffer.hpp"
+#include "Beam/Serialization/DataShuttle.hpp"
+#include "Beam/Serialization/SenderMixin.hpp"
+#include "Beam/Serialization/ShuttleDateTime.hpp"
+#include "Beam/Utilities/FixedString.hpp"
+
+namespace Beam {
+namespace Serialization {
+namespace Details {
+  inline void AppendVarint(std::string& column, std::uint64_t value) {
+    while(value >= 0x80) {
+      column.push_back(static_cast<char>(value | 0x80));
+      value >>= 7;
+    }
+    column.push_back(static_cast<char>(value));
+  }
+
+  inline std::uint64_t ZigZagEncode(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^
+      static_cast<std::uint64_t>(value >> 63);
+  }
+}
+
+  /** Implements a Sender that lays a series of rows out column by column.
+      Every scalar a row sends occupies a column identified by its position
+      within the row, integers and timestamps are written as the varint of
+      their difference from the same column in the previous row, and strings
+      are written once and then referenced through a dictionary.
+      \tparam SinkType The type of Buffer to send the data to.
+   */
+  template<typename SinkType>
+  class ColumnarSender : public SenderMixin<ColumnarSender<SinkType>> {
+    public:
+      static_assert(ImplementsConcept<SinkType, IO::Buffer>::value,
+        "SinkType must implement the Buffer Concept.");
+      using Sink = SinkType;
+
+      //! Constructs a ColumnarSender.
+      ColumnarSender() = default;
+
+      //! Constructs a ColumnarSender.
+      /*!
+        \param registry The TypeRegistry used for sending polymorphic types.
+      */
+      ColumnarSender(Ref<TypeRegistry<ColumnarSender>> registry);
+
+      //! Sets the sink and clears all columns.
+      void SetSink(Ref<Sink> sink);
+
+      //! Begins a new row, subsequent values are compared against the
+      //! previous row's.
+      void StartRow();
+
+      //! Writes all columns to the sink.
+      void Flush();
+
+      template<typename T>
+      std::enable_if_t<std::is_integral_v<T>> Send(const char* name,
+        const T& value);
+
+      template<typename T>
+      std::enable_if_t<std::is_floating_point_v<T>> Send(const char* name,
+        const T& value);
+
+      template<typename T>
+      std::enable_if_t<ImplementsConcept<T, IO::Buffer>::value> Send(
+        const char* name, const T& value);
+
+      void Send(const char* name, const std::string& value,
+        unsigned int version);
+
+      template<std::size_t N>
+      void Send(const char* name, const FixedString<N>& value,
+        unsigned int version);
+
+      void Send(const char* name, const boost::posix_time::ptime& value);
+
+      void Send(const char* name,
+        const boost::posix_time::time_duration& value);
+
+      void StartStructure(const char* name);
+
+      void EndStructure();
+
+      void StartSequence(const char* name, const int& size);
+
+      void StartSequence(const char* name);
+
+      void EndSequence();
+
+      using SenderMixin<ColumnarSender<SinkType>>::Send;
+      using SenderMixin<ColumnarSender<SinkType>>::Shuttle;
+
+    private:
+      struct Column {
+        std::string m_data;
+        std::uint64_t m_previous;
+      };
+      Sink* m_sink;
+      std::vector<Column> m_columns;
+      std::size_t m_column;
+      std::unordered_map<std::string, std::uint64_t> m_dictionary;
+
+      Column& NextColumn();
+      void SendInteger(std::uint64_t value);
+  };
+
+  template<typename SinkType>
+  ColumnarSender<SinkType>::ColumnarSender(
+      Ref<TypeRegistry<ColumnarSender>> registry)
+      : SenderMixin<ColumnarSender<SinkType>>(Ref(registry)) {}
+
+  template<typename SinkType>
+  void ColumnarSender<SinkType>::SetSink(Ref<Sink> sink) {
+    m_sink = sink.Get();
+    m_columns.clear();
+    m_column = 0;
+    m_dictionary.clear();
+  }
+
+  template<typename SinkType>
+  void ColumnarSender<SinkType>::StartRow() {
+    m_column = 0;
+  }
+
+  template<typename SinkType>
+  void ColumnarSender<SinkType>::Flush() {
+    auto header = std::string();
+    Details::AppendVarint(header, m_columns.size());
+    for(auto& column : m_columns) {
+      Details::AppendVarint(header, column.m_data.size());
+    }
+    m_sink->Append(header.data(), header.size());
+    for(auto& column : m_columns) {
+      m_sink->Append(column.m_data.data(), column.m_data.size());
+    }
+    m_columns.clear();
+    m_column = 0;
+    m_dictionary.clear();
+  }
+
+  template<typename SinkType>
+  template<typename T>
+  std::enable_if_t<std::is_integral_v<T>> ColumnarSender<SinkType>::Send(
+      const char* name, const T& value) {
+    if constexpr(std::is_signed_v<T>) {
+      SendInteger(static_cast<std::uint64_t>(
+        static_cast<std::int64_t>(value)));
+    } else {
+      SendInteger(static_cast<std::uint64_t>(value));
+    }
+  }
+
+  template<typename SinkType>
+  template<typename T>
+  std::enable_if_t<std::is_floating_point_v<T>> ColumnarSender<SinkType>::Send(
+      const char* name, const T& value) {
+    auto& column = NextColumn();
+    column.m_data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template<typename SinkType>
+  template<typename T>
+  std::enable_if_t<ImplementsConcept<T, IO::Buffer>::value>
+      ColumnarSender<SinkType>::Send(const char* name, const T& value) {
+    auto& column = NextColumn();
+    Details::AppendVarint(column.m_data, value.GetSize());
+    column.m_data.append(value.GetData(), value.GetSize());
+  }
+
+  template<typename SinkType>
+  void ColumnarSender<SinkType>::Send(const char* name,
+      const std::string& value, unsigned int version) {
+    auto& column = NextColumn();
+    auto entry = m_dictionary.find(value);
+    if(entry != m_dictionary.end()) {
+      Details::AppendVarint(column.m_data, entry->second);
+      return;
+    }
+    m_dictionary.insert(std::make_pair(value, m_dictionary.size() + 1));
+    Details::AppendVarint(column.m_data, 0);
+    Details::AppendVarint(column.m_data, value.size());
+    column.m_data.append(value);
+  }
+
+  template<typename SinkType>
+  template<std::size_t N>
+  void ColumnarSender<SinkType>::Send(const char* name,
+      const FixedString<N>& value, unsigned int version) {
+    auto& column = NextColumn();
+    column.m_data.append(value.GetData(), N);
+  }
+
+  template<typename SinkType>
+  void ColumnarSender<SinkType>::Send(const char* name,
+      const boost::posix_time::ptime& value) {
+    SendInteger(static_cast<std::uint64_t>(Details::ToBinaryTicks(value)));
+  }
+
+  template<typename SinkType>
+  void ColumnarSender<SinkType>::Send(const char* name,
+      const boost::posix_time::time_duration& value) {
+    SendInteger(static_cast<std::uint64_t>(Details::ToBinaryTicks(value)));
+  }
+
+  template<typename SinkType>
+  void ColumnarSender<SinkType>::StartStructure(const char* name) {}
+
+  template<typename SinkType>
+  void ColumnarSender<SinkType>::EndStructure() {}
+
+  template<typename SinkType>
+  void ColumnarSender<SinkType>::StartSequence(const char* name,
+      const int& size) {
+    Shuttle(size);
+  }
+
+  template<typename SinkType>
+  void ColumnarSender<SinkType>::StartSequence(const char* name) {}
+
+  template<typename SinkType>
+  void ColumnarSender<SinkType>::EndSequence() {}
+
+  template<typename SinkType>
+  typename ColumnarSender<SinkType>::Column&
+      ColumnarSender<SinkType>::NextColumn() {
+    if(m_column == m_columns.size()) {
+      m_columns.push_back(Column{std::string(), 0});
+    }
+    return m_columns[m_column++];
+  }
+
+  template<typename SinkType>
+  void ColumnarSender<SinkType>::SendInteger(std::uint64_t value) {
+    auto& column = NextColumn();
+    Details::AppendVarint(column.m_data, Details::ZigZagEncode(
+      static_cast<std::int64_t>(value - column.m_previous)));
+    column.m_previous = value;
+  }
+
+  template<typename SinkType>
+  struct Inverse<ColumnarSender<SinkType>> {
+    using type = ColumnarReceiver<SinkType>;
+  };
+}
+
+  template<typename SinkType>
+  struct ImplementsConcept<Serialization::ColumnarSender<SinkType>,
+    Serialization::Sender<SinkType>> : std::true_type {};
+}
+
+#endif
@@ -157,6 +157,20 @@ namespace Serialization {
   template<typename T>
   struct IsSequence : std::false_type {};
 
+  /*! \class IsBinaryShuttler
+      \brief Type trait for whether a DataShuttle uses the binary wire format,
+             which carries sequence lengths and raw words verbatim.
+      \tparam T The type of DataShuttle to check.
+   */
+  template<typename T>
+  struct IsBinaryShuttler : std::false_type {};
+
+  template<typename SinkType>
+  struct IsBinaryShuttler<BinarySender<SinkType>> : std::true_type {};
+
+  template<typename SourceType>
+  struct IsBinaryShuttler<BinaryReceiver<SourceType>> : std::true_type {};
+
   /*! \class Shuttle
       \brief Contains operations for shuttling a type.
       \tparam T The type being specialized.
@@ -2,10 +2,12 @@
 #define BEAM_JSONRECEIVER_HPP
 #include <cstdint>
 #include <cstring>
-#include <deque>
+#include <limits>
+#include <string>
 #include <type_traits>
+#include <vector>
 #include "Beam/IO/Buffer.hpp"
-#include "Beam/Json/JsonParser.hpp"
+#include "Beam/Json/JsonPullParser.hpp"
 #include "Beam/Serialization/DataShuttle.hpp"
 #include "Beam/Serialization/ReceiverMixin.hpp"
 #include "Beam/Serialization/SerializationException.hpp"
@@ -15,7 +17,8 @@ namespace Beam {
 namespace Serialization {
 
   /*! \class JsonReceiver
-      \brief Implements a Receiver using the JSON format.
+      \brief Implements a Receiver using the JSON format, values are read
+             directly out of the source as they are shuttled.
       \tparam SourceType The type of Buffer to receive the data from.
    */
   template<typename SourceType>
@@ -74,18 +77,19 @@ namespace Serialization {
       using ReceiverMixin<JsonReceiver<SourceType>>::Shuttle;
 
     private:
-      struct Sequence {
-        std::vector<JsonValue> m_list;
-        std::size_t m_index;
+      struct Aggregate {
+        bool m_isObject;
+        const char* m_begin;
+        const char* m_end;
+        bool m_isFirst;
       };
-      boost::optional<Parsers::ReaderParserStream<IO::BufferReader<Source>>>
-        m_parserStream;
-      JsonParser m_parser;
-      using AggregateType = boost::variant<JsonObject, Sequence>;
-      std::deque<AggregateType> m_aggregateQueue;
-
-      const JsonValue& ExtractValue(const char* name,
-        boost::optional<JsonValue>& storage);
+      JsonPullParser m_parser;
+      std::vector<Aggregate> m_aggregates;
+
+      bool SeekValue(const char* name);
+      void ExtractValue(const char* name);
+      bool SeekMember(const char* name, Aggregate& aggregate,
+        const char* stop);
   };
 
   template<typename SourceType>
@@ -95,19 +99,14 @@ namespace Serialization {
 
   template<typename SourceType>
   void JsonReceiver<SourceType>::SetSource(Ref<const Source> source) {
-    m_aggregateQueue.clear();
-    m_parserStream.emplace(*source);
+    m_aggregates.clear();
+    m_parser.Reset(source->GetData(), source->GetData() + source->GetSize());
   }
 
   template<typename SourceType>
   void JsonReceiver<SourceType>::Shuttle(const char* name, bool& value) {
-    boost::optional<JsonValue> storage;
-    auto& jsonValue = ExtractValue(name, storage);
-    try {
-      value = boost::get<bool>(jsonValue);
-    } catch(const boost::bad_get&) {
-      BOOST_THROW_EXCEPTION(SerializationException{"JSON type mismatch."});
-    }
+    ExtractValue(name);
+    value = m_parser.ReadBool();
   }
 
   template<typename SourceType>
@@ -135,17 +134,17 @@ namespace Serialization {
 
   template<typename SourceType>
   void JsonReceiver<SourceType>::Shuttle(const char* name, char& value) {
-    boost::optional<JsonValue> storage;
-    auto& jsonValue = ExtractValue(name, storage);
-    if(auto s = boost::get<std::string>(&jsonValue)) {
-      if(s->size() != 1) {
+    ExtractValue(name);
+    if(m_parser.Peek() == '\"') {
+      auto s = std::string();
+      m_parser.ReadString(s);
+      if(s.size() != 1) {
         BOOST_THROW_EXCEPTION(SerializationException{"Length out of range."});
       }
-      value = s->front();
-    } else if(boost::get<double>(&jsonValue)) {
-      value = '\0';
+      value = s.front();
     } else {
-      BOOST_THROW_EXCEPTION(SerializationException{"JSON type mismatch."});
+      m_parser.template ReadFloatingPoint<double>();
+      value = '\0';
     }
   }
 
@@ -153,88 +152,94 @@ namespace Serialization {
   template<typename T>
   typename std::enable_if<std::is_integral<T>::value>::type
       JsonReceiver<SourceType>::Shuttle(const char* name, T& value) {
-    double rawValue;
-    Shuttle(name, rawValue);
-    value = static_cast<T>(rawValue);
+    if(!SeekValue(name)) {
+      if(std::strcmp(name, "__version") != 0) {
+        BOOST_THROW_EXCEPTION(SerializationException{
+          "JSON member not found."});
+      }
+      value = 0;
+      return;
+    }
+    value = m_parser.template ReadIntegral<T>();
   }
 
   template<typename SourceType>
   template<typename T>
   typename std::enable_if<std::is_floating_point<T>::value>::type
       JsonReceiver<SourceType>::Shuttle(const char* name, T& value) {
-    boost::optional<JsonValue> storage;
-    auto& jsonValue = ExtractValue(name, storage);
-    if(auto s = boost::get<double>(&jsonValue)) {
-      value = static_cast<T>(*s);
-    } else {
-      BOOST_THROW_EXCEPTION(SerializationException{"JSON type mismatch."});
-    }
+    ExtractValue(name);
+    value = m_parser.template ReadFloatingPoint<T>();
   }
 
   template<typename SourceType>
   template<typename T>
   typename std::enable_if<ImplementsConcept<T, IO::Buffer>::value>::type
-      JsonReceiver<SourceType>::Shuttle(const char* name, T& value) {}
+      JsonReceiver<SourceType>::Shuttle(const char* name, T& value) {
+    auto encoding = std::string();
+    Shuttle(name, encoding);
+    IO::Base64Decode(encoding, Store(value));
+  }
 
   template<typename SourceType>
   void JsonReceiver<SourceType>::Shuttle(const char* name, std::string& value) {
-    boost::optional<JsonValue> storage;
-    auto& jsonValue = ExtractValue(name, storage);
-    if(auto s = boost::get<std::string>(&jsonValue)) {
-      value = std::move(*s);
-    } else {
-      BOOST_THROW_EXCEPTION(SerializationException{"JSON type mismatch."});
-    }
+    ExtractValue(name);
+    m_parser.ReadString(value);
   }
 
   template<typename SourceType>
   template<std::size_t N>
   void JsonReceiver<SourceType>::Shuttle(const char* name,
       FixedString<N>& value) {
-    boost::optional<JsonValue> storage;
-    auto& jsonValue = ExtractValue(name, storage);
-    if(auto s = boost::get<std::string>(&jsonValue)) {
-      if(s->size() > N) {
-        BOOST_THROW_EXCEPTION(SerializationException{"Length out of range."});
-      }
-      value = std::move(*s);
-    } else {
-      BOOST_THROW_EXCEPTION(SerializationException{"JSON type mismatch."});
+    auto s = std::string();
+    Shuttle(name, s);
+    if(s.size() > N) {
+      BOOST_THROW_EXCEPTION(SerializationException{"Length out of range."});
     }
+    value = s;
   }
 
   template<typename SourceType>
   void JsonReceiver<SourceType>::StartStructure(const char* name) {
-    boost::optional<JsonValue> storage;
-    auto& jsonValue = ExtractValue(name, storage);
-    if(auto s = boost::get<JsonObject>(&jsonValue)) {
-      if(!s->Get("__version").is_initialized()) {
-        const_cast<JsonObject&>(*s).Set("__version", 0.0);
-      }
-      m_aggregateQueue.push_back(*s);
-    } else {
-      BOOST_THROW_EXCEPTION(SerializationException{"JSON type mismatch."});
-    }
+    ExtractValue(name);
+    m_parser.Expect('{');
+    m_aggregates.push_back(
+      Aggregate{true, m_parser.GetPosition(), nullptr, true});
   }
 
   template<typename SourceType>
   void JsonReceiver<SourceType>::EndStructure() {
-    m_aggregateQueue.pop_back();
+    auto& aggregate = m_aggregates.back();
+    if(aggregate.m_end == nullptr) {
+      while(m_parser.Peek() != '}') {
+        m_parser.Match(',');
+        m_parser.ReadKey("");
+        m_parser.SkipValue();
+      }
+    } else {
+      m_parser.SetPosition(aggregate.m_end);
+    }
+    m_parser.Expect('}');
+    m_aggregates.pop_back();
   }
 
   template<typename SourceType>
   void JsonReceiver<SourceType>::StartSequence(const char* name, int& size) {
-    boost::optional<JsonValue> storage;
-    auto& jsonValue = ExtractValue(name, storage);
-    if(auto s = boost::get<std::vector<JsonValue>>(&jsonValue)) {
-      Sequence sequence;
-      sequence.m_list = std::move(*s);
-      sequence.m_index = 0;
-      size = static_cast<int>(sequence.m_list.size());
-      m_aggregateQueue.push_back(std::move(sequence));
-    } else {
-      BOOST_THROW_EXCEPTION(SerializationException{"JSON type mismatch."});
+    ExtractValue(name);
+    m_parser.Expect('[');
+    auto begin = m_parser.GetPosition();
+    size = 0;
+    if(m_parser.Peek() != ']') {
+      do {
+        m_parser.SkipValue();
+        ++size;
+      } while(m_parser.Match(','));
+    }
+    if(m_parser.Peek() != ']') {
+      BOOST_THROW_EXCEPTION(SerializationException{"Invalid JSON format."});
     }
+    m_aggregates.push_back(
+      Aggregate{false, begin, m_parser.GetPosition(), true});
+    m_parser.SetPosition(begin);
   }
 
   template<typename SourceType>
@@ -245,35 +250,79 @@ namespace Serialization {
 
   template<typename SourceType>
   void JsonReceiver<SourceType>::EndSequence() {
-    m_aggregateQueue.pop_back();
+    m_parser.SetPosition(m_aggregates.back().m_end);
+    m_parser.Expect(']');
+    m_aggregates.pop_back();
   }
 
   template<typename SourceType>
-  const JsonValue& JsonReceiver<SourceType>::ExtractValue(const char* name,
-      boost::optional<JsonValue>& storage) {
-    if(m_aggregateQueue.empty()) {
-      storage.emplace();
-      if(!m_parser.Read(*m_parserStream, *storage)) {
+  bool JsonReceiver<SourceType>::SeekValue(const char* name) {
+    if(m_aggregates.empty()) {
+      m_parser.Match(',');
+      if(m_parser.Peek() == '\0') {
         BOOST_THROW_EXCEPTION(SerializationException{"Invalid JSON format."});
       }
-      return *storage;
-    } else if(auto aggregate =
-        boost::get<JsonObject>(&m_aggregateQueue.back()))  {
-      if(name != nullptr) {
-        return aggregate->At(name);
-      } else {
+      return true;
+    }
+    auto& aggregate = m_aggregates.back();
+    if(aggregate.m_isObject) {
+      if(name == nullptr) {
         BOOST_THROW_EXCEPTION(SerializationException{"Invalid JSON format."});
       }
-    } else if(auto aggregate = boost::get<Sequence>(&m_aggregateQueue.back())) {
-      if(aggregate->m_index >= aggregate->m_list.size()) {
-        BOOST_THROW_EXCEPTION(
-          SerializationException{"JSON sequence out of range."});
+      auto position = m_parser.GetPosition();
+      auto isFirst = aggregate.m_isFirst;
+      if(SeekMember(name, aggregate, nullptr)) {
+        return true;
+      }
+      if(position != aggregate.m_begin) {
+        m_parser.SetPosition(aggregate.m_begin);
+        aggregate.m_isFirst = true;
+        if(SeekMember(name, aggregate, position)) {
+          return true;
+        }
+      }
+      m_parser.SetPosition(position);
+      aggregate.m_isFirst = isFirst;
+      return false;
+    }
+    if(m_parser.Peek() == ']') {
+      BOOST_THROW_EXCEPTION(
+        SerializationException{"JSON sequence out of range."});
+    }
+    if(!aggregate.m_isFirst) {
+      m_parser.Expect(',');
+    }
+    aggregate.m_isFirst = false;
+    return true;
+  }
+
+  template<typename SourceType>
+  void JsonReceiver<SourceType>::ExtractValue(const char* name) {
+    if(!SeekValue(name)) {
+      BOOST_THROW_EXCEPTION(SerializationException{"JSON member not found."});
+    }
+  }
+
+  template<typename SourceType>
+  bool JsonReceiver<SourceType>::SeekMember(const char* name,
+      Aggregate& aggregate, const char* stop) {
+    while(true) {
+      if(m_parser.Peek() == '}') {
+        aggregate.m_end = m_parser.GetPosition();
+        return false;
+      }
+      if(stop != nullptr && m_parser.GetPosition() >= stop) {
+        return false;
+      }
+      if(!aggregate.m_isFirst) {
+        m_parser.Expect(',');
+      }
+      aggregate.m_isFirst = false;
+      if(m_parser.ReadKey(name)) {
+        return true;
       }
-      auto& value = aggregate->m_list[aggregate->m_index];
-      ++aggregate->m_index;
-      return value;
+      m_parser.SkipValue();
     }
-    BOOST_THROW_EXCEPTION(SerializationException{"Invalid JSON format."});
   }
 
   template<typename SourceType>
@@ -1,37 +1,47 @@
 #ifndef BEAM_JSONSENDER_HPP
 #define BEAM_JSONSENDER_HPP
+#include <charconv>
 #include <cstring>
 #include <type_traits>
 #include "Beam/IO/SharedBuffer.hpp"
 #include "Beam/Serialization/DataShuttle.hpp"
 #include "Beam/Serialization/SenderMixin.hpp"
-#include "Beam/Utilities/ToString.hpp"
 
 namespace Beam {
 namespace Serialization {
 namespace Details {
-  inline std::string JsonEscape(const std::string& source) {
-    std::string result;
-    for(auto c : source) {
+  template<typename Sink>
+  void AppendJsonEscaped(Sink& sink, const char* source, std::size_t size) {
+    static const char HEX[] = "0123456789abcdef";
+    auto run = source;
+    auto last = source + size;
+    for(auto i = source; i != last; ++i) {
+      auto c = static_cast<unsigned char>(*i);
+      if(c >= 0x20 && c != '\"' && c != '\\') {
+        continue;
+      }
+      sink.Append(run, static_cast<std::size_t>(i - run));
+      run = i + 1;
       if(c == '\\') {
-        result += "\\\\";
+        sink.Append("\\\\", 2);
+      } else if(c == '\"') {
+        sink.Append("\\\"", 2);
       } else if(c == '\n') {
-        result += "\\n";
+        sink.Append("\\n", 2);
       } else if(c == '\r') {
-        result += "\\r";
-      } else if(c == '\"') {
-        result += "\\\"";
+        sink.Append("\\r", 2);
       } else if(c == '\b') {
-        result += "\\b";
+        sink.Append("\\b", 2);
       } else if(c == '\f') {
-        result += "\\f";
+        sink.Append("\\f", 2);
       } else if(c == '\t') {
-        result += "\\t";
+        sink.Append("\\t", 2);
       } else {
-        result += c;
+        char escape[] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF]};
+        sink.Append(escape, sizeof(escape));
       }
     }
-    return result;
+    sink.Append(run, static_cast<std::size_t>(last - run));
   }
 }
 
@@ -94,6 +104,8 @@ namespace Details {
     private:
       Sink* m_sink;
       bool m_appendComma;
+
+      void AppendName(const char* name);
   };
 
   /** Converts an object to its JSON representation. */
@@ -138,18 +150,9 @@ namespace Details {
       Send(name, static_cast<int>(value));
       return;
     }
-    if(m_appendComma) {
-      m_sink->Append(',');
-    }
-    if(name != nullptr) {
-      m_sink->Append('\"');
-      m_sink->Append(name, std::strlen(name));
-      m_sink->Append('\"');
-      m_sink->Append(':');
-    }
-    auto v = ToString(value);
+    AppendName(name);
     m_sink->Append('\"');
-    m_sink->Append(v.c_str(), v.size());
+    Details::AppendJsonEscaped(*m_sink, &value, 1);
     m_sink->Append('\"');
     m_appendComma = true;
   }
@@ -158,17 +161,18 @@ namespace Details {
   template<typename T>
   typename std::enable_if<std::is_fundamental<T>::value>::type
       JsonSender<SinkType>::Send(const char* name, const T& value) {
-    if(m_appendComma) {
-      m_sink->Append(',');
-    }
-    if(name != nullptr) {
-      m_sink->Append('\"');
-      m_sink->Append(name, std::strlen(name));
-      m_sink->Append('\"');
-      m_sink->Append(':');
+    AppendName(name);
+    if constexpr(std::is_same_v<T, bool>) {
+      if(value) {
+        m_sink->Append("true", 4);
+      } else {
+        m_sink->Append("false", 5);
+      }
+    } else {
+      char buffer[32];
+      auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+      m_sink->Append(buffer, static_cast<std::size_t>(result.ptr - buffer));
     }
-    auto v = ToString(value);
-    m_sink->Append(v.c_str(), v.size());
     m_appendComma = true;
   }
 
@@ -183,18 +187,9 @@ namespace Details {
   template<typename SinkType>
   void JsonSender<SinkType>::Send(const char* name, const std::string& value,
       unsigned int version) {
-    if(m_appendComma) {
-      m_sink->Append(',');
-    }
-    if(name != nullptr) {
-      m_sink->Append('\"');
-      m_sink->Append(name, std::strlen(name));
-      m_sink->Append('\"');
-      m_sink->Append(':');
-    }
+    AppendName(name);
     m_sink->Append('\"');
-    auto escapedValue = Details::JsonEscape(value);
-    m_sink->Append(escapedValue.c_str(), escapedValue.size());
+    Details::AppendJsonEscaped(*m_sink, value.c_str(), value.size());
     m_sink->Append('\"');
     m_appendComma = true;
   }
@@ -203,20 +198,17 @@ namespace Details {
   template<std::size_t N>
   void JsonSender<SinkType>::Send(const char* name, const FixedString<N>& value,
       unsigned int version) {
-    Send(name, std::string{value.GetData()});
+    AppendName(name);
+    m_sink->Append('\"');
+    Details::AppendJsonEscaped(*m_sink, value.GetData(),
+      std::strlen(value.GetData()));
+    m_sink->Append('\"');
+    m_appendComma = true;
   }
 
   template<typename SinkType>
   void JsonSender<SinkType>::StartStructure(const char* name) {
-    if(m_appendComma) {
-      m_sink->Append(',');
-    }
-    if(name != nullptr) {
-      m_sink->Append('\"');
-      m_sink->Append(name, std::strlen(name));
-      m_sink->Append('\"');
-      m_sink->Append(':');
-    }
+    AppendName(name);
     m_sink->Append('{');
     m_appendComma = false;
   }
@@ -234,6 +226,19 @@ namespace Details {
 
   template<typename SinkType>
   void JsonSender<SinkType>::StartSequence(const char* name) {
+    AppendName(name);
+    m_sink->Append('[');
+    m_appendComma = false;
+  }
+
+  template<typename SinkType>
+  void JsonSender<SinkType>::EndSequence() {
+    m_sink->Append(']');
+    m_appendComma = true;
+  }
+
+  template<typename SinkType>
+  void JsonSender<SinkType>::AppendName(const char* name) {
     if(m_appendComma) {
       m_sink->Append(',');
     }
@@ -243,14 +248,6 @@ namespace Details {
       m_sink->Append('\"');
       m_sink->Append(':');
     }
-    m_sink->Append('[');
-    m_appendComma = false;
-  }
-
-  template<typename SinkType>
-  void JsonSender<SinkType>::EndSequence() {
-    m_sink->Append(']');
-    m_appendComma = true;
   }
 
   template<typename SinkType>
@@ -5,6 +5,8 @@ namespace Beam {
 namespace Serialization {
   template<typename SourceType> class BinaryReceiver;
   template<typename SinkType> class BinarySender;
+  template<typename SourceType> class ColumnarReceiver;
+  template<typename SinkType> class ColumnarSender;
   struct DataShuttle;
   template<typename T> struct Inverse;
   template<typename T, typename Enabled = void> struct IsReceiver;
@@ -1,5 +1,8 @@
 #ifndef BEAM_SHUTTLEDATETIME_HPP
 #define BEAM_SHUTTLEDATETIME_HPP
+#include <cstdint>
+#include <string>
+#include <utility>
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include "Beam/Serialization/Receiver.hpp"
@@ -7,6 +10,112 @@
 
 namespace Beam {
 namespace Serialization {
+namespace Details {
+  /* Marks the first word of a binary date/time, text is prefixed by its
+     length which never has this bit set. */
+  constexpr auto BINARY_DATE_TIME_MARKER = std::uint32_t(0x80000000);
+
+  constexpr auto BINARY_POS_INFIN = (std::int64_t(1) << 62) - 1;
+
+  constexpr auto BINARY_NOT_A_DATE_TIME = BINARY_POS_INFIN - 1;
+
+  constexpr auto BINARY_NEG_INFIN = -(std::int64_t(1) << 62);
+
+  inline const boost::posix_time::ptime& GetBinaryEpoch() {
+    static const auto EPOCH = boost::posix_time::ptime(
+      boost::gregorian::date(1970, boost::gregorian::Jan, 1));
+    return EPOCH;
+  }
+
+  inline std::int64_t ToBinaryTicks(boost::posix_time::time_duration value) {
+    if(value.is_pos_infinity()) {
+      return BINARY_POS_INFIN;
+    } else if(value.is_neg_infinity()) {
+      return BINARY_NEG_INFIN;
+    } else if(value.is_not_a_date_time()) {
+      return BINARY_NOT_A_DATE_TIME;
+    }
+    return value.total_microseconds();
+  }
+
+  inline std::int64_t ToBinaryTicks(boost::posix_time::ptime value) {
+    if(value.is_pos_infinity()) {
+      return BINARY_POS_INFIN;
+    } else if(value.is_neg_infinity()) {
+      return BINARY_NEG_INFIN;
+    } else if(value.is_not_a_date_time()) {
+      return BINARY_NOT_A_DATE_TIME;
+    }
+    return ToBinaryTicks(value - GetBinaryEpoch());
+  }
+
+  inline boost::posix_time::time_duration DurationFromBinaryTicks(
+      std::int64_t ticks) {
+    if(ticks == BINARY_POS_INFIN) {
+      return boost::posix_time::pos_infin;
+    } else if(ticks == BINARY_NEG_INFIN) {
+      return boost::posix_time::neg_infin;
+    } else if(ticks == BINARY_NOT_A_DATE_TIME) {
+      return boost::posix_time::not_a_date_time;
+    }
+    return boost::posix_time::microseconds(ticks);
+  }
+
+  inline boost::posix_time::ptime TimestampFromBinaryTicks(
+      std::int64_t ticks) {
+    if(ticks == BINARY_POS_INFIN) {
+      return boost::posix_time::pos_infin;
+    } else if(ticks == BINARY_NEG_INFIN) {
+      return boost::posix_time::neg_infin;
+    } else if(ticks == BINARY_NOT_A_DATE_TIME) {
+      return boost::posix_time::not_a_date_time;
+    }
+    return GetBinaryEpoch() + boost::posix_time::microseconds(ticks);
+  }
+
+  /* Splits microseconds into the two words sent by a binary Sender, the
+     first word carries the marker followed by the upper 31 of 63 bits. */
+  inline std::pair<std::uint32_t, std::uint32_t> EncodeBinaryTicks(
+      std::int64_t ticks) {
+    auto encoded = static_cast<std::uint64_t>(ticks) &
+      ((std::uint64_t(1) << 63) - 1);
+    return std::pair(BINARY_DATE_TIME_MARKER |
+      static_cast<std::uint32_t>(encoded >> 32),
+      static_cast<std::uint32_t>(encoded));
+  }
+
+  inline std::int64_t DecodeBinaryTicks(std::uint32_t high,
+      std::uint32_t low) {
+    auto encoded = (static_cast<std::uint64_t>(
+      high & ~BINARY_DATE_TIME_MARKER) << 32) | low;
+    if(encoded & (std::uint64_t(1) << 62)) {
+      encoded |= std::uint64_t(1) << 63;
+    }
+    return static_cast<std::int64_t>(encoded);
+  }
+
+  inline boost::posix_time::time_duration ParseTimeDuration(
+      const std::string& source) {
+    if(source == "+infinity") {
+      return boost::posix_time::pos_infin;
+    } else if(source == "-infinity") {
+      return boost::posix_time::neg_infin;
+    }
+    return boost::posix_time::duration_from_string(source);
+  }
+
+  inline boost::posix_time::ptime ParseTimestamp(const std::string& source) {
+    if(source == "+infinity") {
+      return boost::posix_time::pos_infin;
+    } else if(source == "-infinity") {
+      return boost::posix_time::neg_infin;
+    } else if(source == "not-a-date-time") {
+      return boost::posix_time::ptime();
+    }
+    return boost::posix_time::from_iso_string(source);
+  }
+}
+
   template<>
   struct IsStructure<boost::posix_time::time_duration> : std::false_type {};
 
@@ -26,13 +135,7 @@ namespace Serialization {
         boost::posix_time::time_duration& value) const {
       std::string timeAsString;
       shuttle.Shuttle(name, timeAsString);
-      if(timeAsString == "+infinity") {
-        value = boost::posix_time::pos_infin;
-      } else if(timeAsString == "-infinity") {
-        value = boost::posix_time::neg_infin;
-      } else {
-        value = boost::posix_time::duration_from_string(timeAsString);
-      }
+      value = Details::ParseTimeDuration(timeAsString);
     }
   };
 
@@ -55,15 +158,7 @@ namespace Serialization {
         boost::posix_time::ptime& value) const {
       std::string timeAsString;
       shuttle.Shuttle(name, timeAsString);
-      if(timeAsString == "+infinity") {
-        value = boost::posix_time::pos_infin;
-      } else if(timeAsString == "-infinity") {
-        value = boost::posix_time::neg_infin;
-      } else if(timeAsString == "not-a-date-time") {
-        value = boost::posix_time::ptime();
-      } else {
-        value = boost::posix_time::from_iso_string(timeAsString);
-      }
+      value = Details::ParseTimestamp(timeAsString);
     }
   };
 
@@ -1,11 +1,221 @@
 #ifndef BEAM_SHUTTLEDECIMAL_HPP
 #define BEAM_SHUTTLEDECIMAL_HPP
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
 #include <boost/multiprecision/cpp_dec_float.hpp>
+#include "Beam/Serialization/BinaryReceiver.hpp"
+#include "Beam/Serialization/BinarySender.hpp"
 #include "Beam/Serialization/Receiver.hpp"
 #include "Beam/Serialization/Sender.hpp"
+#include "Beam/Serialization/SerializationException.hpp"
 
 namespace Beam {
 namespace Serialization {
+namespace Details {
+
+  /* The binary form of a decimal, sent under COMPACT_BINARY_PROTOCOL, is a
+     header word, a signed 32-bit exponent E and a sequence of digit groups:
+       header: bit 31 is set to distinguish it from the length of a decimal
+               sent as text, bit 30 is the sign, bits 28-29 are the class
+               (finite, infinite or NaN) and bits 0-27 count the digit groups.
+       groups: unsigned 32-bit words g0...gn each less than 10^8, g0 is
+               non-zero and trailing zero groups are omitted.
+     A finite value is the sum of gi * 10^(E - 8i), E is a multiple of eight
+     and zero is sent without any groups. */
+  constexpr auto BINARY_DECIMAL_MARKER = std::uint32_t(0x80000000);
+
+  constexpr auto BINARY_DECIMAL_NEGATIVE = std::uint32_t(0x40000000);
+
+  constexpr auto BINARY_DECIMAL_CLASS_SHIFT = 28;
+
+  constexpr auto BINARY_DECIMAL_CLASS_MASK = std::uint32_t(0x3);
+
+  constexpr auto BINARY_DECIMAL_COUNT_MASK = std::uint32_t(0x0FFFFFFF);
+
+  constexpr auto BINARY_DECIMAL_FINITE = std::uint32_t(0);
+
+  constexpr auto BINARY_DECIMAL_INFINITE = std::uint32_t(1);
+
+  constexpr auto BINARY_DECIMAL_NAN = std::uint32_t(2);
+
+  constexpr auto BINARY_DECIMAL_GROUP_DIGITS = 8;
+
+  constexpr auto BINARY_DECIMAL_GROUP_LIMIT = std::uint32_t(100000000);
+
+  /* The digit groups and exponent of a cpp_dec_float, which stores its value
+     in the same base 10^8 form as the wire layout. The backend only exposes
+     them through its serialize method, whose field names are part of
+     Boost's archive format. */
+  template<typename Decimal>
+  struct DecimalParts {
+    static constexpr auto GROUP_COUNT =
+      Decimal::backend_type::cpp_dec_float_total_digits10 /
+      BINARY_DECIMAL_GROUP_DIGITS;
+    std::uint32_t m_groups[GROUP_COUNT];
+    std::int64_t m_exponent;
+    bool m_isNegative;
+    std::size_t m_index;
+  };
+
+  template<typename Decimal>
+  class DecimalPartsReader {
+    public:
+      explicit DecimalPartsReader(DecimalParts<Decimal>& parts)
+        : m_parts(&parts) {}
+
+      template<typename T>
+      DecimalPartsReader& operator &(const T& field) {
+        using Value = std::remove_reference_t<decltype(field.value())>;
+        if constexpr(std::is_same_v<Value, std::uint32_t>) {
+          if(m_parts->m_index != DecimalParts<Decimal>::GROUP_COUNT) {
+            m_parts->m_groups[m_parts->m_index] = field.value();
+            ++m_parts->m_index;
+          }
+        } else if constexpr(std::is_same_v<Value, bool>) {
+          m_parts->m_isNegative = field.value();
+        } else if constexpr(std::is_integral_v<Value>) {
+          if(std::strcmp(field.name(), "exponent") == 0) {
+            m_parts->m_exponent = field.value();
+          }
+        }
+        return *this;
+      }
+
+    private:
+      DecimalParts<Decimal>* m_parts;
+  };
+
+  template<typename Decimal>
+  class DecimalPartsWriter {
+    public:
+      explicit DecimalPartsWriter(const DecimalParts<Decimal>& parts)
+        : m_parts(&parts),
+          m_index(0) {}
+
+      template<typename T>
+      DecimalPartsWriter& operator &(const T& field) {
+        using Value = std::remove_reference_t<decltype(field.value())>;
+        if constexpr(std::is_same_v<Value, std::uint32_t>) {
+          field.value() = m_index < m_parts->m_index ?
+            m_parts->m_groups[m_index] : 0;
+          ++m_index;
+        } else if constexpr(std::is_same_v<Value, bool>) {
+          field.value() = m_parts->m_isNegative;
+        } else if constexpr(std::is_integral_v<Value>) {
+          if(std::strcmp(field.name(), "exponent") == 0) {
+            field.value() = static_cast<Value>(m_parts->m_exponent);
+          }
+        }
+        return *this;
+      }
+
+    private:
+      const DecimalParts<Decimal>* m_parts;
+      std::size_t m_index;
+  };
+
+  template<typename Shuttler, typename Decimal>
+  void SendBinaryDecimal(Shuttler& shuttle, const Decimal& value) {
+    auto& backend = const_cast<typename Decimal::backend_type&>(
+      value.backend());
+    auto header = BINARY_DECIMAL_MARKER;
+    if(backend.isnan()) {
+      shuttle.Send(header | (BINARY_DECIMAL_NAN <<
+        BINARY_DECIMAL_CLASS_SHIFT));
+      shuttle.Send(std::int32_t(0));
+      return;
+    }
+    if(backend.isneg()) {
+      header |= BINARY_DECIMAL_NEGATIVE;
+    }
+    if(backend.isinf()) {
+      shuttle.Send(header | (BINARY_DECIMAL_INFINITE <<
+        BINARY_DECIMAL_CLASS_SHIFT));
+      shuttle.Send(std::int32_t(0));
+      return;
+    }
+    if(backend.iszero()) {
+      shuttle.Send(header & ~BINARY_DECIMAL_NEGATIVE);
+      shuttle.Send(std::int32_t(0));
+      return;
+    }
+    auto parts = DecimalParts<Decimal>();
+    parts.m_index = 0;
+    auto reader = DecimalPartsReader<Decimal>(parts);
+    backend.serialize(reader, 0);
+    auto exponent = parts.m_exponent + BINARY_DECIMAL_GROUP_DIGITS;
+    if(exponent < std::numeric_limits<std::int32_t>::min() ||
+        exponent > std::numeric_limits<std::int32_t>::max()) {
+      BOOST_THROW_EXCEPTION(SerializationException(
+        "Exponent out of range."));
+    }
+    auto count = parts.m_index;
+    while(count != 0 && parts.m_groups[count - 1] == 0) {
+      --count;
+    }
+    shuttle.Send(header | static_cast<std::uint32_t>(count));
+    shuttle.Send(static_cast<std::int32_t>(exponent));
+    for(auto i = std::size_t(0); i != count; ++i) {
+      shuttle.Send(parts.m_groups[i]);
+    }
+  }
+
+  template<typename Decimal, typename Shuttler>
+  Decimal ReceiveBinaryDecimal(Shuttler& shuttle, std::uint32_t header) {
+    auto type = (header >> BINARY_DECIMAL_CLASS_SHIFT) &
+      BINARY_DECIMAL_CLASS_MASK;
+    auto count = header & BINARY_DECIMAL_COUNT_MASK;
+    auto exponent = std::int32_t();
+    shuttle.Shuttle(exponent);
+    auto parts = DecimalParts<Decimal>();
+    parts.m_isNegative = (header & BINARY_DECIMAL_NEGATIVE) != 0;
+    if(type == BINARY_DECIMAL_NAN) {
+      return std::numeric_limits<Decimal>::quiet_NaN();
+    } else if(type == BINARY_DECIMAL_INFINITE) {
+      auto infinity = std::numeric_limits<Decimal>::infinity();
+      return parts.m_isNegative ? -infinity : infinity;
+    } else if(type != BINARY_DECIMAL_FINITE) {
+      BOOST_THROW_EXCEPTION(SerializationException("Invalid decimal."));
+    } else if(count == 0) {
+      return Decimal(0);
+    } else if(count > DecimalParts<Decimal>::GROUP_COUNT) {
+      BOOST_THROW_EXCEPTION(SerializationException(
+        "Decimal precision out of range."));
+    } else if(exponent % BINARY_DECIMAL_GROUP_DIGITS != 0) {
+      BOOST_THROW_EXCEPTION(SerializationException("Invalid decimal."));
+    }
+    for(auto i = std::uint32_t(0); i != count; ++i) {
+      shuttle.Shuttle(parts.m_groups[i]);
+      if(parts.m_groups[i] >= BINARY_DECIMAL_GROUP_LIMIT) {
+        BOOST_THROW_EXCEPTION(SerializationException("Invalid decimal."));
+      }
+    }
+    if(parts.m_groups[0] == 0) {
+      BOOST_THROW_EXCEPTION(SerializationException("Invalid decimal."));
+    }
+    auto order = std::int64_t(exponent);
+    for(auto group = parts.m_groups[0]; group >= 10; group /= 10) {
+      ++order;
+    }
+    if(order - BINARY_DECIMAL_GROUP_DIGITS <
+        std::numeric_limits<Decimal>::min_exponent10 ||
+        order - BINARY_DECIMAL_GROUP_DIGITS >
+        std::numeric_limits<Decimal>::max_exponent10) {
+      BOOST_THROW_EXCEPTION(SerializationException(
+        "Exponent out of range."));
+    }
+    parts.m_exponent = std::int64_t(exponent) - BINARY_DECIMAL_GROUP_DIGITS;
+    parts.m_index = count;
+    auto value = Decimal();
+    auto writer = DecimalPartsWriter<Decimal>(parts);
+    value.backend().serialize(writer, 0);
+    return value;
+  }
+}
+
   template<unsigned Digits10, typename ExponentType, typename Allocator>
   struct IsStructure<
     boost::multiprecision::number<boost::multiprecision::cpp_dec_float<
@@ -20,9 +230,13 @@ namespace Serialization {
         const boost::multiprecision::number<
         boost::multiprecision::cpp_dec_float<Digits10, ExponentType,
         Allocator>>& value) const {
-      std::stringstream sink;
-      sink << value;
-      shuttle.Send(name, sink.str());
+      if constexpr(IsBinaryShuttler<Shuttler>::value) {
+        if(shuttle.GetProtocolVersion() >= COMPACT_BINARY_PROTOCOL) {
+          Details::SendBinaryDecimal(shuttle, value);
+          return;
+        }
+      }
+      shuttle.Send(name, value.str());
     }
   };
 
@@ -34,11 +248,22 @@ namespace Serialization {
     void operator ()(Shuttler& shuttle, const char* name,
         boost::multiprecision::number<boost::multiprecision::cpp_dec_float<
         Digits10, ExponentType, Allocator>>& value) const {
-      std::string input;
-      shuttle.Shuttle(name, input);
-      value = boost::multiprecision::number<
+      using Decimal = boost::multiprecision::number<
         boost::multiprecision::cpp_dec_float<Digits10, ExponentType,
-        Allocator>>{input};
+        Allocator>>;
+      if constexpr(IsBinaryShuttler<Shuttler>::value) {
+        value = Details::ReceiveBinaryOrText(shuttle,
+          [&] (std::uint32_t header) {
+            return Details::ReceiveBinaryDecimal<Decimal>(shuttle, header);
+          },
+          [] (const std::string& source) {
+            return Decimal(source);
+          });
+      } else {
+        auto input = std::string();
+        shuttle.Shuttle(name, input);
+        value = Decimal(input);
+      }
     }
   };
 }
@@ -42,27 +42,40 @@ namespace ServiceLocator {
       //! Resets the Account, logging it out.
       void ResetAccount();
 
+      //! Returns the capabilities negotiated for this session.
+      int GetCapabilities() const;
+
+      //! Sets the capabilities negotiated for this session.
+      /*!
+        \param capabilities A bit set of the features the client supports.
+      */
+      void SetCapabilities(int capabilities);
+
     private:
       mutable boost::mutex m_mutex;
       DirectoryEntry m_account;
+      int m_capabilities = 0;
   };
 
   inline AuthenticatedSession::AuthenticatedSession(
       const AuthenticatedSession& session) {
     boost::lock_guard<boost::mutex> lock{session.m_mutex};
     m_account = session.m_account;
+    m_capabilities = session.m_capabilities;
   }
 
   inline AuthenticatedSession::AuthenticatedSession(
       AuthenticatedSession&& session) {
     boost::lock_guard<boost::mutex> lock{session.m_mutex};
     m_account = std::move(session.m_account);
+    m_capabilities = session.m_capabilities;
   }
 
   inline AuthenticatedSession& AuthenticatedSession::operator =(
       const AuthenticatedSession& rhs) {
     boost::lock_guard<boost::mutex> lock{rhs.m_mutex};
     m_account = rhs.m_account;
+    m_capabilities = rhs.m_capabilities;
     return *this;
   }
 
@@ -70,6 +83,7 @@ namespace ServiceLocator {
       AuthenticatedSession&& rhs) {
     boost::lock_guard<boost::mutex> lock{rhs.m_mutex};
     m_account = std::move(rhs.m_account);
+    m_capabilities = rhs.m_capabilities;
     return *this;
   }
 
@@ -93,6 +107,16 @@ namespace ServiceLocator {
     boost::lock_guard<boost::mutex> lock{m_mutex};
     m_account = DirectoryEntry();
   }
+
+  inline int AuthenticatedSession::GetCapabilities() const {
+    boost::lock_guard<boost::mutex> lock{m_mutex};
+    return m_capabilities;
+  }
+
+  inline void AuthenticatedSession::SetCapabilities(int capabilities) {
+    boost::lock_guard<boost::mutex> lock{m_mutex};
+    m_capabilities = capabilities;
+  }
 }
 }
 
@@ -6,6 +6,7 @@
 #include "Beam/IO/OpenState.hpp"
 #include "Beam/Pointers/LocalPtr.hpp"
 #include "Beam/Pointers/LocalPointerPolicy.hpp"
+#include "Beam/Serialization/BinarySender.hpp"
 #include "Beam/ServiceLocator/AuthenticatedSession.hpp"
 #include "Beam/ServiceLocator/ServiceLocatorServices.hpp"
 #include "Beam/Services/ServiceProtocolServletContainer.hpp"
@@ -60,6 +61,8 @@ namespace ServiceLocator {
       void OnSendSessionIdRequest(
         Services::RequestToken<ServiceProtocolClient, SendSessionIdService>&
         request, unsigned int key, const std::string& sessionId);
+      int OnSendCapabilitiesRequest(ServiceProtocolClient& client,
+        int capabilities);
       void OnServiceRequest(ServiceProtocolClient& client);
   };
 
@@ -119,6 +122,15 @@ namespace ServiceLocator {
     SendSessionIdService::AddRequestSlot(Store(slots), std::bind(
       &AuthenticationServletAdapter::OnSendSessionIdRequest, this,
       std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+    slots->GetRegistry().template Register<SendCapabilitiesService::Request<
+      ServiceProtocolClient>>(
+      "Beam.ServiceLocator.SendCapabilitiesService.Request");
+    slots->GetRegistry().template Register<SendCapabilitiesService::Response<
+      ServiceProtocolClient>>(
+      "Beam.ServiceLocator.SendCapabilitiesService.Response");
+    SendCapabilitiesService::AddSlot(Store(slots), std::bind(
+      &AuthenticationServletAdapter::OnSendCapabilitiesRequest, this,
+      std::placeholders::_1, std::placeholders::_2));
     Services::ServiceSlots<ServiceProtocolClient> servletSlots;
     m_servlet->RegisterServices(Store(servletSlots));
     auto serviceRequestPreHook = std::bind(
@@ -201,6 +213,18 @@ namespace ServiceLocator {
     }
   }
 
+  template<typename ContainerType, typename ServletType,
+    typename ServiceLocatorClientType>
+  int AuthenticationServletAdapter<ContainerType, ServletType,
+      ServiceLocatorClientType>::OnSendCapabilitiesRequest(
+      ServiceProtocolClient& client, int capabilities) {
+    client.GetSession().SetCapabilities(capabilities);
+    if(capabilities & COMPACT_BINARY_CAPABILITY) {
+      client.SetProtocolVersion(Serialization::COMPACT_BINARY_PROTOCOL);
+    }
+    return capabilities;
+  }
+
   template<typename ContainerType, typename ServletType,
     typename ServiceLocatorClientType>
   void AuthenticationServletAdapter<ContainerType, ServletType,
@@ -0,0 +1,304 @@
+#ifndef BEAM_PASSWORDVERIFIER_HPP
+#define BEAM_PASSWORDVERIFIER_HPP
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/noncopyable.hpp>
+#include <cryptopp/sha.h>
+#include "Beam/Routines/Async.hpp"
+#include "Beam/ServiceLocator/DirectoryEntry.hpp"
+#include "Beam/ServiceLocator/ServiceLocator.hpp"
+#include "Beam/ServiceLocator/ServiceLocatorDataStore.hpp"
+#include "Beam/ServiceLocator/SessionEncryption.hpp"
+#include "Beam/Services/ServiceRequestException.hpp"
+#include "Beam/Threading/Sync.hpp"
+#include "Beam/Threading/ThreadPool.hpp"
+
+namespace Beam {
+namespace ServiceLocator {
+
+  /*! \class PasswordVerifier
+      \brief Hashes and validates passwords on a bounded pool of threads so
+             that the deliberately slow bcrypt cost never runs on a routine
+             scheduler thread.
+   */
+  class PasswordVerifier : private boost::noncopyable {
+    public:
+
+      /*! \struct Settings
+          \brief Stores the settings used by a PasswordVerifier.
+       */
+      struct Settings {
+
+        //! The number of threads hashing passwords.
+        std::size_t m_threadCount;
+
+        //! The number of hashes that may be queued or running at once before
+        //! further requests are rejected.
+        std::size_t m_maxPendingCount;
+
+        //! How long a successful validation is remembered.
+        boost::posix_time::time_duration m_cacheDuration;
+
+        //! The maximum number of accounts whose validation is remembered.
+        std::size_t m_maxCacheSize;
+
+        //! Constructs default settings.
+        Settings();
+      };
+
+      /*! \struct Statistics
+          \brief Stores a snapshot of a PasswordVerifier's activity.
+       */
+      struct Statistics {
+
+        //! The number of validations requested.
+        std::uint64_t m_validations;
+
+        //! The number of validations answered from the cache.
+        std::uint64_t m_cacheHits;
+
+        //! The number of hashes computed on the thread pool.
+        std::uint64_t m_hashes;
+
+        //! The number of requests rejected because the queue was full.
+        std::uint64_t m_rejections;
+
+        //! The number of hashes queued or running.
+        std::size_t m_pendingCount;
+
+        //! The largest number of hashes that were queued or running at once.
+        std::size_t m_maxPendingCount;
+      };
+
+      //! Constructs a PasswordVerifier with default Settings.
+      PasswordVerifier();
+
+      //! Constructs a PasswordVerifier.
+      /*!
+        \param settings The Settings to use.
+      */
+      PasswordVerifier(const Settings& settings);
+
+      //! Returns a snapshot of the Statistics.
+      Statistics GetStatistics() const;
+
+      //! Validates a password, see ValidatePassword.
+      /*!
+        \param account The account to validate the password for.
+        \param receivedPassword The password received from the client.
+        \param storedPassword The password stored for the <i>account</i>.
+        \return <code>true</code> iff the <i>receivedPassword<i> matches the
+                <i>storedPassword</i>.
+      */
+      bool Validate(const DirectoryEntry& account,
+        const std::string& receivedPassword, const std::string& storedPassword);
+
+      //! Hashes a password, see HashPassword.
+      /*!
+        \param account The account to make the password for.
+        \param password The plain-text password to hash.
+        \return A hashed password for the <i>account</i>.
+      */
+      std::string Hash(const DirectoryEntry& account,
+        const std::string& password);
+
+      //! Forgets any cached validation for an account.
+      /*!
+        \param account The account whose password changed.
+      */
+      void Invalidate(const DirectoryEntry& account);
+
+    private:
+      using Digest = std::array<CryptoPP::byte, CryptoPP::SHA256::DIGESTSIZE>;
+      struct CacheEntry {
+        Digest m_digest;
+        boost::posix_time::ptime m_expiry;
+      };
+      using Cache = std::unordered_map<unsigned int, CacheEntry>;
+      Settings m_settings;
+      std::string m_pepper;
+      Threading::Sync<Cache> m_cache;
+      std::atomic<std::uint64_t> m_validations;
+      std::atomic<std::uint64_t> m_cacheHits;
+      std::atomic<std::uint64_t> m_hashes;
+      std::atomic<std::uint64_t> m_rejections;
+      std::atomic<std::size_t> m_pendingCount;
+      std::atomic<std::size_t> m_maxPendingCount;
+      Threading::ThreadPool m_threadPool;
+
+      Digest ComputeDigest(const DirectoryEntry& account,
+        const std::string& receivedPassword,
+        const std::string& storedPassword) const;
+      bool IsCached(const DirectoryEntry& account, const Digest& digest);
+      void CacheDigest(const DirectoryEntry& account, const Digest& digest);
+      template<typename F>
+      std::result_of_t<F()> Run(F&& f);
+  };
+
+  inline PasswordVerifier::Settings::Settings()
+      : m_threadCount(std::max<std::size_t>(1,
+          boost::thread::hardware_concurrency() / 2)),
+        m_maxPendingCount(256),
+        m_cacheDuration(boost::posix_time::minutes(5)),
+        m_maxCacheSize(10000) {}
+
+  inline PasswordVerifier::PasswordVerifier()
+      : PasswordVerifier(Settings()) {}
+
+  inline PasswordVerifier::PasswordVerifier(const Settings& settings)
+      : m_settings(settings),
+        m_pepper(GenerateSessionId()),
+        m_validations(0),
+        m_cacheHits(0),
+        m_hashes(0),
+        m_rejections(0),
+        m_pendingCount(0),
+        m_maxPendingCount(0),
+        m_threadPool(settings.m_threadCount) {}
+
+  inline PasswordVerifier::Statistics PasswordVerifier::GetStatistics() const {
+    auto statistics = Statistics();
+    statistics.m_validations = m_validations;
+    statistics.m_cacheHits = m_cacheHits;
+    statistics.m_hashes = m_hashes;
+    statistics.m_rejections = m_rejections;
+    statistics.m_pendingCount = m_pendingCount;
+    statistics.m_maxPendingCount = m_maxPendingCount;
+    return statistics;
+  }
+
+  inline bool PasswordVerifier::Validate(const DirectoryEntry& account,
+      const std::string& receivedPassword, const std::string& storedPassword) {
+    ++m_validations;
+    if(storedPassword.empty() || storedPassword[0] != '$') {
+      return ValidatePassword(account, receivedPassword, storedPassword);
+    }
+    auto digest = ComputeDigest(account, receivedPassword, storedPassword);
+    if(IsCached(account, digest)) {
+      ++m_cacheHits;
+      return true;
+    }
+    auto isValid = Run(
+      [&] {
+        return ValidatePassword(account, receivedPassword, storedPassword);
+      });
+    if(isValid) {
+      CacheDigest(account, digest);
+    }
+    return isValid;
+  }
+
+  inline std::string PasswordVerifier::Hash(const DirectoryEntry& account,
+      const std::string& password) {
+    return Run(
+      [&] {
+        return HashPassword(account, password);
+      });
+  }
+
+  inline void PasswordVerifier::Invalidate(const DirectoryEntry& account) {
+    Threading::With(m_cache,
+      [&] (Cache& cache) {
+        cache.erase(account.m_id);
+      });
+  }
+
+  inline PasswordVerifier::Digest PasswordVerifier::ComputeDigest(
+      const DirectoryEntry& account, const std::string& receivedPassword,
+      const std::string& storedPassword) const {
+    auto hash = CryptoPP::SHA256();
+    auto update = [&] (const void* data, std::size_t size) {
+      hash.Update(static_cast<const CryptoPP::byte*>(data), size);
+    };
+    update(m_pepper.data(), m_pepper.size());
+    update(&account.m_id, sizeof(account.m_id));
+    auto storedSize = storedPassword.size();
+    update(&storedSize, sizeof(storedSize));
+    update(storedPassword.data(), storedSize);
+    update(receivedPassword.data(), receivedPassword.size());
+    auto digest = Digest();
+    hash.Final(digest.data());
+    return digest;
+  }
+
+  inline bool PasswordVerifier::IsCached(const DirectoryEntry& account,
+      const Digest& digest) {
+    auto now = boost::posix_time::microsec_clock::universal_time();
+    return Threading::With(m_cache,
+      [&] (Cache& cache) {
+        auto entry = cache.find(account.m_id);
+        if(entry == cache.end()) {
+          return false;
+        }
+        if(entry->second.m_expiry <= now) {
+          cache.erase(entry);
+          return false;
+        }
+        auto difference = CryptoPP::byte(0);
+        for(auto i = std::size_t(0); i != digest.size(); ++i) {
+          difference |= digest[i] ^ entry->second.m_digest[i];
+        }
+        return difference == 0;
+      });
+  }
+
+  inline void PasswordVerifier::CacheDigest(const DirectoryEntry& account,
+      const Digest& digest) {
+    if(m_settings.m_maxCacheSize == 0 ||
+        m_settings.m_cacheDuration <= boost::posix_time::seconds(0)) {
+      return;
+    }
+    auto now = boost::posix_time::microsec_clock::universal_time();
+    Threading::With(m_cache,
+      [&] (Cache& cache) {
+        if(cache.size() >= m_settings.m_maxCacheSize &&
+            cache.find(account.m_id) == cache.end()) {
+          for(auto i = cache.begin(); i != cache.end();) {
+            if(i->second.m_expiry <= now) {
+              i = cache.erase(i);
+            } else {
+              ++i;
+            }
+          }
+          if(cache.size() >= m_settings.m_maxCacheSize) {
+            cache.erase(cache.begin());
+          }
+        }
+        cache[account.m_id] = CacheEntry{digest,
+          now + m_settings.m_cacheDuration};
+      });
+  }
+
+  template<typename F>
+  std::result_of_t<F()> PasswordVerifier::Run(F&& f) {
+    auto pendingCount = ++m_pendingCount;
+    if(pendingCount > m_settings.m_maxPendingCount) {
+      --m_pendingCount;
+      ++m_rejections;
+      throw Services::ServiceRequestException(
+        "Too many pending logins, try again later.");
+    }
+    auto maxPendingCount = m_maxPendingCount.load();
+    while(pendingCount > maxPendingCount &&
+        !m_maxPendingCount.compare_exchange_weak(maxPendingCount,
+        pendingCount)) {}
+    ++m_hashes;
+    auto result = Routines::Async<std::result_of_t<F()>>();
+    m_threadPool.Queue(std::forward<F>(f), result.GetEval());
+    try {
+      auto value = std::move(result.Get());
+      --m_pendingCount;
+      return value;
+    } catch(...) {
+      --m_pendingCount;
+      throw;
+    }
+  }
+}
+}
+
+#endif
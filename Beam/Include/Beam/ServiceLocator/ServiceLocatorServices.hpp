@@ -16,6 +16,10 @@ namespace ServiceLocator {
   BEAM_DEFINE_RECORD(LoginServiceResult, DirectoryEntry, account,
     std::string, session_id);
 
+  //! The session capability bit for sending dates, times and decimals in
+  //! their compact binary form, see Serialization::COMPACT_BINARY_PROTOCOL.
+  constexpr auto COMPACT_BINARY_CAPABILITY = 2;
+
   BEAM_DEFINE_SERVICES(ServiceLocatorServices,
 
     /*! \interface Beam::ServiceLocator::SendSessionIdService
@@ -28,6 +32,16 @@ namespace ServiceLocator {
       unsigned int, key, std::string, session_id),
     //! \endcond
 
+    /*! \interface Beam::ServiceLocator::SendCapabilitiesService
+        \brief Advertises the optional features a session supports.
+        \param capabilities A bit set of the features the client supports.
+        \return The capabilities the server will use for the session.
+    */
+    //! \cond
+    (SendCapabilitiesService, "Beam.ServiceLocator.SendCapabilitiesService",
+      int, int, capabilities),
+    //! \endcond
+
     /*! \interface Beam::ServiceLocator::LoginService
         \brief Logs into the ServiceLocator.
         \param username <code>std::string</code> The account's username.
@@ -9,6 +9,7 @@
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/noncopyable.hpp>
 #include "Beam/Pointers/LocalPtr.hpp"
+#include "Beam/ServiceLocator/PasswordVerifier.hpp"
 #include "Beam/ServiceLocator/ServiceLocatorSession.hpp"
 #include "Beam/ServiceLocator/ServiceLocatorServices.hpp"
 #include "Beam/Services/ServiceProtocolServlet.hpp"
@@ -40,6 +41,19 @@ namespace ServiceLocator {
       template<typename DataStoreForward>
       ServiceLocatorServlet(DataStoreForward&& dataStore);
 
+      //! Constructs a ServiceLocatorServlet.
+      /*!
+        \param dataStore The data store to use.
+        \param verifierSettings The settings used to hash and validate
+               passwords.
+      */
+      template<typename DataStoreForward>
+      ServiceLocatorServlet(DataStoreForward&& dataStore,
+        const PasswordVerifier::Settings& verifierSettings);
+
+      //! Returns the PasswordVerifier used to hash and validate passwords.
+      const PasswordVerifier& GetPasswordVerifier() const;
+
       void RegisterServices(
         Out<Services::ServiceSlots<ServiceProtocolClient>> slots);
 
@@ -70,6 +84,7 @@ namespace ServiceLocator {
       Threading::Sync<DirectoryEntryMonitorEntries>
         m_directoryEntryMonitorEntries;
       std::atomic_int m_nextServiceId;
+      PasswordVerifier m_passwordVerifier;
       IO::OpenState m_openState;
 
       void Shutdown();
@@ -149,6 +164,20 @@ namespace ServiceLocator {
       ServiceLocatorServlet(DataStoreForward&& dataStore)
       : m_dataStore{std::forward<DataStoreForward>(dataStore)} {}
 
+  template<typename ContainerType, typename ServiceLocatorDataStoreType>
+  template<typename DataStoreForward>
+  ServiceLocatorServlet<ContainerType, ServiceLocatorDataStoreType>::
+      ServiceLocatorServlet(DataStoreForward&& dataStore,
+      const PasswordVerifier::Settings& verifierSettings)
+      : m_dataStore{std::forward<DataStoreForward>(dataStore)},
+        m_passwordVerifier{verifierSettings} {}
+
+  template<typename ContainerType, typename ServiceLocatorDataStoreType>
+  const PasswordVerifier& ServiceLocatorServlet<ContainerType,
+      ServiceLocatorDataStoreType>::GetPasswordVerifier() const {
+    return m_passwordVerifier;
+  }
+
   template<typename ContainerType, typename ServiceLocatorDataStoreType>
   void ServiceLocatorServlet<ContainerType, ServiceLocatorDataStoreType>::
       RegisterServices(Out<Services::ServiceSlots<ServiceProtocolClient>>
@@ -360,6 +389,7 @@ namespace ServiceLocator {
     }
     DirectoryEntry account;
     try {
+      std::string accountPassword;
       m_dataStore->WithTransaction(
         [&] {
           try {
@@ -368,20 +398,19 @@ namespace ServiceLocator {
             throw Services::ServiceRequestException{
               "Invalid username or password."};
           }
-          std::string accountPassword;
           try {
             accountPassword = m_dataStore->LoadPassword(account);
           } catch(const ServiceLocatorDataStoreException&) {
             throw Services::ServiceRequestException{
               "Unable to retrieve password, try again later."};
           }
-          if(!ValidatePassword(account, password, accountPassword)) {
-            throw Services::ServiceRequestException{
-              "Invalid username or password."};
-          }
-          m_dataStore->StoreLastLoginTime(account,
-            boost::posix_time::second_clock::universal_time());
         });
+      if(!m_passwordVerifier.Validate(account, password, accountPassword)) {
+        throw Services::ServiceRequestException{
+          "Invalid username or password."};
+      }
+      m_dataStore->StoreLastLoginTime(account,
+        boost::posix_time::second_clock::universal_time());
     } catch(const std::exception&) {
       session.ResetLogin();
       throw;
@@ -832,17 +861,19 @@ namespace ServiceLocator {
     if(!session.IsLoggedIn()) {
       throw Services::ServiceRequestException{"Not logged in."};
     }
+    DirectoryEntry validatedAccount;
     m_dataStore->WithTransaction(
       [&] {
-        auto validatedAccount = m_dataStore->Validate(account);
+        validatedAccount = m_dataStore->Validate(account);
         if(validatedAccount != session.GetAccount() &&
             !HasPermission(*m_dataStore, session.GetAccount(), validatedAccount,
             Permission::ADMINISTRATE)) {
           throw Services::ServiceRequestException{"Insufficient permissions."};
         }
-        m_dataStore->SetPassword(validatedAccount,
-          HashPassword(validatedAccount, password));
       });
+    auto hashedPassword = m_passwordVerifier.Hash(validatedAccount, password);
+    m_dataStore->SetPassword(validatedAccount, hashedPassword);
+    m_passwordVerifier.Invalidate(validatedAccount);
   }
 
   template<typename ContainerType, typename ServiceLocatorDataStoreType>
@@ -978,10 +1009,11 @@ namespace ServiceLocator {
     if(!session.IsLoggedIn()) {
       throw Services::ServiceRequestException{"Not logged in."};
     }
-    DirectoryEntry account;
+    DirectoryEntry entry;
+    std::string accountPassword;
+    auto isFound = false;
     m_dataStore->WithTransaction(
       [&] {
-        DirectoryEntry entry;
         try {
           entry = m_dataStore->LoadAccount(username);
         } catch(const ServiceLocatorDataStoreException&) {
@@ -991,20 +1023,20 @@ namespace ServiceLocator {
             Permission::ADMINISTRATE)) {
           throw Services::ServiceRequestException{"Insufficient permissions."};
         }
-        std::string accountPassword;
         try {
           accountPassword = m_dataStore->LoadPassword(entry);
         } catch(const ServiceLocatorDataStoreException&) {
           return;
         }
-        if(!ValidatePassword(entry, password, accountPassword)) {
-          return;
-        }
-        m_dataStore->StoreLastLoginTime(entry,
-          boost::posix_time::second_clock::universal_time());
-        account = entry;
+        isFound = true;
       });
-    return account;
+    if(!isFound ||
+        !m_passwordVerifier.Validate(entry, password, accountPassword)) {
+      return DirectoryEntry();
+    }
+    m_dataStore->StoreLastLoginTime(entry,
+      boost::posix_time::second_clock::universal_time());
+    return entry;
   }
 
   template<typename ContainerType, typename ServiceLocatorDataStoreType>
@@ -2,6 +2,7 @@
 #define BEAM_SESSIONAUTHENTICATOR_HPP
 #include <cryptopp/osrng.h>
 #include "Beam/Pointers/Ref.hpp"
+#include "Beam/Serialization/BinarySender.hpp"
 #include "Beam/ServiceLocator/Authenticator.hpp"
 #include "Beam/ServiceLocator/ServiceLocator.hpp"
 #include "Beam/ServiceLocator/ServiceLocatorServices.hpp"
@@ -26,17 +27,36 @@ namespace ServiceLocator {
       SessionAuthenticator(Beam::Ref<ServiceLocatorClientType>
         serviceLocatorClient);
 
+      //! Constructs a SessionAuthenticator that advertises capabilities.
+      /*!
+        \param serviceLocatorClient The ServiceLocatorClient used to
+               authenticate the session.
+        \param capabilities The optional features to request for the session,
+               none are advertised when this is zero so that servers
+               predating SendCapabilitiesService are unaffected.
+      */
+      SessionAuthenticator(Beam::Ref<ServiceLocatorClientType>
+        serviceLocatorClient, int capabilities);
+
       template<typename ServiceProtocolClient>
       void operator ()(ServiceProtocolClient& client) const;
 
     private:
       ServiceLocatorClientType* m_serviceLocatorClient;
+      int m_capabilities;
   };
 
   template<typename ServiceLocatorClientType>
   SessionAuthenticator<ServiceLocatorClientType>::SessionAuthenticator(
       Beam::Ref<ServiceLocatorClientType> serviceLocatorClient)
-      : m_serviceLocatorClient(serviceLocatorClient.Get()) {}
+      : SessionAuthenticator(std::move(serviceLocatorClient), 0) {}
+
+  template<typename ServiceLocatorClientType>
+  SessionAuthenticator<ServiceLocatorClientType>::SessionAuthenticator(
+      Beam::Ref<ServiceLocatorClientType> serviceLocatorClient,
+      int capabilities)
+      : m_serviceLocatorClient(serviceLocatorClient.Get()),
+        m_capabilities(capabilities) {}
 
   template<typename ServiceLocatorClientType>
   template<typename ServiceProtocolClient>
@@ -49,6 +69,13 @@ namespace ServiceLocator {
     RegisterServiceLocatorServices(Store(client.GetSlots()));
     client.template SendRequest<SendSessionIdService>(key,
       m_serviceLocatorClient->GetEncryptedSessionId(key));
+    if(m_capabilities != 0) {
+      auto capabilities = client.template SendRequest<
+        SendCapabilitiesService>(m_capabilities);
+      if(capabilities & COMPACT_BINARY_CAPABILITY) {
+        client.SetProtocolVersion(Serialization::COMPACT_BINARY_PROTOCOL);
+      }
+    }
   }
 }
 }
@@ -62,6 +62,19 @@ namespace Services {
         serviceLocatorClient, const ChannelBuilder& channelBuilder,
         const TimerBuilder& timerBuilder);
 
+      //! Constructs an AuthenticatedServiceProtocolClientBuilder that
+      //! advertises capabilities when authenticating.
+      /*!
+        \param serviceLocatorClient The ServiceLocatorClient used to
+               authenticate the session.
+        \param channelBuilder Used to build new Channels.
+        \param timerBuilder Used to build heartbeat Timers.
+        \param capabilities The optional features to request for the session.
+      */
+      AuthenticatedServiceProtocolClientBuilder(Ref<ServiceLocatorClient>
+        serviceLocatorClient, const ChannelBuilder& channelBuilder,
+        const TimerBuilder& timerBuilder, int capabilities);
+
       std::unique_ptr<Client> Build(ServiceSlots<Client>& slots);
 
       void Open(Client& client);
@@ -70,6 +83,7 @@ namespace Services {
       ServiceLocatorClient* m_serviceLocatorClient;
       ChannelBuilder m_channelBuilder;
       TimerBuilder m_timerBuilder;
+      int m_capabilities;
   };
 
   template<typename ServiceLocatorClientType, typename MessageProtocolType,
@@ -79,9 +93,21 @@ namespace Services {
       AuthenticatedServiceProtocolClientBuilder(
       Ref<ServiceLocatorClient> serviceLocatorClient,
       const ChannelBuilder& channelBuilder, const TimerBuilder& timerBuilder)
+      : AuthenticatedServiceProtocolClientBuilder(
+          std::move(serviceLocatorClient), channelBuilder, timerBuilder, 0) {}
+
+  template<typename ServiceLocatorClientType, typename MessageProtocolType,
+    typename TimerType>
+  AuthenticatedServiceProtocolClientBuilder<ServiceLocatorClientType,
+      MessageProtocolType, TimerType>::
+      AuthenticatedServiceProtocolClientBuilder(
+      Ref<ServiceLocatorClient> serviceLocatorClient,
+      const ChannelBuilder& channelBuilder, const TimerBuilder& timerBuilder,
+      int capabilities)
       : m_serviceLocatorClient(serviceLocatorClient.Get()),
         m_channelBuilder(channelBuilder),
-        m_timerBuilder(timerBuilder) {}
+        m_timerBuilder(timerBuilder),
+        m_capabilities(capabilities) {}
 
   template<typename ServiceLocatorClientType, typename MessageProtocolType,
     typename TimerType>
@@ -102,7 +128,7 @@ namespace Services {
       MessageProtocolType, TimerType>::Open(Client& client) {
     ServiceLocator::OpenAndAuthenticate(
       ServiceLocator::SessionAuthenticator<ServiceLocatorClient>(
-      Ref(*m_serviceLocatorClient)), client);
+      Ref(*m_serviceLocatorClient), m_capabilities), client);
   }
 }
 }
@@ -1,5 +1,6 @@
 #ifndef BEAM_MESSAGE_PROTOCOL_HPP
 #define BEAM_MESSAGE_PROTOCOL_HPP
+#include <type_traits>
 #include <utility>
 #include <boost/thread/mutex.hpp>
 #include <boost/throw_exception.hpp>
@@ -20,6 +21,14 @@
 #include "Beam/Utilities/Endian.hpp"
 
 namespace Beam::Services {
+namespace Details {
+  template<typename Sender, typename = void>
+  struct HasProtocolVersion : std::false_type {};
+
+  template<typename Sender>
+  struct HasProtocolVersion<Sender, std::void_t<decltype(
+    std::declval<Sender&>().SetProtocolVersion(0))>> : std::true_type {};
+}
 
   /** Implements a protocol used to send/receive discrete messages over a
       Channel.
@@ -68,6 +77,13 @@ namespace Beam::Services {
       //! Returns the Channel.
       Channel& GetChannel();
 
+      //! Sets the protocol version used to serialize outgoing messages, has
+      //! no effect on Senders that have only one format.
+      /*!
+        \param version The protocol version negotiated with the peer.
+      */
+      void SetProtocolVersion(int version);
+
       //! Clones a value using this protocol's serializer.
       /*!
         \param value The value to clone.
@@ -144,6 +160,15 @@ namespace Beam::Services {
     return *m_channel;
   }
 
+  template<typename ChannelType, typename SenderType, typename EncoderType>
+  void MessageProtocol<ChannelType, SenderType, EncoderType>::
+      SetProtocolVersion(int version) {
+    if constexpr(Details::HasProtocolVersion<Sender>::value) {
+      auto lock = boost::lock_guard(m_mutex);
+      m_sender->SetProtocolVersion(version);
+    }
+  }
+
   template<typename ChannelType, typename SenderType, typename EncoderType>
   template<typename T>
   std::unique_ptr<T> MessageProtocol<ChannelType, SenderType, EncoderType>::
@@ -2,6 +2,7 @@
 #define BEAM_SERVICEPROTOCOLCLIENT_HPP
 #include <atomic>
 #include <iostream>
+#include <limits>
 #include <unordered_map>
 #include <boost/noncopyable.hpp>
 #include <boost/range/adaptor/map.hpp>
@@ -104,6 +105,12 @@ namespace Details {
       //! Returns the session info.
       Session& GetSession();
 
+      //! Sets the protocol version used to serialize outgoing messages.
+      /*!
+        \param version The protocol version negotiated with the peer.
+      */
+      void SetProtocolVersion(int version);
+
       //! Clones a ServiceRequestException usable with this protocol.
       /*!
         \param e The ServiceRequestException to clone.
@@ -199,19 +206,34 @@ namespace Details {
     static constexpr bool value = T::SupportsParallelism;
   };
 
+  //! Indicates that a parallel ServiceProtocolClient doesn't limit the number
+  //! of Messages it handles at once.
+  inline constexpr auto UNBOUNDED_PARALLEL_MESSAGES =
+    std::numeric_limits<std::size_t>::max();
+
   //! Implements a basic Message handling loop for a ServiceProtocolClient.
   /*!
     \param client The ServiceProtocolClient to handle the Messages for.
+    \param maxParallelMessages The maximum number of Messages handled at once
+           when the client supports parallelism, once reached no further
+           Messages are read until a handler completes. Responses are always
+           handled on the loop itself so that handlers waiting on them can't
+           hold up their delivery.
   */
   template<typename ServiceProtocolClientType>
-  void HandleMessagesLoop(ServiceProtocolClientType& client) {
-    Routines::RoutineHandlerGroup routines;
+  void HandleMessagesLoop(ServiceProtocolClientType& client,
+      std::size_t maxParallelMessages) {
+    Routines::RoutineHandlerGroup routines(maxParallelMessages);
     try {
       while(true) {
         auto message = client.ReadMessage();
         auto slot = client.GetSlots().Find(*message);
         if(slot != nullptr) {
-          if(SupportsParallelism<ServiceProtocolClientType>::value) {
+          auto serviceMessage = dynamic_cast<
+            ServiceMessage<ServiceProtocolClientType>*>(message.get());
+          if(SupportsParallelism<ServiceProtocolClientType>::value &&
+              (serviceMessage == nullptr ||
+              !serviceMessage->IsResponseMessage())) {
             routines.Spawn(
               [&, message = std::move(message), slot = std::move(slot)] {
                 try {
@@ -232,7 +254,17 @@ namespace Details {
     } catch(const IO::EndOfFileException&) {
       return;
     }
-  };
+  }
+
+  //! Implements a basic Message handling loop for a ServiceProtocolClient,
+  //! without limiting the number of Messages handled at once.
+  /*!
+    \param client The ServiceProtocolClient to handle the Messages for.
+  */
+  template<typename ServiceProtocolClientType>
+  void HandleMessagesLoop(ServiceProtocolClientType& client) {
+    HandleMessagesLoop(client, UNBOUNDED_PARALLEL_MESSAGES);
+  }
 
   template<typename MessageProtocolType, typename TimerType,
     typename ServiceSlotsPolicy, typename SessionType,
@@ -313,6 +345,15 @@ namespace Details {
     return m_session;
   }
 
+  template<typename MessageProtocolType, typename TimerType,
+    typename ServiceSlotsPolicy, typename SessionType,
+    bool SupportsParallelismValue>
+  void ServiceProtocolClient<MessageProtocolType, TimerType,
+      ServiceSlotsPolicy, SessionType, SupportsParallelismValue>::
+      SetProtocolVersion(int version) {
+    m_protocol.SetProtocolVersion(version);
+  }
+
   template<typename MessageProtocolType, typename TimerType,
     typename ServiceSlotsPolicy, typename SessionType,
     bool SupportsParallelismValue>
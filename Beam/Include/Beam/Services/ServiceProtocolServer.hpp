@@ -16,6 +16,10 @@
 namespace Beam {
 namespace Services {
 
+  //! The default maximum number of Messages a ServiceProtocolServer handles
+  //! at once for each of its clients when requests are handled in parallel.
+  inline constexpr auto DEFAULT_MAX_PARALLEL_MESSAGES = std::size_t(64);
+
   /*! \class ServiceProtocolServer
       \brief A server accepting ServiceProtocolClients.
       \tparam ServerConnectionType The type of ServerConnection accepting
@@ -94,6 +98,24 @@ namespace Services {
         const TimerFactory& timerFactory, const AcceptSlot& acceptSlot,
         const ClientClosedSlot& clientClosedSlot);
 
+      //! Constructs a ServiceProtocolServer.
+      /*!
+        \param serverConnection Initializes the ServerConnection.
+        \param timerFactory Builds Timers for the ServiceProtocolClients.
+        \param acceptSlot The slot to call when a ServiceProtocolClient is
+               accepted.
+        \param clientClosedSlot The slot to call when a ServiceProtocolClient is
+               closed.
+        \param maxParallelMessages The maximum number of Messages handled at
+               once for each ServiceProtocolClient when requests are handled in
+               parallel.
+      */
+      template<typename ServerConnectionForward>
+      ServiceProtocolServer(ServerConnectionForward&& serverConnection,
+        const TimerFactory& timerFactory, const AcceptSlot& acceptSlot,
+        const ClientClosedSlot& clientClosedSlot,
+        std::size_t maxParallelMessages);
+
       ~ServiceProtocolServer();
 
       //! Returns the ServiceSlots shared amongst all ServiceProtocolClients.
@@ -108,6 +130,7 @@ namespace Services {
       TimerFactory m_timerFactory;
       AcceptSlot m_acceptSlot;
       ClientClosedSlot m_clientClosedSlot;
+      std::size_t m_maxParallelMessages;
       ServiceSlots<ServiceProtocolClient> m_slots;
       Routines::RoutineHandler m_acceptRoutine;
       IO::OpenState m_openState;
@@ -125,11 +148,26 @@ namespace Services {
       ServerConnectionForward&& serverConnection,
       const TimerFactory& timerFactory, const AcceptSlot& acceptSlot,
       const ClientClosedSlot& clientClosedSlot)
+      : ServiceProtocolServer(std::forward<ServerConnectionForward>(
+          serverConnection), timerFactory, acceptSlot, clientClosedSlot,
+          DEFAULT_MAX_PARALLEL_MESSAGES) {}
+
+  template<typename ServerConnectionType, typename SenderType,
+    typename EncoderType, typename TimerType, typename SessionType,
+    bool SupportsParallelismValue>
+  template<typename ServerConnectionForward>
+  ServiceProtocolServer<ServerConnectionType, SenderType, EncoderType,
+      TimerType, SessionType, SupportsParallelismValue>::ServiceProtocolServer(
+      ServerConnectionForward&& serverConnection,
+      const TimerFactory& timerFactory, const AcceptSlot& acceptSlot,
+      const ClientClosedSlot& clientClosedSlot,
+      std::size_t maxParallelMessages)
       : m_serverConnection(std::forward<ServerConnectionForward>(
           serverConnection)),
         m_timerFactory(timerFactory),
         m_acceptSlot(acceptSlot),
-        m_clientClosedSlot(clientClosedSlot) {}
+        m_clientClosedSlot(clientClosedSlot),
+        m_maxParallelMessages(maxParallelMessages) {}
 
   template<typename ServerConnectionType, typename SenderType,
     typename EncoderType, typename TimerType, typename SessionType,
@@ -216,7 +254,7 @@ namespace Services {
           try {
             client->Open();
             m_acceptSlot(*client);
-            HandleMessagesLoop(*client);
+            HandleMessagesLoop(*client, m_maxParallelMessages);
           } catch(const std::exception&) {
             std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
           }
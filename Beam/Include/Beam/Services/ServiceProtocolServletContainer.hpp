@@ -65,6 +65,20 @@ namespace Services {
         ServerConnectionForward&& serverConnection,
         const typename ServiceProtocolServer::TimerFactory& timerFactory);
 
+      //! Constructs the ServiceProtocolServletContainer.
+      /*!
+        \param servlet Initializes the Servlet.
+        \param serverConnection Accepts connections to the servlet.
+        \param timerFactory The type of Timer used for heartbeats.
+        \param maxParallelMessages The maximum number of Messages handled at
+               once for each client when the Servlet supports parallelism.
+      */
+      template<typename ServletForward, typename ServerConnectionForward>
+      ServiceProtocolServletContainer(ServletForward&& servlet,
+        ServerConnectionForward&& serverConnection,
+        const typename ServiceProtocolServer::TimerFactory& timerFactory,
+        std::size_t maxParallelMessages);
+
       ~ServiceProtocolServletContainer();
 
       void Open();
@@ -88,6 +102,20 @@ namespace Services {
       ServiceProtocolServletContainer(ServletForward&& servlet,
       ServerConnectionForward&& serverConnection,
       const typename ServiceProtocolServer::TimerFactory& timerFactory)
+      : ServiceProtocolServletContainer(std::forward<ServletForward>(servlet),
+          std::forward<ServerConnectionForward>(serverConnection),
+          timerFactory, DEFAULT_MAX_PARALLEL_MESSAGES) {}
+
+  template<typename MetaServlet, typename ServerConnectionType,
+    typename SenderType, typename EncoderType, typename TimerType,
+    typename ServletPointerPolicy>
+  template<typename ServletForward, typename ServerConnectionForward>
+  ServiceProtocolServletContainer<MetaServlet, ServerConnectionType,
+      SenderType, EncoderType, TimerType, ServletPointerPolicy>::
+      ServiceProtocolServletContainer(ServletForward&& servlet,
+      ServerConnectionForward&& serverConnection,
+      const typename ServiceProtocolServer::TimerFactory& timerFactory,
+      std::size_t maxParallelMessages)
 BEAM_SUPPRESS_THIS_INITIALIZER()
       : m_servlet{std::forward<ServletForward>(servlet)},
         m_protocolServer{std::forward<ServerConnectionForward>(
@@ -95,7 +123,7 @@ BEAM_SUPPRESS_THIS_INITIALIZER()
           std::bind(&ServiceProtocolServletContainer::OnClientAccepted, this,
           std::placeholders::_1), std::bind(
           &ServiceProtocolServletContainer::OnClientClosed, this,
-          std::placeholders::_1)} {
+          std::placeholders::_1), maxParallelMessages} {
 BEAM_UNSUPPRESS_THIS_INITIALIZER()
     m_servlet->RegisterServices(Store(m_protocolServer.GetSlots()));
   }
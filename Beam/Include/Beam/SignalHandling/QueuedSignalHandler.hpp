@@ -14,6 +14,7 @@
 #include <boost/thread/mutex.hpp>
 #include "Beam/SignalHandling/SignalHandling.hpp"
 #include "Beam/Utilities/Functional.hpp"
+#include "Beam/Utilities/Task.hpp"
 
 namespace Beam {
 namespace SignalHandling {
@@ -43,7 +44,8 @@ namespace SignalHandling {
       /*!
         \param task The task to perform.
       */
-      void QueueTask(const std::function<void ()>& task);
+      template<typename F>
+      void QueueTask(F&& task);
 
       //! Returns a slot compatible with this signal handler.
       /*!
@@ -58,7 +60,7 @@ namespace SignalHandling {
     private:
       boost::mutex m_mutex;
       QueuedSlot m_queuedSlot;
-      std::vector<std::function<void ()>> m_slots;
+      std::vector<Task> m_slots;
 
       template<typename SlotType, int Arity =
         boost::function_types::function_arity<
@@ -93,20 +95,20 @@ namespace SignalHandling {
   }
 
   inline void QueuedSignalHandler::HandleSignals() {
-    std::vector<std::function<void ()>> slots;
+    std::vector<Task> slots;
     {
       boost::lock_guard<boost::mutex> lock(m_mutex);
       slots.swap(m_slots);
     }
-    for(const std::function<void ()>& slot : slots) {
+    for(auto& slot : slots) {
       slot();
     }
   }
 
-  inline void QueuedSignalHandler::QueueTask(
-      const std::function<void ()>& task) {
+  template<typename F>
+  void QueuedSignalHandler::QueueTask(F&& task) {
     boost::lock_guard<boost::mutex> lock(m_mutex);
-    m_slots.push_back(task);
+    m_slots.emplace_back(std::forward<F>(task));
     if(m_slots.size() == 1 && m_queuedSlot) {
       m_queuedSlot();
     }
@@ -143,7 +145,7 @@ namespace SignalHandling {
   void QueuedSignalHandler::Slot(const SlotType& slot BOOST_PP_COMMA_IF(n)     \
       BOOST_PP_REPEAT(n, BEAM_DECLARE_PARAMETER, BOOST_PP_EMPTY)) {            \
     boost::lock_guard<boost::mutex> lock(m_mutex);                             \
-    m_slots.push_back(std::bind(slot BOOST_PP_COMMA_IF(n)                      \
+    m_slots.emplace_back(std::bind(slot BOOST_PP_COMMA_IF(n)                   \
       BOOST_PP_ENUM_PARAMS(n, a)));                                            \
     if(m_slots.size() == 1 && m_queuedSlot) {                                  \
       m_queuedSlot();                                                          \
@@ -0,0 +1,225 @@
+#ifndef BEAM_IO_SERVICE_GROUP_HPP
+#define BEAM_IO_SERVICE_GROUP_HPP
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <boost/asio/io_service.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/thread.hpp>
+#include "Beam/Routines/Routine.hpp"
+#include "Beam/Routines/ScheduledRoutine.hpp"
+#include "Beam/Routines/Scheduler.hpp"
+#include "Beam/Threading/ThreadAffinity.hpp"
+#include "Beam/Threading/Threading.hpp"
+
+namespace Beam {
+namespace Threading {
+
+  /*! \class IoServiceGroup
+      \brief Runs a group of threads over one or more io_services.
+      \details In the SHARED mode every thread runs a single io_service, in
+               every other mode each thread runs its own io_service (a shard)
+               and objects are assigned a shard when they are created, so all
+               of an object's handlers run on the same thread.
+   */
+  class IoServiceGroup : private boost::noncopyable {
+    public:
+
+      //! Specifies how objects are assigned to a shard.
+      enum class Assignment {
+
+        //! All threads run a single io_service.
+        SHARED,
+
+        //! Shards are assigned in turn.
+        ROUND_ROBIN,
+
+        //! The shard with the fewest assigned objects is used.
+        LEAST_LOADED,
+
+        //! The calling Routine's context is mapped onto the shards in
+        //! contiguous blocks, so each context uses a single shard and contexts
+        //! are spread evenly across the shards. The shard's index matches the
+        //! context's id only when there are as many shards as the Scheduler
+        //! has threads. Falls back to ROUND_ROBIN outside of a scheduled
+        //! Routine.
+        ROUTINE
+      };
+
+      //! Constructs an IoServiceGroup.
+      /*!
+        \param threadCount The number of threads to use.
+        \param assignment How objects are assigned to a shard.
+        \param isPinned Whether each thread is pinned to its own CPU.
+      */
+      IoServiceGroup(std::size_t threadCount, Assignment assignment,
+        bool isPinned);
+
+      ~IoServiceGroup();
+
+      //! Returns the number of threads used.
+      std::size_t GetThreadCount() const;
+
+      //! Returns how objects are assigned to a shard.
+      Assignment GetAssignment() const;
+
+      //! Returns the number of io_services, 1 in the SHARED mode and one per
+      //! thread otherwise.
+      std::size_t GetServiceCount() const;
+
+      //! Returns the number of objects currently assigned to a shard.
+      /*!
+        \param index The index of the shard.
+      */
+      std::size_t GetLoad(std::size_t index) const;
+
+      //! Returns the index of the shard to assign the next object to.
+      std::size_t Select();
+
+      //! Returns an io_service without assigning an object to it.
+      /*!
+        \param index The index of the shard.
+      */
+      boost::asio::io_service& GetService(std::size_t index);
+
+      //! Assigns an object to a shard.
+      /*!
+        \param index The index of the shard.
+        \return The shard's io_service, the assignment is released when the
+                returned pointer is destroyed.
+      */
+      std::shared_ptr<boost::asio::io_service> Acquire(std::size_t index);
+
+      //! Assigns an object to the shard returned by Select().
+      std::shared_ptr<boost::asio::io_service> Acquire();
+
+    private:
+      struct Shard {
+        boost::asio::io_service m_service;
+        boost::asio::io_service::work m_work;
+        std::atomic<std::size_t> m_load;
+
+        explicit Shard(int concurrencyHint);
+      };
+      Assignment m_assignment;
+      std::size_t m_threadCount;
+      std::vector<std::unique_ptr<Shard>> m_shards;
+      std::atomic<std::size_t> m_nextShard;
+      std::unique_ptr<boost::thread[]> m_threads;
+  };
+
+  inline IoServiceGroup::Shard::Shard(int concurrencyHint)
+      : m_service(concurrencyHint),
+        m_work(m_service),
+        m_load(0) {}
+
+  inline IoServiceGroup::IoServiceGroup(std::size_t threadCount,
+      Assignment assignment, bool isPinned)
+      : m_assignment(assignment),
+        m_threadCount(threadCount),
+        m_nextShard(0),
+        m_threads(std::make_unique<boost::thread[]>(m_threadCount)) {
+    if(m_assignment == Assignment::SHARED) {
+      m_shards.push_back(
+        std::make_unique<Shard>(BOOST_ASIO_CONCURRENCY_HINT_DEFAULT));
+    } else {
+      for(std::size_t i = 0; i < std::max<std::size_t>(m_threadCount, 1);
+          ++i) {
+        m_shards.push_back(std::make_unique<Shard>(1));
+      }
+    }
+    for(std::size_t i = 0; i < m_threadCount; ++i) {
+      auto& service = m_shards[i % m_shards.size()]->m_service;
+      m_threads[i] = boost::thread(
+        [&service] {
+          service.run();
+        });
+      if(isPinned) {
+        SetThreadAffinity(m_threads[i], i);
+      }
+    }
+  }
+
+  inline IoServiceGroup::~IoServiceGroup() {
+    for(auto& shard : m_shards) {
+      shard->m_service.stop();
+    }
+    for(std::size_t i = 0; i < m_threadCount; ++i) {
+      m_threads[i].join();
+    }
+  }
+
+  inline std::size_t IoServiceGroup::GetThreadCount() const {
+    return m_threadCount;
+  }
+
+  inline IoServiceGroup::Assignment IoServiceGroup::GetAssignment() const {
+    return m_assignment;
+  }
+
+  inline std::size_t IoServiceGroup::GetServiceCount() const {
+    return m_shards.size();
+  }
+
+  inline std::size_t IoServiceGroup::GetLoad(std::size_t index) const {
+    return m_shards[index]->m_load.load(std::memory_order_relaxed);
+  }
+
+  inline std::size_t IoServiceGroup::Select() {
+    if(m_shards.size() == 1) {
+      return 0;
+    }
+    if(m_assignment == Assignment::ROUTINE) {
+      if(auto routine = dynamic_cast<Routines::ScheduledRoutine*>(
+          Routines::Details::CurrentRoutineGlobal<void>::GetInstance())) {
+        auto contextCount = routine->GetScheduler().GetThreadCount();
+        assert(routine->GetContextId() < contextCount);
+        return routine->GetContextId() * m_shards.size() / contextCount;
+      }
+    }
+    auto start = m_nextShard.fetch_add(1, std::memory_order_relaxed) %
+      m_shards.size();
+    if(m_assignment != Assignment::LEAST_LOADED) {
+      return start;
+    }
+
+    // Scan from a rotating start so ties are spread across the shards.
+    auto selection = start;
+    auto minimumLoad = std::numeric_limits<std::size_t>::max();
+    for(std::size_t i = 0; i < m_shards.size(); ++i) {
+      auto index = (start + i) % m_shards.size();
+      auto load = GetLoad(index);
+      if(load < minimumLoad) {
+        selection = index;
+        minimumLoad = load;
+      }
+    }
+    return selection;
+  }
+
+  inline boost::asio::io_service& IoServiceGroup::GetService(
+      std::size_t index) {
+    return m_shards[index]->m_service;
+  }
+
+  inline std::shared_ptr<boost::asio::io_service> IoServiceGroup::Acquire(
+      std::size_t index) {
+    auto& shard = *m_shards[index];
+    shard.m_load.fetch_add(1, std::memory_order_relaxed);
+    return std::shared_ptr<boost::asio::io_service>(&shard.m_service,
+      [&shard] (boost::asio::io_service*) {
+        shard.m_load.fetch_sub(1, std::memory_order_relaxed);
+      });
+  }
+
+  inline std::shared_ptr<boost::asio::io_service> IoServiceGroup::Acquire() {
+    return Acquire(Select());
+  }
+}
+}
+
+#endif
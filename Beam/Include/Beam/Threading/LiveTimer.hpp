@@ -1,5 +1,6 @@
 #ifndef BEAM_LIVETIMER_HPP
 #define BEAM_LIVETIMER_HPP
+#include <memory>
 #include <boost/asio/deadline_timer.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/system/system_error.hpp>
@@ -41,6 +42,7 @@ namespace Threading {
     private:
       mutable Mutex m_mutex;
       boost::posix_time::time_duration m_interval;
+      std::shared_ptr<boost::asio::io_service> m_service;
       boost::asio::deadline_timer m_deadLineTimer;
       bool m_isPending;
       MultiQueueWriter<Timer::Result> m_publisher;
@@ -50,7 +52,8 @@ namespace Threading {
   inline LiveTimer::LiveTimer(boost::posix_time::time_duration interval,
     Ref<TimerThreadPool> timerThreadPool)
       : m_interval(interval),
-        m_deadLineTimer(timerThreadPool->GetService()),
+        m_service(timerThreadPool->GetService()),
+        m_deadLineTimer(*m_service),
         m_isPending(false) {}
 
   inline LiveTimer::~LiveTimer() {
@@ -0,0 +1,134 @@
+#ifndef BEAM_LOCK_STATISTICS_HPP
+#define BEAM_LOCK_STATISTICS_HPP
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <boost/noncopyable.hpp>
+#include "Beam/Threading/Threading.hpp"
+
+namespace Beam {
+namespace Threading {
+
+  /*! \class LatencyHistogram
+      \brief Counts durations in buckets whose bounds are powers of 2
+             nanoseconds.
+      \details Bucket 0 counts durations under 1 ns and bucket i counts
+               durations in [2^(i - 1), 2^i) ns, the last bucket also counts
+               everything longer.
+   */
+  class LatencyHistogram : private boost::noncopyable {
+    public:
+
+      //! The number of buckets.
+      static constexpr std::size_t BUCKET_COUNT = 40;
+
+      //! Returns the exclusive upper bound of a bucket.
+      /*!
+        \param bucket The index of the bucket.
+      */
+      static std::chrono::nanoseconds GetUpperBound(std::size_t bucket);
+
+      //! Constructs an empty LatencyHistogram.
+      LatencyHistogram();
+
+      //! Returns the total number of durations recorded.
+      std::uint64_t GetCount() const;
+
+      //! Returns the number of durations recorded in a bucket.
+      /*!
+        \param bucket The index of the bucket.
+      */
+      std::uint64_t GetCount(std::size_t bucket) const;
+
+      //! Returns the upper bound of the bucket containing a percentile.
+      /*!
+        \param percentile The percentile, in the range [0, 100].
+      */
+      std::chrono::nanoseconds GetPercentile(double percentile) const;
+
+      //! Records a duration.
+      /*!
+        \param duration The duration to record.
+      */
+      void Record(std::chrono::steady_clock::duration duration);
+
+      //! Clears all recorded durations.
+      void Reset();
+
+    private:
+      std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> m_buckets;
+  };
+
+  /*! \struct LockStatistics
+      \brief Stores the wait and hold times of a lock.
+   */
+  struct LockStatistics {
+
+    //! The time spent waiting to acquire the lock.
+    LatencyHistogram m_waitTime;
+
+    //! The time the lock was held exclusively.
+    LatencyHistogram m_holdTime;
+  };
+
+  inline std::chrono::nanoseconds LatencyHistogram::GetUpperBound(
+      std::size_t bucket) {
+    return std::chrono::nanoseconds(std::int64_t(1) << bucket);
+  }
+
+  inline LatencyHistogram::LatencyHistogram() {
+    Reset();
+  }
+
+  inline std::uint64_t LatencyHistogram::GetCount() const {
+    auto count = std::uint64_t(0);
+    for(auto& bucket : m_buckets) {
+      count += bucket.load(std::memory_order_relaxed);
+    }
+    return count;
+  }
+
+  inline std::uint64_t LatencyHistogram::GetCount(std::size_t bucket) const {
+    return m_buckets[bucket].load(std::memory_order_relaxed);
+  }
+
+  inline std::chrono::nanoseconds LatencyHistogram::GetPercentile(
+      double percentile) const {
+    auto count = GetCount();
+    if(count == 0) {
+      return std::chrono::nanoseconds(0);
+    }
+    auto rank = static_cast<std::uint64_t>(percentile / 100 * (count - 1));
+    auto total = std::uint64_t(0);
+    for(std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+      total += GetCount(i);
+      if(total > rank) {
+        return GetUpperBound(i);
+      }
+    }
+    return GetUpperBound(BUCKET_COUNT - 1);
+  }
+
+  inline void LatencyHistogram::Record(
+      std::chrono::steady_clock::duration duration) {
+    auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      duration).count();
+    auto bucket = std::size_t(0);
+    while(nanoseconds > 0 && bucket < BUCKET_COUNT - 1) {
+      nanoseconds >>= 1;
+      ++bucket;
+    }
+    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  inline void LatencyHistogram::Reset() {
+    for(auto& bucket : m_buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+}
+
+#endif
@@ -1,17 +1,99 @@
 #ifndef BEAM_MUTEX_HPP
 #define BEAM_MUTEX_HPP
+#include <algorithm>
+#include <atomic>
 #include <boost/thread/lock_types.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#if defined(_M_X64) || defined(_M_IX86)
+  #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+  #include <immintrin.h>
+#endif
 #include "Beam/Routines/Routine.hpp"
 #include "Beam/Routines/SuspendedRoutineQueue.hpp"
 #include "Beam/Threading/LockRelease.hpp"
+#include "Beam/Threading/LockStatistics.hpp"
 #include "Beam/Threading/Threading.hpp"
 
+#ifndef BEAM_MUTEX_SPIN_COUNT
+  #define BEAM_MUTEX_SPIN_COUNT 100
+#endif
+
 namespace Beam {
 namespace Threading {
+namespace Details {
+
+  //! Hints to the processor that the calling thread is busy waiting.
+  inline void SpinPause() {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || \
+    defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+  }
+
+  /*! \class AdaptiveSpin
+      \brief Bounds how long a lock spins before suspending its Routine.
+      \details The bound tracks how many iterations recent successful spins
+               took and shrinks whenever spinning fails, so a lock whose
+               holder is usually suspended stops spinning on it.
+   */
+  class AdaptiveSpin {
+    public:
+
+      //! The maximum number of iterations to spin for.
+      static constexpr int MAX_SPIN_COUNT = BEAM_MUTEX_SPIN_COUNT;
+
+      //! Constructs an AdaptiveSpin.
+      AdaptiveSpin();
+
+      //! Spins until a condition holds or the bound is reached.
+      /*!
+        \param f The condition to test, returning <code>true</code> once
+               spinning should stop.
+        \return <code>true</code> iff the condition held before the bound was
+                reached.
+      */
+      template<typename F>
+      bool Spin(F&& f);
+
+    private:
+      std::atomic<int> m_estimate;
+  };
+
+  inline AdaptiveSpin::AdaptiveSpin()
+      : m_estimate(0) {}
+
+  template<typename F>
+  bool AdaptiveSpin::Spin(F&& f) {
+    static const auto IS_MULTIPROCESSOR =
+      boost::thread::hardware_concurrency() > 1;
+    if(MAX_SPIN_COUNT <= 0 || !IS_MULTIPROCESSOR) {
+      return f();
+    }
+    auto estimate = m_estimate.load(std::memory_order_relaxed);
+    auto limit = std::min(MAX_SPIN_COUNT, 2 * estimate + 10);
+    for(auto i = 0; i < limit; ++i) {
+      if(f()) {
+        m_estimate.store(estimate + (i - estimate) / 8,
+          std::memory_order_relaxed);
+        return true;
+      }
+      SpinPause();
+    }
+    m_estimate.store(estimate - estimate / 8, std::memory_order_relaxed);
+    return false;
+  }
+}
 
   /*! \class Mutex
       \brief Implements a mutex that suspends the current Routine.
+      \details A contended lock first spins for a short, adaptively bounded
+               period in case the holder is about to release it, and only
+               then suspends the Routine. Defining
+               BEAM_ENABLE_LOCK_INSTRUMENTATION records wait and hold times.
    */
   class Mutex : private boost::noncopyable {
     public:
@@ -30,10 +112,22 @@ namespace Threading {
       //! Unlocks this Mutex.
       void unlock();
 
+#ifdef BEAM_ENABLE_LOCK_INSTRUMENTATION
+      //! Returns the wait and hold times recorded for this Mutex.
+      const LockStatistics& GetStatistics() const;
+#endif
+
     private:
       boost::mutex m_mutex;
-      int m_counter;
+      std::atomic<int> m_counter;
       Routines::SuspendedRoutineQueue m_suspendedRoutines;
+      Details::AdaptiveSpin m_spin;
+#ifdef BEAM_ENABLE_LOCK_INSTRUMENTATION
+      std::chrono::steady_clock::time_point m_acquireTime;
+      LockStatistics m_statistics;
+#endif
+
+      void Acquire();
   };
 
   inline Mutex::Mutex()
@@ -44,15 +138,20 @@ namespace Threading {
   }
 
   inline void Mutex::lock() {
-    boost::unique_lock<boost::mutex> lock{m_mutex};
-    ++m_counter;
-    if(m_counter > 1) {
-      Routines::SuspendedRoutineNode currentRoutine;
-      m_suspendedRoutines.push_back(currentRoutine);
-      currentRoutine.m_routine->PendingSuspend();
-      auto release = Release(lock);
-      Routines::Suspend();
+#ifdef BEAM_ENABLE_LOCK_INSTRUMENTATION
+    auto start = std::chrono::steady_clock::now();
+#endif
+    if(!m_spin.Spin(
+        [&] {
+          return m_counter.load(std::memory_order_relaxed) == 0 &&
+            try_lock();
+        })) {
+      Acquire();
     }
+#ifdef BEAM_ENABLE_LOCK_INSTRUMENTATION
+    m_acquireTime = std::chrono::steady_clock::now();
+    m_statistics.m_waitTime.Record(m_acquireTime - start);
+#endif
   }
 
   inline bool Mutex::try_lock() {
@@ -61,10 +160,17 @@ namespace Threading {
       return false;
     }
     m_counter = 1;
+#ifdef BEAM_ENABLE_LOCK_INSTRUMENTATION
+    m_acquireTime = std::chrono::steady_clock::now();
+#endif
     return true;
   }
 
   inline void Mutex::unlock() {
+#ifdef BEAM_ENABLE_LOCK_INSTRUMENTATION
+    m_statistics.m_holdTime.Record(
+      std::chrono::steady_clock::now() - m_acquireTime);
+#endif
     Routines::Routine* routine;
     {
       boost::lock_guard<boost::mutex> lock{m_mutex};
@@ -77,6 +183,24 @@ namespace Threading {
     }
     Routines::Resume(routine);
   }
+
+#ifdef BEAM_ENABLE_LOCK_INSTRUMENTATION
+  inline const LockStatistics& Mutex::GetStatistics() const {
+    return m_statistics;
+  }
+#endif
+
+  inline void Mutex::Acquire() {
+    boost::unique_lock<boost::mutex> lock{m_mutex};
+    ++m_counter;
+    if(m_counter > 1) {
+      Routines::SuspendedRoutineNode currentRoutine;
+      m_suspendedRoutines.push_back(currentRoutine);
+      currentRoutine.m_routine->PendingSuspend();
+      auto release = Release(lock);
+      Routines::Suspend();
+    }
+  }
 }
 }
 
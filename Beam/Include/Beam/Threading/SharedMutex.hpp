@@ -0,0 +1,257 @@
+#ifndef BEAM_SHARED_MUTEX_HPP
+#define BEAM_SHARED_MUTEX_HPP
+#include <atomic>
+#include <boost/thread/lock_types.hpp>
+#include <boost/thread/mutex.hpp>
+#include "Beam/Routines/Routine.hpp"
+#include "Beam/Routines/SuspendedRoutineQueue.hpp"
+#include "Beam/Threading/LockRelease.hpp"
+#include "Beam/Threading/LockStatistics.hpp"
+#include "Beam/Threading/Mutex.hpp"
+#include "Beam/Threading/Threading.hpp"
+
+namespace Beam {
+namespace Threading {
+
+  /*! \class SharedMutex
+      \brief Implements a shared_mutex that suspends the current Routine.
+      \details Like Mutex, a contended lock spins briefly before suspending.
+               Ownership is handed directly to the Routines being resumed, so
+               a released lock can't be taken by a newcomer ahead of them.
+   */
+  class SharedMutex : private boost::noncopyable {
+    public:
+
+      //! Specifies which waiters are admitted first when the lock is
+      //! contended.
+      enum class Preference {
+
+        //! New readers share the lock as long as it isn't held exclusively,
+        //! even while writers are waiting.
+        READERS,
+
+        //! New readers wait behind any waiting writer and a released lock
+        //! goes to the next waiting writer before any waiting reader.
+        WRITERS
+      };
+
+      //! Constructs a SharedMutex that prefers writers.
+      SharedMutex();
+
+      //! Constructs a SharedMutex.
+      /*!
+        \param preference Which waiters are admitted first.
+      */
+      explicit SharedMutex(Preference preference);
+
+      ~SharedMutex();
+
+      //! Returns which waiters are admitted first.
+      Preference GetPreference() const;
+
+      //! Locks this SharedMutex exclusively.
+      void lock();
+
+      //! Tries to lock this SharedMutex exclusively.
+      bool try_lock();
+
+      //! Unlocks this SharedMutex from exclusive ownership.
+      void unlock();
+
+      //! Locks this SharedMutex in shared mode.
+      void lock_shared();
+
+      //! Tries to lock this SharedMutex in shared mode.
+      bool try_lock_shared();
+
+      //! Unlocks this SharedMutex from shared ownership.
+      void unlock_shared();
+
+#ifdef BEAM_ENABLE_LOCK_INSTRUMENTATION
+      //! Returns the wait and hold times recorded for this SharedMutex, hold
+      //! times are only recorded for exclusive ownership.
+      const LockStatistics& GetStatistics() const;
+#endif
+
+    private:
+      static constexpr int EXCLUSIVE = -1;
+      Preference m_preference;
+      boost::mutex m_mutex;
+
+      // EXCLUSIVE when held exclusively, otherwise the number of readers.
+      std::atomic<int> m_state;
+      Routines::SuspendedRoutineQueue m_suspendedReaders;
+      Routines::SuspendedRoutineQueue m_suspendedWriters;
+      Details::AdaptiveSpin m_spin;
+#ifdef BEAM_ENABLE_LOCK_INSTRUMENTATION
+      std::chrono::steady_clock::time_point m_acquireTime;
+      LockStatistics m_statistics;
+#endif
+
+      bool IsSharedAvailable() const;
+      void Acquire();
+      void AcquireShared();
+      void Suspend(Routines::SuspendedRoutineQueue& queue,
+        boost::unique_lock<boost::mutex>& lock);
+      void ResumeWriter();
+      void ResumeReaders();
+  };
+
+  inline SharedMutex::SharedMutex()
+      : SharedMutex(Preference::WRITERS) {}
+
+  inline SharedMutex::SharedMutex(Preference preference)
+      : m_preference(preference),
+        m_state(0) {}
+
+  inline SharedMutex::~SharedMutex() {
+    assert(m_state == 0);
+  }
+
+  inline SharedMutex::Preference SharedMutex::GetPreference() const {
+    return m_preference;
+  }
+
+  inline void SharedMutex::lock() {
+#ifdef BEAM_ENABLE_LOCK_INSTRUMENTATION
+    auto start = std::chrono::steady_clock::now();
+#endif
+    if(!m_spin.Spin(
+        [&] {
+          return m_state.load(std::memory_order_relaxed) == 0 && try_lock();
+        })) {
+      Acquire();
+    }
+#ifdef BEAM_ENABLE_LOCK_INSTRUMENTATION
+    m_acquireTime = std::chrono::steady_clock::now();
+    m_statistics.m_waitTime.Record(m_acquireTime - start);
+#endif
+  }
+
+  inline bool SharedMutex::try_lock() {
+    boost::lock_guard<boost::mutex> lock{m_mutex};
+    if(m_state != 0) {
+      return false;
+    }
+    m_state = EXCLUSIVE;
+#ifdef BEAM_ENABLE_LOCK_INSTRUMENTATION
+    m_acquireTime = std::chrono::steady_clock::now();
+#endif
+    return true;
+  }
+
+  inline void SharedMutex::unlock() {
+#ifdef BEAM_ENABLE_LOCK_INSTRUMENTATION
+    m_statistics.m_holdTime.Record(
+      std::chrono::steady_clock::now() - m_acquireTime);
+#endif
+    boost::lock_guard<boost::mutex> lock{m_mutex};
+    m_state = 0;
+    if(m_preference == Preference::READERS) {
+      if(!m_suspendedReaders.empty()) {
+        ResumeReaders();
+      } else {
+        ResumeWriter();
+      }
+    } else {
+      if(!m_suspendedWriters.empty()) {
+        ResumeWriter();
+      } else {
+        ResumeReaders();
+      }
+    }
+  }
+
+  inline void SharedMutex::lock_shared() {
+#ifdef BEAM_ENABLE_LOCK_INSTRUMENTATION
+    auto start = std::chrono::steady_clock::now();
+#endif
+    if(!m_spin.Spin(
+        [&] {
+          return m_state.load(std::memory_order_relaxed) != EXCLUSIVE &&
+            try_lock_shared();
+        })) {
+      AcquireShared();
+    }
+#ifdef BEAM_ENABLE_LOCK_INSTRUMENTATION
+    m_statistics.m_waitTime.Record(std::chrono::steady_clock::now() - start);
+#endif
+  }
+
+  inline bool SharedMutex::try_lock_shared() {
+    boost::lock_guard<boost::mutex> lock{m_mutex};
+    if(!IsSharedAvailable()) {
+      return false;
+    }
+    ++m_state;
+    return true;
+  }
+
+  inline void SharedMutex::unlock_shared() {
+    boost::lock_guard<boost::mutex> lock{m_mutex};
+    --m_state;
+    if(m_state == 0) {
+      ResumeWriter();
+    }
+  }
+
+#ifdef BEAM_ENABLE_LOCK_INSTRUMENTATION
+  inline const LockStatistics& SharedMutex::GetStatistics() const {
+    return m_statistics;
+  }
+#endif
+
+  inline bool SharedMutex::IsSharedAvailable() const {
+    return m_state != EXCLUSIVE && (m_preference == Preference::READERS ||
+      m_suspendedWriters.empty());
+  }
+
+  inline void SharedMutex::Acquire() {
+    boost::unique_lock<boost::mutex> lock{m_mutex};
+    if(m_state == 0) {
+      m_state = EXCLUSIVE;
+      return;
+    }
+    Suspend(m_suspendedWriters, lock);
+  }
+
+  inline void SharedMutex::AcquireShared() {
+    boost::unique_lock<boost::mutex> lock{m_mutex};
+    if(IsSharedAvailable()) {
+      ++m_state;
+      return;
+    }
+    Suspend(m_suspendedReaders, lock);
+  }
+
+  inline void SharedMutex::Suspend(Routines::SuspendedRoutineQueue& queue,
+      boost::unique_lock<boost::mutex>& lock) {
+    Routines::SuspendedRoutineNode currentRoutine;
+    queue.push_back(currentRoutine);
+    currentRoutine.m_routine->PendingSuspend();
+    auto release = Release(lock);
+    Routines::Suspend();
+  }
+
+  inline void SharedMutex::ResumeWriter() {
+    if(m_suspendedWriters.empty()) {
+      return;
+    }
+    m_state = EXCLUSIVE;
+    auto routine = m_suspendedWriters.front().m_routine;
+    m_suspendedWriters.pop_front();
+    Routines::Resume(routine);
+  }
+
+  inline void SharedMutex::ResumeReaders() {
+    while(!m_suspendedReaders.empty()) {
+      ++m_state;
+      auto routine = m_suspendedReaders.front().m_routine;
+      m_suspendedReaders.pop_front();
+      Routines::Resume(routine);
+    }
+  }
+}
+}
+
+#endif
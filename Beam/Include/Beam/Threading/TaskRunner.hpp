@@ -1,7 +1,6 @@
 #ifndef BEAM_TASKRUNNER_HPP
 #define BEAM_TASKRUNNER_HPP
-#include <deque>
-#include <functional>
+#include <vector>
 #include <boost/noncopyable.hpp>
 #include <boost/thread/condition_variable.hpp>
 #include <boost/thread/locks.hpp>
@@ -10,18 +9,21 @@
 #include "Beam/Threading/Threading.hpp"
 #include "Beam/Utilities/BeamWorkaround.hpp"
 #include "Beam/Utilities/ReportException.hpp"
+#include "Beam/Utilities/Task.hpp"
 
 namespace Beam {
 namespace Threading {
 
   /*! \class TaskRunner
       \brief Runs a series of tasks that get pushed.
+      \details All tasks pending when the runner picks up work are run as a
+               single batch.
    */
   class TaskRunner : private boost::noncopyable {
     public:
 
       //! Defines the type of a Task.
-      using Task = std::function<void ()>;
+      using Task = Beam::Task;
 
       //! Constructs a TaskRunner.
       TaskRunner();
@@ -41,7 +43,7 @@ namespace Threading {
     private:
       mutable boost::mutex m_mutex;
       bool m_handlingTasks;
-      std::deque<Task> m_pendingTasks;
+      std::vector<Task> m_pendingTasks;
       boost::condition_variable m_handlingTaskCondition;
 
       void HandleTasks(boost::unique_lock<boost::mutex>& lock);
@@ -60,7 +62,7 @@ namespace Threading {
   template<typename F>
   inline void TaskRunner::Add(F&& task) {
     boost::unique_lock<boost::mutex> lock(m_mutex);
-    m_pendingTasks.push_back(std::forward<F>(task));
+    m_pendingTasks.emplace_back(std::forward<F>(task));
     if(m_handlingTasks) {
       return;
     }
@@ -74,16 +76,19 @@ namespace Threading {
 
   inline void TaskRunner::HandleTasks(boost::unique_lock<boost::mutex>& lock) {
     m_handlingTasks = true;
+    std::vector<Task> tasks;
     while(!m_pendingTasks.empty()) {
-      Task task(std::move(m_pendingTasks.front()));
-      m_pendingTasks.pop_front();
+      tasks.swap(m_pendingTasks);
       {
         LockRelease<boost::unique_lock<boost::mutex>> release(lock);
-        try {
-          task();
-        } catch(const std::exception&) {
-          std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
+        for(auto& task : tasks) {
+          try {
+            task();
+          } catch(const std::exception&) {
+            std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
+          }
         }
+        tasks.clear();
       }
     }
     m_handlingTasks = false;
@@ -0,0 +1,52 @@
+#ifndef BEAM_THREAD_AFFINITY_HPP
+#define BEAM_THREAD_AFFINITY_HPP
+#include <cstddef>
+#include <boost/thread/thread.hpp>
+#ifdef _WIN32
+  #include <windows.h>
+#elif defined(__linux__)
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+#include "Beam/Threading/Threading.hpp"
+
+namespace Beam {
+namespace Threading {
+
+  //! Pins a thread to a single CPU.
+  /*!
+    \param thread The thread to pin.
+    \param cpu The index of the CPU to pin the thread to, taken modulo the
+           system's concurrency.
+    \return <code>true</code> iff the thread was pinned, platforms that do not
+            support thread affinity always return <code>false</code>.
+  */
+  inline bool SetThreadAffinity(boost::thread& thread, std::size_t cpu) {
+    auto concurrency = static_cast<std::size_t>(
+      boost::thread::hardware_concurrency());
+    if(concurrency != 0) {
+      cpu %= concurrency;
+    }
+#ifdef _WIN32
+    if(cpu >= 8 * sizeof(DWORD_PTR)) {
+      return false;
+    }
+    return ::SetThreadAffinityMask(thread.native_handle(),
+      DWORD_PTR(1) << cpu) != 0;
+#elif defined(__linux__)
+    if(cpu >= CPU_SETSIZE) {
+      return false;
+    }
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    return ::pthread_setaffinity_np(thread.native_handle(), sizeof(cpus),
+      &cpus) == 0;
+#else
+    return false;
+#endif
+  }
+}
+}
+
+#endif
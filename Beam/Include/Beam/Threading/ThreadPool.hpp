@@ -1,18 +1,24 @@
 #ifndef BEAM_THREADPOOL_HPP
 #define BEAM_THREADPOOL_HPP
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <deque>
-#include <functional>
 #include <iostream>
+#include <memory>
 #include <type_traits>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
 #include <boost/type_traits.hpp>
-#include "Beam/Pointers/Ref.hpp"
+#include "Beam/Pointers/Out.hpp"
 #include "Beam/Routines/Async.hpp"
-#include "Beam/Utilities/Algorithm.hpp"
-#include "Beam/Utilities/Functional.hpp"
+#include "Beam/Threading/Threading.hpp"
 #include "Beam/Utilities/ReportException.hpp"
 
 namespace Beam {
@@ -20,6 +26,9 @@ namespace Threading {
 
   /*! \class ThreadPool
       \brief Implements a thread pool for running Tasks.
+      \details Tasks are queued into a lane per Priority, an idle thread
+               always drains a higher Priority's lane before looking at a
+               lower one.
    */
   class ThreadPool : private boost::noncopyable {
     public:
@@ -31,7 +40,57 @@ namespace Threading {
           typename std::remove_pointer<F>::type>::result_type type;
       };
 
-      //! Constructs a ThreadPool.
+      //! Specifies the lane a task is queued in.
+      enum class Priority {
+
+        //! Latency sensitive tasks, run ahead of all others.
+        HIGH,
+
+        //! The default priority.
+        NORMAL,
+
+        //! Bulk tasks, run only when no other tasks are pending.
+        LOW
+      };
+
+      //! The number of priorities.
+      static constexpr auto PRIORITY_COUNT = std::size_t(3);
+
+      //! The number of seconds a thread above the minimum thread count waits
+      //! for a task before exiting.
+      static constexpr auto IDLE_TIMEOUT = 30;
+
+      //! The number of times a thread without a task yields and looks again
+      //! before waiting.
+      static constexpr auto SPIN_COUNT = 64;
+
+      /*! \struct Metrics
+          \brief Stores a snapshot of a ThreadPool's load.
+       */
+      struct Metrics {
+
+        //! The number of threads allocated.
+        std::size_t m_threadCount;
+
+        //! The number of threads waiting for a task.
+        std::size_t m_idleThreadCount;
+
+        //! The number of tasks queued but not yet started, per Priority.
+        std::array<std::size_t, PRIORITY_COUNT> m_queueDepths;
+
+        //! The number of tasks started, per Priority.
+        std::array<std::uint64_t, PRIORITY_COUNT> m_taskCounts;
+
+        //! The total time started tasks spent queued, per Priority.
+        std::array<boost::posix_time::time_duration, PRIORITY_COUNT>
+          m_totalWaitTimes;
+
+        //! The longest time a started task spent queued, per Priority.
+        std::array<boost::posix_time::time_duration, PRIORITY_COUNT>
+          m_maxWaitTimes;
+      };
+
+      //! Constructs a ThreadPool allocating up to one thread per core.
       ThreadPool();
 
       //! Constructs a ThreadPool.
@@ -40,12 +99,26 @@ namespace Threading {
       */
       ThreadPool(std::size_t maxThreadCount);
 
+      //! Constructs a ThreadPool.
+      /*!
+        \param minThreadCount The number of threads that are always
+               allocated.
+        \param maxThreadCount The maximum number of threads to allocate.
+      */
+      ThreadPool(std::size_t minThreadCount, std::size_t maxThreadCount);
+
       ~ThreadPool();
 
+      //! Returns the minimum thread count.
+      std::size_t GetMinThreadCount() const;
+
       //! Returns the maximum thread count.
       std::size_t GetMaxThreadCount() const;
 
-      //! Blocks until all running threads have completed.
+      //! Returns a snapshot of this pool's Metrics.
+      Metrics GetMetrics() const;
+
+      //! Blocks until all queued and running tasks have completed.
       void WaitForCompletion();
 
       //! Queues a function to be run within an allocated thread.
@@ -56,10 +129,20 @@ namespace Threading {
       template<typename F, typename R>
       void Queue(F&& function, Routines::Eval<R> result);
 
+      //! Queues a function to be run within an allocated thread.
+      /*!
+        \param function The function execute.
+        \param result The result of the <i>function</i>.
+        \param priority The Priority to run the <i>function</i> at.
+      */
+      template<typename F, typename R>
+      void Queue(F&& function, Routines::Eval<R> result, Priority priority);
+
     private:
-      class TaskThread;
       class BaseTask : private boost::noncopyable {
         public:
+          std::int64_t m_queueTime;
+
           BaseTask();
           virtual ~BaseTask();
           virtual void Run() = 0;
@@ -83,39 +166,54 @@ namespace Threading {
           F m_function;
           Routines::Eval<R> m_result;
       };
-      class TaskThread {
-        public:
-          TaskThread(ThreadPool& threadPool);
-          bool SetTask(BaseTask& task);
-          void Run();
-          void Stop();
+      struct WaitMetrics {
+        std::atomic<std::uint64_t> m_taskCount;
+        std::atomic<std::int64_t> m_totalWaitTime;
+        std::atomic<std::int64_t> m_maxWaitTime;
 
-        private:
-          boost::mutex m_mutex;
-          ThreadPool* m_threadPool;
-          BaseTask* volatile m_task;
-          volatile bool m_available;
-          volatile bool m_stopped;
-          boost::thread m_thread;
-          boost::condition_variable m_taskAvailableCondition;
+        WaitMetrics();
+      };
+      struct Worker {
+        bool m_isRunning;
+        std::array<WaitMetrics, PRIORITY_COUNT> m_waitMetrics;
+        boost::thread m_thread;
+
+        Worker();
+      };
+      struct Lane {
+        boost::mutex m_mutex;
+        std::deque<BaseTask*> m_tasks;
+        std::atomic<std::size_t> m_depth;
+
+        Lane();
       };
-      static constexpr auto LOWER_BOUND_WAIT_TIME = 30;
-      static constexpr auto UPPER_BOUND_WAIT_TIME = 60;
-      boost::mutex m_mutex;
+      std::size_t m_minThreadCount;
       std::size_t m_maxThreadCount;
-      std::size_t m_isWaitingForCompletion;
-      std::size_t m_runningThreads;
-      std::size_t m_activeThreads;
-      std::deque<TaskThread*> m_threads;
-      std::deque<BaseTask*> m_tasks;
+      std::unique_ptr<Worker[]> m_workers;
+      std::array<Lane, PRIORITY_COUNT> m_lanes;
+      std::atomic<std::size_t> m_outstandingCount;
+      std::atomic<std::size_t> m_threadCount;
+      std::atomic<std::size_t> m_idleCount;
+      mutable boost::mutex m_mutex;
+      std::size_t m_signalCount;
+      bool m_isStopping;
+      boost::condition_variable m_taskAvailableCondition;
+      boost::condition_variable m_tasksCompletedCondition;
       boost::condition_variable m_threadsFinishedCondition;
 
-      void QueueTask(BaseTask& task);
-      bool AddThread(TaskThread& taskThread);
-      void RemoveThread(TaskThread& taskThread);
+      static std::int64_t GetTimestamp();
+      static boost::posix_time::time_duration ToDuration(
+        std::int64_t nanoseconds);
+      bool HasPendingTasks() const;
+      void QueueTask(BaseTask& task, Priority priority);
+      void AddWorker();
+      BaseTask* Pop(Out<std::size_t> lane);
+      void Execute(Worker& worker, BaseTask& task, std::size_t lane);
+      void Run(Worker& worker);
   };
 
-  inline ThreadPool::BaseTask::BaseTask() {}
+  inline ThreadPool::BaseTask::BaseTask()
+    : m_queueTime(0) {}
 
   inline ThreadPool::BaseTask::~BaseTask() {}
 
@@ -151,172 +249,258 @@ namespace Threading {
     Invoker<F, R>()(m_function, std::move(m_result));
   }
 
-  inline ThreadPool::TaskThread::TaskThread(ThreadPool& threadPool)
-      : m_threadPool(&threadPool),
-        m_task(nullptr),
-        m_available(true),
-        m_stopped(false) {
-    m_thread = boost::thread(std::bind(&TaskThread::Run, this));
-  }
-
-  inline bool ThreadPool::TaskThread::SetTask(BaseTask& task) {
-    boost::lock_guard<boost::mutex> lock(m_mutex);
-    assert(m_task == nullptr);
-    if(!m_available) {
-      return false;
-    }
-    m_task = &task;
-    m_taskAvailableCondition.notify_one();
-    return true;
-  }
+  inline ThreadPool::WaitMetrics::WaitMetrics()
+    : m_taskCount(0),
+      m_totalWaitTime(0),
+      m_maxWaitTime(0) {}
 
-  inline void ThreadPool::TaskThread::Run() {
-    while(true) {
-      {
-        boost::unique_lock<boost::mutex> lock(m_mutex);
-        if(m_task == nullptr) {
-          boost::posix_time::time_duration waitTime =
-            boost::posix_time::seconds(LOWER_BOUND_WAIT_TIME) +
-            boost::posix_time::seconds(rand() % (UPPER_BOUND_WAIT_TIME -
-            LOWER_BOUND_WAIT_TIME));
-          if(!m_available ||
-              (!m_taskAvailableCondition.timed_wait(lock, waitTime) &&
-              m_task == nullptr) || !m_available) {
-            m_available = false;
-            bool stopped = m_stopped;
-            lock.unlock();
-            if(!stopped) {
-              m_threadPool->RemoveThread(*this);
-            }
-            delete this;
-            return;
-          }
-        }
-        assert(m_available);
-        try {
-          m_task->Run();
-        } catch(...) {
-          std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
-        }
-        delete m_task;
-        m_task = nullptr;
-      }
-      if(!m_threadPool->AddThread(*this)) {
-        delete this;
-        return;
-      }
-    }
-  }
+  inline ThreadPool::Worker::Worker()
+    : m_isRunning(false) {}
 
-  inline void ThreadPool::TaskThread::Stop() {
-    boost::lock_guard<boost::mutex> lock(m_mutex);
-    m_available = false;
-    m_stopped = true;
-    m_task = nullptr;
-    m_taskAvailableCondition.notify_all();
-  }
+  inline ThreadPool::Lane::Lane()
+    : m_depth(0) {}
 
   inline ThreadPool::ThreadPool()
-      : m_maxThreadCount(boost::thread::hardware_concurrency()),
-        m_runningThreads(0),
-        m_activeThreads(0),
-        m_isWaitingForCompletion(false) {}
+    : ThreadPool(boost::thread::hardware_concurrency()) {}
 
   inline ThreadPool::ThreadPool(std::size_t maxThreadCount)
-      : m_maxThreadCount(maxThreadCount),
-        m_runningThreads(0),
-        m_activeThreads(0),
-        m_isWaitingForCompletion(false) {}
+    : ThreadPool(0, maxThreadCount) {}
+
+  inline ThreadPool::ThreadPool(std::size_t minThreadCount,
+      std::size_t maxThreadCount)
+      : m_minThreadCount(std::min(minThreadCount,
+          std::max<std::size_t>(maxThreadCount, 1))),
+        m_maxThreadCount(std::max<std::size_t>(maxThreadCount, 1)),
+        m_workers(std::make_unique<Worker[]>(
+          std::max<std::size_t>(maxThreadCount, 1))),
+        m_outstandingCount(0),
+        m_threadCount(0),
+        m_idleCount(0),
+        m_signalCount(0),
+        m_isStopping(false) {
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+    while(m_threadCount.load() < m_minThreadCount) {
+      AddWorker();
+    }
+  }
 
   inline ThreadPool::~ThreadPool() {
-    boost::unique_lock<boost::mutex> lock(m_mutex);
-    m_isWaitingForCompletion = true;
-    m_maxThreadCount = 0;
-    while(!m_threads.empty()) {
-      TaskThread* taskThread = m_threads.back();
-      taskThread->Stop();
-      m_threads.pop_back();
+    {
+      boost::unique_lock<boost::mutex> lock(m_mutex);
+      m_isStopping = true;
+      m_taskAvailableCondition.notify_all();
+      while(m_threadCount.load() != 0) {
+        m_threadsFinishedCondition.wait(lock);
+      }
     }
-    if(m_activeThreads != 0) {
-      m_threadsFinishedCondition.wait(lock);
+    for(auto i = std::size_t(0); i != m_maxThreadCount; ++i) {
+      if(m_workers[i].m_thread.joinable()) {
+        m_workers[i].m_thread.join();
+      }
     }
   }
 
+  inline std::size_t ThreadPool::GetMinThreadCount() const {
+    return m_minThreadCount;
+  }
+
   inline std::size_t ThreadPool::GetMaxThreadCount() const {
     return m_maxThreadCount;
   }
 
+  inline ThreadPool::Metrics ThreadPool::GetMetrics() const {
+    auto metrics = Metrics();
+    metrics.m_threadCount = m_threadCount.load();
+    metrics.m_idleThreadCount = m_idleCount.load();
+    for(auto i = std::size_t(0); i != PRIORITY_COUNT; ++i) {
+      metrics.m_queueDepths[i] = m_lanes[i].m_depth.load();
+      auto taskCount = std::uint64_t(0);
+      auto totalWaitTime = std::int64_t(0);
+      auto maxWaitTime = std::int64_t(0);
+      for(auto j = std::size_t(0); j != m_maxThreadCount; ++j) {
+        auto& waitMetrics = m_workers[j].m_waitMetrics[i];
+        taskCount += waitMetrics.m_taskCount.load(std::memory_order_relaxed);
+        totalWaitTime +=
+          waitMetrics.m_totalWaitTime.load(std::memory_order_relaxed);
+        maxWaitTime = std::max(maxWaitTime,
+          waitMetrics.m_maxWaitTime.load(std::memory_order_relaxed));
+      }
+      metrics.m_taskCounts[i] = taskCount;
+      metrics.m_totalWaitTimes[i] = ToDuration(totalWaitTime);
+      metrics.m_maxWaitTimes[i] = ToDuration(maxWaitTime);
+    }
+    return metrics;
+  }
+
   inline void ThreadPool::WaitForCompletion() {
     boost::unique_lock<boost::mutex> lock(m_mutex);
-    m_isWaitingForCompletion = true;
-    while(m_activeThreads != 0) {
-      m_threadsFinishedCondition.wait(lock);
+    while(m_outstandingCount.load() != 0) {
+      m_tasksCompletedCondition.wait(lock);
     }
-    m_isWaitingForCompletion = false;
   }
 
   template<typename F, typename R>
   void ThreadPool::Queue(F&& function, Routines::Eval<R> result) {
-    Task<F, R>* task = new Task<F, R>(std::forward<F>(function),
+    Queue(std::forward<F>(function), std::move(result), Priority::NORMAL);
+  }
+
+  template<typename F, typename R>
+  void ThreadPool::Queue(F&& function, Routines::Eval<R> result,
+      Priority priority) {
+    auto task = new Task<std::decay_t<F>, R>(std::forward<F>(function),
       std::move(result));
-    QueueTask(*task);
+    QueueTask(*task, priority);
+  }
+
+  inline std::int64_t ThreadPool::GetTimestamp() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  inline boost::posix_time::time_duration ThreadPool::ToDuration(
+      std::int64_t nanoseconds) {
+    return boost::posix_time::microseconds(nanoseconds / 1000);
   }
 
-  inline void ThreadPool::QueueTask(BaseTask& task) {
+  inline bool ThreadPool::HasPendingTasks() const {
+    return std::any_of(m_lanes.begin(), m_lanes.end(),
+      [] (const Lane& lane) {
+        return lane.m_depth.load() != 0;
+      });
+  }
+
+  inline void ThreadPool::QueueTask(BaseTask& task, Priority priority) {
+    auto index = static_cast<std::size_t>(priority);
+    auto& lane = m_lanes[index];
+    task.m_queueTime = GetTimestamp();
+    m_outstandingCount.fetch_add(1);
+    lane.m_depth.fetch_add(1);
+    {
+      boost::lock_guard<boost::mutex> lock(lane.m_mutex);
+      lane.m_tasks.push_back(&task);
+    }
+    if(m_idleCount.load() == 0 && m_threadCount.load() >= m_maxThreadCount) {
+      return;
+    }
     boost::lock_guard<boost::mutex> lock(m_mutex);
-    bool threadFound = false;
-    while(!threadFound) {
-      if(m_threads.empty() && m_runningThreads < m_maxThreadCount) {
-        TaskThread* taskThread = new TaskThread(*this);
-        taskThread->SetTask(task);
-        ++m_activeThreads;
-        ++m_runningThreads;
-        return;
-      } else if(!m_tasks.empty() || m_threads.empty()) {
-        m_tasks.push_back(&task);
-        return;
+    if(m_idleCount.load() != 0) {
+      m_idleCount.fetch_sub(1);
+      ++m_signalCount;
+      m_taskAvailableCondition.notify_one();
+    } else if(m_threadCount.load() < m_maxThreadCount && !m_isStopping) {
+      AddWorker();
+    }
+  }
+
+  inline void ThreadPool::AddWorker() {
+    for(auto i = std::size_t(0); i != m_maxThreadCount; ++i) {
+      auto& worker = m_workers[i];
+      if(worker.m_isRunning) {
+        continue;
       }
-      TaskThread* taskThread = m_threads.front();
-      m_threads.pop_front();
-      threadFound = taskThread->SetTask(task);
-      if(threadFound) {
-        ++m_activeThreads;
+      if(worker.m_thread.joinable()) {
+        worker.m_thread.join();
       }
+      worker.m_isRunning = true;
+      m_threadCount.fetch_add(1);
+      worker.m_thread = boost::thread(
+        [this, &worker] {
+          Run(worker);
+        });
+      return;
     }
   }
 
-  inline bool ThreadPool::AddThread(TaskThread& taskThread) {
-    boost::lock_guard<boost::mutex> lock(m_mutex);
-    if(m_maxThreadCount == 0) {
-      --m_activeThreads;
-      --m_runningThreads;
-      if(m_activeThreads == 0) {
-        m_threadsFinishedCondition.notify_all();
+  inline ThreadPool::BaseTask* ThreadPool::Pop(Out<std::size_t> lane) {
+    for(auto i = std::size_t(0); i != PRIORITY_COUNT; ++i) {
+      if(m_lanes[i].m_depth.load(std::memory_order_relaxed) == 0) {
+        continue;
       }
-      return false;
-    }
-    if(m_tasks.empty()) {
-      m_threads.push_back(&taskThread);
-      --m_activeThreads;
-      if(m_isWaitingForCompletion && m_activeThreads == 0) {
-        m_threadsFinishedCondition.notify_all();
+      boost::lock_guard<boost::mutex> lock(m_lanes[i].m_mutex);
+      if(!m_lanes[i].m_tasks.empty()) {
+        auto task = m_lanes[i].m_tasks.front();
+        m_lanes[i].m_tasks.pop_front();
+        *lane = i;
+        return task;
       }
-      return true;
     }
-    BaseTask* task = m_tasks.front();
-    if(!taskThread.SetTask(*task)) {
-      --m_activeThreads;
-      --m_runningThreads;
-      return false;
+    return nullptr;
+  }
+
+  inline void ThreadPool::Execute(Worker& worker, BaseTask& task,
+      std::size_t lane) {
+    m_lanes[lane].m_depth.fetch_sub(1);
+    auto waitTime = GetTimestamp() - task.m_queueTime;
+    auto& metrics = worker.m_waitMetrics[lane];
+    metrics.m_taskCount.store(
+      metrics.m_taskCount.load(std::memory_order_relaxed) + 1,
+      std::memory_order_relaxed);
+    metrics.m_totalWaitTime.store(
+      metrics.m_totalWaitTime.load(std::memory_order_relaxed) + waitTime,
+      std::memory_order_relaxed);
+    if(waitTime > metrics.m_maxWaitTime.load(std::memory_order_relaxed)) {
+      metrics.m_maxWaitTime.store(waitTime, std::memory_order_relaxed);
+    }
+    try {
+      task.Run();
+    } catch(...) {
+      std::cout << BEAM_REPORT_CURRENT_EXCEPTION() << std::flush;
+    }
+    delete &task;
+    if(m_outstandingCount.fetch_sub(1) == 1) {
+      boost::lock_guard<boost::mutex> lock(m_mutex);
+      m_tasksCompletedCondition.notify_all();
     }
-    m_tasks.pop_front();
-    return true;
   }
 
-  inline void ThreadPool::RemoveThread(TaskThread& taskThread) {
-    boost::lock_guard<boost::mutex> lock(m_mutex);
-    --m_runningThreads;
-    RemoveFirst(m_threads, &taskThread);
+  inline void ThreadPool::Run(Worker& worker) {
+    auto spinCount = 0;
+    while(true) {
+      auto lane = std::size_t(0);
+      if(auto task = Pop(Store(lane))) {
+        Execute(worker, *task, lane);
+        spinCount = 0;
+        continue;
+      }
+      if(spinCount < SPIN_COUNT) {
+        ++spinCount;
+        boost::this_thread::yield();
+        continue;
+      }
+      spinCount = 0;
+      boost::unique_lock<boost::mutex> lock(m_mutex);
+      m_idleCount.fetch_add(1);
+      if(HasPendingTasks()) {
+        m_idleCount.fetch_sub(1);
+        continue;
+      }
+      if(m_isStopping) {
+        m_idleCount.fetch_sub(1);
+        m_threadCount.fetch_sub(1);
+        worker.m_isRunning = false;
+        m_threadsFinishedCondition.notify_all();
+        return;
+      }
+      auto isTimedOut = false;
+      if(m_threadCount.load() > m_minThreadCount) {
+        isTimedOut = !m_taskAvailableCondition.timed_wait(lock,
+          boost::posix_time::seconds(IDLE_TIMEOUT));
+      } else {
+        m_taskAvailableCondition.wait(lock);
+      }
+      if(m_signalCount != 0) {
+        --m_signalCount;
+        continue;
+      }
+      if(isTimedOut && !HasPendingTasks() && !m_isStopping &&
+          m_threadCount.load() > m_minThreadCount) {
+        m_threadCount.fetch_sub(1);
+        m_idleCount.fetch_sub(1);
+        worker.m_isRunning = false;
+        return;
+      }
+      m_idleCount.fetch_sub(1);
+    }
   }
 }
 }
@@ -5,12 +5,16 @@ namespace Beam {
 namespace Threading {
   template<typename MutexType> class CallOnce;
   class ConditionVariable;
+  class IoServiceGroup;
+  class LatencyHistogram;
   class LiveTimer;
   template<typename LockType> class LockRelease;
+  struct LockStatistics;
   class Mutex;
   template<bool Acquire, typename MutexType> class OptionalLock;
   template<typename MutexType> struct PreferredConditionVariable;
   class RecursiveMutex;
+  class SharedMutex;
   template<typename T, typename MutexType> class Sync;
   class TaskRunner;
   class ThreadPool;
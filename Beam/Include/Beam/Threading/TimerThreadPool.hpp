@@ -4,6 +4,7 @@
 #include <boost/asio/io_service.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/thread/thread.hpp>
+#include "Beam/Threading/IoServiceGroup.hpp"
 #include "Beam/Threading/Threading.hpp"
 
 namespace Beam {
@@ -11,10 +12,16 @@ namespace Threading {
 
   /*! \class TimerThreadPool
       \brief Provides the thread pool used by Timer implementations.
+      \details Supports the same sharded modes as the SocketThreadPool, in
+               which case each timer's expiry is always handled by the same
+               thread.
    */
   class TimerThreadPool : private boost::noncopyable {
     public:
 
+      //! Specifies how timers are assigned to a thread.
+      using Assignment = IoServiceGroup::Assignment;
+
       //! Constructs a TimerThreadPool.
       TimerThreadPool();
 
@@ -24,42 +31,67 @@ namespace Threading {
       */
       TimerThreadPool(std::size_t threadCount);
 
-      ~TimerThreadPool();
+      //! Constructs a TimerThreadPool.
+      /*!
+        \param threadCount The number of threads to use.
+        \param assignment How timers are assigned to a thread.
+        \param isPinned Whether each thread is pinned to its own CPU.
+      */
+      TimerThreadPool(std::size_t threadCount, Assignment assignment,
+        bool isPinned = false);
+
+      //! Returns the number of threads used.
+      std::size_t GetThreadCount() const;
+
+      //! Returns how timers are assigned to a thread.
+      Assignment GetAssignment() const;
+
+      //! Returns the number of shards, 1 when unsharded and one per thread
+      //! otherwise.
+      std::size_t GetShardCount() const;
+
+      //! Returns the number of timers currently assigned to a shard.
+      /*!
+        \param shard The index of the shard.
+      */
+      std::size_t GetTimerCount(std::size_t shard) const;
 
     private:
       friend class LiveTimer;
-      boost::asio::io_service m_service;
-      boost::asio::io_service::work m_work;
-      std::size_t m_threadCount;
-      std::unique_ptr<boost::thread[]> m_threads;
+      IoServiceGroup m_services;
 
-      boost::asio::io_service& GetService();
+      std::shared_ptr<boost::asio::io_service> GetService();
   };
 
   inline TimerThreadPool::TimerThreadPool()
       : TimerThreadPool(boost::thread::hardware_concurrency()) {}
 
   inline TimerThreadPool::TimerThreadPool(std::size_t threadCount)
-      : m_work(m_service),
-        m_threadCount(threadCount),
-        m_threads(std::make_unique<boost::thread[]>(m_threadCount)) {
-    for(std::size_t i = 0; i < m_threadCount; ++i) {
-      m_threads[i] = boost::thread(
-        [=] {
-          m_service.run();
-        });
-    }
+      : TimerThreadPool(threadCount, Assignment::SHARED) {}
+
+  inline TimerThreadPool::TimerThreadPool(std::size_t threadCount,
+      Assignment assignment, bool isPinned)
+      : m_services(threadCount, assignment, isPinned) {}
+
+  inline std::size_t TimerThreadPool::GetThreadCount() const {
+    return m_services.GetThreadCount();
+  }
+
+  inline TimerThreadPool::Assignment TimerThreadPool::GetAssignment() const {
+    return m_services.GetAssignment();
+  }
+
+  inline std::size_t TimerThreadPool::GetShardCount() const {
+    return m_services.GetServiceCount();
   }
 
-  inline TimerThreadPool::~TimerThreadPool() {
-    m_service.stop();
-    for(std::size_t i = 0; i < m_threadCount; ++i) {
-      m_threads[i].join();
-    }
+  inline std::size_t TimerThreadPool::GetTimerCount(std::size_t shard) const {
+    return m_services.GetLoad(shard);
   }
 
-  inline boost::asio::io_service& TimerThreadPool::GetService() {
-    return m_service;
+  inline std::shared_ptr<boost::asio::io_service>
+      TimerThreadPool::GetService() {
+    return m_services.Acquire();
   }
 }
 }
@@ -1,6 +1,11 @@
 #ifndef BEAM_LOCAL_TIME_CLIENT_HPP
 #define BEAM_LOCAL_TIME_CLIENT_HPP
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <boost/date_time/posix_time/posix_time_duration.hpp>
+#include "Beam/TimeService/MonotonicClock.hpp"
+#include "Beam/TimeService/TimeOrigin.hpp"
 #include "Beam/TimeService/TimeService.hpp"
 
 namespace Beam::TimeService {
@@ -9,18 +14,68 @@ namespace Beam::TimeService {
   class LocalTimeClient {
     public:
 
+      /**
+       * The number of nanoseconds between synchronizations of a TSC clock
+       * with the computer's clock.
+       */
+      static constexpr auto SYNCHRONIZATION_PERIOD =
+        std::int64_t(1000000000);
+
       /** Constructs a LocalTimeClient. */
       LocalTimeClient() = default;
 
+      /**
+       * Constructs a LocalTimeClient.
+       * @param source The preferred source of the clock. With a TSC the
+       *        computer's clock is only read once per SYNCHRONIZATION_PERIOD
+       *        and differences to it are slewed in.
+       */
+      explicit LocalTimeClient(MonotonicClock::Source source);
+
       boost::posix_time::ptime GetTime();
 
       void Open();
 
       void Close();
+
+    private:
+      struct FastClock {
+        TimeOrigin m_origin;
+        std::atomic<std::int64_t> m_nextSynchronization;
+
+        FastClock(MonotonicClock clock);
+      };
+      std::shared_ptr<FastClock> m_fastClock;
   };
 
+  inline LocalTimeClient::FastClock::FastClock(MonotonicClock clock)
+      : m_origin(clock),
+        m_nextSynchronization(clock.GetNanoseconds() + SYNCHRONIZATION_PERIOD) {
+    m_origin.Set(boost::posix_time::microsec_clock::universal_time());
+  }
+
+  inline LocalTimeClient::LocalTimeClient(MonotonicClock::Source source) {
+    auto clock = MonotonicClock(source);
+    if(clock.GetSource() == MonotonicClock::Source::STEADY) {
+      return;
+    }
+    m_fastClock = std::make_shared<FastClock>(clock);
+  }
+
   inline boost::posix_time::ptime LocalTimeClient::GetTime() {
-    return boost::posix_time::microsec_clock::universal_time();
+    if(!m_fastClock) {
+      return boost::posix_time::microsec_clock::universal_time();
+    }
+    auto clock = m_fastClock->m_origin.GetClock().GetNanoseconds();
+    auto next = m_fastClock->m_nextSynchronization.load(
+      std::memory_order_relaxed);
+    if(clock >= next &&
+        m_fastClock->m_nextSynchronization.compare_exchange_strong(next,
+        clock + SYNCHRONIZATION_PERIOD, std::memory_order_relaxed)) {
+      m_fastClock->m_origin.Synchronize(
+        boost::posix_time::microsec_clock::universal_time());
+    }
+    return m_fastClock->m_origin.GetTime();
   }
 
   inline void LocalTimeClient::Open() {}
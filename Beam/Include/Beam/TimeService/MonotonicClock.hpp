@@ -0,0 +1,142 @@
+#ifndef BEAM_MONOTONIC_CLOCK_HPP
+#define BEAM_MONOTONIC_CLOCK_HPP
+#include <chrono>
+#include <cstdint>
+#include "Beam/TimeService/TimeService.hpp"
+#if defined(_M_X64) || defined(__x86_64__)
+  #define BEAM_TIME_SERVICE_USE_TSC
+  #ifdef _MSC_VER
+    #include <intrin.h>
+  #else
+    #include <cpuid.h>
+    #include <x86intrin.h>
+  #endif
+#endif
+
+namespace Beam::TimeService {
+namespace Details {
+#ifdef BEAM_TIME_SERVICE_USE_TSC
+  inline bool HasInvariantTsc() {
+    #ifdef _MSC_VER
+      int registers[4];
+      __cpuid(registers, 0x80000000);
+      if(static_cast<unsigned int>(registers[0]) < 0x80000007) {
+        return false;
+      }
+      __cpuid(registers, 0x80000007);
+      return (registers[3] & (1 << 8)) != 0;
+    #else
+      unsigned int eax, ebx, ecx, edx;
+      if(__get_cpuid_max(0x80000000, nullptr) < 0x80000007) {
+        return false;
+      }
+      __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+      return (edx & (1 << 8)) != 0;
+    #endif
+  }
+#endif
+
+  inline std::int64_t GetSteadyNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+}
+
+  /**
+   * A monotonic clock measured in nanoseconds, read either from the steady
+   * clock or from the CPU's time stamp counter calibrated against it.
+   */
+  class MonotonicClock {
+    public:
+
+      /** The source of the clock's readings. */
+      enum class Source {
+
+        /** std::chrono::steady_clock. */
+        STEADY,
+
+        /** The invariant time stamp counter, where one is available. */
+        TSC
+      };
+
+      /** Constructs a MonotonicClock reading from the steady clock. */
+      MonotonicClock();
+
+      /**
+       * Constructs a MonotonicClock.
+       * @param source The preferred source, a TSC is calibrated for roughly
+       *        10 milliseconds and the steady clock is used when the CPU has
+       *        no invariant TSC.
+       */
+      explicit MonotonicClock(Source source);
+
+      /** Returns the source the clock reads from. */
+      Source GetSource() const;
+
+      /** Returns the number of nanoseconds since an arbitrary epoch. */
+      std::int64_t GetNanoseconds() const;
+
+    private:
+      Source m_source;
+      std::int64_t m_baseNanoseconds;
+      std::uint64_t m_baseTicks;
+      double m_nanosecondsPerTick;
+
+      void Calibrate();
+  };
+
+  inline MonotonicClock::MonotonicClock()
+    : MonotonicClock(Source::STEADY) {}
+
+  inline MonotonicClock::MonotonicClock(Source source)
+      : m_source(Source::STEADY),
+        m_baseNanoseconds(0),
+        m_baseTicks(0),
+        m_nanosecondsPerTick(0) {
+#ifdef BEAM_TIME_SERVICE_USE_TSC
+    if(source == Source::TSC && Details::HasInvariantTsc()) {
+      Calibrate();
+    }
+#endif
+  }
+
+  inline MonotonicClock::Source MonotonicClock::GetSource() const {
+    return m_source;
+  }
+
+  inline std::int64_t MonotonicClock::GetNanoseconds() const {
+#ifdef BEAM_TIME_SERVICE_USE_TSC
+    if(m_source == Source::TSC) {
+      auto ticks = static_cast<std::int64_t>(__rdtsc() - m_baseTicks);
+      return m_baseNanoseconds + static_cast<std::int64_t>(
+        static_cast<double>(ticks) * m_nanosecondsPerTick);
+    }
+#endif
+    return Details::GetSteadyNanoseconds();
+  }
+
+  inline void MonotonicClock::Calibrate() {
+#ifdef BEAM_TIME_SERVICE_USE_TSC
+    const auto CALIBRATION_PERIOD = std::int64_t(10000000);
+    auto startNanoseconds = Details::GetSteadyNanoseconds();
+    auto startTicks = __rdtsc();
+    auto endNanoseconds = startNanoseconds;
+    auto endTicks = startTicks;
+    while(endNanoseconds - startNanoseconds < CALIBRATION_PERIOD) {
+      endNanoseconds = Details::GetSteadyNanoseconds();
+      endTicks = __rdtsc();
+    }
+    if(endTicks <= startTicks) {
+      return;
+    }
+    m_nanosecondsPerTick =
+      static_cast<double>(endNanoseconds - startNanoseconds) /
+      static_cast<double>(endTicks - startTicks);
+    m_baseNanoseconds = endNanoseconds;
+    m_baseTicks = endTicks;
+    m_source = Source::TSC;
+#endif
+  }
+}
+
+#endif
@@ -3,7 +3,6 @@
 #include <array>
 #include <cstdint>
 #include <vector>
-#include <boost/chrono/system_clocks.hpp>
 #include <boost/date_time/posix_time/posix_time_duration.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/throw_exception.hpp>
@@ -14,10 +13,11 @@
 #include "Beam/Network/UdpSocketChannel.hpp"
 #include "Beam/Pointers/LocalPtr.hpp"
 #include "Beam/Queues/RoutineTaskQueue.hpp"
+#include "Beam/TimeService/MonotonicClock.hpp"
 #include "Beam/TimeService/TimeClient.hpp"
+#include "Beam/TimeService/TimeOrigin.hpp"
 #include "Beam/TimeService/TimeService.hpp"
 #include "Beam/Threading/LiveTimer.hpp"
-#include "Beam/Threading/Sync.hpp"
 #include "Beam/Threading/Timer.hpp"
 #include "Beam/Utilities/ReportException.hpp"
 
@@ -45,6 +45,9 @@ namespace TimeService {
 
   /*! \class NtpTimeClient
       \brief Implements a TimeClient using the NTP protocol.
+             Reading the time takes no lock, and offsets measured after the
+             first synchronization are slewed in gradually unless they exceed
+             TimeOrigin::STEP_THRESHOLD.
       \tparam ChannelType The type of Channel used to synchronize with the NTP
               server.
       \tparam TimerType The type of Timer used to specify the synchronization
@@ -65,10 +68,11 @@ namespace TimeService {
         \param sources The list of NTP servers to query for time.
         \param timer Initializes the Timer used to specify the synchronization
                period.
+        \param clock The clock used to measure time between synchronizations.
       */
       template<typename TimerForward>
       NtpTimeClient(std::vector<std::unique_ptr<Channel>> sources,
-        TimerForward&& timer);
+        TimerForward&& timer, MonotonicClock clock = MonotonicClock());
 
       ~NtpTimeClient();
 
@@ -79,13 +83,9 @@ namespace TimeService {
       void Close();
 
     private:
-      struct Origin {
-        boost::posix_time::ptime m_startTime;
-        boost::chrono::steady_clock::time_point m_startPoint;
-      };
       std::vector<std::unique_ptr<Channel>> m_sources;
       GetOptionalLocalPtr<TimerType> m_timer;
-      Threading::Sync<Origin> m_origin;
+      TimeOrigin m_origin;
       IO::OpenState m_openState;
       RoutineTaskQueue m_callbacks;
 
@@ -153,12 +153,15 @@ namespace TimeService {
     \param socketThreadPool The SocketThreadPool used by the UdpSocketChannels.
     \param timerThreadPool The TimerThreadPool used to pace the synchronization
            points.
+    \param clock The preferred source of the clock used between
+           synchronizations.
     \return A LiveNtpTimeClient using the specified list of <i>sources</i>.
   */
   inline std::unique_ptr<LiveNtpTimeClient> MakeLiveNtpTimeClient(
       const std::vector<Network::IpAddress>& sources,
       Ref<Network::SocketThreadPool> socketThreadPool,
-      Ref<Threading::TimerThreadPool> timerThreadPool) {
+      Ref<Threading::TimerThreadPool> timerThreadPool,
+      MonotonicClock::Source clock = MonotonicClock::Source::STEADY) {
     std::vector<std::unique_ptr<Network::UdpSocketChannel>> channels;
     for(auto& source : sources) {
       auto channel = std::make_unique<Network::UdpSocketChannel>(source,
@@ -169,15 +172,18 @@ namespace TimeService {
       channels.push_back(std::move(channel));
     }
     return std::make_unique<LiveNtpTimeClient>(std::move(channels),
-      Initialize(boost::posix_time::minutes(30), Ref(timerThreadPool)));
+      Initialize(boost::posix_time::minutes(30), Ref(timerThreadPool)),
+      MonotonicClock(clock));
   }
 
   template<typename ChannelType, typename TimerType>
   template<typename TimerForward>
   NtpTimeClient<ChannelType, TimerType>::NtpTimeClient(
-      std::vector<std::unique_ptr<Channel>> sources, TimerForward&& timer)
+      std::vector<std::unique_ptr<Channel>> sources, TimerForward&& timer,
+      MonotonicClock clock)
       : m_sources(std::move(sources)),
-        m_timer{std::forward<TimerForward>(timer)} {}
+        m_timer{std::forward<TimerForward>(timer)},
+        m_origin(clock) {}
 
   template<typename ChannelType, typename TimerType>
   NtpTimeClient<ChannelType, TimerType>::~NtpTimeClient() {
@@ -186,13 +192,7 @@ namespace TimeService {
 
   template<typename ChannelType, typename TimerType>
   boost::posix_time::ptime NtpTimeClient<ChannelType, TimerType>::GetTime() {
-    auto time = Threading::With(m_origin,
-      [&] (const Origin& origin) {
-        return origin.m_startTime + boost::posix_time::microseconds(
-          (boost::chrono::steady_clock::now().time_since_epoch() -
-          origin.m_startPoint.time_since_epoch()).count() / 1000);
-      });
-    return Truncate(time, boost::posix_time::milliseconds(1));
+    return m_origin.GetTime();
   }
 
   template<typename ChannelType, typename TimerType>
@@ -285,12 +285,8 @@ namespace TimeService {
       BOOST_THROW_EXCEPTION(std::runtime_error{"Unable to query NTP time."});
     }
     averageOffset = averageOffset / count;
-    Threading::With(m_origin,
-      [&] (Origin& origin) {
-        origin.m_startTime =
-          boost::posix_time::microsec_clock::universal_time() + averageOffset;
-        origin.m_startPoint = boost::chrono::steady_clock::now();
-      });
+    m_origin.Synchronize(
+      boost::posix_time::microsec_clock::universal_time() + averageOffset);
   }
 
   template<typename ChannelType, typename TimerType>
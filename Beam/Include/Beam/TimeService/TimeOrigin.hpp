@@ -0,0 +1,231 @@
+#ifndef BEAM_TIME_ORIGIN_HPP
+#define BEAM_TIME_ORIGIN_HPP
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include "Beam/TimeService/MonotonicClock.hpp"
+#include "Beam/TimeService/TimeService.hpp"
+
+namespace Beam::TimeService {
+
+  /**
+   * Maps readings of a MonotonicClock to UTC. The mapping is published
+   * through a sequence lock, so readers never block and only retry when they
+   * race a publication. Adjustments below the step threshold are slewed in at
+   * a bounded rate rather than applied at once, keeping the time continuous
+   * and monotonic.
+   */
+  class TimeOrigin {
+    public:
+
+      /** The largest rate at which an adjustment is slewed in. */
+      static constexpr auto MAX_SLEW_RATE = 500E-6;
+
+      /** Adjustments larger than this, in nanoseconds, are stepped. */
+      static constexpr auto STEP_THRESHOLD = std::int64_t(128000000);
+
+      /** Constructs a TimeOrigin reading from the steady clock. */
+      TimeOrigin();
+
+      /**
+       * Constructs a TimeOrigin.
+       * @param clock The clock to map to UTC.
+       */
+      explicit TimeOrigin(MonotonicClock clock);
+
+      /** Returns the clock being mapped to UTC. */
+      const MonotonicClock& GetClock() const;
+
+      /** Returns the current time, or not_a_date_time if no time was set. */
+      boost::posix_time::ptime GetTime() const;
+
+      /**
+       * Returns the time at a reading of the clock.
+       * @param clock The reading of the clock, in nanoseconds.
+       */
+      boost::posix_time::ptime GetTime(std::int64_t clock) const;
+
+      /**
+       * Steps to a time.
+       * @param time The current time.
+       */
+      void Set(boost::posix_time::ptime time);
+
+      /**
+       * Steps to a time at a reading of the clock.
+       * @param time The time at the reading.
+       * @param clock The reading of the clock, in nanoseconds.
+       */
+      void Set(boost::posix_time::ptime time, std::int64_t clock);
+
+      /**
+       * Adjusts to a time, slewing if the adjustment is below the step
+       * threshold.
+       * @param time The current time.
+       */
+      void Synchronize(boost::posix_time::ptime time);
+
+      /**
+       * Adjusts to a time at a reading of the clock, slewing if the
+       * adjustment is below the step threshold.
+       * @param time The time at the reading.
+       * @param clock The reading of the clock, in nanoseconds.
+       */
+      void Synchronize(boost::posix_time::ptime time, std::int64_t clock);
+
+    private:
+      struct Mapping {
+        std::int64_t m_baseClock;
+        std::int64_t m_baseTime;
+        std::int64_t m_slewPeriod;
+        std::int64_t m_correction;
+      };
+      MonotonicClock m_clock;
+      std::mutex m_publishMutex;
+      std::atomic<std::uint64_t> m_sequence;
+      std::atomic<std::int64_t> m_baseClock;
+      std::atomic<std::int64_t> m_baseTime;
+      std::atomic<std::int64_t> m_slewPeriod;
+      std::atomic<std::int64_t> m_correction;
+
+      TimeOrigin(const TimeOrigin&) = delete;
+      TimeOrigin& operator =(const TimeOrigin&) = delete;
+      static std::int64_t ToNanoseconds(boost::posix_time::ptime time);
+      static boost::posix_time::ptime FromNanoseconds(std::int64_t time);
+      static std::int64_t Evaluate(const Mapping& mapping, std::int64_t clock);
+      bool Load(Mapping& mapping) const;
+      void Publish(const Mapping& mapping);
+  };
+
+  inline TimeOrigin::TimeOrigin()
+    : TimeOrigin(MonotonicClock()) {}
+
+  inline TimeOrigin::TimeOrigin(MonotonicClock clock)
+    : m_clock(clock),
+      m_sequence(0),
+      m_baseClock(0),
+      m_baseTime(0),
+      m_slewPeriod(0),
+      m_correction(0) {}
+
+  inline const MonotonicClock& TimeOrigin::GetClock() const {
+    return m_clock;
+  }
+
+  inline boost::posix_time::ptime TimeOrigin::GetTime() const {
+    return GetTime(m_clock.GetNanoseconds());
+  }
+
+  inline boost::posix_time::ptime TimeOrigin::GetTime(
+      std::int64_t clock) const {
+    auto mapping = Mapping();
+    if(!Load(mapping)) {
+      return boost::posix_time::not_a_date_time;
+    }
+    return FromNanoseconds(Evaluate(mapping, clock));
+  }
+
+  inline void TimeOrigin::Set(boost::posix_time::ptime time) {
+    Set(time, m_clock.GetNanoseconds());
+  }
+
+  inline void TimeOrigin::Set(boost::posix_time::ptime time,
+      std::int64_t clock) {
+    auto lock = std::lock_guard(m_publishMutex);
+    Publish(Mapping{clock, ToNanoseconds(time), 0, 0});
+  }
+
+  inline void TimeOrigin::Synchronize(boost::posix_time::ptime time) {
+    Synchronize(time, m_clock.GetNanoseconds());
+  }
+
+  inline void TimeOrigin::Synchronize(boost::posix_time::ptime time,
+      std::int64_t clock) {
+    auto lock = std::lock_guard(m_publishMutex);
+    auto target = ToNanoseconds(time);
+    auto mapping = Mapping();
+    if(!Load(mapping)) {
+      Publish(Mapping{clock, target, 0, 0});
+      return;
+    }
+    auto current = Evaluate(mapping, clock);
+    auto correction = target - current;
+    if(correction > STEP_THRESHOLD || correction < -STEP_THRESHOLD) {
+      Publish(Mapping{clock, target, 0, 0});
+      return;
+    }
+    auto slewPeriod = static_cast<std::int64_t>(
+      std::abs(static_cast<double>(correction)) / MAX_SLEW_RATE);
+    if(slewPeriod == 0) {
+      Publish(Mapping{clock, target, 0, 0});
+    } else {
+      Publish(Mapping{clock, current, slewPeriod, correction});
+    }
+  }
+
+  inline std::int64_t TimeOrigin::ToNanoseconds(
+      boost::posix_time::ptime time) {
+    static const auto EPOCH = boost::posix_time::ptime(
+      boost::gregorian::date(1970, 1, 1));
+    return (time - EPOCH).total_microseconds() * 1000;
+  }
+
+  inline boost::posix_time::ptime TimeOrigin::FromNanoseconds(
+      std::int64_t time) {
+    static const auto EPOCH = boost::posix_time::ptime(
+      boost::gregorian::date(1970, 1, 1));
+    auto microseconds = time / 1000;
+    if(time % 1000 < 0) {
+      --microseconds;
+    }
+    return EPOCH + boost::posix_time::microseconds(microseconds);
+  }
+
+  inline std::int64_t TimeOrigin::Evaluate(const Mapping& mapping,
+      std::int64_t clock) {
+    auto elapsed = clock - mapping.m_baseClock;
+    auto time = mapping.m_baseTime + elapsed;
+    if(mapping.m_slewPeriod != 0) {
+      auto slewed = std::min(elapsed, mapping.m_slewPeriod);
+      time += static_cast<std::int64_t>(std::llround(
+        static_cast<double>(mapping.m_correction) *
+        (static_cast<double>(slewed) / mapping.m_slewPeriod)));
+    }
+    return time;
+  }
+
+  inline bool TimeOrigin::Load(Mapping& mapping) const {
+    while(true) {
+      auto sequence = m_sequence.load(std::memory_order_acquire);
+      if(sequence == 0) {
+        return false;
+      } else if((sequence & 1) != 0) {
+        continue;
+      }
+      mapping.m_baseClock = m_baseClock.load(std::memory_order_relaxed);
+      mapping.m_baseTime = m_baseTime.load(std::memory_order_relaxed);
+      mapping.m_slewPeriod = m_slewPeriod.load(std::memory_order_relaxed);
+      mapping.m_correction = m_correction.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if(m_sequence.load(std::memory_order_relaxed) == sequence) {
+        return true;
+      }
+    }
+  }
+
+  inline void TimeOrigin::Publish(const Mapping& mapping) {
+    auto sequence = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_baseClock.store(mapping.m_baseClock, std::memory_order_relaxed);
+    m_baseTime.store(mapping.m_baseTime, std::memory_order_relaxed);
+    m_slewPeriod.store(mapping.m_slewPeriod, std::memory_order_relaxed);
+    m_correction.store(mapping.m_correction, std::memory_order_relaxed);
+    m_sequence.store(sequence + 2, std::memory_order_release);
+  }
+}
+
+#endif
@@ -1,15 +1,58 @@
 #ifndef BEAM_KEYVALUECACHE_HPP
 #define BEAM_KEYVALUECACHE_HPP
+#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <list>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
-#include "Beam/Utilities/SynchronizedMap.hpp"
+#include "Beam/Routines/RoutineHandlerGroup.hpp"
+#include "Beam/Threading/ConditionVariable.hpp"
 #include "Beam/Utilities/Utilities.hpp"
 
 namespace Beam {
 
+  /*! \struct KeyValueCacheStatistics
+      \brief Stores the hit/miss statistics of a KeyValueCache.
+   */
+  struct KeyValueCacheStatistics {
+
+    //! The number of loads served from the cache.
+    std::uint64_t m_hits = 0;
+
+    //! The number of loads that had to wait on the source function.
+    std::uint64_t m_misses = 0;
+
+    //! The number of calls made to the source function.
+    std::uint64_t m_loads = 0;
+
+    //! The number of entries evicted to stay within the capacity.
+    std::uint64_t m_evictions = 0;
+
+    //! The number of entries that were found to be expired.
+    std::uint64_t m_expirations = 0;
+
+    //! The number of entries reloaded ahead of their expiry.
+    std::uint64_t m_refreshes = 0;
+
+    //! The number of entries currently cached.
+    std::size_t m_size = 0;
+  };
+
   /*! \class KeyValueCache
       \brief Stores a cache of key value pairs.
+      \details Keys are distributed among independently locked shards and the
+               source function is always called outside of any lock.
+               Concurrent misses on the same key share a single call to the
+               source function. Each shard evicts its least recently used
+               entries to stay within its share of the capacity.
       \tparam KeyType The type of key used to retrieve values.
       \tparam ValueType The type of value to store.
       \tparam MutexType The type of mutex used to synchronize access.
@@ -31,45 +74,244 @@ namespace Beam {
       //! The function signature used to load values not yet cached.
       using SourceFunction = std::function<Value (const Key& key)>;
 
-      //! Constructs a KeyValueCache.
+      //! Constructs an unbounded KeyValueCache.
       KeyValueCache();
 
-      //! Constructs a KeyValueCache with a specified source.
+      //! Constructs an unbounded KeyValueCache with a specified source.
       /*!
         \param source The function to call to load values not yet cached.
       */
       KeyValueCache(SourceFunction source);
 
+      //! Constructs a KeyValueCache with a bounded size.
+      /*!
+        \param source The function to call to load values not yet cached.
+        \param capacity The maximum number of entries to cache.
+      */
+      KeyValueCache(SourceFunction source, std::size_t capacity);
+
+      //! Constructs a KeyValueCache with a bounded size and expiry.
+      /*!
+        \param source The function to call to load values not yet cached.
+        \param capacity The maximum number of entries to cache.
+        \param timeToLive How long a loaded value remains valid.
+        \param refreshAhead How long before its expiry that a value accessed
+               is reloaded in the background.
+      */
+      KeyValueCache(SourceFunction source, std::size_t capacity,
+        boost::posix_time::time_duration timeToLive,
+        boost::posix_time::time_duration refreshAhead);
+
+      ~KeyValueCache();
+
       //! Loads a value from this cache.
       /*!
         \param key The key used to retrieve the value.
         \return The value associated with the specified <i>key</i>.
       */
-      const Value& Load(const Key& key);
+      Value Load(const Key& key);
+
+      //! Removes a value from this cache.
+      /*!
+        \param key The key of the value to remove.
+      */
+      void Invalidate(const Key& key);
+
+      //! Removes all values from this cache.
+      void Clear();
+
+      //! Returns the statistics accumulated by this cache.
+      KeyValueCacheStatistics GetStatistics() const;
 
       //! Sets the function used to load values not yet cached.
       void SetSource(SourceFunction source);
 
     private:
-      SynchronizedUnorderedMap<Key, Value, Mutex> m_cache;
+      static constexpr auto MAX_SHARDS = std::size_t(16);
+      static constexpr auto MIN_SHARD_CAPACITY = std::size_t(64);
+      struct PendingLoad {
+        Threading::ConditionVariable m_isComplete;
+        bool m_hasResult;
+        std::optional<Value> m_value;
+        std::exception_ptr m_exception;
+
+        PendingLoad();
+      };
+      struct Entry {
+        std::optional<Value> m_value;
+        boost::posix_time::ptime m_loadTime;
+        std::shared_ptr<PendingLoad> m_load;
+        typename std::list<Key>::iterator m_recentUse;
+      };
+      struct Shard {
+        mutable Mutex m_mutex;
+        std::unordered_map<Key, Entry> m_entries;
+        std::list<Key> m_recentUses;
+        KeyValueCacheStatistics m_statistics;
+      };
       SourceFunction m_source;
+      std::size_t m_shardCapacity;
+      boost::posix_time::time_duration m_timeToLive;
+      boost::posix_time::time_duration m_refreshAhead;
+      std::vector<std::unique_ptr<Shard>> m_shards;
+      Routines::RoutineHandlerGroup m_refreshRoutines;
+
+      Shard& GetShard(const Key& key);
+      void Touch(Shard& shard, Entry& entry);
+      void Evict(Shard& shard);
+      void Refresh(const Key& key, std::shared_ptr<PendingLoad> load);
+      void Complete(const Key& key, const std::shared_ptr<PendingLoad>& load,
+        const std::exception_ptr& exception);
   };
 
   template<typename KeyType, typename ValueType, typename MutexType>
-  KeyValueCache<KeyType, ValueType, MutexType>::KeyValueCache() {}
+  KeyValueCache<KeyType, ValueType, MutexType>::PendingLoad::PendingLoad()
+    : m_hasResult(false) {}
+
+  template<typename KeyType, typename ValueType, typename MutexType>
+  KeyValueCache<KeyType, ValueType, MutexType>::KeyValueCache()
+    : KeyValueCache(SourceFunction()) {}
+
+  template<typename KeyType, typename ValueType, typename MutexType>
+  KeyValueCache<KeyType, ValueType, MutexType>::KeyValueCache(
+    SourceFunction source)
+    : KeyValueCache(std::move(source),
+        std::numeric_limits<std::size_t>::max()) {}
+
+  template<typename KeyType, typename ValueType, typename MutexType>
+  KeyValueCache<KeyType, ValueType, MutexType>::KeyValueCache(
+    SourceFunction source, std::size_t capacity)
+    : KeyValueCache(std::move(source), capacity,
+        boost::posix_time::pos_infin, boost::posix_time::seconds(0)) {}
 
   template<typename KeyType, typename ValueType, typename MutexType>
   KeyValueCache<KeyType, ValueType, MutexType>::KeyValueCache(
-      SourceFunction source)
-      : m_source(std::move(source)) {}
+      SourceFunction source, std::size_t capacity,
+      boost::posix_time::time_duration timeToLive,
+      boost::posix_time::time_duration refreshAhead)
+      : m_source(std::move(source)),
+        m_timeToLive(timeToLive),
+        m_refreshAhead(refreshAhead) {
+    capacity = std::max<std::size_t>(capacity, 1);
+    auto shardCount = std::clamp<std::size_t>(capacity / MIN_SHARD_CAPACITY, 1,
+      MAX_SHARDS);
+    m_shardCapacity = capacity / shardCount + (capacity % shardCount != 0);
+    for(auto i = std::size_t(0); i != shardCount; ++i) {
+      m_shards.push_back(std::make_unique<Shard>());
+    }
+  }
 
   template<typename KeyType, typename ValueType, typename MutexType>
-  const typename KeyValueCache<KeyType, ValueType, MutexType>::Value&
+  KeyValueCache<KeyType, ValueType, MutexType>::~KeyValueCache() {
+    m_refreshRoutines.Wait();
+  }
+
+  template<typename KeyType, typename ValueType, typename MutexType>
+  typename KeyValueCache<KeyType, ValueType, MutexType>::Value
       KeyValueCache<KeyType, ValueType, MutexType>::Load(const Key& key) {
-    return m_cache.GetOrInsert(key,
-      [&] {
-        return m_source(key);
-      });
+    auto& shard = GetShard(key);
+    auto load = std::shared_ptr<PendingLoad>();
+    {
+      boost::unique_lock<Mutex> lock(shard.m_mutex);
+      auto entryIterator = shard.m_entries.find(key);
+      if(entryIterator != shard.m_entries.end()) {
+        auto& entry = entryIterator->second;
+        if(entry.m_value) {
+          auto age = boost::posix_time::microsec_clock::universal_time() -
+            entry.m_loadTime;
+          if(m_timeToLive.is_pos_infinity() || age < m_timeToLive) {
+            ++shard.m_statistics.m_hits;
+            Touch(shard, entry);
+            if(entry.m_load || m_timeToLive.is_pos_infinity() ||
+                age < m_timeToLive - m_refreshAhead) {
+              return *entry.m_value;
+            }
+            auto value = *entry.m_value;
+            entry.m_load = std::make_shared<PendingLoad>();
+            ++shard.m_statistics.m_refreshes;
+            auto refresh = entry.m_load;
+            lock.unlock();
+            m_refreshRoutines.Spawn(
+              [this, key, load = std::move(refresh)] {
+                Refresh(key, std::move(load));
+              });
+            return value;
+          }
+          ++shard.m_statistics.m_expirations;
+          entry.m_value = std::nullopt;
+        }
+        ++shard.m_statistics.m_misses;
+        if(entry.m_load) {
+          auto pendingLoad = entry.m_load;
+          while(!pendingLoad->m_hasResult) {
+            pendingLoad->m_isComplete.wait(lock);
+          }
+          if(pendingLoad->m_exception) {
+            std::rethrow_exception(pendingLoad->m_exception);
+          }
+          return *pendingLoad->m_value;
+        }
+        load = std::make_shared<PendingLoad>();
+        entry.m_load = load;
+        Touch(shard, entry);
+      } else {
+        ++shard.m_statistics.m_misses;
+        load = std::make_shared<PendingLoad>();
+        auto& entry = shard.m_entries[key];
+        entry.m_load = load;
+        entry.m_recentUse = shard.m_recentUses.insert(
+          shard.m_recentUses.begin(), key);
+        Evict(shard);
+      }
+      ++shard.m_statistics.m_loads;
+    }
+    try {
+      load->m_value.emplace(m_source(key));
+    } catch(...) {
+      Complete(key, load, std::current_exception());
+      throw;
+    }
+    Complete(key, load, nullptr);
+    return *load->m_value;
+  }
+
+  template<typename KeyType, typename ValueType, typename MutexType>
+  void KeyValueCache<KeyType, ValueType, MutexType>::Invalidate(
+      const Key& key) {
+    auto& shard = GetShard(key);
+    boost::lock_guard<Mutex> lock(shard.m_mutex);
+    auto entryIterator = shard.m_entries.find(key);
+    if(entryIterator == shard.m_entries.end()) {
+      return;
+    }
+    shard.m_recentUses.erase(entryIterator->second.m_recentUse);
+    shard.m_entries.erase(entryIterator);
+  }
+
+  template<typename KeyType, typename ValueType, typename MutexType>
+  void KeyValueCache<KeyType, ValueType, MutexType>::Clear() {
+    for(auto& shard : m_shards) {
+      boost::lock_guard<Mutex> lock(shard->m_mutex);
+      shard->m_entries.clear();
+      shard->m_recentUses.clear();
+    }
+  }
+
+  template<typename KeyType, typename ValueType, typename MutexType>
+  KeyValueCacheStatistics KeyValueCache<KeyType, ValueType, MutexType>::
+      GetStatistics() const {
+    auto statistics = KeyValueCacheStatistics();
+    for(auto& shard : m_shards) {
+      boost::lock_guard<Mutex> lock(shard->m_mutex);
+      statistics.m_hits += shard->m_statistics.m_hits;
+      statistics.m_misses += shard->m_statistics.m_misses;
+      statistics.m_loads += shard->m_statistics.m_loads;
+      statistics.m_evictions += shard->m_statistics.m_evictions;
+      statistics.m_expirations += shard->m_statistics.m_expirations;
+      statistics.m_refreshes += shard->m_statistics.m_refreshes;
+      statistics.m_size += shard->m_entries.size();
+    }
+    return statistics;
   }
 
   template<typename KeyType, typename ValueType, typename MutexType>
@@ -77,6 +319,72 @@ namespace Beam {
       SourceFunction source) {
     m_source = std::move(source);
   }
+
+  template<typename KeyType, typename ValueType, typename MutexType>
+  typename KeyValueCache<KeyType, ValueType, MutexType>::Shard&
+      KeyValueCache<KeyType, ValueType, MutexType>::GetShard(const Key& key) {
+    return *m_shards[std::hash<Key>()(key) % m_shards.size()];
+  }
+
+  template<typename KeyType, typename ValueType, typename MutexType>
+  void KeyValueCache<KeyType, ValueType, MutexType>::Touch(Shard& shard,
+      Entry& entry) {
+    shard.m_recentUses.splice(shard.m_recentUses.begin(), shard.m_recentUses,
+      entry.m_recentUse);
+  }
+
+  template<typename KeyType, typename ValueType, typename MutexType>
+  void KeyValueCache<KeyType, ValueType, MutexType>::Evict(Shard& shard) {
+    while(shard.m_entries.size() > m_shardCapacity) {
+      shard.m_entries.erase(shard.m_recentUses.back());
+      shard.m_recentUses.pop_back();
+      ++shard.m_statistics.m_evictions;
+    }
+  }
+
+  template<typename KeyType, typename ValueType, typename MutexType>
+  void KeyValueCache<KeyType, ValueType, MutexType>::Refresh(const Key& key,
+      std::shared_ptr<PendingLoad> load) {
+    {
+      auto& shard = GetShard(key);
+      boost::lock_guard<Mutex> lock(shard.m_mutex);
+      ++shard.m_statistics.m_loads;
+    }
+    try {
+      load->m_value.emplace(m_source(key));
+    } catch(...) {
+      Complete(key, load, std::current_exception());
+      return;
+    }
+    Complete(key, load, nullptr);
+  }
+
+  template<typename KeyType, typename ValueType, typename MutexType>
+  void KeyValueCache<KeyType, ValueType, MutexType>::Complete(const Key& key,
+      const std::shared_ptr<PendingLoad>& load,
+      const std::exception_ptr& exception) {
+    auto& shard = GetShard(key);
+    boost::lock_guard<Mutex> lock(shard.m_mutex);
+    load->m_exception = exception;
+    load->m_hasResult = true;
+    load->m_isComplete.notify_all();
+    auto entryIterator = shard.m_entries.find(key);
+    if(entryIterator == shard.m_entries.end() ||
+        entryIterator->second.m_load != load) {
+      return;
+    }
+    auto& entry = entryIterator->second;
+    entry.m_load = nullptr;
+    if(exception) {
+      if(!entry.m_value) {
+        shard.m_recentUses.erase(entry.m_recentUse);
+        shard.m_entries.erase(entryIterator);
+      }
+      return;
+    }
+    entry.m_value = load->m_value;
+    entry.m_loadTime = boost::posix_time::microsec_clock::universal_time();
+  }
 }
 
 #endif
@@ -0,0 +1,170 @@
+#ifndef BEAM_TASK_HPP
+#define BEAM_TASK_HPP
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "Beam/Utilities/Utilities.hpp"
+
+namespace Beam {
+
+  /*! \class Task
+      \brief A move-only <code>void ()</code> callable that stores callables of
+             up to INLINE_SIZE bytes without allocating.
+   */
+  class Task {
+    public:
+
+      //! The largest callable stored inline.
+      static constexpr std::size_t INLINE_SIZE = 64;
+
+      //! Constructs an empty Task.
+      Task() noexcept;
+
+      //! Constructs an empty Task.
+      Task(std::nullptr_t) noexcept;
+
+      //! Constructs a Task.
+      /*!
+        \param f The callable to invoke.
+      */
+      template<typename F, typename = std::enable_if_t<
+        !std::is_same_v<std::decay_t<F>, Task> &&
+        std::is_invocable_v<std::decay_t<F>&>>>
+      Task(F&& f);
+
+      Task(Task&& task) noexcept;
+
+      ~Task();
+
+      //! Invokes the callable.
+      void operator ()();
+
+      //! Returns <code>true</code> iff this Task stores a callable.
+      explicit operator bool() const noexcept;
+
+      Task& operator =(Task&& task) noexcept;
+
+      Task& operator =(std::nullptr_t) noexcept;
+
+    private:
+      struct Operations {
+        void (*m_invoke)(void* storage);
+        void (*m_move)(void* destination, void* source) noexcept;
+        void (*m_destroy)(void* storage) noexcept;
+      };
+      template<typename F>
+      static constexpr bool IS_INLINE = sizeof(F) <= INLINE_SIZE &&
+        alignof(F) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible_v<F>;
+      template<typename F>
+      struct InlineOperations {
+        static const Operations VALUE;
+      };
+      template<typename F>
+      struct HeapOperations {
+        static const Operations VALUE;
+      };
+      alignas(std::max_align_t) unsigned char m_storage[INLINE_SIZE];
+      const Operations* m_operations;
+
+      Task(const Task&) = delete;
+      Task& operator =(const Task&) = delete;
+  };
+
+  template<typename F>
+  const Task::Operations Task::InlineOperations<F>::VALUE = {
+    [] (void* storage) {
+      (*static_cast<F*>(storage))();
+    },
+    [] (void* destination, void* source) noexcept {
+      new(destination) F(std::move(*static_cast<F*>(source)));
+      static_cast<F*>(source)->~F();
+    },
+    [] (void* storage) noexcept {
+      static_cast<F*>(storage)->~F();
+    }
+  };
+
+  template<typename F>
+  const Task::Operations Task::HeapOperations<F>::VALUE = {
+    [] (void* storage) {
+      (**static_cast<F**>(storage))();
+    },
+    [] (void* destination, void* source) noexcept {
+      *static_cast<F**>(destination) = *static_cast<F**>(source);
+    },
+    [] (void* storage) noexcept {
+      delete *static_cast<F**>(storage);
+    }
+  };
+
+  inline Task::Task() noexcept
+    : m_operations(nullptr) {}
+
+  inline Task::Task(std::nullptr_t) noexcept
+    : Task() {}
+
+  template<typename F, typename>
+  Task::Task(F&& f) {
+    using Callable = std::decay_t<F>;
+    if constexpr(IS_INLINE<Callable>) {
+      new(m_storage) Callable(std::forward<F>(f));
+      m_operations = &InlineOperations<Callable>::VALUE;
+    } else {
+      *reinterpret_cast<Callable**>(m_storage) =
+        new Callable(std::forward<F>(f));
+      m_operations = &HeapOperations<Callable>::VALUE;
+    }
+  }
+
+  inline Task::Task(Task&& task) noexcept
+      : m_operations(task.m_operations) {
+    if(m_operations) {
+      m_operations->m_move(m_storage, task.m_storage);
+      task.m_operations = nullptr;
+    }
+  }
+
+  inline Task::~Task() {
+    if(m_operations) {
+      m_operations->m_destroy(m_storage);
+    }
+  }
+
+  inline void Task::operator ()() {
+    if(!m_operations) {
+      throw std::bad_function_call();
+    }
+    m_operations->m_invoke(m_storage);
+  }
+
+  inline Task::operator bool() const noexcept {
+    return m_operations != nullptr;
+  }
+
+  inline Task& Task::operator =(Task&& task) noexcept {
+    if(this == &task) {
+      return *this;
+    }
+    *this = nullptr;
+    if(task.m_operations) {
+      task.m_operations->m_move(m_storage, task.m_storage);
+      m_operations = task.m_operations;
+      task.m_operations = nullptr;
+    }
+    return *this;
+  }
+
+  inline Task& Task::operator =(std::nullptr_t) noexcept {
+    if(m_operations) {
+      auto operations = m_operations;
+      m_operations = nullptr;
+      operations->m_destroy(m_storage);
+    }
+    return *this;
+  }
+}
+
+#endif
@@ -28,6 +28,7 @@ namespace Beam {
   template<typename ListType, typename MutexType> class SynchronizedList;
   template<typename MapType, typename MutexType> class SynchronizedMap;
   template<typename SetType, typename MutexType> class SynchronizedSet;
+  class Task;
 }
 
 #endif
@@ -1,10 +1,28 @@
 #ifndef BEAM_FILESTORE_HPP
 #define BEAM_FILESTORE_HPP
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
+#include <iomanip>
+#include <list>
+#include <locale>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include "Beam/IO/IOException.hpp"
+#include "Beam/IO/SharedBuffer.hpp"
 #include "Beam/Pointers/Out.hpp"
 #include "Beam/WebServices/ContentTypePatterns.hpp"
+#include "Beam/WebServices/Cookie.hpp"
 #include "Beam/WebServices/HttpRequest.hpp"
 #include "Beam/WebServices/HttpRequestSlot.hpp"
 #include "Beam/WebServices/HttpResponse.hpp"
@@ -12,13 +30,47 @@
 
 namespace Beam {
 namespace WebServices {
+namespace Details {
+  inline std::optional<boost::posix_time::ptime> ParseHttpDate(
+      const std::string& source) {
+
+    // IMF-fixdate, then the obsolete RFC 850 and asctime formats.
+    static const char* FORMATS[] = {"%a, %d %b %Y %H:%M:%S GMT",
+      "%A, %d-%b-%y %H:%M:%S GMT", "%a %b %d %H:%M:%S %Y"};
+    for(auto format : FORMATS) {
+      auto stream = std::istringstream(source);
+      stream.imbue(std::locale::classic());
+      auto time = std::tm();
+      stream >> std::get_time(&time, format);
+      if(!stream.fail()) {
+        try {
+          return boost::posix_time::ptime_from_tm(time);
+        } catch(const std::exception&) {
+          return std::nullopt;
+        }
+      }
+    }
+    return std::nullopt;
+  }
+}
 
   /*! \class FileStore
       \brief Handles an HTTP request to serve a file.
+      \details Files up to the maximum cached file size are kept in memory,
+               larger files and ranges are streamed from disk in parts.
    */
   class FileStore : private boost::noncopyable {
     public:
 
+      //! The default number of bytes of file contents to keep in memory.
+      static constexpr auto DEFAULT_CACHE_CAPACITY = std::size_t(64 << 20);
+
+      //! The default size of the largest file kept in memory.
+      static constexpr auto DEFAULT_MAX_CACHED_FILE_SIZE = std::size_t(1 << 20);
+
+      //! The default size of the largest open ended range served at once.
+      static constexpr auto DEFAULT_MAX_RANGE_SIZE = std::size_t(1 << 20);
+
       //! Constructs a FileStore with a specified path.
       /*!
         \param root The root of the file system.
@@ -33,6 +85,20 @@ namespace WebServices {
       FileStore(std::filesystem::path root,
         ContentTypePatterns contentTypePatterns);
 
+      //! Constructs a FileStore with a specified path.
+      /*!
+        \param root The root of the file system.
+        \param contentTypePatterns The set of patterns to use for content types.
+        \param cacheCapacity The number of bytes of file contents to keep in
+               memory.
+        \param maxCachedFileSize The size of the largest file kept in memory.
+        \param maxRangeSize The size of the largest chunk served for an open
+               ended range request.
+      */
+      FileStore(std::filesystem::path root,
+        ContentTypePatterns contentTypePatterns, std::size_t cacheCapacity,
+        std::size_t maxCachedFileSize, std::size_t maxRangeSize);
+
       //! Serves a file from a specified path.
       /*!
         \param path The path to the file to serve.
@@ -54,7 +120,8 @@ namespace WebServices {
       */
       void Serve(const std::filesystem::path& path, Out<HttpResponse> response);
 
-      //! Serves a file from an HTTP request.
+      //! Serves a file from an HTTP request, honoring conditional and range
+      //! headers.
       /*!
         \param request The HTTP request to serve.
         \param response Stores the HTTP response containing the file contents.
@@ -62,8 +129,46 @@ namespace WebServices {
       void Serve(const HttpRequest& request, Out<HttpResponse> response);
 
     private:
+      struct FileInfo {
+        std::filesystem::path m_path;
+        std::filesystem::file_time_type m_lastWriteTime;
+        std::uintmax_t m_size;
+        std::string m_entityTag;
+        boost::posix_time::ptime m_lastModifiedTime;
+        std::string m_lastModified;
+      };
+      struct CacheEntry {
+        FileInfo m_info;
+        IO::SharedBuffer m_contents;
+        std::list<std::string>::iterator m_position;
+      };
+      struct Range {
+        std::uintmax_t m_start;
+        std::uintmax_t m_end;
+      };
+      static constexpr auto STREAM_PART_SIZE = std::size_t(64 * 1024);
       std::filesystem::path m_root;
       ContentTypePatterns m_contentTypePatterns;
+      std::size_t m_cacheCapacity;
+      std::size_t m_maxCachedFileSize;
+      std::size_t m_maxRangeSize;
+      std::chrono::system_clock::duration m_clockOffset;
+      boost::mutex m_mutex;
+      std::unordered_map<std::string, CacheEntry> m_cache;
+      std::list<std::string> m_recentlyUsed;
+      std::size_t m_cacheSize;
+
+      std::filesystem::path GetPath(const HttpRequest& request) const;
+      std::optional<FileInfo> LoadInfo(const std::filesystem::path& path) const;
+      std::optional<IO::SharedBuffer> LoadCachedContents(const FileInfo& info);
+      IO::SharedBuffer LoadContents(const FileInfo& info);
+      bool SetBody(const FileInfo& info, const Range& range,
+        HttpResponse& response);
+      void SetHeaders(const FileInfo& info, HttpResponse& response) const;
+      bool IsNotModified(const FileInfo& info,
+        const HttpRequest& request) const;
+      std::optional<Range> ParseRange(const FileInfo& info,
+        const std::string& range) const;
   };
 
   //! Returns an HttpRequestSlot to serve index.html.
@@ -85,14 +190,27 @@ namespace WebServices {
   }
 
   inline FileStore::FileStore(std::filesystem::path root)
-      : m_contentTypePatterns{ContentTypePatterns::GetDefaultPatterns()} {
-    m_root = std::filesystem::canonical(std::filesystem::absolute(root));
-  }
+    : FileStore(std::move(root), ContentTypePatterns::GetDefaultPatterns()) {}
 
   inline FileStore::FileStore(std::filesystem::path root,
-      ContentTypePatterns contentTypePatterns)
-      : m_contentTypePatterns{std::move(contentTypePatterns)} {
+    ContentTypePatterns contentTypePatterns)
+    : FileStore(std::move(root), std::move(contentTypePatterns),
+        DEFAULT_CACHE_CAPACITY, DEFAULT_MAX_CACHED_FILE_SIZE,
+        DEFAULT_MAX_RANGE_SIZE) {}
+
+  inline FileStore::FileStore(std::filesystem::path root,
+      ContentTypePatterns contentTypePatterns, std::size_t cacheCapacity,
+      std::size_t maxCachedFileSize, std::size_t maxRangeSize)
+      : m_contentTypePatterns{std::move(contentTypePatterns)},
+        m_cacheCapacity{cacheCapacity},
+        m_maxCachedFileSize{std::min(maxCachedFileSize, cacheCapacity)},
+        m_maxRangeSize{std::max<std::size_t>(maxRangeSize, 1)},
+        m_cacheSize{0} {
     m_root = std::filesystem::canonical(std::filesystem::absolute(root));
+    m_clockOffset = std::chrono::duration_cast<
+      std::chrono::system_clock::duration>(
+      std::chrono::system_clock::now().time_since_epoch() -
+      std::filesystem::file_time_type::clock::now().time_since_epoch());
   }
 
   inline HttpResponse FileStore::Serve(const std::filesystem::path& path) {
@@ -102,36 +220,303 @@ namespace WebServices {
   }
 
   inline HttpResponse FileStore::Serve(const HttpRequest& request) {
-    if(!request.GetUri().GetPath().empty() &&
-        request.GetUri().GetPath()[0] == '/') {
-      return Serve(request.GetUri().GetPath().substr(1));
-    } else {
-      return Serve(request.GetUri().GetPath());
-    }
+    HttpResponse response;
+    Serve(request, Store(response));
+    return response;
   }
 
   inline void FileStore::Serve(const std::filesystem::path& path,
       Out<HttpResponse> response) {
-    std::filesystem::path fullPath = m_root / path;
-    std::ifstream file{fullPath, std::ios::in | std::ios::binary};
-    if(!file) {
+    auto info = LoadInfo(path);
+    if(!info) {
       response->SetStatusCode(HttpStatusCode::NOT_FOUND);
       return;
     }
-    IO::SharedBuffer buffer;
-    buffer.Grow(static_cast<std::size_t>(
-      std::filesystem::file_size(fullPath)));
-    file.read(buffer.GetMutableData(), buffer.GetSize());
-    auto& contentType = m_contentTypePatterns.GetContentType(fullPath);
-    if(!contentType.empty()) {
-      response->SetHeader({"Content-Type", contentType});
+    SetHeaders(*info, *response);
+    if(info->m_size == 0) {
+      response->SetBody({});
+    } else if(!SetBody(*info, Range{0, info->m_size - 1}, *response)) {
+      response->SetStatusCode(HttpStatusCode::INTERNAL_SERVER_ERROR);
     }
-    response->SetBody(std::move(buffer));
   }
 
   inline void FileStore::Serve(const HttpRequest& request,
       Out<HttpResponse> response) {
-    Serve(request.GetUri().GetPath(), Store(response));
+    auto info = LoadInfo(GetPath(request));
+    if(!info) {
+      response->SetStatusCode(HttpStatusCode::NOT_FOUND);
+      return;
+    }
+    SetHeaders(*info, *response);
+    if(IsNotModified(*info, request)) {
+      response->SetStatusCode(HttpStatusCode::NOT_MODIFIED);
+      return;
+    }
+    auto rangeHeader = request.GetHeader("Range");
+    if(rangeHeader && info->m_size != 0) {
+      auto ifRange = request.GetHeader("If-Range");
+      if(!ifRange || *ifRange == info->m_entityTag ||
+          *ifRange == info->m_lastModified) {
+        auto range = ParseRange(*info, *rangeHeader);
+        if(!range) {
+          response->SetStatusCode(
+            HttpStatusCode::REQUESTED_RANGE_NOT_SATISFIABLE);
+          response->SetHeader({"Content-Range",
+            "bytes */" + std::to_string(info->m_size)});
+          return;
+        }
+        if(range->m_start != 0 || range->m_end + 1 != info->m_size) {
+          if(!SetBody(*info, *range, *response)) {
+            response->SetStatusCode(HttpStatusCode::INTERNAL_SERVER_ERROR);
+            return;
+          }
+          response->SetStatusCode(HttpStatusCode::PARTIAL_CONTENT);
+          response->SetHeader({"Content-Range", "bytes " +
+            std::to_string(range->m_start) + "-" +
+            std::to_string(range->m_end) + "/" +
+            std::to_string(info->m_size)});
+          return;
+        }
+      }
+    }
+    if(info->m_size == 0) {
+      response->SetBody({});
+    } else if(!SetBody(*info, Range{0, info->m_size - 1}, *response)) {
+      response->SetStatusCode(HttpStatusCode::INTERNAL_SERVER_ERROR);
+    }
+  }
+
+  inline std::filesystem::path FileStore::GetPath(
+      const HttpRequest& request) const {
+    auto& path = request.GetUri().GetPath();
+    if(!path.empty() && path[0] == '/') {
+      return path.substr(1);
+    }
+    return path;
+  }
+
+  inline std::optional<FileStore::FileInfo> FileStore::LoadInfo(
+      const std::filesystem::path& path) const {
+    auto info = FileInfo();
+    info.m_path = m_root / path;
+    auto error = std::error_code();
+    if(!std::filesystem::is_regular_file(info.m_path, error)) {
+      return std::nullopt;
+    }
+    info.m_lastWriteTime = std::filesystem::last_write_time(info.m_path,
+      error);
+    if(error) {
+      return std::nullopt;
+    }
+    info.m_size = std::filesystem::file_size(info.m_path, error);
+    if(error) {
+      return std::nullopt;
+    }
+    auto ticks = static_cast<std::uintmax_t>(
+      info.m_lastWriteTime.time_since_epoch().count());
+    char entityTag[48];
+    std::snprintf(entityTag, sizeof(entityTag), "\"%jx-%jx\"", ticks,
+      info.m_size);
+    info.m_entityTag = entityTag;
+    auto lastWriteTime = std::chrono::time_point_cast<
+      std::chrono::system_clock::duration>(
+      std::chrono::system_clock::time_point(std::chrono::duration_cast<
+      std::chrono::system_clock::duration>(
+      info.m_lastWriteTime.time_since_epoch()) + m_clockOffset));
+    info.m_lastModifiedTime = boost::posix_time::from_time_t(
+      std::chrono::system_clock::to_time_t(lastWriteTime));
+    info.m_lastModified = Details::FormatExpiration(info.m_lastModifiedTime);
+    return info;
+  }
+
+  inline std::optional<IO::SharedBuffer> FileStore::LoadCachedContents(
+      const FileInfo& info) {
+    auto lock = boost::lock_guard(m_mutex);
+    auto entry = m_cache.find(info.m_path.string());
+    if(entry == m_cache.end()) {
+      return std::nullopt;
+    }
+    if(entry->second.m_info.m_lastWriteTime != info.m_lastWriteTime ||
+        entry->second.m_info.m_size != info.m_size) {
+      m_cacheSize -= entry->second.m_contents.GetSize();
+      m_recentlyUsed.erase(entry->second.m_position);
+      m_cache.erase(entry);
+      return std::nullopt;
+    }
+    m_recentlyUsed.splice(m_recentlyUsed.begin(), m_recentlyUsed,
+      entry->second.m_position);
+    return entry->second.m_contents;
+  }
+
+  inline IO::SharedBuffer FileStore::LoadContents(const FileInfo& info) {
+    if(auto contents = LoadCachedContents(info)) {
+      return std::move(*contents);
+    }
+    auto file = std::ifstream(info.m_path, std::ios::in | std::ios::binary);
+    auto contents = IO::SharedBuffer();
+    contents.Grow(static_cast<std::size_t>(info.m_size));
+    file.read(contents.GetMutableData(), contents.GetSize());
+    if(static_cast<std::uintmax_t>(file.gcount()) != info.m_size ||
+        info.m_size > m_maxCachedFileSize) {
+      contents.Shrink(contents.GetSize() - file.gcount());
+      return contents;
+    }
+    auto lock = boost::lock_guard(m_mutex);
+    auto key = info.m_path.string();
+    auto entry = m_cache.find(key);
+    if(entry != m_cache.end()) {
+      m_cacheSize -= entry->second.m_contents.GetSize();
+      m_recentlyUsed.erase(entry->second.m_position);
+      m_cache.erase(entry);
+    }
+    while(m_cacheSize + contents.GetSize() > m_cacheCapacity &&
+        !m_recentlyUsed.empty()) {
+      auto evicted = m_cache.find(m_recentlyUsed.back());
+      m_cacheSize -= evicted->second.m_contents.GetSize();
+      m_cache.erase(evicted);
+      m_recentlyUsed.pop_back();
+    }
+    m_recentlyUsed.push_front(key);
+    m_cache.emplace(std::move(key),
+      CacheEntry{info, contents, m_recentlyUsed.begin()});
+    m_cacheSize += contents.GetSize();
+    return contents;
+  }
+
+  inline bool FileStore::SetBody(const FileInfo& info, const Range& range,
+      HttpResponse& response) {
+    auto length = range.m_end - range.m_start + 1;
+    if(length == info.m_size && info.m_size <= m_maxCachedFileSize) {
+      auto contents = LoadContents(info);
+      if(contents.GetSize() != info.m_size) {
+        return false;
+      }
+      response.SetBody(std::move(contents));
+      return true;
+    }
+    if(auto contents = LoadCachedContents(info)) {
+      auto body = IO::SharedBuffer();
+      body.Append(contents->GetData() + range.m_start,
+        static_cast<std::size_t>(length));
+      response.SetBody(std::move(body));
+      return true;
+    }
+    auto file = std::make_shared<std::ifstream>(info.m_path,
+      std::ios::in | std::ios::binary);
+    file->seekg(static_cast<std::streamoff>(range.m_start));
+    if(!*file) {
+      return false;
+    }
+    if(length <= m_maxCachedFileSize) {
+      auto body = IO::SharedBuffer();
+      body.Grow(static_cast<std::size_t>(length));
+      file->read(body.GetMutableData(), body.GetSize());
+      if(static_cast<std::uintmax_t>(file->gcount()) != length) {
+        return false;
+      }
+      response.SetBody(std::move(body));
+      return true;
+    }
+    response.SetBody(length,
+      [file, remaining = length] (Out<IO::SharedBuffer> buffer) mutable {
+        auto size = static_cast<std::size_t>(
+          std::min<std::uintmax_t>(remaining, STREAM_PART_SIZE));
+        auto offset = buffer->GetSize();
+        buffer->Grow(size);
+        file->read(buffer->GetMutableData() + offset, size);
+        if(static_cast<std::size_t>(file->gcount()) != size) {
+          BOOST_THROW_EXCEPTION(IO::IOException("File was truncated."));
+        }
+        remaining -= size;
+        return remaining != 0;
+      });
+    return true;
+  }
+
+  inline void FileStore::SetHeaders(const FileInfo& info,
+      HttpResponse& response) const {
+    auto& contentType = m_contentTypePatterns.GetContentType(info.m_path);
+    if(!contentType.empty()) {
+      response.SetHeader({"Content-Type", contentType});
+    }
+    response.SetHeader({"ETag", info.m_entityTag});
+    response.SetHeader({"Last-Modified", info.m_lastModified});
+    response.SetHeader({"Accept-Ranges", "bytes"});
+  }
+
+  inline bool FileStore::IsNotModified(const FileInfo& info,
+      const HttpRequest& request) const {
+    if(auto ifNoneMatch = request.GetHeader("If-None-Match")) {
+      auto start = std::size_t(0);
+      while(start <= ifNoneMatch->size()) {
+        auto end = ifNoneMatch->find(',', start);
+        if(end == std::string::npos) {
+          end = ifNoneMatch->size();
+        }
+        auto tag = boost::algorithm::trim_copy(
+          ifNoneMatch->substr(start, end - start));
+        if(tag.compare(0, 2, "W/") == 0) {
+          tag.erase(0, 2);
+        }
+        if(tag == "*" || tag == info.m_entityTag) {
+          return true;
+        }
+        start = end + 1;
+      }
+      return false;
+    }
+    if(auto ifModifiedSince = request.GetHeader("If-Modified-Since")) {
+      if(auto date = Details::ParseHttpDate(*ifModifiedSince)) {
+        return info.m_lastModifiedTime <= *date;
+      }
+    }
+    return false;
+  }
+
+  inline std::optional<FileStore::Range> FileStore::ParseRange(
+      const FileInfo& info, const std::string& range) const {
+    auto prefix = std::string("bytes=");
+    if(range.compare(0, prefix.size(), prefix) != 0 ||
+        range.find(',') != std::string::npos) {
+      return Range{0, info.m_size - 1};
+    }
+    auto separator = range.find('-', prefix.size());
+    if(separator == std::string::npos) {
+      return Range{0, info.m_size - 1};
+    }
+    auto first = range.substr(prefix.size(), separator - prefix.size());
+    auto last = range.substr(separator + 1);
+    auto IsNumber = [] (const std::string& value) {
+      return !value.empty() && value.size() < 20 &&
+        value.find_first_not_of("0123456789") == std::string::npos;
+    };
+    if(first.empty()) {
+      if(!IsNumber(last)) {
+        return Range{0, info.m_size - 1};
+      }
+      auto length = std::stoull(last);
+      if(length == 0) {
+        return std::nullopt;
+      }
+      length = std::min<std::uintmax_t>(length, info.m_size);
+      return Range{info.m_size - length, info.m_size - 1};
+    }
+    if(!IsNumber(first) || (!last.empty() && !IsNumber(last))) {
+      return Range{0, info.m_size - 1};
+    }
+    auto start = static_cast<std::uintmax_t>(std::stoull(first));
+    if(start >= info.m_size) {
+      return std::nullopt;
+    }
+    if(last.empty()) {
+      return Range{start,
+        std::min<std::uintmax_t>(start + m_maxRangeSize, info.m_size) - 1};
+    }
+    auto end = static_cast<std::uintmax_t>(std::stoull(last));
+    if(end < start) {
+      return Range{0, info.m_size - 1};
+    }
+    return Range{start, std::min<std::uintmax_t>(end, info.m_size - 1)};
   }
 }
 }
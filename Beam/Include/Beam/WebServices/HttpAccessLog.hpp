@@ -0,0 +1,129 @@
+#ifndef BEAM_HTTPACCESSLOG_HPP
+#define BEAM_HTTPACCESSLOG_HPP
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/noncopyable.hpp>
+#include "Beam/Queues/PipeBrokenException.hpp"
+#include "Beam/Queues/Queue.hpp"
+#include "Beam/Routines/RoutineHandler.hpp"
+#include "Beam/WebServices/HttpRequest.hpp"
+#include "Beam/WebServices/HttpStatusCode.hpp"
+#include "Beam/WebServices/WebServices.hpp"
+
+namespace Beam {
+namespace WebServices {
+
+  /*! \class HttpAccessLog
+      \brief Writes a line for every HTTP request served.
+      \details Lines are written by a dedicated Routine so that serving a
+               request never waits on the output stream. The log starts out
+               disabled, while disabled no line is formatted.
+   */
+  class HttpAccessLog : private boost::noncopyable {
+    public:
+
+      //! Constructs an HttpAccessLog writing to std::cout.
+      HttpAccessLog();
+
+      //! Constructs an HttpAccessLog.
+      /*!
+        \param out The stream to write to.
+      */
+      explicit HttpAccessLog(std::ostream& out);
+
+      ~HttpAccessLog();
+
+      //! Returns <code>true</code> iff requests are being logged.
+      bool IsEnabled() const;
+
+      //! Sets whether requests are logged.
+      /*!
+        \param isEnabled <code>true</code> iff requests should be logged.
+      */
+      void SetEnabled(bool isEnabled);
+
+      //! Logs a request.
+      /*!
+        \param request The request that was served.
+        \param statusCode The status code of the response.
+        \param contentLength The length of the response body.
+      */
+      void Log(const HttpRequest& request, HttpStatusCode statusCode,
+        std::size_t contentLength);
+
+    private:
+      std::ostream* m_out;
+      std::atomic_bool m_isEnabled;
+      std::shared_ptr<Queue<std::string>> m_lines;
+      Routines::RoutineHandler m_writeRoutine;
+
+      void WriteLoop();
+  };
+
+  inline HttpAccessLog::HttpAccessLog()
+    : HttpAccessLog(std::cout) {}
+
+  inline HttpAccessLog::HttpAccessLog(std::ostream& out)
+      : m_out(&out),
+        m_isEnabled(false),
+        m_lines(std::make_shared<Queue<std::string>>()) {
+    m_writeRoutine = Routines::Spawn(
+      std::bind(&HttpAccessLog::WriteLoop, this));
+  }
+
+  inline HttpAccessLog::~HttpAccessLog() {
+    m_lines->Break();
+    m_writeRoutine.Wait();
+  }
+
+  inline bool HttpAccessLog::IsEnabled() const {
+    return m_isEnabled.load(std::memory_order_relaxed);
+  }
+
+  inline void HttpAccessLog::SetEnabled(bool isEnabled) {
+    m_isEnabled.store(isEnabled, std::memory_order_relaxed);
+  }
+
+  inline void HttpAccessLog::Log(const HttpRequest& request,
+      HttpStatusCode statusCode, std::size_t contentLength) {
+    if(!IsEnabled()) {
+      return;
+    }
+    auto line = std::stringstream();
+    line << boost::posix_time::to_iso_extended_string(
+      boost::posix_time::microsec_clock::universal_time()) << ' ' <<
+      request.GetMethod() << ' ';
+    if(request.GetUri().GetPath().empty()) {
+      line << '/';
+    } else {
+      line << request.GetUri().GetPath();
+    }
+    line << ' ' << request.GetVersion() << ' ' <<
+      static_cast<int>(statusCode) << ' ' << contentLength << '\n';
+    try {
+      m_lines->Push(line.str());
+    } catch(const PipeBrokenException&) {}
+  }
+
+  inline void HttpAccessLog::WriteLoop() {
+    try {
+      while(true) {
+        *m_out << m_lines->Top();
+        m_lines->Pop();
+        while(!m_lines->IsEmpty()) {
+          *m_out << m_lines->Top();
+          m_lines->Pop();
+        }
+        m_out->flush();
+      }
+    } catch(const PipeBrokenException&) {}
+    m_out->flush();
+  }
+}
+}
+
+#endif
@@ -1,10 +1,23 @@
 #ifndef BEAM_HTTPCLIENT_HPP
 #define BEAM_HTTPCLIENT_HPP
+#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
+#include <boost/algorithm/string.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/optional/optional.hpp>
+#include <boost/thread/locks.hpp>
+#include "Beam/IO/IOException.hpp"
 #include "Beam/Network/IpAddress.hpp"
 #include "Beam/Pointers/Dereference.hpp"
+#include "Beam/Threading/ConditionVariable.hpp"
+#include "Beam/Threading/Mutex.hpp"
 #include "Beam/WebServices/HttpRequest.hpp"
 #include "Beam/WebServices/HttpResponseParser.hpp"
 #include "Beam/WebServices/WebServices.hpp"
@@ -12,9 +25,24 @@
 
 namespace Beam {
 namespace WebServices {
+namespace Details {
+  inline bool IsIdempotent(HttpMethod method) {
+    return method == HttpMethod::GET || method == HttpMethod::HEAD ||
+      method == HttpMethod::PUT || method == HttpMethod::DELETE ||
+      method == HttpMethod::OPTIONS;
+  }
+}
 
   /*! \class HttpClient
       \brief A client that can submit HTTP requests to a server.
+      \details Connections are pooled per host and kept alive between
+               requests. Requests may be sent concurrently from multiple
+               Routines, each using an idle connection, opening a new one or,
+               when pipelining is enabled and the pool is full, queuing behind
+               the requests already in flight on an open connection. A
+               request is resent on a new connection if writing it to a
+               reused connection fails, once written it's only resent if its
+               method is idempotent.
       \tparam ChannelType The type Channel used to connect to the server.
    */
   template<typename ChannelType>
@@ -31,12 +59,75 @@ namespace WebServices {
       */
       using ChannelBuilder = std::function<ChannelType (const Uri& uri)>;
 
+      /*! \struct Statistics
+          \brief Stores statistics about an HttpClient's connection pool.
+       */
+      struct Statistics {
+
+        //! The number of connections opened.
+        std::uint64_t m_connectionsOpened;
+
+        //! The number of connections closed.
+        std::uint64_t m_connectionsClosed;
+
+        //! The number of connections closed for having been idle too long.
+        std::uint64_t m_connectionsExpired;
+
+        //! The number of requests sent.
+        std::uint64_t m_requests;
+
+        //! The number of requests sent over an already open connection.
+        std::uint64_t m_reusedRequests;
+
+        //! The number of requests sent while other requests were awaiting
+        //! their response on the same connection.
+        std::uint64_t m_pipelinedRequests;
+
+        //! The number of requests that waited for a connection to become
+        //! available.
+        std::uint64_t m_waitedRequests;
+
+        //! The number of requests resent after an open connection failed.
+        std::uint64_t m_retriedRequests;
+
+        //! The number of connections currently open.
+        std::size_t m_openConnections;
+
+        //! The number of open connections with no request in flight.
+        std::size_t m_idleConnections;
+      };
+
+      //! The default maximum number of connections to a single host.
+      static constexpr auto DEFAULT_MAX_CONNECTIONS_PER_HOST = std::size_t(8);
+
+      //! The default maximum number of requests in flight on a single
+      //! connection, a depth of 1 disables pipelining.
+      static constexpr auto DEFAULT_MAX_PIPELINE_DEPTH = std::size_t(1);
+
       //! Constructs an HttpClient.
       /*!
         \param channelBuilder Builds the Channel used to connect to the server.
       */
       HttpClient(ChannelBuilder channelBuilder);
 
+      //! Constructs an HttpClient.
+      /*!
+        \param channelBuilder Builds the Channel used to connect to the server.
+        \param maxConnectionsPerHost The maximum number of connections to a
+               single host.
+        \param idleTimeout The amount of time a connection may remain idle
+               before it's closed.
+        \param maxPipelineDepth The maximum number of requests in flight on a
+               single connection.
+      */
+      HttpClient(ChannelBuilder channelBuilder,
+        std::size_t maxConnectionsPerHost,
+        boost::posix_time::time_duration idleTimeout,
+        std::size_t maxPipelineDepth);
+
+      //! Returns the connection pool's Statistics.
+      Statistics GetStatistics() const;
+
       //! Sends a request.
       /*!
         \param request The HttpRequest to send.
@@ -45,105 +136,347 @@ namespace WebServices {
       HttpResponse Send(const HttpRequest& request);
 
     private:
-      struct ChannelEntry {
-        Network::IpAddress m_endPoint;
+      struct Connection {
         ChannelType m_channel;
+        HttpResponseParser m_parser;
+        std::size_t m_pendingRequests;
+        bool m_isReusable;
+        boost::posix_time::ptime m_lastUsed;
+        Threading::Mutex m_writeMutex;
+        std::uint64_t m_nextTicket;
+        Threading::Mutex m_readMutex;
+        std::uint64_t m_servingTicket;
+        bool m_isBroken;
+        Threading::ConditionVariable m_readCondition;
 
-        ChannelEntry(Network::IpAddress endPoint, ChannelType channel);
+        Connection(ChannelType channel);
+      };
+      struct Host {
+        std::vector<std::shared_ptr<Connection>> m_connections;
+        std::size_t m_connectionCount;
+        Threading::ConditionVariable m_availableCondition;
+
+        Host();
       };
-      std::unordered_map<std::string, std::vector<Cookie>> m_cookies;
       ChannelBuilder m_channelBuilder;
-      boost::optional<ChannelEntry> m_channel;
+      std::size_t m_maxConnectionsPerHost;
+      boost::posix_time::time_duration m_idleTimeout;
+      std::size_t m_maxPipelineDepth;
+      mutable Threading::Mutex m_mutex;
+      std::unordered_map<std::string, Host> m_hosts;
+      std::unordered_map<std::string, std::vector<Cookie>> m_cookies;
+      Statistics m_statistics;
+
+      std::pair<std::shared_ptr<Connection>, bool> Acquire(Host& host,
+        const Uri& uri);
+      boost::optional<HttpResponse> Send(Connection& connection,
+        const typename Channel::Writer::Buffer& writeBuffer, bool isReused,
+        bool isIdempotent);
+      void Release(Host& host, const std::shared_ptr<Connection>& connection,
+        bool isReusable);
+      void Break(Connection& connection);
+      void Expire(std::vector<std::shared_ptr<Connection>>& expired);
   };
 
   template<typename ChannelType>
-  HttpClient<ChannelType>::ChannelEntry::ChannelEntry(
-      Network::IpAddress endPoint, ChannelType channel)
-      : m_endPoint{std::move(endPoint)},
-        m_channel{std::move(channel)} {}
+  HttpClient<ChannelType>::Connection::Connection(ChannelType channel)
+    : m_channel(std::move(channel)),
+      m_pendingRequests(0),
+      m_isReusable(true),
+      m_nextTicket(0),
+      m_servingTicket(0),
+      m_isBroken(false) {}
+
+  template<typename ChannelType>
+  HttpClient<ChannelType>::Host::Host()
+    : m_connectionCount(0) {}
 
   template<typename ChannelType>
   HttpClient<ChannelType>::HttpClient(ChannelBuilder channelBuilder)
-      : m_channelBuilder{std::move(channelBuilder)} {}
+    : HttpClient(std::move(channelBuilder), DEFAULT_MAX_CONNECTIONS_PER_HOST,
+        boost::posix_time::minutes(1), DEFAULT_MAX_PIPELINE_DEPTH) {}
+
+  template<typename ChannelType>
+  HttpClient<ChannelType>::HttpClient(ChannelBuilder channelBuilder,
+    std::size_t maxConnectionsPerHost,
+    boost::posix_time::time_duration idleTimeout,
+    std::size_t maxPipelineDepth)
+    : m_channelBuilder(std::move(channelBuilder)),
+      m_maxConnectionsPerHost(std::max<std::size_t>(maxConnectionsPerHost, 1)),
+      m_idleTimeout(idleTimeout),
+      m_maxPipelineDepth(std::max<std::size_t>(maxPipelineDepth, 1)),
+      m_statistics() {}
+
+  template<typename ChannelType>
+  typename HttpClient<ChannelType>::Statistics
+      HttpClient<ChannelType>::GetStatistics() const {
+    auto lock = boost::lock_guard(m_mutex);
+    auto statistics = m_statistics;
+    for(auto& host : m_hosts) {
+      for(auto& connection : host.second.m_connections) {
+        ++statistics.m_openConnections;
+        if(connection->m_pendingRequests == 0) {
+          ++statistics.m_idleConnections;
+        }
+      }
+    }
+    return statistics;
+  }
 
   template<typename ChannelType>
   HttpResponse HttpClient<ChannelType>::Send(const HttpRequest& request) {
-    auto endPoint = Network::IpAddress{
-      request.GetUri().GetHostname(), request.GetUri().GetPort()};
-    auto isNewChannel = false;
-    auto& hostCookies = m_cookies[request.GetUri().GetHostname()];
-    boost::optional<HttpRequest> cookieRequest;
-    auto& properRequest =
-      [&] () -> const HttpRequest& {
-        if(hostCookies.empty()) {
-          return request;
+    auto key = request.GetUri().GetHostname() + ':' +
+      std::to_string(request.GetUri().GetPort());
+    auto cookies = std::vector<Cookie>();
+    auto host = static_cast<Host*>(nullptr);
+    {
+      auto lock = boost::lock_guard(m_mutex);
+      host = &m_hosts[key];
+      cookies = m_cookies[request.GetUri().GetHostname()];
+    }
+    typename Channel::Writer::Buffer writeBuffer;
+    if(cookies.empty()) {
+      request.Encode(Store(writeBuffer));
+    } else {
+      auto cookieRequest = request;
+      for(auto& cookie : cookies) {
+        cookieRequest.Add(cookie);
+      }
+      cookieRequest.Encode(Store(writeBuffer));
+    }
+    auto isIdempotent = Details::IsIdempotent(request.GetMethod());
+    auto response = boost::optional<HttpResponse>();
+    while(!response.is_initialized()) {
+      auto [connection, isReused] = Acquire(*host, request.GetUri());
+      try {
+        response = Send(*connection, writeBuffer, isReused, isIdempotent);
+      } catch(const std::exception&) {
+        Release(*host, connection, false);
+        throw;
+      }
+      if(!response.is_initialized()) {
+        Release(*host, connection, false);
+        auto lock = boost::lock_guard(m_mutex);
+        ++m_statistics.m_retriedRequests;
+        continue;
+      }
+      auto isKeepAlive = [&] {
+        auto connectionHeader = response->GetHeader("Connection");
+        if(!connectionHeader.is_initialized()) {
+          return response->GetVersion() != HttpVersion::Version1_0();
         }
-        cookieRequest.emplace(request);
+        return boost::iequals(*connectionHeader, "keep-alive");
+      }();
+      Release(*host, connection, isKeepAlive);
+    }
+    if(!response->GetCookies().empty()) {
+      auto lock = boost::lock_guard(m_mutex);
+      auto& hostCookies = m_cookies[request.GetUri().GetHostname()];
+      for(auto& cookie : response->GetCookies()) {
+        auto isFound = false;
         for(auto& hostCookie : hostCookies) {
-          cookieRequest->Add(hostCookie);
+          if(hostCookie.GetName() == cookie.GetName()) {
+            hostCookie.SetValue(cookie.GetValue());
+            isFound = true;
+            break;
+          }
         }
-        return *cookieRequest;
-      }();
-    if(!m_channel.is_initialized() || m_channel->m_endPoint != endPoint) {
-      m_channel.reset();
-      auto channel = m_channelBuilder(request.GetUri());
-      channel->GetConnection().Open();
-      m_channel.emplace(endPoint, std::move(channel));
-      isNewChannel = true;
+        if(!isFound) {
+          hostCookies.push_back(cookie);
+        }
+      }
     }
+    return std::move(*response);
+  }
+
+  template<typename ChannelType>
+  std::pair<std::shared_ptr<typename HttpClient<ChannelType>::Connection>,
+      bool> HttpClient<ChannelType>::Acquire(Host& host, const Uri& uri) {
+    auto expired = std::vector<std::shared_ptr<Connection>>();
     {
-      typename Channel::Writer::Buffer writeBuffer;
-      properRequest.Encode(Store(writeBuffer));
-      try {
-        m_channel->m_channel->GetWriter().Write(writeBuffer);
-      } catch(const std::exception&) {
-        m_channel.reset();
-        if(isNewChannel) {
+      auto lock = boost::lock_guard(m_mutex);
+      Expire(expired);
+    }
+    for(auto& connection : expired) {
+      connection->m_channel->GetConnection().Close();
+    }
+    auto lock = boost::unique_lock(m_mutex);
+    ++m_statistics.m_requests;
+    auto hasWaited = false;
+    while(true) {
+      for(auto& connection : host.m_connections) {
+        if(connection->m_isReusable && connection->m_pendingRequests == 0) {
+          ++connection->m_pendingRequests;
+          ++m_statistics.m_reusedRequests;
+          return {connection, true};
+        }
+      }
+      if(host.m_connectionCount < m_maxConnectionsPerHost) {
+        ++host.m_connectionCount;
+        lock.unlock();
+        auto connection = std::shared_ptr<Connection>();
+        try {
+          connection = std::make_shared<Connection>(m_channelBuilder(uri));
+          connection->m_channel->GetConnection().Open();
+        } catch(const std::exception&) {
+          lock.lock();
+          --host.m_connectionCount;
+          host.m_availableCondition.notify_all();
           throw;
         }
-        Send(request);
+        lock.lock();
+        ++connection->m_pendingRequests;
+        host.m_connections.push_back(connection);
+        ++m_statistics.m_connectionsOpened;
+        return {std::move(connection), false};
+      }
+      if(m_maxPipelineDepth > 1) {
+        auto shortest = std::shared_ptr<Connection>();
+        for(auto& connection : host.m_connections) {
+          if(connection->m_isReusable &&
+              connection->m_pendingRequests < m_maxPipelineDepth &&
+              (shortest == nullptr || connection->m_pendingRequests <
+              shortest->m_pendingRequests)) {
+            shortest = connection;
+          }
+        }
+        if(shortest != nullptr) {
+          ++shortest->m_pendingRequests;
+          ++m_statistics.m_reusedRequests;
+          ++m_statistics.m_pipelinedRequests;
+          return {std::move(shortest), true};
+        }
+      }
+      if(!hasWaited) {
+        hasWaited = true;
+        ++m_statistics.m_waitedRequests;
       }
+      host.m_availableCondition.wait(lock);
     }
-    HttpResponseParser parser;
-    auto response = parser.GetNextResponse();
-    while(!response.is_initialized()) {
-      typename Channel::Reader::Buffer readBuffer;
+  }
+
+  template<typename ChannelType>
+  boost::optional<HttpResponse> HttpClient<ChannelType>::Send(
+      Connection& connection,
+      const typename Channel::Writer::Buffer& writeBuffer, bool isReused,
+      bool isIdempotent) {
+    auto ticket = std::uint64_t();
+    {
+      auto lock = boost::lock_guard(connection.m_writeMutex);
+      ticket = connection.m_nextTicket;
+      ++connection.m_nextTicket;
       try {
-        m_channel->m_channel->GetReader().Read(Store(readBuffer));
+        connection.m_channel->GetWriter().Write(writeBuffer);
       } catch(const std::exception&) {
-        m_channel.reset();
+        Break(connection);
+        if(isReused) {
+          return boost::none;
+        }
         throw;
       }
-      parser.Feed(readBuffer.GetData(), readBuffer.GetSize());
-      response = parser.GetNextResponse();
     }
-    auto connectionHeader = response->GetHeader("Connection");
-    if(!connectionHeader.is_initialized()) {
-      if(response->GetVersion() == HttpVersion::Version1_0()) {
-        m_channel->m_channel->GetConnection().Close();
-        m_channel.reset();
+    {
+      auto lock = boost::unique_lock(connection.m_readMutex);
+      while(!connection.m_isBroken && connection.m_servingTicket != ticket) {
+        connection.m_readCondition.wait(lock);
       }
-    } else {
-      if(!boost::iequals(*connectionHeader, "keep-alive")) {
-        m_channel->m_channel->GetConnection().Close();
-        m_channel.reset();
+      if(connection.m_isBroken) {
+        if(isIdempotent) {
+          return boost::none;
+        }
+        BOOST_THROW_EXCEPTION(IO::IOException(
+          "Connection failed after the request was sent."));
       }
     }
-    auto& cookies = response->GetCookies();
-    for(auto& cookie : cookies) {
-      auto isFound = false;
-      for(auto& hostCookie : hostCookies) {
-        if(hostCookie.GetName() == cookie.GetName()) {
-          hostCookie.SetValue(cookie.GetValue());
-          isFound = true;
-          break;
-        }
+    auto hasReceived = false;
+    auto response = connection.m_parser.GetNextResponse();
+    try {
+      while(!response.is_initialized()) {
+        typename Channel::Reader::Buffer readBuffer;
+        connection.m_channel->GetReader().Read(Store(readBuffer));
+        hasReceived = true;
+        connection.m_parser.Feed(readBuffer.GetData(), readBuffer.GetSize());
+        response = connection.m_parser.GetNextResponse();
+      }
+    } catch(const std::exception&) {
+      Break(connection);
+      if(isReused && isIdempotent && !hasReceived) {
+        return boost::none;
+      }
+      throw;
+    }
+    auto lock = boost::lock_guard(connection.m_readMutex);
+    ++connection.m_servingTicket;
+    connection.m_readCondition.notify_all();
+    return response;
+  }
+
+  template<typename ChannelType>
+  void HttpClient<ChannelType>::Release(Host& host,
+      const std::shared_ptr<Connection>& connection, bool isReusable) {
+    {
+      auto lock = boost::lock_guard(m_mutex);
+      --connection->m_pendingRequests;
+      connection->m_lastUsed =
+        boost::posix_time::microsec_clock::universal_time();
+      if(!isReusable) {
+        connection->m_isReusable = false;
+      }
+      host.m_availableCondition.notify_all();
+      if(connection->m_isReusable || connection->m_pendingRequests != 0) {
+        return;
       }
-      if(!isFound) {
-        hostCookies.push_back(cookie);
+      auto i = std::find(host.m_connections.begin(), host.m_connections.end(),
+        connection);
+      if(i == host.m_connections.end()) {
+        return;
+      }
+      host.m_connections.erase(i);
+      --host.m_connectionCount;
+      ++m_statistics.m_connectionsClosed;
+    }
+    connection->m_channel->GetConnection().Close();
+  }
+
+  template<typename ChannelType>
+  void HttpClient<ChannelType>::Break(Connection& connection) {
+    {
+      auto lock = boost::lock_guard(m_mutex);
+      connection.m_isReusable = false;
+    }
+    {
+      auto lock = boost::lock_guard(connection.m_readMutex);
+      connection.m_isBroken = true;
+      connection.m_readCondition.notify_all();
+    }
+    connection.m_channel->GetConnection().Close();
+  }
+
+  template<typename ChannelType>
+  void HttpClient<ChannelType>::Expire(
+      std::vector<std::shared_ptr<Connection>>& expired) {
+    auto now = boost::posix_time::microsec_clock::universal_time();
+    for(auto& host : m_hosts) {
+      auto& connections = host.second.m_connections;
+      auto i = std::stable_partition(connections.begin(), connections.end(),
+        [&] (const auto& connection) {
+          return !connection->m_isReusable ||
+            connection->m_pendingRequests != 0 ||
+            now - connection->m_lastUsed < m_idleTimeout;
+        });
+      auto count = static_cast<std::size_t>(std::distance(i,
+        connections.end()));
+      if(count == 0) {
+        continue;
       }
+      expired.insert(expired.end(), std::make_move_iterator(i),
+        std::make_move_iterator(connections.end()));
+      connections.erase(i, connections.end());
+      host.second.m_connectionCount -= count;
+      m_statistics.m_connectionsExpired += count;
+      m_statistics.m_connectionsClosed += count;
+      host.second.m_availableCondition.notify_all();
     }
-    return *response;
   }
 }
 }
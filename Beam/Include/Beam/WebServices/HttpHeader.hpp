@@ -1,11 +1,96 @@
 #ifndef BEAM_HTTPHEADER_HPP
 #define BEAM_HTTPHEADER_HPP
+#include <cstddef>
 #include <ostream>
 #include <string>
+#include <string_view>
+#include <vector>
 #include "Beam/WebServices/WebServices.hpp"
 
 namespace Beam {
 namespace WebServices {
+namespace Details {
+  inline char ToLowerAscii(char c) {
+    if(c >= 'A' && c <= 'Z') {
+      return static_cast<char>(c - 'A' + 'a');
+    }
+    return c;
+  }
+
+  inline bool IEquals(std::string_view left, std::string_view right) {
+    if(left.size() != right.size()) {
+      return false;
+    }
+    for(auto i = std::size_t(0); i != left.size(); ++i) {
+      if(ToLowerAscii(left[i]) != ToLowerAscii(right[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  inline bool IContains(std::string_view source, std::string_view token) {
+    if(token.size() > source.size()) {
+      return false;
+    }
+    for(auto i = std::size_t(0); i <= source.size() - token.size(); ++i) {
+      if(IEquals(source.substr(i, token.size()), token)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  inline std::size_t IHash(std::string_view source) {
+    auto hash = std::size_t(14695981039346656037ULL);
+    for(auto c : source) {
+      hash ^= static_cast<unsigned char>(ToLowerAscii(c));
+      hash *= std::size_t(1099511628211ULL);
+    }
+    return hash;
+  }
+
+  /* Stores a list of headers as offsets into a single string. */
+  struct HttpHeaderBlock {
+    struct Span {
+      std::size_t m_nameOffset;
+      std::size_t m_nameSize;
+      std::size_t m_valueOffset;
+      std::size_t m_valueSize;
+    };
+    std::string m_text;
+    std::vector<Span> m_spans;
+
+    std::size_t GetSize() const {
+      return m_spans.size();
+    }
+
+    std::string_view GetName(std::size_t index) const {
+      auto& span = m_spans[index];
+      return std::string_view(m_text).substr(span.m_nameOffset,
+        span.m_nameSize);
+    }
+
+    std::string_view GetValue(std::size_t index) const {
+      auto& span = m_spans[index];
+      return std::string_view(m_text).substr(span.m_valueOffset,
+        span.m_valueSize);
+    }
+
+    void Append(std::string_view name, std::string_view value) {
+      auto nameOffset = m_text.size();
+      m_text.append(name.data(), name.size());
+      auto valueOffset = m_text.size();
+      m_text.append(value.data(), value.size());
+      m_spans.push_back({nameOffset, name.size(), valueOffset, value.size()});
+    }
+
+    void Clear() {
+      m_text.clear();
+      m_spans.clear();
+    }
+  };
+}
 
   /*! \class HttpHeader
       \brief Stores an HTTP header.
@@ -117,7 +117,7 @@ namespace WebServices {
 
       //! Returns the value of a header.
       /*!
-        \param name The name of the header.
+        \param name The name of the header, compared case-insensitively.
         \return The value of the header with the specified <i>name</i>.
       */
       boost::optional<const std::string&> GetHeader(
@@ -163,14 +163,22 @@ namespace WebServices {
       void Encode(Out<Buffer> buffer) const;
 
     private:
+      friend class HttpRequestParser;
       HttpVersion m_version;
       HttpMethod m_method;
       Uri m_uri;
-      std::vector<HttpHeader> m_headers;
+      Details::HttpHeaderBlock m_headerBlock;
+      std::vector<std::size_t> m_headerHashes;
+      mutable Threading::Sync<boost::optional<std::vector<HttpHeader>>>
+        m_headers;
       SpecialHeaders m_specialHeaders;
       std::vector<Cookie> m_cookies;
       IO::SharedBuffer m_body;
       mutable Threading::Sync<std::string> m_contentLength;
+
+      HttpRequest(HttpVersion version, HttpMethod method, Uri uri,
+        Details::HttpHeaderBlock headers, const SpecialHeaders& specialHeaders,
+        std::vector<Cookie> cookies, IO::SharedBuffer body);
   };
 
   inline std::ostream& operator <<(std::ostream& sink,
@@ -247,24 +255,42 @@ namespace WebServices {
 
   inline HttpRequest::HttpRequest(HttpMethod method, Uri uri,
       IO::SharedBuffer body)
-      : HttpRequest{HttpVersion::Version1_1(), method, std::move(uri), {}, {},
-          {}, std::move(body)} {}
+      : HttpRequest{HttpVersion::Version1_1(), method, std::move(uri),
+          Details::HttpHeaderBlock(), {}, {}, std::move(body)} {}
 
   inline HttpRequest::HttpRequest(HttpVersion version, HttpMethod method,
       Uri uri)
-      : HttpRequest{version, method, std::move(uri), {}, {}, {}, {}} {}
+      : HttpRequest{version, method, std::move(uri), Details::HttpHeaderBlock(),
+          {}, {}, {}} {}
 
   inline HttpRequest::HttpRequest(HttpVersion version, HttpMethod method,
       Uri uri, std::vector<HttpHeader> headers,
       const SpecialHeaders& specialHeaders, std::vector<Cookie> cookies,
       IO::SharedBuffer body)
+      : HttpRequest{std::move(version), method, std::move(uri),
+          [&] {
+            auto block = Details::HttpHeaderBlock();
+            for(auto& header : headers) {
+              block.Append(header.GetName(), header.GetValue());
+            }
+            return block;
+          }(), specialHeaders, std::move(cookies), std::move(body)} {}
+
+  inline HttpRequest::HttpRequest(HttpVersion version, HttpMethod method,
+      Uri uri, Details::HttpHeaderBlock headers,
+      const SpecialHeaders& specialHeaders, std::vector<Cookie> cookies,
+      IO::SharedBuffer body)
       : m_version{std::move(version)},
         m_method{std::move(method)},
         m_uri{std::move(uri)},
-        m_headers{std::move(headers)},
+        m_headerBlock{std::move(headers)},
         m_specialHeaders{specialHeaders},
         m_cookies{std::move(cookies)},
         m_body{std::move(body)} {
+    m_headerHashes.reserve(m_headerBlock.GetSize());
+    for(auto i = std::size_t(0); i != m_headerBlock.GetSize(); ++i) {
+      m_headerHashes.push_back(Details::IHash(m_headerBlock.GetName(i)));
+    }
     if(m_specialHeaders.m_host.empty()) {
       m_specialHeaders.m_host = m_uri.GetHostname();
       if(m_uri.GetPort() != 0 &&
@@ -303,41 +329,54 @@ namespace WebServices {
 
   inline boost::optional<const std::string&> HttpRequest::GetHeader(
       const std::string& name) const {
-    auto header = std::find_if(m_headers.begin(), m_headers.end(),
-      [&] (const HttpHeader& value) {
-        return value.GetName() == name;
-      });
-    if(header == m_headers.end()) {
-      if(name == "Host") {
-        return m_specialHeaders.m_host;
-      } else if(name == "Content-Length") {
-        return Threading::With(m_contentLength,
-          [&] (auto& contentLength) -> std::string& {
-            if(contentLength.empty()) {
-              contentLength = std::to_string(m_specialHeaders.m_contentLength);
-            }
-            return contentLength;
-          });
-      } else if(name == "Connection") {
-        if(m_specialHeaders.m_connection == ConnectionHeader::KEEP_ALIVE) {
-          static const std::string VALUE = "keep-alive";
-          return VALUE;
-        } else if(m_specialHeaders.m_connection == ConnectionHeader::CLOSE) {
-          static const std::string VALUE = "close";
-          return VALUE;
-        } else {
-          static const std::string VALUE = "Upgrade";
-          return VALUE;
-        }
+    auto hash = Details::IHash(name);
+    for(auto i = std::size_t(0); i != m_headerHashes.size(); ++i) {
+      if(m_headerHashes[i] == hash &&
+          Details::IEquals(m_headerBlock.GetName(i), name)) {
+        return GetHeaders()[i].GetValue();
+      }
+    }
+    if(Details::IEquals(name, "Host")) {
+      return m_specialHeaders.m_host;
+    } else if(Details::IEquals(name, "Content-Length")) {
+      return Threading::With(m_contentLength,
+        [&] (auto& contentLength) -> std::string& {
+          if(contentLength.empty()) {
+            contentLength = std::to_string(m_specialHeaders.m_contentLength);
+          }
+          return contentLength;
+        });
+    } else if(Details::IEquals(name, "Connection")) {
+      if(m_specialHeaders.m_connection == ConnectionHeader::KEEP_ALIVE) {
+        static const std::string VALUE = "keep-alive";
+        return VALUE;
+      } else if(m_specialHeaders.m_connection == ConnectionHeader::CLOSE) {
+        static const std::string VALUE = "close";
+        return VALUE;
       } else {
-        return boost::none;
+        static const std::string VALUE = "Upgrade";
+        return VALUE;
       }
+    } else {
+      return boost::none;
     }
-    return header->GetValue();
   }
 
   inline const std::vector<HttpHeader>& HttpRequest::GetHeaders() const {
-    return m_headers;
+
+    // Parsed headers stay in the block until they're first accessed.
+    return Threading::With(m_headers,
+      [&] (auto& headers) -> std::vector<HttpHeader>& {
+        if(!headers.is_initialized()) {
+          headers.emplace();
+          headers->reserve(m_headerBlock.GetSize());
+          for(auto i = std::size_t(0); i != m_headerBlock.GetSize(); ++i) {
+            headers->emplace_back(std::string(m_headerBlock.GetName(i)),
+              std::string(m_headerBlock.GetValue(i)));
+          }
+        }
+        return *headers;
+      });
   }
 
   inline const SpecialHeaders& HttpRequest::GetSpecialHeaders() const {
@@ -362,7 +401,9 @@ namespace WebServices {
         BOOST_THROW_EXCEPTION(std::runtime_error{"Invalid Connection header."});
       }
     } else {
-      m_headers.push_back(std::move(header));
+      m_headerHashes.push_back(Details::IHash(header.GetName()));
+      m_headerBlock.Append(header.GetName(), header.GetValue());
+      m_headers = boost::none;
     }
   }
 
@@ -1,7 +1,9 @@
 #ifndef BEAM_HTTPREQUESTPARSER_HPP
 #define BEAM_HTTPREQUESTPARSER_HPP
+#include <charconv>
 #include <deque>
-#include <boost/algorithm/string.hpp>
+#include <string>
+#include <string_view>
 #include <boost/noncopyable.hpp>
 #include <boost/optional/optional.hpp>
 #include "Beam/WebServices/HttpHeader.hpp"
@@ -13,7 +15,6 @@
 
 namespace Beam {
 namespace WebServices {
-
   /*! \class HttpRequestParser
       \brief Parses an HTTP request.
    */
@@ -44,7 +45,7 @@ namespace WebServices {
       HttpMethod m_method;
       boost::optional<Uri> m_uri;
       HttpVersion m_version;
-      std::vector<HttpHeader> m_headers;
+      Details::HttpHeaderBlock m_headers;
       SpecialHeaders m_specialHeaders;
       std::vector<Cookie> m_cookies;
       IO::SharedBuffer m_body;
@@ -53,8 +54,8 @@ namespace WebServices {
 
       void ParseMethod(const char* c, std::size_t size);
       void ParseHeader(const char* c, std::size_t size);
-      void ParseCookie(const char* source, int length);
-      void ParseCookies(const std::string& source);
+      void ParseCookie(std::string_view source);
+      void ParseCookies(std::string_view source);
       void ParseBody(const char* c);
   };
 
@@ -136,11 +137,11 @@ namespace WebServices {
       if(m_parserState == ParserState::ERR) {
         return;
       }
-      m_requests.emplace_back(m_version, m_method, std::move(*m_uri),
+      m_requests.push_back(HttpRequest(m_version, m_method, std::move(*m_uri),
         std::move(m_headers), m_specialHeaders, std::move(m_cookies),
-        std::move(m_body));
+        std::move(m_body)));
       m_uri.reset();
-      m_headers.clear();
+      m_headers.Clear();
       m_cookies.clear();
       m_body.Reset();
       m_parserState = ParserState::METHOD;
@@ -211,63 +212,62 @@ namespace WebServices {
       m_parserState = ParserState::ERR;
       return;
     }
-    ++c;
-    --size;
-    auto nameEnd = static_cast<const char*>(std::memchr(c, ':', size));
-    if(nameEnd == nullptr) {
+    auto line = std::string_view(c + 1, size - 1);
+    auto nameEnd = line.find(':');
+    if(nameEnd == std::string_view::npos) {
       m_parserState = ParserState::ERR;
       return;
     }
-    auto nameLength = static_cast<unsigned int>(nameEnd - c);
-    std::string name{c, nameLength};
-    c += nameLength + 1;
-    size -= nameLength + 1;
-    if(*c != ' ') {
+    auto name = line.substr(0, nameEnd);
+    auto value = line.substr(nameEnd + 1);
+    if(value.empty() || value.front() != ' ') {
       m_parserState = ParserState::ERR;
       return;
     }
-    ++c;
-    --size;
-    std::string value{c, size};
+    value.remove_prefix(1);
     if(m_specialHeaders.m_contentLength == 0 &&
-        boost::iequals(name, "Content-Length")) {
-      m_specialHeaders.m_contentLength = std::stoul(value);
-    } else if(boost::iequals(name, "Connection")) {
+        Details::IEquals(name, "Content-Length")) {
+      auto contentLength = std::size_t(0);
+      auto result = std::from_chars(value.data(), value.data() + value.size(),
+        contentLength);
+      if(result.ec != std::errc() ||
+          result.ptr != value.data() + value.size()) {
+        m_parserState = ParserState::ERR;
+        return;
+      }
+      m_specialHeaders.m_contentLength = contentLength;
+    } else if(Details::IEquals(name, "Connection")) {
       m_specialHeaders.m_connection = ConnectionHeader::CLOSE;
-      if(boost::ifind_first(value, "Upgrade")) {
+      if(Details::IContains(value, "Upgrade")) {
         m_specialHeaders.m_connection = ConnectionHeader::UPGRADE;
-      } else if(boost::ifind_first(value, "keep-alive")) {
+      } else if(Details::IContains(value, "keep-alive")) {
         m_specialHeaders.m_connection = ConnectionHeader::KEEP_ALIVE;
       }
+    } else if(m_cookies.empty() && Details::IEquals(name, "Cookie")) {
+      ParseCookies(value);
     } else {
-      if(m_cookies.empty() && boost::iequals(name, "Cookie")) {
-        ParseCookies(value);
-      } else {
-        m_headers.emplace_back(std::move(name), std::move(value));
-      }
+      m_headers.Append(name, value);
     }
   }
 
-  inline void HttpRequestParser::ParseCookie(const char* source, int length) {
-    auto separator = static_cast<const char*>(std::memchr(source, '=', length));
-    if(separator == nullptr) {
-      m_cookies.emplace_back(std::string{},
-        std::string{source, static_cast<unsigned int>(length)});
+  inline void HttpRequestParser::ParseCookie(std::string_view source) {
+    auto separator = source.find('=');
+    if(separator == std::string_view::npos) {
+      m_cookies.emplace_back(std::string(), std::string(source));
     } else {
-      m_cookies.emplace_back(std::string{source, separator},
-        std::string{separator + 1, static_cast<std::string::size_type>(length) -
-        (separator - source) - 1});
+      m_cookies.emplace_back(std::string(source.substr(0, separator)),
+        std::string(source.substr(separator + 1)));
     }
   }
 
-  inline void HttpRequestParser::ParseCookies(const std::string& source) {
-    std::string::size_type front = 0;
+  inline void HttpRequestParser::ParseCookies(std::string_view source) {
+    auto front = std::size_t(0);
     while(front < source.size()) {
       auto separator = source.find(';', front);
-      if(separator == std::string::npos) {
+      if(separator == std::string_view::npos) {
         separator = source.size();
       }
-      ParseCookie(source.c_str() + front, separator - front);
+      ParseCookie(source.substr(front, separator - front));
       front = separator + 2;
     }
   }
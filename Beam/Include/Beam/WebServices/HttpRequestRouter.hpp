@@ -0,0 +1,149 @@
+#ifndef BEAM_HTTPREQUESTROUTER_HPP
+#define BEAM_HTTPREQUESTROUTER_HPP
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Beam/WebServices/HttpRequest.hpp"
+#include "Beam/WebServices/HttpRequestSlot.hpp"
+#include "Beam/WebServices/WebServices.hpp"
+
+namespace Beam {
+namespace WebServices {
+
+  /*! \class HttpRequestRouter
+      \brief Finds the HttpRequestSlot that handles an HttpRequest.
+      \details Slots with a Route are compiled into a trie keyed by method and
+               path segment so they are found without evaluating predicates,
+               slots with only a predicate are evaluated in order. In either
+               case the first slot in the list to match the request is the
+               one found.
+   */
+  class HttpRequestRouter {
+    public:
+
+      //! Constructs an HttpRequestRouter.
+      /*!
+        \param slots The slots to route requests to, in order of priority.
+      */
+      explicit HttpRequestRouter(std::vector<HttpRequestSlot> slots);
+
+      //! Returns the slots requests are routed to.
+      const std::vector<HttpRequestSlot>& GetSlots() const;
+
+      //! Finds the slot handling a request.
+      /*!
+        \param request The request to route.
+        \return The first slot matching the <i>request</i> or
+                <code>nullptr</code> if no slot matches.
+      */
+      const HttpRequestSlot* Find(const HttpRequest& request) const;
+
+    private:
+      static constexpr auto NONE = std::numeric_limits<std::size_t>::max();
+      struct Node {
+        std::map<std::string, std::unique_ptr<Node>, std::less<>> m_children;
+        std::unique_ptr<Node> m_wildcard;
+        std::size_t m_index;
+        std::size_t m_remainderIndex;
+
+        Node();
+      };
+      std::vector<HttpRequestSlot> m_slots;
+      std::unordered_map<HttpMethod, Node> m_roots;
+      std::vector<std::size_t> m_predicateSlots;
+
+      void Add(const HttpRequestSlot::Route& route, std::size_t index);
+      static std::size_t Find(const Node& node, std::string_view path);
+  };
+
+  inline HttpRequestRouter::Node::Node()
+    : m_index(NONE),
+      m_remainderIndex(NONE) {}
+
+  inline HttpRequestRouter::HttpRequestRouter(
+      std::vector<HttpRequestSlot> slots)
+      : m_slots(std::move(slots)) {
+    for(auto i = std::size_t(0); i != m_slots.size(); ++i) {
+      if(m_slots[i].m_route) {
+        Add(*m_slots[i].m_route, i);
+      } else {
+        m_predicateSlots.push_back(i);
+      }
+    }
+  }
+
+  inline const std::vector<HttpRequestSlot>&
+      HttpRequestRouter::GetSlots() const {
+    return m_slots;
+  }
+
+  inline const HttpRequestSlot* HttpRequestRouter::Find(
+      const HttpRequest& request) const {
+    auto index = NONE;
+    auto root = m_roots.find(request.GetMethod());
+    if(root != m_roots.end()) {
+      index = Find(root->second, request.GetUri().GetPath());
+    }
+    for(auto predicateIndex : m_predicateSlots) {
+      if(predicateIndex > index) {
+        break;
+      }
+      if(m_slots[predicateIndex].m_predicate(request)) {
+        return &m_slots[predicateIndex];
+      }
+    }
+    if(index == NONE) {
+      return nullptr;
+    }
+    return &m_slots[index];
+  }
+
+  inline void HttpRequestRouter::Add(const HttpRequestSlot::Route& route,
+      std::size_t index) {
+    auto node = &m_roots[route.m_method];
+    auto path = std::string_view(route.m_path);
+    auto segment = std::string_view();
+    while(Details::NextPathSegment(path, segment)) {
+      if(segment == "**") {
+        node->m_remainderIndex = std::min(node->m_remainderIndex, index);
+        return;
+      }
+      auto& child = [&] () -> std::unique_ptr<Node>& {
+        if(segment == "*") {
+          return node->m_wildcard;
+        }
+        return node->m_children[std::string(segment)];
+      }();
+      if(child == nullptr) {
+        child = std::make_unique<Node>();
+      }
+      node = child.get();
+    }
+    node->m_index = std::min(node->m_index, index);
+  }
+
+  inline std::size_t HttpRequestRouter::Find(const Node& node,
+      std::string_view path) {
+    auto index = node.m_remainderIndex;
+    auto segment = std::string_view();
+    if(!Details::NextPathSegment(path, segment)) {
+      return std::min(index, node.m_index);
+    }
+    auto child = node.m_children.find(segment);
+    if(child != node.m_children.end()) {
+      index = std::min(index, Find(*child->second, path));
+    }
+    if(node.m_wildcard != nullptr) {
+      index = std::min(index, Find(*node.m_wildcard, path));
+    }
+    return index;
+  }
+}
+}
+
+#endif
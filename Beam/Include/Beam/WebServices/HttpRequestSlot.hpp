@@ -1,10 +1,45 @@
 #ifndef BEAM_HTTPREQUESTSLOT_HPP
 #define BEAM_HTTPREQUESTSLOT_HPP
 #include <functional>
+#include <string>
+#include <string_view>
+#include <boost/optional/optional.hpp>
+#include "Beam/WebServices/HttpMethod.hpp"
+#include "Beam/WebServices/HttpRequest.hpp"
 #include "Beam/WebServices/WebServices.hpp"
 
 namespace Beam {
 namespace WebServices {
+namespace Details {
+  inline bool NextPathSegment(std::string_view& path,
+      std::string_view& segment) {
+    while(!path.empty() && path.front() == '/') {
+      path.remove_prefix(1);
+    }
+    if(path.empty()) {
+      return false;
+    }
+    auto end = path.find('/');
+    segment = path.substr(0, end);
+    path.remove_prefix(segment.size());
+    return true;
+  }
+
+  inline bool IsRouteMatch(std::string_view pattern, std::string_view path) {
+    auto patternSegment = std::string_view();
+    auto pathSegment = std::string_view();
+    while(NextPathSegment(pattern, patternSegment)) {
+      if(patternSegment == "**") {
+        return true;
+      }
+      if(!NextPathSegment(path, pathSegment) ||
+          (patternSegment != "*" && patternSegment != pathSegment)) {
+        return false;
+      }
+    }
+    return !NextPathSegment(path, pathSegment);
+  }
+}
 
   /*! \struct HttpRequestSlot
       \brief Composes an HttpRequestPredicate with a callback.
@@ -25,23 +60,57 @@ namespace WebServices {
     */
     using Slot = std::function<HttpResponse (const HttpRequest& request)>;
 
+    /*! \struct Route
+        \brief Matches a request by its method and URI path.
+        \details The path is a list of segments separated by '/', a segment
+                 consisting of * matches any single segment and a final
+                 segment consisting of ** matches any remaining segments.
+     */
+    struct Route {
+
+      //! The method to match.
+      HttpMethod m_method;
+
+      //! The path pattern to match.
+      std::string m_path;
+    };
+
     //! The predicate to match.
     Predicate m_predicate;
 
     //! The slot to call if the predicate matches.
     Slot m_slot;
 
+    //! The Route equivalent to the predicate, used to dispatch a request
+    //! without evaluating the predicate.
+    boost::optional<Route> m_route;
+
     //! Constructs an HttpRequestSlot.
     /*!
       \param predicate The predicate that must be satisfied.
       \param slot The slot to call if the <i>predicate</i> is satisfied.
     */
     HttpRequestSlot(Predicate predicate, Slot slot);
+
+    //! Constructs an HttpRequestSlot matching a Route.
+    /*!
+      \param route The Route that must be matched.
+      \param slot The slot to call if the <i>route</i> is matched.
+    */
+    HttpRequestSlot(Route route, Slot slot);
   };
 
   inline HttpRequestSlot::HttpRequestSlot(Predicate predicate, Slot slot)
       : m_predicate{std::move(predicate)},
         m_slot{std::move(slot)} {}
+
+  inline HttpRequestSlot::HttpRequestSlot(Route route, Slot slot)
+      : m_predicate{[=] (const HttpRequest& request) {
+          return request.GetMethod() == route.m_method &&
+            Details::IsRouteMatch(route.m_path, request.GetUri().GetPath());
+        }},
+        m_slot{std::move(slot)},
+        m_route{std::move(route)} {}
 }
 }
 
@@ -1,8 +1,11 @@
 #ifndef BEAM_HTTPRESPONSE_HPP
 #define BEAM_HTTPRESPONSE_HPP
+#include <cstdint>
+#include <functional>
 #include <vector>
 #include "Beam/IO/BufferOutputStream.hpp"
 #include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Pointers/Out.hpp"
 #include "Beam/WebServices/Cookie.hpp"
 #include "Beam/WebServices/HttpHeader.hpp"
 #include "Beam/WebServices/HttpStatusCode.hpp"
@@ -18,6 +21,13 @@ namespace WebServices {
   class HttpResponse {
     public:
 
+      //! Appends the next part of a streamed body to a buffer.
+      /*!
+        \param buffer The buffer to append the next part to.
+        \return <code>true</code> iff further parts remain.
+      */
+      using BodyStream = std::function<bool (Out<IO::SharedBuffer> buffer)>;
+
       //! Constructs an HttpResponse with a status of OK.
       HttpResponse();
 
@@ -91,7 +101,19 @@ namespace WebServices {
       //! Sets the body.
       void SetBody(IO::SharedBuffer body);
 
-      //! Outputs this response into a Buffer.
+      //! Sets a body that is written out in parts rather than held in memory.
+      /*!
+        \param size The total size of the body.
+        \param stream Produces the parts of the body.
+      */
+      void SetBody(std::uintmax_t size, BodyStream stream);
+
+      //! Returns the stream producing the body, empty if the body is held in
+      //! memory.
+      const BodyStream& GetBodyStream() const;
+
+      //! Outputs this response into a Buffer, a streamed body is left for
+      //! the caller to write from the BodyStream.
       /*!
         \param buffer The Buffer to output this response to.
       */
@@ -104,6 +126,7 @@ namespace WebServices {
       std::vector<HttpHeader> m_headers;
       std::vector<Cookie> m_cookies;
       IO::SharedBuffer m_body;
+      BodyStream m_bodyStream;
   };
 
   inline std::ostream& operator <<(std::ostream& sink,
@@ -211,9 +234,20 @@ namespace WebServices {
 
   inline void HttpResponse::SetBody(IO::SharedBuffer body) {
     m_body = std::move(body);
+    m_bodyStream = nullptr;
     SetHeader({"Content-Length", std::to_string(m_body.GetSize())});
   }
 
+  inline void HttpResponse::SetBody(std::uintmax_t size, BodyStream stream) {
+    m_body.Reset();
+    m_bodyStream = std::move(stream);
+    SetHeader({"Content-Length", std::to_string(size)});
+  }
+
+  inline const HttpResponse::BodyStream& HttpResponse::GetBodyStream() const {
+    return m_bodyStream;
+  }
+
   template<typename Buffer>
   void HttpResponse::Encode(Out<Buffer> buffer) const {
     char conversionBuffer[64];
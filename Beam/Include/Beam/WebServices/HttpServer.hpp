@@ -12,10 +12,13 @@
 #include "Beam/Routines/RoutineHandlerGroup.hpp"
 #include "Beam/Serialization/JsonSender.hpp"
 #include "Beam/Utilities/SynchronizedSet.hpp"
+#include "Beam/WebServices/HttpAccessLog.hpp"
 #include "Beam/WebServices/HttpRequestParser.hpp"
+#include "Beam/WebServices/HttpRequestRouter.hpp"
 #include "Beam/WebServices/HttpRequestSlot.hpp"
 #include "Beam/WebServices/HttpResponse.hpp"
 #include "Beam/WebServices/HttpUpgradeSlot.hpp"
+#include "Beam/WebServices/PerMessageDeflate.hpp"
 #include "Beam/WebServices/WebSocketChannel.hpp"
 #include "Beam/WebServices/WebServices.hpp"
 
@@ -71,6 +74,9 @@ namespace WebServices {
 
       ~HttpServer();
 
+      //! Returns the log of requests served.
+      HttpAccessLog& GetAccessLog();
+
       void Open();
 
       void Close();
@@ -79,8 +85,9 @@ namespace WebServices {
       typename Channel::Writer::Buffer BAD_REQUEST_RESPONSE_BUFFER;
       typename Channel::Writer::Buffer NOT_FOUND_RESPONSE_BUFFER;
       GetOptionalLocalPtr<ServerConnectionType> m_serverConnection;
-      std::vector<HttpRequestSlot> m_slots;
+      HttpRequestRouter m_router;
       std::vector<WebSocketSlot> m_webSocketSlots;
+      HttpAccessLog m_accessLog;
       Routines::RoutineHandler m_acceptRoutine;
       IO::OpenState m_openState;
 
@@ -109,7 +116,7 @@ namespace WebServices {
       std::vector<WebSocketSlot> webSocketSlots)
       : m_serverConnection{std::forward<ServerConnectionForward>(
           serverConnection)},
-        m_slots{std::move(slots)},
+        m_router{std::move(slots)},
         m_webSocketSlots{std::move(webSocketSlots)} {
     HttpResponse badRequestResponse{HttpStatusCode::BAD_REQUEST};
     badRequestResponse.Encode(Store(BAD_REQUEST_RESPONSE_BUFFER));
@@ -122,6 +129,11 @@ namespace WebServices {
     Close();
   }
 
+  template<typename ServerConnectionType>
+  HttpAccessLog& HttpServer<ServerConnectionType>::GetAccessLog() {
+    return m_accessLog;
+  }
+
   template<typename ServerConnectionType>
   void HttpServer<ServerConnectionType>::Open() {
     if(m_openState.SetOpening()) {
@@ -187,7 +199,6 @@ namespace WebServices {
               requestBuffer.Reset();
               auto request = parser.GetNextRequest();
               while(request.is_initialized()) {
-                std::cout << *request << "\n\n\n" << std::flush;
                 responseBuffer.Reset();
                 if(request->GetSpecialHeaders().m_connection ==
                     ConnectionHeader::UPGRADE) {
@@ -245,9 +256,19 @@ namespace WebServices {
           response.SetHeader({"Connection", "Upgrade"});
           response.SetHeader({"Upgrade", "websocket"});
           response.SetHeader({"Sec-WebSocket-Accept", acceptToken});
+          auto compression =
+            boost::optional<PerMessageDeflate::Parameters>();
+          if(auto extensions = request.GetHeader("Sec-WebSocket-Extensions")) {
+            compression = PerMessageDeflate::Parse(*extensions);
+            if(compression.is_initialized()) {
+              response.SetHeader({"Sec-WebSocket-Extensions",
+                PerMessageDeflate::Format(*compression)});
+            }
+          }
           response.Encode(Store(responseBuffer));
           channel->GetWriter().Write(responseBuffer);
-          auto webSocket = std::make_unique<WebSocket>(channel,
+          auto webSocket = std::make_unique<WebSocket>(channel, compression,
+            WebSocketConfig::DEFAULT_MAX_MESSAGE_SIZE,
             typename WebSocket::ServerTag{});
           auto webSocketChannel = std::make_unique<WebSocketChannel>(
             std::move(webSocket));
@@ -264,28 +285,52 @@ namespace WebServices {
   bool HttpServer<ServerConnectionType>::HandleHttpRequest(
       const HttpRequest& request, Channel& channel,
       typename Channel::Writer::Buffer& responseBuffer) {
-    auto foundSlot = false;
-    for(auto& slot : m_slots) {
-      if(slot.m_predicate(request)) {
+    auto slot = m_router.Find(request);
+    if(slot == nullptr) {
+      channel.GetWriter().Write(NOT_FOUND_RESPONSE_BUFFER);
+      m_accessLog.Log(request, HttpStatusCode::NOT_FOUND, 0);
+    } else {
+      auto statusCode = HttpStatusCode::OK;
+      auto contentLength = std::size_t(0);
+      auto bodyStream = HttpResponse::BodyStream();
+      try {
+        auto response = slot->m_slot(request);
+        statusCode = response.GetStatusCode();
+        contentLength = response.GetBody().GetSize();
+        bodyStream = response.GetBodyStream();
+        response.Encode(Store(responseBuffer));
+      } catch(const std::exception& e) {
+        responseBuffer.Reset();
+        bodyStream = nullptr;
+        HttpResponse response{HttpStatusCode::INTERNAL_SERVER_ERROR};
+        response.SetHeader({"Content-Type", "application/json"});
+        Serialization::JsonSender<IO::SharedBuffer> jsonSender;
+        response.SetBody(Serialization::Encode<IO::SharedBuffer>(jsonSender,
+          std::string{e.what()}));
+        statusCode = response.GetStatusCode();
+        contentLength = response.GetBody().GetSize();
+        response.Encode(Store(responseBuffer));
+      }
+      channel.GetWriter().Write(responseBuffer);
+      if(bodyStream) {
+
+        // The headers are already out, a body that fails part way can only
+        // be reported by closing the connection.
+        auto part = IO::SharedBuffer();
         try {
-          auto response = slot.m_slot(request);
-          response.Encode(Store(responseBuffer));
-        } catch(const std::exception& e) {
-          responseBuffer.Reset();
-          HttpResponse response{HttpStatusCode::INTERNAL_SERVER_ERROR};
-          response.SetHeader({"Content-Type", "application/json"});
-          Serialization::JsonSender<IO::SharedBuffer> jsonSender;
-          response.SetBody(Serialization::Encode<IO::SharedBuffer>(jsonSender,
-            std::string{e.what()}));
-          response.Encode(Store(responseBuffer));
+          auto hasMore = true;
+          while(hasMore) {
+            part.Reset();
+            hasMore = bodyStream(Store(part));
+            channel.GetWriter().Write(part.GetData(), part.GetSize());
+            contentLength += part.GetSize();
+          }
+        } catch(const std::exception&) {
+          m_accessLog.Log(request, statusCode, contentLength);
+          return false;
         }
-        channel.GetWriter().Write(responseBuffer);
-        foundSlot = true;
-        break;
       }
-    }
-    if(!foundSlot) {
-      channel.GetWriter().Write(NOT_FOUND_RESPONSE_BUFFER);
+      m_accessLog.Log(request, statusCode, contentLength);
     }
     return request.GetSpecialHeaders().m_connection != ConnectionHeader::CLOSE;
   }
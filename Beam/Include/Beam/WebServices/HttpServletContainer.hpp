@@ -139,6 +139,9 @@ namespace Details {
 
       ~HttpServletContainer();
 
+      //! Returns the log of requests served.
+      HttpAccessLog& GetAccessLog();
+
       void Open();
 
       void Close();
@@ -163,6 +166,12 @@ namespace Details {
     Close();
   }
 
+  template<typename ServletType, typename ServerConnectionType>
+  HttpAccessLog& HttpServletContainer<ServletType, ServerConnectionType>::
+      GetAccessLog() {
+    return m_server->GetAccessLog();
+  }
+
   template<typename ServletType, typename ServerConnectionType>
   void HttpServletContainer<ServletType, ServerConnectionType>::Open() {
     m_servlet->Open();
@@ -0,0 +1,34 @@
+#ifndef BEAM_MESSAGETOOLARGEEXCEPTION_HPP
+#define BEAM_MESSAGETOOLARGEEXCEPTION_HPP
+#include "Beam/IO/IOException.hpp"
+#include "Beam/WebServices/WebServices.hpp"
+
+namespace Beam {
+namespace WebServices {
+
+  /*! \class MessageTooLargeException
+      \brief Signals that a message exceeded the maximum size allowed.
+   */
+  class MessageTooLargeException : public IO::IOException {
+    public:
+
+      //! Constructs a MessageTooLargeException.
+      MessageTooLargeException();
+
+      //! Constructs a MessageTooLargeException.
+      /*!
+        \param message A message describing the error.
+      */
+      MessageTooLargeException(const std::string& message);
+  };
+
+  inline MessageTooLargeException::MessageTooLargeException()
+      : MessageTooLargeException{"Message too large."} {}
+
+  inline MessageTooLargeException::MessageTooLargeException(
+      const std::string& message)
+      : IO::IOException{message} {}
+}
+}
+
+#endif
@@ -0,0 +1,321 @@
+#ifndef BEAM_PERMESSAGEDEFLATE_HPP
+#define BEAM_PERMESSAGEDEFLATE_HPP
+#include <algorithm>
+#include <charconv>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <boost/noncopyable.hpp>
+#include <boost/optional/optional.hpp>
+#include <boost/throw_exception.hpp>
+#include <zlib.h>
+#include "Beam/IO/IOException.hpp"
+#include "Beam/Pointers/Out.hpp"
+#include "Beam/WebServices/MessageTooLargeException.hpp"
+#include "Beam/WebServices/WebServices.hpp"
+
+namespace Beam {
+namespace WebServices {
+
+  /*! \class PerMessageDeflate
+      \brief Implements the permessage-deflate WebSocket extension (RFC 7692).
+   */
+  class PerMessageDeflate : private boost::noncopyable {
+    public:
+
+      /*! \struct Parameters
+          \brief Stores the parameters negotiated for the extension.
+       */
+      struct Parameters {
+
+        //! Whether the server resets its compression context per message.
+        bool m_serverNoContextTakeover = false;
+
+        //! Whether the client resets its compression context per message.
+        bool m_clientNoContextTakeover = false;
+
+        //! The base-2 log of the server's compression window.
+        int m_serverMaxWindowBits = 15;
+
+        //! The base-2 log of the client's compression window.
+        int m_clientMaxWindowBits = 15;
+      };
+
+      //! Parses the first acceptable permessage-deflate offer or response
+      //! from a Sec-WebSocket-Extensions header.
+      /*!
+        \param header The value of the Sec-WebSocket-Extensions header.
+        \return The Parameters of the first acceptable offer, or
+                <code>boost::none</code> if there is none.
+      */
+      static boost::optional<Parameters> Parse(std::string_view header);
+
+      //! Formats Parameters as a Sec-WebSocket-Extensions value.
+      /*!
+        \param parameters The Parameters to format.
+      */
+      static std::string Format(const Parameters& parameters);
+
+      //! Constructs a PerMessageDeflate.
+      /*!
+        \param parameters The negotiated Parameters.
+        \param isServer Whether the local endpoint is the server.
+      */
+      PerMessageDeflate(const Parameters& parameters, bool isServer);
+
+      ~PerMessageDeflate();
+
+      //! Compresses a fragment of an outgoing message.
+      /*!
+        \param data The uncompressed fragment.
+        \param size The size of the fragment.
+        \param isFinal Whether this is the message's last fragment.
+        \param destination The buffer to append the compressed data to.
+      */
+      template<typename Buffer>
+      void Compress(const void* data, std::size_t size, bool isFinal,
+        Out<Buffer> destination);
+
+      //! Decompresses a fragment of an incoming message.
+      /*!
+        \param data The compressed fragment.
+        \param size The size of the fragment.
+        \param isFinal Whether this is the message's last fragment.
+        \param maxSize The maximum number of bytes the fragment may decompress
+               to, a MessageTooLargeException is thrown if it's exceeded.
+        \param destination The buffer to append the decompressed data to.
+      */
+      template<typename Buffer>
+      void Decompress(const void* data, std::size_t size, bool isFinal,
+        std::size_t maxSize, Out<Buffer> destination);
+
+    private:
+      static constexpr auto MIN_CHUNK_SIZE = std::size_t(1024);
+      z_stream m_deflateStream;
+      z_stream m_inflateStream;
+      bool m_resetDeflate;
+      bool m_resetInflate;
+
+      template<typename Buffer, typename F>
+      static void Flush(z_stream& stream, Out<Buffer> destination,
+        std::size_t chunkSize, std::size_t maxSize, F&& f);
+  };
+
+namespace Details {
+  inline std::string_view Trim(std::string_view source) {
+    while(!source.empty() && (source.front() == ' ' ||
+        source.front() == '\t')) {
+      source.remove_prefix(1);
+    }
+    while(!source.empty() && (source.back() == ' ' || source.back() == '\t')) {
+      source.remove_suffix(1);
+    }
+    return source;
+  }
+
+  inline bool ParseWindowBits(std::string_view value, int& bits) {
+    if(value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+      value = value.substr(1, value.size() - 2);
+    }
+    auto result = std::from_chars(value.data(), value.data() + value.size(),
+      bits);
+    return result.ec == std::errc() &&
+      result.ptr == value.data() + value.size() && bits >= 9 && bits <= 15;
+  }
+
+  inline boost::optional<PerMessageDeflate::Parameters> ParseDeflateOffer(
+      std::string_view offer) {
+    auto parameters = PerMessageDeflate::Parameters();
+    auto isFirst = true;
+    while(!offer.empty()) {
+      auto end = offer.find(';');
+      auto token = Trim(offer.substr(0, end));
+      offer.remove_prefix(std::min(end, offer.size() - 1) + 1);
+      if(isFirst) {
+        if(token != "permessage-deflate") {
+          return boost::none;
+        }
+        isFirst = false;
+        continue;
+      }
+      auto separator = token.find('=');
+      auto name = Trim(token.substr(0, separator));
+      auto value = [&] {
+        if(separator == std::string_view::npos) {
+          return std::string_view();
+        }
+        return Trim(token.substr(separator + 1));
+      }();
+      if(name == "server_no_context_takeover" && value.empty()) {
+        parameters.m_serverNoContextTakeover = true;
+      } else if(name == "client_no_context_takeover" && value.empty()) {
+        parameters.m_clientNoContextTakeover = true;
+      } else if(name == "server_max_window_bits") {
+        if(!ParseWindowBits(value, parameters.m_serverMaxWindowBits)) {
+          return boost::none;
+        }
+      } else if(name == "client_max_window_bits") {
+        if(!value.empty() &&
+            !ParseWindowBits(value, parameters.m_clientMaxWindowBits)) {
+          return boost::none;
+        }
+      } else {
+        return boost::none;
+      }
+    }
+    if(isFirst) {
+      return boost::none;
+    }
+    return parameters;
+  }
+}
+
+  inline boost::optional<PerMessageDeflate::Parameters>
+      PerMessageDeflate::Parse(std::string_view header) {
+    while(!header.empty()) {
+      auto end = header.find(',');
+      if(auto parameters = Details::ParseDeflateOffer(header.substr(0, end))) {
+        return parameters;
+      }
+      if(end == std::string_view::npos) {
+        break;
+      }
+      header.remove_prefix(end + 1);
+    }
+    return boost::none;
+  }
+
+  inline std::string PerMessageDeflate::Format(const Parameters& parameters) {
+    auto header = std::string("permessage-deflate");
+    if(parameters.m_serverNoContextTakeover) {
+      header += "; server_no_context_takeover";
+    }
+    if(parameters.m_clientNoContextTakeover) {
+      header += "; client_no_context_takeover";
+    }
+    if(parameters.m_serverMaxWindowBits != 15) {
+      header += "; server_max_window_bits=" +
+        std::to_string(parameters.m_serverMaxWindowBits);
+    }
+    if(parameters.m_clientMaxWindowBits != 15) {
+      header += "; client_max_window_bits=" +
+        std::to_string(parameters.m_clientMaxWindowBits);
+    }
+    return header;
+  }
+
+  inline PerMessageDeflate::PerMessageDeflate(const Parameters& parameters,
+      bool isServer)
+      : m_deflateStream(),
+        m_inflateStream() {
+    auto windowBits = [&] {
+      if(isServer) {
+        m_resetDeflate = parameters.m_serverNoContextTakeover;
+        m_resetInflate = parameters.m_clientNoContextTakeover;
+        return parameters.m_serverMaxWindowBits;
+      }
+      m_resetDeflate = parameters.m_clientNoContextTakeover;
+      m_resetInflate = parameters.m_serverNoContextTakeover;
+      return parameters.m_clientMaxWindowBits;
+    }();
+    if(deflateInit2(&m_deflateStream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+        -windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+      BOOST_THROW_EXCEPTION(IO::IOException("Unable to initialize deflate."));
+    }
+    if(inflateInit2(&m_inflateStream, -15) != Z_OK) {
+      deflateEnd(&m_deflateStream);
+      BOOST_THROW_EXCEPTION(IO::IOException("Unable to initialize inflate."));
+    }
+  }
+
+  inline PerMessageDeflate::~PerMessageDeflate() {
+    inflateEnd(&m_inflateStream);
+    deflateEnd(&m_deflateStream);
+  }
+
+  template<typename Buffer>
+  void PerMessageDeflate::Compress(const void* data, std::size_t size,
+      bool isFinal, Out<Buffer> destination) {
+    m_deflateStream.next_in = static_cast<Bytef*>(const_cast<void*>(data));
+    m_deflateStream.avail_in = static_cast<uInt>(size);
+    Flush(m_deflateStream, Store(destination),
+      std::max(MIN_CHUNK_SIZE, size / 2),
+      std::numeric_limits<std::size_t>::max(), [] (z_stream& stream) {
+        return deflate(&stream, Z_SYNC_FLUSH);
+      });
+    if(isFinal) {
+      static const char TAIL[] = {'\x00', '\x00', '\xFF', '\xFF'};
+      if(destination->GetSize() >= sizeof(TAIL) && std::equal(TAIL,
+          TAIL + sizeof(TAIL), destination->GetData() +
+          destination->GetSize() - sizeof(TAIL))) {
+        destination->Shrink(sizeof(TAIL));
+      }
+      if(m_resetDeflate) {
+        deflateReset(&m_deflateStream);
+      }
+    }
+  }
+
+  template<typename Buffer>
+  void PerMessageDeflate::Decompress(const void* data, std::size_t size,
+      bool isFinal, std::size_t maxSize, Out<Buffer> destination) {
+    auto inflateSome = [] (z_stream& stream) {
+      auto result = inflate(&stream, Z_SYNC_FLUSH);
+      if(result == Z_STREAM_END) {
+        inflateReset(&stream);
+        return Z_OK;
+      }
+      if(result == Z_BUF_ERROR) {
+        return Z_OK;
+      }
+      if(result != Z_OK) {
+        BOOST_THROW_EXCEPTION(IO::IOException("Invalid compressed message."));
+      }
+      return result;
+    };
+    m_inflateStream.next_in = static_cast<Bytef*>(const_cast<void*>(data));
+    m_inflateStream.avail_in = static_cast<uInt>(size);
+    auto initialSize = destination->GetSize();
+    Flush(m_inflateStream, Store(destination),
+      std::max(MIN_CHUNK_SIZE, 2 * size), maxSize, inflateSome);
+    if(isFinal) {
+      static const char TAIL[] = {'\x00', '\x00', '\xFF', '\xFF'};
+      m_inflateStream.next_in =
+        reinterpret_cast<Bytef*>(const_cast<char*>(TAIL));
+      m_inflateStream.avail_in = sizeof(TAIL);
+      Flush(m_inflateStream, Store(destination), MIN_CHUNK_SIZE,
+        maxSize - (destination->GetSize() - initialSize), inflateSome);
+      if(m_resetInflate) {
+        inflateReset(&m_inflateStream);
+      }
+    }
+  }
+
+  template<typename Buffer, typename F>
+  void PerMessageDeflate::Flush(z_stream& stream, Out<Buffer> destination,
+      std::size_t chunkSize, std::size_t maxSize, F&& f) {
+    auto total = std::size_t(0);
+    do {
+
+      // Room for one byte past the limit tells a stream that fits exactly
+      // apart from one that overflows it.
+      if(maxSize - total < chunkSize) {
+        chunkSize = maxSize - total + 1;
+      }
+      auto offset = destination->GetSize();
+      destination->Grow(chunkSize);
+      stream.next_out =
+        reinterpret_cast<Bytef*>(destination->GetMutableData() + offset);
+      stream.avail_out = static_cast<uInt>(chunkSize);
+      f(stream);
+      destination->Shrink(stream.avail_out);
+      total += chunkSize - stream.avail_out;
+      if(total > maxSize) {
+        BOOST_THROW_EXCEPTION(MessageTooLargeException());
+      }
+    } while(stream.avail_out == 0 || stream.avail_in != 0);
+  }
+}
+}
+
+#endif
@@ -10,10 +10,12 @@ namespace WebServices {
   struct EmailClient;
   class EmailAddress;
   class FileStore;
+  class HttpAccessLog;
   template<typename ChannelType> class HttpClient;
   class HttpHeader;
   enum class HttpMethod;
   class HttpRequest;
+  class HttpRequestRouter;
   struct HttpRequestSlot;
   class HttpResponse;
   class HttpResponseParser;
@@ -25,6 +27,7 @@ namespace WebServices {
   class InvalidHttpRequestException;
   class InvalidHttpResponseException;
   class MalformedUriException;
+  class MessageTooLargeException;
   class NullSessionDataStore;
   class SecureSocketChannelFactory;
   class Session;
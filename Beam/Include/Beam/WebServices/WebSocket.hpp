@@ -1,21 +1,34 @@
 #ifndef BEAM_WEB_SOCKET_HPP
 #define BEAM_WEB_SOCKET_HPP
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <ctime>
 #include <functional>
+#include <memory>
 #include <random>
 #include <string>
 #include <vector>
 #include <boost/noncopyable.hpp>
+#include <boost/optional/optional.hpp>
+#include <boost/thread/locks.hpp>
 #include <cryptopp/osrng.h>
 #include <cryptopp/sha.h>
 #include "Beam/IO/BufferOutputStream.hpp"
+#include "Beam/IO/EndOfFileException.hpp"
+#include "Beam/IO/IOException.hpp"
 #include "Beam/IO/OpenState.hpp"
+#include "Beam/IO/Reader.hpp"
 #include "Beam/IO/SharedBuffer.hpp"
 #include "Beam/Pointers/Dereference.hpp"
 #include "Beam/Pointers/LocalPtr.hpp"
 #include "Beam/Pointers/Out.hpp"
+#include "Beam/Threading/Mutex.hpp"
+#include "Beam/Utilities/Endian.hpp"
 #include "Beam/WebServices/HttpRequest.hpp"
 #include "Beam/WebServices/HttpResponseParser.hpp"
+#include "Beam/WebServices/MessageTooLargeException.hpp"
+#include "Beam/WebServices/PerMessageDeflate.hpp"
 #include "Beam/WebServices/Uri.hpp"
 #include "Beam/WebServices/WebServices.hpp"
 
@@ -39,6 +52,28 @@ namespace Details {
       KEY_LENGTH);
     return std::string(randomBytes, KEY_LENGTH);
   }
+
+  //! Applies a WebSocket masking key to a payload, one word at a time.
+  /*!
+    \param data The payload to mask or unmask in place.
+    \param size The size of the payload.
+    \param maskingKey The masking key in the byte order sent on the wire.
+  */
+  inline void ApplyMask(char* data, std::size_t size,
+      std::uint32_t maskingKey) {
+    auto wideKey = (static_cast<std::uint64_t>(maskingKey) << 32) | maskingKey;
+    auto end = data + (size & ~std::size_t(7));
+    for(; data != end; data += sizeof(wideKey)) {
+      auto word = std::uint64_t();
+      std::memcpy(&word, data, sizeof(word));
+      word ^= wideKey;
+      std::memcpy(data, &word, sizeof(word));
+    }
+    auto key = reinterpret_cast<const char*>(&maskingKey);
+    for(auto i = std::size_t(0); i != (size & 7); ++i) {
+      data[i] ^= key[i & 3];
+    }
+  }
 }
 
   /*! \class WebSocketConfig
@@ -47,6 +82,10 @@ namespace Details {
   class WebSocketConfig {
     public:
 
+      //! The default maximum size of a received message.
+      static constexpr auto DEFAULT_MAX_MESSAGE_SIZE =
+        std::size_t(16 * 1024 * 1024);
+
       //! Constructs a WebSocketConfig with default values.
       WebSocketConfig();
 
@@ -62,16 +101,27 @@ namespace Details {
       //! Sets the list of extensions.
       WebSocketConfig& SetExtensions(std::vector<std::string> extensions);
 
+      //! Sets whether to offer permessage-deflate compression.
+      WebSocketConfig& SetCompression(bool isEnabled);
+
+      //! Sets the maximum size of a received message, after decompression.
+      WebSocketConfig& SetMaxMessageSize(std::size_t maxMessageSize);
+
     private:
       template<typename> friend class WebSocket;
       Uri m_uri;
       std::string m_version;
       std::vector<std::string> m_protocols;
       std::vector<std::string> m_extensions;
+      bool m_isCompressionEnabled;
+      std::size_t m_maxMessageSize;
   };
 
   /*! \class WebSocket
       \brief Implements a WebSocket connection to a server.
+      \details A received message larger than the maximum message size closes
+               the connection with status 1009 and throws a
+               MessageTooLargeException.
       \tparam ChannelType The type Channel used to connect to the server.
    */
   template<typename ChannelType>
@@ -99,19 +149,42 @@ namespace Details {
       //! Constructs a WebSocket operating in server-mode for internal use only.
       /*!
         \param channel The existing Channel to adapt.
+        \param compression The negotiated permessage-deflate parameters.
+        \param maxMessageSize The maximum size of a received message.
         \param tag Internal use only.
       */
       template<typename ChannelForward>
-      WebSocket(ChannelForward&& channel, ServerTag tag);
+      WebSocket(ChannelForward&& channel,
+        const boost::optional<PerMessageDeflate::Parameters>& compression,
+        std::size_t maxMessageSize, ServerTag tag);
 
       ~WebSocket();
 
       //! Returns the Uri this socket connects to.
       const Uri& GetUri() const;
 
-      //! Reads the next frame from the web socket.
+      //! Returns <code>true</code> iff permessage-deflate was negotiated.
+      bool IsCompressed() const;
+
+      //! Reads the next message from the web socket.
       IO::SharedBuffer Read();
 
+      //! Reads the next message from the web socket.
+      /*!
+        \param message The buffer to append the message to.
+      */
+      template<typename Buffer>
+      void Read(Out<Buffer> message);
+
+      //! Reads the next fragment of a message from the web socket without
+      //! waiting for the rest of the message.
+      /*!
+        \param fragment The buffer to append the fragment to.
+        \return <code>true</code> iff the fragment completes its message.
+      */
+      template<typename Buffer>
+      bool ReadFragment(Out<Buffer> fragment);
+
       //! Writes to the web socket.
       /*!
         \param data The raw data to write.
@@ -126,29 +199,75 @@ namespace Details {
       template<typename Buffer>
       void Write(const Buffer& buffer);
 
+      //! Writes a fragment of a message to the web socket.
+      /*!
+        \param data The raw data to write.
+        \param size The number of bytes to write.
+        \param isFinal Whether the fragment completes its message.
+      */
+      void WriteFragment(const void* data, std::size_t size, bool isFinal);
+
       void Open();
 
       void Close();
 
     private:
       template<typename> friend class HttpServer;
+      enum OpCode : std::uint8_t {
+        CONTINUATION = 0x0,
+        TEXT = 0x1,
+        CLOSE = 0x8,
+        PING = 0x9,
+        PONG = 0xA
+      };
+      struct FrameHeader {
+        bool m_isFinal;
+        bool m_isCompressed;
+        std::uint8_t m_opCode;
+        bool m_hasMask;
+        std::uint32_t m_maskingKey;
+        std::uint64_t m_payloadLength;
+      };
+      static constexpr auto MAX_CONTROL_PAYLOAD_LENGTH = std::size_t(125);
+      static constexpr auto MESSAGE_TOO_BIG = std::uint16_t(1009);
       bool m_isServerMode;
       Uri m_uri;
       std::vector<std::string> m_protocols;
       std::vector<std::string> m_extensions;
       std::string m_version;
+      bool m_isCompressionEnabled;
+      std::size_t m_maxMessageSize;
       ChannelBuilder m_channelBuilder;
       HttpResponseParser m_parser;
       GetOptionalLocalPtr<ChannelType> m_channel;
+      std::unique_ptr<PerMessageDeflate> m_compression;
       std::mt19937 m_randomEngine;
       typename Channel::Reader::Buffer m_frameBuffer;
+      typename Channel::Reader::Buffer m_compressedReadBuffer;
+      bool m_isReadingCompressed;
+      std::size_t m_messageSize;
+      Threading::Mutex m_writeMutex;
+      typename Channel::Writer::Buffer m_writeBuffer;
+      typename Channel::Writer::Buffer m_compressedWriteBuffer;
+      bool m_isWritingMessage;
       IO::OpenState m_openState;
 
+      static bool IsControlFrame(std::uint8_t opCode);
       void Shutdown();
+      [[noreturn]] void CloseMessageTooLarge();
+      void ReadExact(char* destination, std::size_t size);
+      FrameHeader ReadFrameHeader();
+      template<typename Buffer>
+      void ReadPayload(const FrameHeader& header, Out<Buffer> payload);
+      void HandleControlFrame(const FrameHeader& header);
+      void WriteFrame(std::uint8_t opCode, bool isFinal, bool isCompressed,
+        const void* data, std::size_t size);
   };
 
   inline WebSocketConfig::WebSocketConfig()
-      : m_version{"13"} {}
+      : m_version{"13"},
+        m_isCompressionEnabled{false},
+        m_maxMessageSize{DEFAULT_MAX_MESSAGE_SIZE} {}
 
   inline WebSocketConfig& WebSocketConfig::SetUri(Uri uri) {
     m_uri = std::move(uri);
@@ -172,6 +291,17 @@ namespace Details {
     return *this;
   }
 
+  inline WebSocketConfig& WebSocketConfig::SetCompression(bool isEnabled) {
+    m_isCompressionEnabled = isEnabled;
+    return *this;
+  }
+
+  inline WebSocketConfig& WebSocketConfig::SetMaxMessageSize(
+      std::size_t maxMessageSize) {
+    m_maxMessageSize = maxMessageSize;
+    return *this;
+  }
+
   template<typename ChannelType>
   WebSocket<ChannelType>::WebSocket(WebSocketConfig config,
       ChannelBuilder channelBuilder)
@@ -180,8 +310,13 @@ namespace Details {
         m_protocols{std::move(config.m_protocols)},
         m_extensions{std::move(config.m_extensions)},
         m_version{std::move(config.m_version)},
+        m_isCompressionEnabled{config.m_isCompressionEnabled},
+        m_maxMessageSize{config.m_maxMessageSize},
         m_channelBuilder{std::move(channelBuilder)},
-        m_randomEngine{static_cast<unsigned int>(std::time(nullptr))} {
+        m_randomEngine{static_cast<unsigned int>(std::time(nullptr))},
+        m_isReadingCompressed{false},
+        m_messageSize{0},
+        m_isWritingMessage{false} {
     if(m_uri.GetPort() == 0) {
       if(m_uri.GetScheme() == "http" || m_uri.GetScheme() == "ws") {
         m_uri.SetPort(80);
@@ -193,10 +328,21 @@ namespace Details {
 
   template<typename ChannelType>
   template<typename ChannelForward>
-  WebSocket<ChannelType>::WebSocket(ChannelForward&& channel, ServerTag)
+  WebSocket<ChannelType>::WebSocket(ChannelForward&& channel,
+      const boost::optional<PerMessageDeflate::Parameters>& compression,
+      std::size_t maxMessageSize, ServerTag)
       : m_isServerMode{true},
+        m_isCompressionEnabled{compression.is_initialized()},
+        m_maxMessageSize{maxMessageSize},
         m_channel{std::forward<ChannelForward>(channel)},
-        m_openState{true} {}
+        m_isReadingCompressed{false},
+        m_messageSize{0},
+        m_isWritingMessage{false},
+        m_openState{true} {
+    if(compression.is_initialized()) {
+      m_compression = std::make_unique<PerMessageDeflate>(*compression, true);
+    }
+  }
 
   template <typename ChannelType>
   WebSocket<ChannelType>::~WebSocket() {
@@ -208,103 +354,66 @@ namespace Details {
     return m_uri;
   }
 
+  template<typename ChannelType>
+  bool WebSocket<ChannelType>::IsCompressed() const {
+    return m_compression != nullptr;
+  }
+
   template<typename ChannelType>
   IO::SharedBuffer WebSocket<ChannelType>::Read() {
-    IO::SharedBuffer payload;
+    auto message = IO::SharedBuffer();
+    Read(Store(message));
+    return message;
+  }
+
+  template<typename ChannelType>
+  template<typename Buffer>
+  void WebSocket<ChannelType>::Read(Out<Buffer> message) {
+    while(!ReadFragment(Store(message))) {}
+  }
+
+  template<typename ChannelType>
+  template<typename Buffer>
+  bool WebSocket<ChannelType>::ReadFragment(Out<Buffer> fragment) {
     while(true) {
-      int isFinalFragment;
-      std::uint8_t opCode;
-      int hasMask;
-      std::uint32_t maskingKey;
-      std::uint64_t payloadLength;
-      unsigned char opCodeBuffer[2];
-      m_channel->GetReader().Read(reinterpret_cast<char*>(opCodeBuffer),
-        sizeof(opCodeBuffer));
-      isFinalFragment = opCodeBuffer[0] & (1 << 7);
-      opCode = opCodeBuffer[0] & 0x0F;
-      hasMask = opCodeBuffer[1] & (1 << 7);
-      payloadLength = opCodeBuffer[1] & ~(1 << 7);
-      if(payloadLength == 126) {
-        std::uint16_t revisedPayloadLength;
-        m_channel->GetReader().Read(
-          reinterpret_cast<char*>(&revisedPayloadLength),
-          sizeof(revisedPayloadLength));
-        payloadLength = FromBigEndian(revisedPayloadLength);
-      } else if(payloadLength == 127) {
-        std::uint64_t revisedPayloadLength;
-        m_channel->GetReader().Read(
-          reinterpret_cast<char*>(&revisedPayloadLength),
-          sizeof(revisedPayloadLength));
-        payloadLength = FromBigEndian(revisedPayloadLength);
+      auto header = ReadFrameHeader();
+      if(IsControlFrame(header.m_opCode)) {
+        HandleControlFrame(header);
+        continue;
       }
-      if(hasMask) {
-        m_channel->GetReader().Read(reinterpret_cast<char*>(&maskingKey),
-          sizeof(maskingKey));
-      }
-      std::size_t cursor = payload.GetSize();
-      m_channel->GetReader().Read(Store(payload),
-        static_cast<std::size_t>(payloadLength));
-      if(hasMask) {
-        for(auto i = cursor; i < payloadLength; ++i) {
-          payload.GetMutableData()[i] = payload.GetMutableData()[i] ^
-            (reinterpret_cast<unsigned char*>(&maskingKey)[
-            (i - cursor) % sizeof(maskingKey)]);
+      if(header.m_opCode != CONTINUATION) {
+        if(header.m_isCompressed && m_compression == nullptr) {
+          BOOST_THROW_EXCEPTION(IO::IOException("Unexpected compressed frame."));
         }
+        m_isReadingCompressed = header.m_isCompressed;
+        m_messageSize = 0;
+      }
+      if(header.m_payloadLength > m_maxMessageSize - m_messageSize) {
+        CloseMessageTooLarge();
       }
-      if(isFinalFragment) {
-        break;
+      if(m_isReadingCompressed) {
+        m_compressedReadBuffer.Reset();
+        ReadPayload(header, Store(m_compressedReadBuffer));
+        auto initialSize = fragment->GetSize();
+        try {
+          m_compression->Decompress(m_compressedReadBuffer.GetData(),
+            m_compressedReadBuffer.GetSize(), header.m_isFinal,
+            m_maxMessageSize - m_messageSize, Store(fragment));
+        } catch(const MessageTooLargeException&) {
+          CloseMessageTooLarge();
+        }
+        m_messageSize += fragment->GetSize() - initialSize;
+      } else {
+        ReadPayload(header, Store(fragment));
+        m_messageSize += static_cast<std::size_t>(header.m_payloadLength);
       }
+      return header.m_isFinal;
     }
-    return payload;
   }
 
   template<typename ChannelType>
   void WebSocket<ChannelType>::Write(const void* data, std::size_t size) {
-    const std::size_t MAX_PAYLOAD_LENGTH = 125;
-    const std::size_t MAX_TWO_BYTE_PAYLOAD_LENGTH = (1 << 16);
-    typename Channel::Writer::Buffer frame;
-    std::uint8_t code = (1 << 7) | 1;
-    frame.Append(&code, sizeof(code));
-    auto payloadLength =
-      [&] {
-        if(size <= MAX_PAYLOAD_LENGTH) {
-          return static_cast<std::uint8_t>(size);
-        } else if(size <= MAX_TWO_BYTE_PAYLOAD_LENGTH) {
-          return std::uint8_t{126};
-        } else {
-          return std::uint8_t{127};
-        }
-      }();
-    if(!m_isServerMode) {
-      payloadLength |= (1 << 7);
-    }
-    frame.Append(&payloadLength, sizeof(payloadLength));
-    if(size > MAX_PAYLOAD_LENGTH) {
-      if(size <= MAX_TWO_BYTE_PAYLOAD_LENGTH) {
-        auto extendedPayloadLength = ToBigEndian(
-          static_cast<std::uint16_t>(size));
-        frame.Append(&extendedPayloadLength, sizeof(extendedPayloadLength));
-      } else {
-        auto extendedPayloadLength = ToBigEndian(
-          static_cast<std::uint64_t>(size));
-        frame.Append(&extendedPayloadLength, sizeof(extendedPayloadLength));
-      }
-    }
-    if(m_isServerMode) {
-      frame.Append(data, size);
-    } else {
-      std::uint32_t maskingKey = m_randomEngine();
-      frame.Append(&maskingKey, sizeof(maskingKey));
-      auto frameSize = frame.GetSize();
-      frame.Append(data, size);
-      for(std::size_t i = 0; i < size; ++i) {
-        auto index = i + frameSize;
-        frame.GetMutableData()[index] = frame.GetMutableData()[index] ^
-          (reinterpret_cast<unsigned char*>(&maskingKey)[
-          i % sizeof(maskingKey)]);
-      }
-    }
-    m_channel->GetWriter().Write(frame);
+    WriteFragment(data, size, true);
   }
 
   template<typename ChannelType>
@@ -313,6 +422,23 @@ namespace Details {
     Write(buffer.GetData(), buffer.GetSize());
   }
 
+  template<typename ChannelType>
+  void WebSocket<ChannelType>::WriteFragment(const void* data,
+      std::size_t size, bool isFinal) {
+    auto lock = boost::lock_guard(m_writeMutex);
+    auto opCode = m_isWritingMessage ? CONTINUATION : TEXT;
+    if(m_compression != nullptr) {
+      m_compressedWriteBuffer.Reset();
+      m_compression->Compress(data, size, isFinal,
+        Store(m_compressedWriteBuffer));
+      WriteFrame(opCode, isFinal, !m_isWritingMessage,
+        m_compressedWriteBuffer.GetData(), m_compressedWriteBuffer.GetSize());
+    } else {
+      WriteFrame(opCode, isFinal, false, data, size);
+    }
+    m_isWritingMessage = !isFinal;
+  }
+
   template<typename ChannelType>
   void WebSocket<ChannelType>::Open() {
     static auto MAGIC_TOKEN = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
@@ -340,14 +466,18 @@ namespace Details {
         }
         request.Add(HttpHeader{"Sec-WebSocket-Protocol", protocols});
       }
-      if(!m_extensions.empty()) {
+      auto offers = m_extensions;
+      if(m_isCompressionEnabled) {
+        offers.push_back("permessage-deflate; client_max_window_bits");
+      }
+      if(!offers.empty()) {
         std::string extensions;
         auto isFirst = true;
-        for(auto& extension : m_extensions) {
+        for(auto& extension : offers) {
           if(isFirst) {
             isFirst = false;
           } else {
-            extensions += "; ";
+            extensions += ", ";
           }
           extensions += extension;
         }
@@ -385,6 +515,19 @@ namespace Details {
           if(acceptToken != *acceptHeader) {
             BOOST_THROW_EXCEPTION(IO::ConnectException{"Invalid accept key."});
           }
+          auto extensionsHeader = response->GetHeader(
+            "Sec-WebSocket-Extensions");
+          if(extensionsHeader.is_initialized() &&
+              extensionsHeader->find("permessage-deflate") !=
+              std::string::npos) {
+            auto compression = PerMessageDeflate::Parse(*extensionsHeader);
+            if(!m_isCompressionEnabled || !compression.is_initialized()) {
+              BOOST_THROW_EXCEPTION(IO::ConnectException{
+                "Invalid extension."});
+            }
+            m_compression = std::make_unique<PerMessageDeflate>(*compression,
+              false);
+          }
           break;
         }
       }
@@ -404,11 +547,148 @@ namespace Details {
     Shutdown();
   }
 
+  template<typename ChannelType>
+  bool WebSocket<ChannelType>::IsControlFrame(std::uint8_t opCode) {
+    return opCode >= CLOSE;
+  }
+
   template<typename ChannelType>
   void WebSocket<ChannelType>::Shutdown() {
     m_channel->GetConnection().Close();
     m_openState.SetClosed();
   }
+
+  template<typename ChannelType>
+  void WebSocket<ChannelType>::CloseMessageTooLarge() {
+    try {
+      auto lock = boost::lock_guard(m_writeMutex);
+      auto status = ToBigEndian(MESSAGE_TOO_BIG);
+      WriteFrame(CLOSE, true, false, &status, sizeof(status));
+    } catch(const std::exception&) {}
+    m_channel->GetConnection().Close();
+    BOOST_THROW_EXCEPTION(MessageTooLargeException());
+  }
+
+  template<typename ChannelType>
+  void WebSocket<ChannelType>::ReadExact(char* destination, std::size_t size) {
+    if(m_frameBuffer.GetSize() != 0) {
+      auto bufferedSize = std::min(size, m_frameBuffer.GetSize());
+      std::memcpy(destination, m_frameBuffer.GetData(), bufferedSize);
+      m_frameBuffer.ShrinkFront(bufferedSize);
+      destination += bufferedSize;
+      size -= bufferedSize;
+    }
+    if(size != 0) {
+      IO::ReadExactSize(m_channel->GetReader(), destination, size);
+    }
+  }
+
+  template<typename ChannelType>
+  typename WebSocket<ChannelType>::FrameHeader
+      WebSocket<ChannelType>::ReadFrameHeader() {
+    unsigned char opCodeBuffer[2];
+    ReadExact(reinterpret_cast<char*>(opCodeBuffer), sizeof(opCodeBuffer));
+    auto header = FrameHeader();
+    header.m_isFinal = (opCodeBuffer[0] & 0x80) != 0;
+    header.m_isCompressed = (opCodeBuffer[0] & 0x40) != 0;
+    header.m_opCode = opCodeBuffer[0] & 0x0F;
+    header.m_hasMask = (opCodeBuffer[1] & 0x80) != 0;
+    header.m_payloadLength = opCodeBuffer[1] & 0x7F;
+    if(header.m_payloadLength == 126) {
+      auto payloadLength = std::uint16_t();
+      ReadExact(reinterpret_cast<char*>(&payloadLength),
+        sizeof(payloadLength));
+      header.m_payloadLength = FromBigEndian(payloadLength);
+    } else if(header.m_payloadLength == 127) {
+      auto payloadLength = std::uint64_t();
+      ReadExact(reinterpret_cast<char*>(&payloadLength),
+        sizeof(payloadLength));
+      header.m_payloadLength = FromBigEndian(payloadLength);
+    }
+    if(header.m_hasMask) {
+      ReadExact(reinterpret_cast<char*>(&header.m_maskingKey),
+        sizeof(header.m_maskingKey));
+    }
+    return header;
+  }
+
+  template<typename ChannelType>
+  template<typename Buffer>
+  void WebSocket<ChannelType>::ReadPayload(const FrameHeader& header,
+      Out<Buffer> payload) {
+    auto size = static_cast<std::size_t>(header.m_payloadLength);
+    auto offset = payload->GetSize();
+    payload->Grow(size);
+    auto data = payload->GetMutableData() + offset;
+    ReadExact(data, size);
+    if(header.m_hasMask) {
+      Details::ApplyMask(data, size, header.m_maskingKey);
+    }
+  }
+
+  template<typename ChannelType>
+  void WebSocket<ChannelType>::HandleControlFrame(const FrameHeader& header) {
+    if(!header.m_isFinal ||
+        header.m_payloadLength > MAX_CONTROL_PAYLOAD_LENGTH) {
+      BOOST_THROW_EXCEPTION(IO::IOException("Invalid control frame."));
+    }
+    char payload[MAX_CONTROL_PAYLOAD_LENGTH];
+    auto size = static_cast<std::size_t>(header.m_payloadLength);
+    ReadExact(payload, size);
+    if(header.m_hasMask) {
+      Details::ApplyMask(payload, size, header.m_maskingKey);
+    }
+    if(header.m_opCode == PING) {
+      auto lock = boost::lock_guard(m_writeMutex);
+      WriteFrame(PONG, true, false, payload, size);
+    } else if(header.m_opCode == CLOSE) {
+      try {
+        auto lock = boost::lock_guard(m_writeMutex);
+        WriteFrame(CLOSE, true, false, payload, std::min<std::size_t>(size, 2));
+      } catch(const std::exception&) {}
+      m_channel->GetConnection().Close();
+      BOOST_THROW_EXCEPTION(IO::EndOfFileException());
+    }
+  }
+
+  template<typename ChannelType>
+  void WebSocket<ChannelType>::WriteFrame(std::uint8_t opCode, bool isFinal,
+      bool isCompressed, const void* data, std::size_t size) {
+    const auto MAX_ONE_BYTE_PAYLOAD_LENGTH = std::size_t(125);
+    const auto MAX_TWO_BYTE_PAYLOAD_LENGTH = std::size_t(0xFFFF);
+    char header[14];
+    auto headerSize = std::size_t(2);
+    header[0] = static_cast<char>((isFinal ? 0x80 : 0) |
+      (isCompressed ? 0x40 : 0) | opCode);
+    if(size <= MAX_ONE_BYTE_PAYLOAD_LENGTH) {
+      header[1] = static_cast<char>(size);
+    } else if(size <= MAX_TWO_BYTE_PAYLOAD_LENGTH) {
+      header[1] = 126;
+      auto payloadLength = ToBigEndian(static_cast<std::uint16_t>(size));
+      std::memcpy(header + headerSize, &payloadLength, sizeof(payloadLength));
+      headerSize += sizeof(payloadLength);
+    } else {
+      header[1] = 127;
+      auto payloadLength = ToBigEndian(static_cast<std::uint64_t>(size));
+      std::memcpy(header + headerSize, &payloadLength, sizeof(payloadLength));
+      headerSize += sizeof(payloadLength);
+    }
+    auto maskingKey = std::uint32_t();
+    if(!m_isServerMode) {
+      header[1] |= 0x80;
+      maskingKey = m_randomEngine();
+      std::memcpy(header + headerSize, &maskingKey, sizeof(maskingKey));
+      headerSize += sizeof(maskingKey);
+    }
+    m_writeBuffer.Reset();
+    m_writeBuffer.Append(header, headerSize);
+    m_writeBuffer.Append(data, size);
+    if(!m_isServerMode) {
+      Details::ApplyMask(m_writeBuffer.GetMutableData() + headerSize, size,
+        maskingKey);
+    }
+    m_channel->GetWriter().Write(m_writeBuffer);
+  }
 }
 }
 
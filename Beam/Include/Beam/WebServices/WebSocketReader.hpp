@@ -91,7 +91,9 @@ namespace WebServices {
 
   template<typename WebSocketType>
   void WebSocketReader<WebSocketType>::ReadFromWebSocket() {
-    m_reader.emplace(m_socket->Read());
+    auto fragment = IO::SharedBuffer();
+    m_socket->ReadFragment(Store(fragment));
+    m_reader.emplace(std::move(fragment));
   }
 }
 
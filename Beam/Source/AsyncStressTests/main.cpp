@@ -0,0 +1,78 @@
+#include <chrono>
+#include <iostream>
+#include <boost/format.hpp>
+#include "Beam/Routines/Async.hpp"
+#include "Beam/Routines/RoutineHandler.hpp"
+#include "Beam/Routines/RoutineHandlerGroup.hpp"
+
+using namespace Beam;
+using namespace Beam::Routines;
+
+namespace {
+  const auto ITERATIONS = 10000000;
+  const auto SUSPENDED_ITERATIONS = 1000000;
+
+  template<typename F>
+  void Measure(const std::string& name, int iterations, F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto duration = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+    std::cout << boost::format("%1%: %2% completions/s\n") % name %
+      static_cast<std::uint64_t>(iterations / duration);
+  }
+}
+
+int main() {
+  Measure("inline", ITERATIONS,
+    [] {
+      auto async = Async<int>();
+      auto sum = 0;
+      for(auto i = 0; i < ITERATIONS; ++i) {
+        auto eval = async.GetEval();
+        eval.SetResult(i);
+        sum += async.Get();
+      }
+      std::cout << sum << '\n';
+    });
+  Measure("suspended", SUSPENDED_ITERATIONS,
+    [] {
+      auto async = Async<int>();
+      auto eval = Eval<int>();
+      auto ready = Async<void>();
+      auto readyEval = ready.GetEval();
+      auto producer = RoutineHandler(Spawn(
+        [&] {
+          for(auto i = 0; i < SUSPENDED_ITERATIONS; ++i) {
+            ready.Get();
+            readyEval = ready.GetEval();
+            eval.SetResult(i);
+          }
+        }));
+      for(auto i = 0; i < SUSPENDED_ITERATIONS; ++i) {
+        eval = async.GetEval();
+        readyEval.SetResult();
+        async.Get();
+      }
+    });
+  Measure("wait_all", SUSPENDED_ITERATIONS,
+    [] {
+      auto a = Async<int>();
+      auto b = Async<int>();
+      auto c = Async<int>();
+      for(auto i = 0; i < SUSPENDED_ITERATIONS / 3; ++i) {
+        auto evals = RoutineHandlerGroup();
+        evals.Spawn(
+          [&, aEval = a.GetEval()] () mutable {
+            aEval.SetResult(i);
+          });
+        evals.Spawn(
+          [&, bEval = b.GetEval()] () mutable {
+            bEval.SetResult(i);
+          });
+        auto cEval = c.GetEval();
+        cEval.SetResult(i);
+        WaitAll(a, b, c);
+      }
+    });
+}
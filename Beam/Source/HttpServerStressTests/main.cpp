@@ -0,0 +1,104 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <boost/format.hpp>
+#include <boost/thread/thread.hpp>
+#include "Beam/IO/LocalClientChannel.hpp"
+#include "Beam/IO/LocalServerConnection.hpp"
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Routines/RoutineHandlerGroup.hpp"
+#include "Beam/WebServices/HttpResponse.hpp"
+#include "Beam/WebServices/HttpResponseParser.hpp"
+#include "Beam/WebServices/HttpServer.hpp"
+
+using namespace Beam;
+using namespace Beam::IO;
+using namespace Beam::Routines;
+using namespace Beam::WebServices;
+
+namespace {
+  using TestServerConnection = LocalServerConnection<SharedBuffer>;
+  using TestClientChannel = LocalClientChannel<SharedBuffer>;
+  const auto CLIENTS = 64;
+  const auto ROUNDS = 2000;
+  const auto PIPELINE = 16;
+
+  auto MakeSlots() {
+    auto slots = std::vector<HttpRequestSlot>();
+    auto respond = [] (const HttpRequest& request) {
+      auto response = HttpResponse();
+      response.SetHeader({"Content-Type", "text/plain"});
+      response.SetBody(BufferFromString<SharedBuffer>("ok"));
+      return response;
+    };
+    for(auto i = 0; i < 32; ++i) {
+      slots.emplace_back(HttpRequestSlot::Route{HttpMethod::GET,
+        "/api/v1/resource" + std::to_string(i) + "/*"}, respond);
+    }
+    slots.emplace_back(HttpRequestSlot::Route{HttpMethod::GET, "/static/**"},
+      respond);
+    return slots;
+  }
+
+  auto MakeRequests() {
+    auto requests = SharedBuffer();
+    for(auto i = 0; i < PIPELINE; ++i) {
+      auto path = [&] () -> std::string {
+        if(i % 2 == 0) {
+          return "/api/v1/resource" + std::to_string(i) + "/item";
+        }
+        return "/static/js/main.js";
+      }();
+      requests.Append(BufferFromString<SharedBuffer>(
+        "GET " + path + " HTTP/1.1\r\n"
+        "Host: localhost\r\n"
+        "User-Agent: HttpServerStressTests\r\n"
+        "Accept: */*\r\n"
+        "Cookie: session=abc123; theme=light\r\n"
+        "\r\n"));
+    }
+    return requests;
+  }
+}
+
+int main() {
+  auto serverConnection = TestServerConnection();
+  auto server = HttpServer<TestServerConnection*>(&serverConnection, MakeSlots());
+  server.Open();
+  auto requests = MakeRequests();
+  auto responseCount = std::atomic_int(0);
+  auto start = std::chrono::steady_clock::now();
+  {
+    auto clients = RoutineHandlerGroup();
+    for(auto i = 0; i < CLIENTS; ++i) {
+      clients.Spawn(
+        [&] {
+          auto channel = TestClientChannel("client", Ref(serverConnection));
+          channel.GetConnection().Open();
+          auto parser = HttpResponseParser();
+          auto buffer = SharedBuffer();
+          for(auto j = 0; j < ROUNDS; ++j) {
+            channel.GetWriter().Write(requests);
+            auto received = 0;
+            while(received != PIPELINE) {
+              buffer.Reset();
+              channel.GetReader().Read(Store(buffer));
+              parser.Feed(buffer.GetData(), buffer.GetSize());
+              while(parser.GetNextResponse().is_initialized()) {
+                ++received;
+              }
+            }
+          }
+          responseCount += ROUNDS * PIPELINE;
+        });
+    }
+  }
+  auto duration = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start).count();
+  auto threads = boost::thread::hardware_concurrency();
+  std::cout << boost::format("%1% requests in %2%s: %3% requests/s, "
+    "%4% requests/s/core\n") % responseCount.load() % duration %
+    static_cast<std::uint64_t>(responseCount / duration) %
+    static_cast<std::uint64_t>(responseCount / duration / threads);
+  server.Close();
+}
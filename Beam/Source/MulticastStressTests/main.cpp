@@ -0,0 +1,146 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/multicast.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include "Beam/IO/EndOfFileException.hpp"
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Network/DatagramBatch.hpp"
+#include "Beam/Network/DatagramSequencer.hpp"
+#include "Beam/Network/MulticastSocket.hpp"
+#include "Beam/Network/SocketThreadPool.hpp"
+#include "Beam/Routines/Async.hpp"
+#include "Beam/Routines/RoutineHandler.hpp"
+
+using namespace Beam;
+using namespace Beam::IO;
+using namespace Beam::Network;
+using namespace Beam::Routines;
+
+namespace {
+  const auto GROUP = IpAddress("239.255.0.1", 42103);
+  const auto INTERFACE = IpAddress("127.0.0.1", 0);
+  const auto PACKET_COUNT = std::uint64_t(1000000);
+  const auto PACKET_SIZE = std::size_t(64);
+
+  struct Result {
+    std::uint64_t m_received = 0;
+    std::uint64_t m_lost = 0;
+    std::uint64_t m_reordered = 0;
+    double m_seconds = 0;
+  };
+
+  void Send() {
+    auto service = boost::asio::io_service();
+    auto socket = boost::asio::ip::udp::socket(service,
+      boost::asio::ip::udp::v4());
+    socket.set_option(boost::asio::ip::multicast::outbound_interface(
+      boost::asio::ip::address_v4::from_string(INTERFACE.GetHost())));
+    socket.set_option(boost::asio::ip::multicast::enable_loopback(true));
+    auto destination = boost::asio::ip::udp::endpoint(
+      boost::asio::ip::address::from_string(GROUP.GetHost()),
+      GROUP.GetPort());
+    char packet[PACKET_SIZE] = {};
+    for(auto sequence = std::uint64_t(0); sequence != PACKET_COUNT;
+        ++sequence) {
+      std::memcpy(packet, &sequence, sizeof(sequence));
+      socket.send_to(boost::asio::buffer(packet), destination);
+    }
+  }
+
+  std::unique_ptr<MulticastSocket> OpenSocket(
+      SocketThreadPool& socketThreadPool) {
+    auto socket = std::make_unique<MulticastSocket>(GROUP, INTERFACE,
+      Ref(socketThreadPool));
+    auto settings = socket->GetReceiverSettings();
+    settings.m_timeout = boost::posix_time::milliseconds(500);
+    settings.m_receiveBufferSize = 8 * 1024 * 1024;
+    socket->SetReceiverSettings(settings);
+    socket->Open();
+    return socket;
+  }
+
+  template<typename F>
+  Result Measure(F&& receive) {
+    auto socketThreadPool = SocketThreadPool(1);
+    auto socket = OpenSocket(socketThreadPool);
+    auto sequencer = DatagramSequencer<std::uint64_t>(1024,
+      [] (std::uint64_t sequence, std::uint64_t&) {},
+      [] (std::uint64_t first, std::uint64_t count) {});
+    auto start = std::chrono::steady_clock::time_point();
+    auto end = start;
+    auto result = Async<void>();
+    auto routine = Spawn(
+      [&] {
+        try {
+          while(true) {
+            receive(socket->GetReceiver(),
+              [&] (const char* data, std::size_t size) {
+                if(sequencer.GetStatistics().m_received == 0) {
+                  start = std::chrono::steady_clock::now();
+                }
+                end = std::chrono::steady_clock::now();
+                auto sequence = std::uint64_t();
+                std::memcpy(&sequence, data, sizeof(sequence));
+                sequencer.Push(sequence, sequence);
+              });
+          }
+        } catch(const EndOfFileException&) {}
+        result.GetEval().SetResult();
+      });
+    auto sender = std::thread(Send);
+    sender.join();
+    result.Get();
+    sequencer.Flush();
+    auto& statistics = sequencer.GetStatistics();
+    auto measurement = Result();
+    measurement.m_received = statistics.m_received;
+    measurement.m_reordered = statistics.m_reordered;
+    measurement.m_lost = statistics.m_lost + (PACKET_COUNT -
+      std::min(PACKET_COUNT, sequencer.GetNextSequence()));
+    measurement.m_seconds =
+      std::chrono::duration<double>(end - start).count();
+    return measurement;
+  }
+
+  void Report(const std::string& name, const Result& result) {
+    auto rate = [&] {
+      if(result.m_seconds == 0) {
+        return 0.0;
+      }
+      return result.m_received / result.m_seconds;
+    }();
+    std::cout << name << ": " << static_cast<std::uint64_t>(rate) <<
+      " packets/s, " << result.m_received << " received, " <<
+      result.m_lost << " dropped, " << result.m_reordered << " reordered" <<
+      std::endl;
+  }
+}
+
+int main() {
+  try {
+    Report("Single", Measure(
+      [packet = DatagramPacket<SharedBuffer>()] (UdpSocketReceiver& receiver,
+          auto&& f) mutable {
+        packet.GetData().Reset();
+        receiver.Receive(Store(packet));
+        f(packet.GetData().GetData(), packet.GetData().GetSize());
+      }));
+    for(auto capacity : {std::size_t(16), std::size_t(64)}) {
+      Report("Batch " + std::to_string(capacity), Measure(
+        [batch = DatagramBatch(capacity, PACKET_SIZE)] (
+            UdpSocketReceiver& receiver, auto&& f) mutable {
+          receiver.Receive(Store(batch));
+          for(auto i = std::size_t(0); i != batch.GetSize(); ++i) {
+            f(batch.GetData(i), batch.GetDataSize(i));
+          }
+        }));
+    }
+  } catch(const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return -1;
+  }
+  return 0;
+}
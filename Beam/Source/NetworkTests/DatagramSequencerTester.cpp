@@ -0,0 +1,89 @@
+#include <utility>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Beam/Network/DatagramSequencer.hpp"
+
+using namespace Beam;
+using namespace Beam::Network;
+
+namespace {
+  struct Fixture {
+    std::vector<std::uint64_t> m_delivered;
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> m_gaps;
+
+    DatagramSequencer<int> MakeSequencer(std::size_t reorderWindow) {
+      return DatagramSequencer<int>(reorderWindow,
+        [=] (std::uint64_t sequence, int& datagram) {
+          REQUIRE(static_cast<std::uint64_t>(datagram) == sequence);
+          m_delivered.push_back(sequence);
+        },
+        [=] (std::uint64_t first, std::uint64_t count) {
+          m_gaps.emplace_back(first, count);
+        });
+    }
+  };
+
+  using Sequences = std::vector<std::uint64_t>;
+  using Gaps = std::vector<std::pair<std::uint64_t, std::uint64_t>>;
+}
+
+TEST_SUITE("DatagramSequencer") {
+  TEST_CASE_FIXTURE(Fixture, "in_order") {
+    auto sequencer = MakeSequencer(4);
+    for(auto i = 10; i < 15; ++i) {
+      sequencer.Push(i, i);
+    }
+    REQUIRE((m_delivered == Sequences{10, 11, 12, 13, 14}));
+    REQUIRE(m_gaps.empty());
+    REQUIRE(sequencer.GetNextSequence() == 15);
+    REQUIRE(sequencer.GetStatistics().m_delivered == 5);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "reorder") {
+    auto sequencer = MakeSequencer(4);
+    sequencer.Push(0, 0);
+    sequencer.Push(2, 2);
+    sequencer.Push(3, 3);
+    REQUIRE((m_delivered == Sequences{0}));
+    REQUIRE(sequencer.GetPendingCount() == 2);
+    sequencer.Push(1, 1);
+    REQUIRE((m_delivered == Sequences{0, 1, 2, 3}));
+    REQUIRE(sequencer.GetPendingCount() == 0);
+    REQUIRE(m_gaps.empty());
+    REQUIRE(sequencer.GetStatistics().m_reordered == 2);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "duplicates") {
+    auto sequencer = MakeSequencer(4);
+    sequencer.Push(0, 0);
+    sequencer.Push(0, 0);
+    sequencer.Push(2, 2);
+    sequencer.Push(2, 2);
+    sequencer.Push(1, 1);
+    REQUIRE((m_delivered == Sequences{0, 1, 2}));
+    REQUIRE(sequencer.GetStatistics().m_discarded == 2);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "window_overflow") {
+    auto sequencer = MakeSequencer(3);
+    sequencer.Push(0, 0);
+    sequencer.Push(2, 2);
+    sequencer.Push(5, 5);
+    REQUIRE((m_delivered == Sequences{0, 2}));
+    REQUIRE((m_gaps == Gaps{{1, 1}}));
+    REQUIRE(sequencer.GetNextSequence() == 3);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "flush") {
+    auto sequencer = MakeSequencer(8);
+    sequencer.Push(0, 0);
+    sequencer.Push(3, 3);
+    sequencer.Push(6, 6);
+    sequencer.Flush();
+    REQUIRE((m_delivered == Sequences{0, 3, 6}));
+    REQUIRE((m_gaps == Gaps{{1, 2}, {4, 2}}));
+    REQUIRE(sequencer.GetStatistics().m_lost == 4);
+    sequencer.Push(5, 5);
+    REQUIRE(sequencer.GetStatistics().m_discarded == 1);
+  }
+}
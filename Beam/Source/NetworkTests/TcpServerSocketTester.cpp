@@ -0,0 +1,73 @@
+#include <memory>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Network/SocketThreadPool.hpp"
+#include "Beam/Network/TcpServerSocket.hpp"
+#include "Beam/Network/TcpSocketChannel.hpp"
+#include "Beam/Routines/RoutineHandler.hpp"
+
+using namespace Beam;
+using namespace Beam::IO;
+using namespace Beam::Network;
+
+namespace {
+  const auto SERVER_ADDRESS = IpAddress("127.0.0.1", 42111);
+}
+
+TEST_SUITE("TcpServerSocket") {
+  TEST_CASE("accept") {
+    auto socketThreadPool = SocketThreadPool(2);
+    auto server = TcpServerSocket(SERVER_ADDRESS, Ref(socketThreadPool));
+    server.Open();
+    auto client = TcpSocketChannel(SERVER_ADDRESS, Ref(socketThreadPool));
+    client.GetConnection().Open();
+    auto channel = server.Accept();
+    client.GetWriter().Write(SharedBuffer("hello", 5));
+    auto buffer = SharedBuffer();
+    REQUIRE(channel->GetReader().Read(Store(buffer)) == 5);
+    REQUIRE(std::string(buffer.GetData(), buffer.GetSize()) == "hello");
+  }
+
+  TEST_CASE("listener_per_shard") {
+    auto socketThreadPool = SocketThreadPool(2,
+      SocketThreadPool::Assignment::ROUND_ROBIN);
+    auto server = TcpServerSocket(SERVER_ADDRESS, Ref(socketThreadPool),
+      true);
+    server.Open();
+    auto clients = std::vector<std::unique_ptr<TcpSocketChannel>>();
+    auto channels = std::vector<std::unique_ptr<TcpSocketChannel>>();
+    for(auto i = 0; i < 8; ++i) {
+      clients.push_back(std::make_unique<TcpSocketChannel>(SERVER_ADDRESS,
+        Ref(socketThreadPool)));
+      clients.back()->GetConnection().Open();
+      channels.push_back(server.Accept());
+    }
+    for(auto i = 0; i < 8; ++i) {
+      clients[i]->GetWriter().Write(SharedBuffer(&i, sizeof(i)));
+      auto buffer = SharedBuffer();
+      REQUIRE(channels[i]->GetReader().Read(Store(buffer)) == sizeof(i));
+      REQUIRE(*reinterpret_cast<const int*>(buffer.GetData()) == i);
+    }
+    server.Close();
+    REQUIRE_THROWS_AS(server.Accept(), EndOfFileException);
+  }
+
+  TEST_CASE("close") {
+    auto socketThreadPool = SocketThreadPool(1);
+    auto server = TcpServerSocket(SERVER_ADDRESS, Ref(socketThreadPool));
+    server.Open();
+    auto isClosed = false;
+    auto routine = Routines::RoutineHandler(Routines::Spawn(
+      [&] {
+        try {
+          server.Accept();
+        } catch(const EndOfFileException&) {
+          isClosed = true;
+        }
+      }));
+    server.Close();
+    routine.Wait();
+    REQUIRE(isClosed);
+  }
+}
@@ -0,0 +1,96 @@
+#include <cstring>
+#include <doctest/doctest.h>
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Network/DatagramBatch.hpp"
+#include "Beam/Network/SocketThreadPool.hpp"
+#include "Beam/Network/UdpSocket.hpp"
+
+using namespace Beam;
+using namespace Beam::IO;
+using namespace Beam::Network;
+
+namespace {
+  const auto SENDER_ADDRESS = IpAddress("127.0.0.1", 42101);
+  const auto RECEIVER_ADDRESS = IpAddress("127.0.0.1", 42102);
+
+  struct Fixture {
+    SocketThreadPool m_socketThreadPool;
+    UdpSocket m_sender;
+    UdpSocket m_receiver;
+
+    Fixture()
+        : m_socketThreadPool(1),
+          m_sender(RECEIVER_ADDRESS, SENDER_ADDRESS, Ref(m_socketThreadPool)),
+          m_receiver(SENDER_ADDRESS, RECEIVER_ADDRESS,
+            Ref(m_socketThreadPool)) {
+      auto settings = m_receiver.GetReceiverSettings();
+      settings.m_isTimestampEnabled = true;
+      settings.m_receiveBufferSize = 1024 * 1024;
+      m_receiver.SetReceiverSettings(settings);
+      m_sender.Open();
+      m_receiver.Open();
+    }
+  };
+}
+
+TEST_SUITE("UdpSocketReceiver") {
+  TEST_CASE_FIXTURE(Fixture, "receive_batch") {
+    const auto COUNT = 100;
+    for(auto i = 0; i < COUNT; ++i) {
+      m_sender.GetSender().Send(&i, sizeof(i), RECEIVER_ADDRESS);
+    }
+    auto batch = DatagramBatch(16, 64);
+    auto received = 0;
+    while(received != COUNT) {
+      auto count = m_receiver.GetReceiver().Receive(Store(batch));
+      REQUIRE(count > 0);
+      REQUIRE(count <= batch.GetCapacity());
+      REQUIRE(batch.GetSize() == count);
+      for(auto i = std::size_t(0); i != count; ++i) {
+        REQUIRE(batch.GetDataSize(i) == sizeof(int));
+        auto value = 0;
+        std::memcpy(&value, batch.GetData(i), sizeof(value));
+        REQUIRE(value == received);
+        REQUIRE(batch.GetAddress(i) == SENDER_ADDRESS);
+#ifdef __linux__
+        REQUIRE(!batch.GetTimestamp(i).is_not_a_date_time());
+#endif
+        ++received;
+      }
+    }
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "receive_packet_timestamp") {
+    auto value = 123;
+    m_sender.GetSender().Send(&value, sizeof(value), RECEIVER_ADDRESS);
+    auto packet = DatagramPacket<SharedBuffer>();
+    auto size = m_receiver.GetReceiver().Receive(Store(packet));
+    REQUIRE(size == sizeof(value));
+    REQUIRE(packet.GetData().GetSize() == sizeof(value));
+    REQUIRE(std::memcmp(packet.GetData().GetData(), &value,
+      sizeof(value)) == 0);
+    REQUIRE(packet.GetAddress() == SENDER_ADDRESS);
+#ifdef __linux__
+    REQUIRE(!packet.GetTimestamp().is_not_a_date_time());
+#endif
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "receive_truncated") {
+    char message[100] = {};
+    m_sender.GetSender().Send(message, sizeof(message), RECEIVER_ADDRESS);
+    m_sender.GetSender().Send(message, 8, RECEIVER_ADDRESS);
+    auto batch = DatagramBatch(1, 16);
+    REQUIRE(m_receiver.GetReceiver().Receive(Store(batch)) == 1);
+    REQUIRE(batch.GetDataSize(0) == 16);
+    REQUIRE(batch.IsTruncated(0));
+    REQUIRE(m_receiver.GetReceiver().Receive(Store(batch)) == 1);
+    REQUIRE(batch.GetDataSize(0) == 8);
+    REQUIRE(!batch.IsTruncated(0));
+    m_sender.GetSender().Send(message, sizeof(message), RECEIVER_ADDRESS);
+    auto packet = DatagramPacket<SharedBuffer>();
+    REQUIRE(m_receiver.GetReceiver().Receive(Store(packet), 16) == 16);
+#ifdef __linux__
+    REQUIRE(packet.IsTruncated());
+#endif
+  }
+}
@@ -0,0 +1,162 @@
+#ifdef __linux__
+#include <numeric>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Network/SocketThreadPool.hpp"
+#include "Beam/Network/TcpServerSocket.hpp"
+#include "Beam/Network/UringTcpServerSocket.hpp"
+#include "Beam/Network/UringTcpSocketChannel.hpp"
+#include "Beam/Routines/RoutineHandler.hpp"
+
+using namespace Beam;
+using namespace Beam::IO;
+using namespace Beam::Network;
+using namespace Beam::Routines;
+
+namespace {
+  const auto SERVER_ADDRESS = IpAddress("127.0.0.1", 42121);
+
+  struct Fixture {
+    SocketThreadPool m_socketThreadPool;
+    UringContext m_context;
+    TcpServerSocket m_server;
+
+    Fixture()
+        : m_socketThreadPool(1),
+          m_context(64, 8, 1024),
+          m_server(SERVER_ADDRESS, Ref(m_socketThreadPool)) {
+      m_server.Open();
+    }
+  };
+
+  void ReadExactly(UringTcpSocketChannel& channel, Out<SharedBuffer> buffer,
+      std::size_t size) {
+    while(buffer->GetSize() < size) {
+      channel.GetReader().Read(Store(*buffer), size - buffer->GetSize());
+    }
+  }
+}
+
+TEST_SUITE("UringTcpSocketChannel") {
+  TEST_CASE_FIXTURE(Fixture, "read_write") {
+    auto client = UringTcpSocketChannel(SERVER_ADDRESS, Ref(m_context));
+    client.GetConnection().Open();
+    auto server = m_server.Accept();
+    client.GetWriter().Write(SharedBuffer("hello", 5));
+    auto received = SharedBuffer();
+    while(received.GetSize() < 5) {
+      server->GetReader().Read(Store(received));
+    }
+    REQUIRE(std::string(received.GetData(), received.GetSize()) == "hello");
+    server->GetWriter().Write(SharedBuffer("world", 5));
+    auto reply = SharedBuffer();
+    ReadExactly(client, Store(reply), 5);
+    REQUIRE(std::string(reply.GetData(), reply.GetSize()) == "world");
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "buffer_exhaustion") {
+    auto client = UringTcpSocketChannel(SERVER_ADDRESS, Ref(m_context));
+    client.GetConnection().Open();
+    auto server = m_server.Accept();
+    auto data = std::vector<char>(256 * 1024);
+    std::iota(data.begin(), data.end(), 0);
+    auto writer = RoutineHandler(Spawn(
+      [&] {
+        server->GetWriter().Write(data.data(), data.size());
+      }));
+    auto received = SharedBuffer();
+    ReadExactly(client, Store(received), data.size());
+    REQUIRE(std::equal(data.begin(), data.end(), received.GetData()));
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "ordered_writes") {
+    auto client = UringTcpSocketChannel(SERVER_ADDRESS, Ref(m_context));
+    client.GetConnection().Open();
+    auto server = m_server.Accept();
+    const auto COUNT = 100;
+    auto writers = std::vector<RoutineHandler>();
+    for(auto i = 0; i < COUNT; ++i) {
+      writers.emplace_back(Spawn(
+        [&, i] {
+          auto message = std::vector<char>(1000, static_cast<char>(i));
+          client.GetWriter().Write(message.data(), message.size());
+        }));
+    }
+    auto received = SharedBuffer();
+    while(received.GetSize() < COUNT * 1000) {
+      server->GetReader().Read(Store(received));
+    }
+    writers.clear();
+    for(auto i = 0; i < COUNT; ++i) {
+      auto message = received.GetData() + 1000 * i;
+      REQUIRE(std::all_of(message, message + 1000,
+        [&] (auto c) {
+          return c == message[0];
+        }));
+    }
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "end_of_file") {
+    auto client = UringTcpSocketChannel(SERVER_ADDRESS, Ref(m_context));
+    client.GetConnection().Open();
+    auto server = m_server.Accept();
+    server->GetConnection().Close();
+    auto buffer = SharedBuffer();
+    REQUIRE_THROWS_AS(client.GetReader().Read(Store(buffer)),
+      EndOfFileException);
+    client.GetConnection().Close();
+    REQUIRE_THROWS_AS(client.GetWriter().Write(SharedBuffer("x", 1)),
+      EndOfFileException);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "connect_failure") {
+    auto client = UringTcpSocketChannel(IpAddress("127.0.0.1", 42122),
+      Ref(m_context));
+    REQUIRE_THROWS_AS(client.GetConnection().Open(), ConnectException);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "server_accept") {
+    auto address = IpAddress("127.0.0.1", 42123);
+    auto server = UringTcpServerSocket(address, Ref(m_context));
+    server.Open();
+    auto client = UringTcpSocketChannel(address, Ref(m_context));
+    client.GetConnection().Open();
+    auto channel = server.Accept();
+    REQUIRE(channel->GetIdentifier().GetAddress().GetHost() == "127.0.0.1");
+    client.GetWriter().Write(SharedBuffer("hello", 5));
+    auto received = SharedBuffer();
+    ReadExactly(*channel, Store(received), 5);
+    REQUIRE(std::string(received.GetData(), received.GetSize()) == "hello");
+    channel->GetWriter().Write(SharedBuffer("world", 5));
+    auto reply = SharedBuffer();
+    ReadExactly(client, Store(reply), 5);
+    REQUIRE(std::string(reply.GetData(), reply.GetSize()) == "world");
+    channel->GetConnection().Close();
+    REQUIRE_THROWS_AS(client.GetReader().Read(Store(reply)),
+      EndOfFileException);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "server_close") {
+    auto address = IpAddress("127.0.0.1", 42124);
+    auto server = UringTcpServerSocket(address, Ref(m_context));
+    server.Open();
+    auto accepts = std::vector<RoutineHandler>();
+    auto endOfFiles = 0;
+    for(auto i = 0; i < 3; ++i) {
+      accepts.emplace_back(Spawn(
+        [&] {
+          try {
+            server.Accept();
+          } catch(const EndOfFileException&) {
+            ++endOfFiles;
+          }
+        }));
+    }
+    server.Close();
+    accepts.clear();
+    REQUIRE(endOfFiles == 3);
+    REQUIRE_THROWS_AS(server.Accept(), EndOfFileException);
+  }
+}
+#endif
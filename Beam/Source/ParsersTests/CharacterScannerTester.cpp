@@ -0,0 +1,75 @@
+#include <doctest/doctest.h>
+#include "Beam/Parsers/CharacterScanner.hpp"
+#include "Beam/Parsers/Operators.hpp"
+#include "Beam/Parsers/ReaderParserStream.hpp"
+#include "Beam/Parsers/SubParserStream.hpp"
+#include "Beam/Parsers/Types.hpp"
+
+using namespace Beam;
+using namespace Beam::Parsers;
+
+TEST_SUITE("CharacterScanner") {
+  TEST_CASE("character_classes") {
+    for(auto c = -128; c < 128; ++c) {
+      auto value = static_cast<char>(c);
+      auto run = std::string(40, value) + '\0';
+      auto expected = [&] (bool isMatch) {
+        return run.data() + (isMatch ? 40 : 0);
+      };
+      auto isAscii = c >= 0;
+      REQUIRE(Details::ScanSpaces(run.data(), run.data() + run.size()) ==
+        expected(isAscii && std::isspace(c)));
+      REQUIRE(Details::ScanDigits(run.data(), run.data() + run.size()) ==
+        expected(isAscii && std::isdigit(c)));
+      REQUIRE(Details::ScanAlphas(run.data(), run.data() + run.size()) ==
+        expected(isAscii && std::isalpha(c)));
+    }
+  }
+
+  TEST_CASE("run_end") {
+    for(auto i = 0; i < 40; ++i) {
+      auto run = std::string(i, '7') + 'x' + std::string(20, '7');
+      REQUIRE(Details::ScanDigits(run.data(), run.data() + run.size()) ==
+        run.data() + i);
+    }
+  }
+
+  TEST_CASE("skip_across_reads") {
+    auto parser = tokenize >> +alpha_p;
+    auto source = ParserStreamFromString(std::string(3000, ' ') + "hello");
+    auto value = std::string();
+    REQUIRE(parser.Read(source, value));
+    REQUIRE(value == "hello");
+  }
+
+  TEST_CASE("collect_across_reads") {
+    auto digits = std::string(2500, '5');
+    auto parser = +digit_p >> ';';
+    auto source = ParserStreamFromString(digits + ";");
+    auto value = std::string();
+    REQUIRE(parser.Read(source, value));
+    REQUIRE(value == digits);
+    REQUIRE(!source.Read());
+  }
+
+  TEST_CASE("backtrack_over_scan") {
+    auto parser = (+alpha_p >> '1') | (+alpha_p >> '2');
+    auto source = ParserStreamFromString(std::string(1500, 'a') + "2");
+    REQUIRE(parser.Read(source));
+    REQUIRE(!source.Read());
+    source = ParserStreamFromString("abc3");
+    REQUIRE(!parser.Read(source));
+    REQUIRE(source.Read());
+    REQUIRE(source.GetChar() == 'a');
+  }
+
+  TEST_CASE("empty_run") {
+    auto source = ParserStreamFromString("x ");
+    REQUIRE(!(+space_p).Read(source));
+    REQUIRE((*space_p).Read(source));
+    REQUIRE(source.Read());
+    REQUIRE(source.GetChar() == 'x');
+    REQUIRE((*space_p).Read(source));
+    REQUIRE(!source.Read());
+  }
+}
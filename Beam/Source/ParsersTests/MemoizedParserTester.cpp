@@ -0,0 +1,90 @@
+#include <doctest/doctest.h>
+#include "Beam/Parsers/MemoizedParser.hpp"
+#include "Beam/Parsers/Operators.hpp"
+#include "Beam/Parsers/PackratParserStream.hpp"
+#include "Beam/Parsers/ReaderParserStream.hpp"
+#include "Beam/Parsers/RuleParser.hpp"
+#include "Beam/Parsers/Types.hpp"
+
+using namespace Beam;
+using namespace Beam::Parsers;
+
+namespace {
+  struct CountingParser : ParserOperators {
+    using Result = int;
+    IntegralParser<int> m_parser;
+    int* m_count;
+
+    CountingParser(int* count)
+      : m_count(count) {}
+
+    template<typename ParserStreamType>
+    bool Read(ParserStreamType& source, int& value) {
+      ++*m_count;
+      return m_parser.Read(source, value);
+    }
+
+    template<typename ParserStreamType>
+    bool Read(ParserStreamType& source) {
+      ++*m_count;
+      return m_parser.Read(source);
+    }
+  };
+}
+
+TEST_SUITE("MemoizedParser") {
+  TEST_CASE("unmemoized_stream") {
+    auto count = 0;
+    auto number = Memoize(CountingParser(&count));
+    auto parser = (number >> 'a') | (number >> 'b');
+    auto source = ParserStreamFromString("123b");
+    REQUIRE(parser.Read(source));
+    REQUIRE(count == 2);
+  }
+
+  TEST_CASE("backtracking") {
+    auto count = 0;
+    auto number = Memoize(CountingParser(&count));
+    auto parser = (number >> 'a') | (number >> 'b') | (number >> 'c');
+    auto stream = ParserStreamFromString("123c");
+    auto source = PackratParserStream<DefaultParserStream>(stream);
+    REQUIRE(parser.Read(source));
+    REQUIRE(count == 1);
+    REQUIRE(!source.Read());
+  }
+
+  TEST_CASE("memoized_value") {
+    auto count = 0;
+    auto number = Memoize(CountingParser(&count));
+    auto parser = (number >> 'a') | (number >> 'b');
+    auto stream = ParserStreamFromString("42b");
+    auto source = PackratParserStream<DefaultParserStream>(stream);
+    auto value = 0;
+    REQUIRE(parser.Read(source, value));
+    REQUIRE(value == 42);
+    REQUIRE(count == 1);
+    REQUIRE(!source.Read());
+  }
+
+  TEST_CASE("memoized_failure") {
+    auto count = 0;
+    auto number = Memoize(CountingParser(&count));
+    auto parser = (number >> 'a') | (number >> 'b') | Discard(alpha_p);
+    auto stream = ParserStreamFromString("x");
+    auto source = PackratParserStream<DefaultParserStream>(stream);
+    REQUIRE(parser.Read(source));
+    REQUIRE(count == 1);
+  }
+
+  TEST_CASE("through_rules") {
+    auto count = 0;
+    auto number = RuleParser<NullType>();
+    number = Discard(Memoize(CountingParser(&count)));
+    auto parser = RuleParser<NullType>();
+    parser = (number >> 'a') | (number >> 'b');
+    auto stream = ParserStreamFromString("7b");
+    auto source = PackratParserStream<DefaultParserStream>(stream);
+    REQUIRE(parser.Read(source));
+    REQUIRE(count == 1);
+  }
+}
@@ -0,0 +1,48 @@
+#include <doctest/doctest.h>
+#include "Beam/Parsers/Operators.hpp"
+#include "Beam/Parsers/ReaderParserStream.hpp"
+#include "Beam/Parsers/RuleParser.hpp"
+#include "Beam/Parsers/SubParserStream.hpp"
+#include "Beam/Parsers/TokenParser.hpp"
+#include "Beam/Parsers/Types.hpp"
+
+using namespace Beam;
+using namespace Beam::Parsers;
+
+TEST_SUITE("RuleParser") {
+  TEST_CASE("recursive_rule") {
+    auto parser = RuleParser<NullType>();
+    parser = ('(' >> parser >> ')') | Discard(+digit_p);
+    auto source = ParserStreamFromString("((((12))))");
+    REQUIRE(parser.Read(source));
+    REQUIRE(!source.Read());
+    source = ParserStreamFromString("((12)");
+    REQUIRE(!parser.Read(source));
+  }
+
+  TEST_CASE("nested_rules") {
+    auto word = RuleParser<std::string>();
+    word = +alpha_p;
+    auto words = RuleParser<std::vector<std::string>>();
+    words = *Token(word);
+    auto source = ParserStreamFromString("  ab cde  f");
+    auto value = std::vector<std::string>();
+    REQUIRE(words.Read(source, value));
+    REQUIRE((value == std::vector<std::string>{"ab", "cde", "f"}));
+  }
+
+  TEST_CASE("wrapped_stream") {
+    auto word = RuleParser<std::string>();
+    word = +alpha_p >> ';';
+    auto source = ParserStreamFromString("hello;");
+    auto value = std::string();
+    {
+      auto context = SubParserStream<DefaultParserStream>(source);
+      REQUIRE(word.Read(context, value));
+      REQUIRE(value == "hello");
+      REQUIRE(!context.Read());
+    }
+    REQUIRE(source.Read());
+    REQUIRE(source.GetChar() == 'h');
+  }
+}
@@ -16,6 +16,13 @@ using namespace pybind11;
 
 namespace {
   object ioException;
+
+  /* Holds a copy of a SharedBuffer for the lifetime of a memoryview, the
+     copy shares the buffer's storage and any later change made through the
+     Buffer detaches from it, so the view never dangles or changes. */
+  struct BufferView {
+    SharedBuffer m_buffer;
+  };
 }
 
 const object& Beam::Python::GetIOException() {
@@ -99,6 +106,13 @@ void Beam::Python::ExportReader(pybind11::module& module) {
 }
 
 void Beam::Python::ExportSharedBuffer(pybind11::module& module) {
+  class_<BufferView>(module, "BufferView", buffer_protocol())
+    .def_buffer(
+      [] (BufferView& self) {
+        return buffer_info(const_cast<char*>(self.m_buffer.GetData()),
+          sizeof(char), format_descriptor<char>::format(), 1,
+          {self.m_buffer.GetSize()}, {sizeof(char)}, true);
+      });
   class_<SharedBuffer>(module, "Buffer")
     .def(init())
     .def(init<std::size_t>())
@@ -129,7 +143,12 @@ void Beam::Python::ExportSharedBuffer(pybind11::module& module) {
         }
       })
     .def("reset", &SharedBuffer::Reset)
-    .def_property_readonly("size", &SharedBuffer::GetSize);
+    .def_property_readonly("size", &SharedBuffer::GetSize)
+    .def("__len__", &SharedBuffer::GetSize)
+    .def("view",
+      [] (const SharedBuffer& self) {
+        return memoryview(cast(BufferView{self}));
+      });
 }
 
 void Beam::Python::ExportWriter(pybind11::module& module) {
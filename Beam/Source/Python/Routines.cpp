@@ -43,6 +43,12 @@ void Beam::Python::ExportRoutineHandler(pybind11::module& module) {
 void Beam::Python::ExportRoutineHandlerGroup(pybind11::module& module) {
   class_<RoutineHandlerGroup>(module, "RoutineHandlerGroup")
     .def(init())
+    .def(init<std::size_t>())
+    .def_property_readonly("size", &RoutineHandlerGroup::GetSize)
+    .def_property_readonly("peak_size", &RoutineHandlerGroup::GetPeakSize)
+    .def_property_readonly("max_concurrency",
+      &RoutineHandlerGroup::GetMaxConcurrency)
+    .def_property_readonly("is_cancelled", &RoutineHandlerGroup::IsCancelled)
     .def("__del__",
       [] (RoutineHandlerGroup& self) {
         self.Wait();
@@ -55,11 +61,14 @@ void Beam::Python::ExportRoutineHandlerGroup(pybind11::module& module) {
       })
     .def("spawn",
       [] (RoutineHandlerGroup& self, const std::function<void ()>& callable) {
-        return self.Spawn(
+        auto routine =
           [callable = SharedObject(cast(callable))] {
             callable->cast<std::function<void ()>>()();
-          });
+          };
+        auto release = GilRelease();
+        return self.Spawn(std::move(routine));
       })
+    .def("cancel", &RoutineHandlerGroup::Cancel)
     .def("wait", &RoutineHandlerGroup::Wait, call_guard<GilRelease>());
 }
 
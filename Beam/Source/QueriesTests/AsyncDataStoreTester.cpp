@@ -7,6 +7,7 @@
 #include "Beam/Queries/LocalDataStore.hpp"
 #include "Beam/QueriesTests/TestDataStore.hpp"
 #include "Beam/QueriesTests/TestEntry.hpp"
+#include "Beam/Queues/Queue.hpp"
 #include "Beam/Routines/RoutineHandler.hpp"
 #include "Beam/Routines/Scheduler.hpp"
 #include "Beam/TimeService/IncrementalTimeClient.hpp"
@@ -1,8 +1,10 @@
 #include <vector>
 #include <doctest/doctest.h>
+#include "Beam/Queries/AggregateQuery.hpp"
 #include "Beam/Queries/BasicQuery.hpp"
 #include "Beam/Queries/EvaluatorTranslator.hpp"
 #include "Beam/Queries/LocalDataStore.hpp"
+#include "Beam/Queries/MemberAccessEvaluatorNode.hpp"
 #include "Beam/QueriesTests/TestEntry.hpp"
 #include "Beam/TimeService/IncrementalTimeClient.hpp"
 
@@ -10,10 +12,37 @@ using namespace Beam;
 using namespace Beam::Queries;
 using namespace Beam::Queries::Tests;
 using namespace Beam::TimeService;
+using namespace boost::posix_time;
 
 namespace {
   using DataStore = LocalDataStore<BasicQuery<std::string>, TestEntry,
     EvaluatorTranslator<QueryTypes>>;
+
+  struct TestEntryQueryTypes : QueryTypes {
+    using NativeTypes = boost::mpl::list<bool, char, int, double,
+      std::uint64_t, std::string, ptime, time_duration, TestEntry>;
+  };
+
+  class TestEntryTranslator :
+      public EvaluatorTranslator<TestEntryQueryTypes> {
+    public:
+      using EvaluatorTranslator<TestEntryQueryTypes>::Visit;
+
+      void Visit(const MemberAccessExpression& expression) override {
+        expression.GetExpression()->Apply(*this);
+        SetEvaluator(std::make_unique<MemberAccessEvaluatorNode<int,
+          TestEntry>>(UniqueStaticCast<EvaluatorNode<TestEntry>>(
+          GetEvaluator()), &TestEntry::m_value));
+      }
+  };
+
+  using AggregateDataStore = LocalDataStore<BasicQuery<std::string>,
+    TestEntry, TestEntryTranslator>;
+
+  auto MakeValueExpression() {
+    return MemberAccessExpression("value", IntType(),
+      ParameterExpression(0, NativeDataType<TestEntry>()));
+  }
 }
 
 TEST_SUITE("LocalDataStore") {
@@ -80,4 +109,57 @@ TEST_SUITE("LocalDataStore") {
       expectedEntries.pop_back();
     }
   }
+
+  TEST_CASE("load_aggregates") {
+    auto dataStore = AggregateDataStore();
+    auto base = ptime(boost::gregorian::date(2020, 1, 1), minutes(0));
+    auto values = std::vector<std::pair<int, time_duration>>{
+      {10, seconds(1)}, {30, seconds(20)}, {20, seconds(59)},
+      {50, seconds(61)}, {40, seconds(190)}};
+    auto sequence = Beam::Queries::Sequence(1);
+    for(auto& value : values) {
+      StoreValue(dataStore, "hello", value.first, base + value.second,
+        sequence);
+      sequence = Increment(sequence);
+    }
+    auto query = AggregateDataStore::AggregateQuery();
+    query.SetIndex("hello");
+    query.SetRange(Beam::Queries::Range::Total());
+    query.SetValue(MakeValueExpression());
+    auto total = dataStore.LoadAggregates(query);
+    REQUIRE(total.size() == 1);
+    REQUIRE(total[0].m_timestamp == base + seconds(1));
+    REQUIRE(total[0].m_count == 5);
+    REQUIRE(total[0].m_min == 10);
+    REQUIRE(total[0].m_max == 50);
+    REQUIRE(total[0].m_sum == 150);
+    REQUIRE(GetAverage(total[0]) == 30);
+    query.SetWeight(MakeValueExpression());
+    auto weighted = dataStore.LoadAggregates(query);
+    REQUIRE(weighted.size() == 1);
+    REQUIRE(weighted[0].m_weight == 150);
+    REQUIRE(GetWeightedAverage(weighted[0]) == 5500.0 / 150);
+    query.SetWeight(ConstantExpression(1));
+    query.SetBucket(minutes(1));
+    auto buckets = dataStore.LoadAggregates(query);
+    REQUIRE(buckets.size() == 3);
+    REQUIRE(buckets[0].m_timestamp == base);
+    REQUIRE(buckets[0].m_count == 3);
+    REQUIRE(buckets[0].m_min == 10);
+    REQUIRE(buckets[0].m_max == 30);
+    REQUIRE(buckets[1].m_timestamp == base + minutes(1));
+    REQUIRE(buckets[1].m_count == 1);
+    REQUIRE(buckets[1].m_sum == 50);
+    REQUIRE(buckets[2].m_timestamp == base + minutes(3));
+    REQUIRE(buckets[2].m_sum == 40);
+    query.SetRange(Beam::Queries::Sequence(2), Beam::Queries::Sequence(4));
+    auto ranged = dataStore.LoadAggregates(query);
+    REQUIRE(ranged.size() == 2);
+    REQUIRE(ranged[0].m_count == 2);
+    REQUIRE(ranged[0].m_sum == 50);
+    REQUIRE(ranged[1].m_count == 1);
+    query.SetRange(Beam::Queries::Range::Total());
+    query.SetIndex("goodbye");
+    REQUIRE(dataStore.LoadAggregates(query).empty());
+  }
 }
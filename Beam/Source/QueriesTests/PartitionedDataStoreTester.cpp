@@ -0,0 +1,229 @@
+#include <filesystem>
+#include <doctest/doctest.h>
+#include "Beam/Queries/BasicQuery.hpp"
+#include "Beam/Queries/EvaluatorTranslator.hpp"
+#include "Beam/Queries/LocalDataStore.hpp"
+#include "Beam/Queries/PartitionedDataStore.hpp"
+#include "Beam/QueriesTests/TestEntry.hpp"
+
+using namespace Beam;
+using namespace Beam::IO;
+using namespace Beam::Queries;
+using namespace Beam::Queries::Tests;
+using namespace boost::gregorian;
+using namespace boost::posix_time;
+
+namespace {
+  using BaseDataStore = LocalDataStore<BasicQuery<std::string>, TestEntry,
+    EvaluatorTranslator<QueryTypes>>;
+
+  struct CountingDataStore : BaseDataStore {
+    int* m_loads;
+    int* m_instances;
+
+    CountingDataStore(int* loads, int* instances)
+      : m_loads(loads),
+        m_instances(instances) {
+      ++*m_instances;
+    }
+
+    ~CountingDataStore() {
+      --*m_instances;
+    }
+
+    std::vector<SequencedValue> Load(const Query& query) {
+      ++*m_loads;
+      return BaseDataStore::Load(query);
+    }
+  };
+
+  using DataStore = PartitionedDataStore<CountingDataStore>;
+
+  struct Fixture {
+    std::filesystem::path m_root;
+    int m_loads = 0;
+    int m_instances = 0;
+    DataStore m_dataStore;
+
+    Fixture()
+      : m_root(std::filesystem::temp_directory_path() /
+          "PartitionedDataStoreTester"),
+        m_dataStore(MakeBuilder(), 1, m_root) {
+      std::filesystem::remove_all(m_root);
+      m_dataStore.Open();
+    }
+
+    ~Fixture() {
+      std::filesystem::remove_all(m_root);
+    }
+
+    DataStore::PartitionBuilder MakeBuilder() {
+      return [=] (ptime partition) {
+        return std::make_unique<CountingDataStore>(&m_loads, &m_instances);
+      };
+    }
+
+    SequencedIndexedTestEntry Store(int value, ptime timestamp) {
+      return StoreValue(m_dataStore, "hello", value, timestamp,
+        EncodeTimestamp(timestamp, Beam::Queries::Sequence(value)));
+    }
+  };
+
+  const auto DAY_A = ptime(date(2020, 3, 10), hours(9));
+  const auto DAY_B = ptime(date(2020, 3, 11), hours(9));
+  const auto DAY_C = ptime(date(2020, 3, 12), hours(9));
+}
+
+TEST_SUITE("PartitionedDataStore") {
+  TEST_CASE("get_partition") {
+    REQUIRE(GetPartition(DAY_A, 1) == ptime(date(2020, 3, 10)));
+    REQUIRE(GetPartition(DAY_A, 7) == ptime(date(2020, 3, 5)));
+    REQUIRE(GetPartition(ptime(date(2020, 3, 11)), 7) ==
+      ptime(date(2020, 3, 5)));
+    REQUIRE(GetPartition(ptime(date(2020, 3, 12)), 7) ==
+      ptime(date(2020, 3, 12)));
+    REQUIRE(GetPartition(ptime(date(1969, 12, 31)), 7) ==
+      ptime(date(1969, 12, 25)));
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "routing") {
+    auto entryA = Store(1, DAY_A);
+    auto entryB = Store(2, DAY_B);
+    auto entryC = Store(3, DAY_B + minutes(1));
+    auto entryD = Store(4, DAY_C);
+    REQUIRE((m_dataStore.GetPartitions() == std::vector{
+      ptime(DAY_A.date()), ptime(DAY_B.date()), ptime(DAY_C.date())}));
+    TestQuery(m_dataStore, "hello", Beam::Queries::Range::Total(),
+      SnapshotLimit::Unlimited(), {entryA, entryB, entryC, entryD});
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "pruning") {
+    Store(1, DAY_A);
+    auto entryB = Store(2, DAY_B);
+    auto entryC = Store(3, DAY_B + minutes(1));
+    Store(4, DAY_C);
+    TestQuery(m_dataStore, "hello", Beam::Queries::Range(
+      ptime(DAY_B.date()), DAY_B + hours(1)), SnapshotLimit::Unlimited(),
+      {entryB, entryC});
+    REQUIRE(m_loads == 1);
+    m_loads = 0;
+    TestQuery(m_dataStore, "hello", Beam::Queries::Range(
+      entryB.GetSequence(), entryC.GetSequence()), SnapshotLimit::Unlimited(),
+      {entryB, entryC});
+    REQUIRE(m_loads == 1);
+    m_loads = 0;
+    TestQuery(m_dataStore, "hello", Beam::Queries::Range(
+      ptime(date(2019, 1, 1)), ptime(date(2019, 2, 1))),
+      SnapshotLimit::Unlimited(), {});
+    REQUIRE(m_loads == 0);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "snapshot_limit") {
+    auto entryA = Store(1, DAY_A);
+    auto entryB = Store(2, DAY_B);
+    auto entryC = Store(3, DAY_B + minutes(1));
+    auto entryD = Store(4, DAY_C);
+    TestQuery(m_dataStore, "hello", Beam::Queries::Range::Total(),
+      SnapshotLimit(SnapshotLimit::Type::HEAD, 2), {entryA, entryB});
+    REQUIRE(m_loads == 2);
+    m_loads = 0;
+    TestQuery(m_dataStore, "hello", Beam::Queries::Range::Total(),
+      SnapshotLimit(SnapshotLimit::Type::TAIL, 1), {entryD});
+    REQUIRE(m_loads == 1);
+    TestQuery(m_dataStore, "hello", Beam::Queries::Range::Total(),
+      SnapshotLimit(SnapshotLimit::Type::TAIL, 3), {entryB, entryC, entryD});
+    TestQuery(m_dataStore, "hello", Beam::Queries::Range::Total(),
+      SnapshotLimit(SnapshotLimit::Type::HEAD, 0), {});
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "freeze") {
+    auto entryA = Store(1, DAY_A);
+    auto entryB = Store(2, DAY_B);
+    auto entryC = Store(3, DAY_B + minutes(1));
+    auto entryD = Store(4, DAY_C);
+    m_dataStore.Freeze(ptime(DAY_C.date()));
+    REQUIRE(m_instances == 1);
+    REQUIRE(m_dataStore.IsFrozen(DAY_A));
+    REQUIRE(m_dataStore.IsFrozen(DAY_B));
+    REQUIRE(!m_dataStore.IsFrozen(DAY_C));
+    m_loads = 0;
+    TestQuery(m_dataStore, "hello", Beam::Queries::Range::Total(),
+      SnapshotLimit::Unlimited(), {entryA, entryB, entryC, entryD});
+    REQUIRE(m_loads == 1);
+    TestQuery(m_dataStore, "hello", Beam::Queries::Range(DAY_B, DAY_B),
+      SnapshotLimit::Unlimited(), {entryB});
+    TestQuery(m_dataStore, "hello", Beam::Queries::Range::Total(),
+      SnapshotLimit(SnapshotLimit::Type::TAIL, 2), {entryC, entryD});
+    TestQuery(m_dataStore, "goodbye", Beam::Queries::Range::Total(),
+      SnapshotLimit::Unlimited(), {});
+    REQUIRE_THROWS_AS(Store(5, DAY_A + minutes(1)), IOException);
+    auto entryE = Store(5, DAY_C + minutes(1));
+    TestQuery(m_dataStore, "hello", Beam::Queries::Range(DAY_C,
+      ptime(DAY_C.date() + days(1))), SnapshotLimit::Unlimited(),
+      {entryD, entryE});
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "frozen_blocks") {
+    auto entries = std::vector<SequencedIndexedTestEntry>();
+    for(auto i = 0; i != 3 * DataStore::FROZEN_BLOCK_SIZE + 10; ++i) {
+      entries.push_back(Store(i + 1, DAY_A + seconds(i)));
+    }
+    m_loads = 0;
+    m_dataStore.Freeze(ptime(DAY_B.date()));
+    REQUIRE(m_dataStore.IsFrozen(DAY_A));
+    REQUIRE(m_loads == 4);
+    REQUIRE(m_instances == 0);
+    m_loads = 0;
+    auto slice = [&] (std::size_t first, std::size_t last) {
+      return std::vector<SequencedTestEntry>(entries.begin() + first,
+        entries.begin() + last);
+    };
+    auto first = DataStore::FROZEN_BLOCK_SIZE - 2;
+    auto last = 2 * DataStore::FROZEN_BLOCK_SIZE + 1;
+    TestQuery(m_dataStore, "hello", Beam::Queries::Range(
+      DAY_A + seconds(first), DAY_A + seconds(last)),
+      SnapshotLimit::Unlimited(), slice(first, last + 1));
+    TestQuery(m_dataStore, "hello", Beam::Queries::Range(
+      entries[first].GetSequence(), entries[last].GetSequence()),
+      SnapshotLimit(SnapshotLimit::Type::TAIL, 3), slice(last - 2, last + 1));
+    TestQuery(m_dataStore, "hello", Beam::Queries::Range::Total(),
+      SnapshotLimit(SnapshotLimit::Type::HEAD, 2), slice(0, 2));
+    TestQuery(m_dataStore, "hello", Beam::Queries::Range::Total(),
+      SnapshotLimit::Unlimited(), slice(0, entries.size()));
+    REQUIRE(m_loads == 0);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "reopen_frozen") {
+    auto entryA = Store(1, DAY_A);
+    Store(2, DAY_B);
+    m_dataStore.Freeze(ptime(DAY_B.date()));
+    m_dataStore.Close();
+    auto dataStore = DataStore(MakeBuilder(), 1, m_root,
+      {ptime(DAY_A.date()), ptime(DAY_B.date())});
+    dataStore.Open();
+    REQUIRE(dataStore.IsFrozen(DAY_A));
+    REQUIRE(!dataStore.IsFrozen(DAY_B));
+    m_loads = 0;
+    TestQuery(dataStore, "hello", Beam::Queries::Range(ptime(DAY_A.date()),
+      DAY_A), SnapshotLimit::Unlimited(), {entryA});
+    REQUIRE(m_loads == 0);
+    TestQuery(dataStore, "hello", Beam::Queries::Range::Total(),
+      SnapshotLimit(SnapshotLimit::Type::HEAD, 1), {entryA});
+    REQUIRE_THROWS_AS(StoreValue(dataStore, "hello", 3, DAY_A + minutes(1),
+      EncodeTimestamp(DAY_A + minutes(1), Beam::Queries::Sequence(3))),
+      IOException);
+  }
+
+  TEST_CASE("freeze_without_root") {
+    auto loads = 0;
+    auto instances = 0;
+    auto dataStore = DataStore([&] (ptime partition) {
+      return std::make_unique<CountingDataStore>(&loads, &instances);
+    }, 1);
+    dataStore.Open();
+    StoreValue(dataStore, "hello", 1, DAY_A,
+      EncodeTimestamp(DAY_A, Beam::Queries::Sequence(1)));
+    REQUIRE_THROWS_AS(dataStore.Freeze(ptime(DAY_B.date())), IOException);
+    REQUIRE(!dataStore.IsFrozen(DAY_A));
+  }
+}
@@ -0,0 +1,118 @@
+#include <cstring>
+#include <doctest/doctest.h>
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Queries/IndexedValue.hpp"
+#include "Beam/Queries/QueryResult.hpp"
+#include "Beam/Queries/SequencedValue.hpp"
+#include "Beam/Serialization/BinaryReceiver.hpp"
+#include "Beam/Serialization/BinarySender.hpp"
+#include "Beam/Serialization/ShuttleDateTime.hpp"
+
+using namespace Beam;
+using namespace Beam::IO;
+using namespace Beam::Queries;
+using namespace Beam::Serialization;
+using namespace boost::posix_time;
+
+namespace {
+  using Entry = SequencedValue<IndexedValue<ptime, std::string>>;
+
+  auto MakeSnapshot() {
+    auto snapshot = std::vector<Entry>();
+    auto timestamp = ptime(boost::gregorian::date(2020, 3, 12), seconds(1));
+    for(auto i = 0; i != 500; ++i) {
+      snapshot.push_back(SequencedValue(IndexedValue(
+        timestamp + milliseconds(15 * i), std::string(i % 3 == 0 ? "A" : "B")),
+        Beam::Queries::Sequence(1000 + 2 * i)));
+    }
+    return snapshot;
+  }
+
+  auto Send(const QueryResult<Entry>& result) {
+    auto buffer = SharedBuffer();
+    auto sender = BinarySender<SharedBuffer>();
+    sender.SetSink(Ref(buffer));
+    sender.Send(result);
+    return buffer;
+  }
+
+  struct Session {
+    int m_capabilities;
+
+    int GetCapabilities() const {
+      return m_capabilities;
+    }
+  };
+
+  struct Client {
+    Session m_session;
+
+    const Session& GetSession() const {
+      return m_session;
+    }
+  };
+
+  auto Receive(const SharedBuffer& buffer) {
+    auto receiver = BinaryReceiver<SharedBuffer>();
+    receiver.SetSource(Ref(buffer));
+    auto result = QueryResult<Entry>();
+    receiver.Shuttle(result);
+    return result;
+  }
+}
+
+TEST_SUITE("QueryResult") {
+  TEST_CASE("uncompressed") {
+    auto result = QueryResult(5, MakeSnapshot());
+    auto received = Receive(Send(result));
+    REQUIRE(received.m_queryId == 5);
+    REQUIRE(received.m_encoding == SnapshotEncoding::NONE);
+    REQUIRE(received.m_snapshot == result.m_snapshot);
+  }
+
+  TEST_CASE("columnar") {
+    auto result = QueryResult(5, MakeSnapshot(), SnapshotEncoding::COLUMNAR);
+    auto buffer = Send(result);
+    REQUIRE(buffer.GetSize() * 4 < Send(QueryResult(5, MakeSnapshot())).GetSize());
+    auto received = Receive(buffer);
+    REQUIRE(received.m_queryId == 5);
+    REQUIRE(received.m_encoding == SnapshotEncoding::COLUMNAR);
+    REQUIRE(received.m_snapshot == result.m_snapshot);
+  }
+
+  TEST_CASE("empty_columnar") {
+    auto result = QueryResult(3, std::vector<Entry>(),
+      SnapshotEncoding::COLUMNAR);
+    auto received = Receive(Send(result));
+    REQUIRE(received.m_queryId == 3);
+    REQUIRE(received.m_snapshot.empty());
+  }
+
+  TEST_CASE("legacy_layout") {
+    auto result = QueryResult(5, MakeSnapshot());
+    auto legacy = SharedBuffer();
+    auto sender = BinarySender<SharedBuffer>();
+    sender.SetSink(Ref(legacy));
+    sender.StartStructure(nullptr);
+    sender.Send("__version", 0U);
+    sender.Shuttle("query_id", result.m_queryId);
+    sender.Shuttle("snapshot", result.m_snapshot);
+    sender.EndStructure();
+    auto buffer = Send(result);
+    REQUIRE(buffer.GetSize() == legacy.GetSize());
+    REQUIRE(std::memcmp(buffer.GetData(), legacy.GetData(),
+      buffer.GetSize()) == 0);
+    auto received = Receive(legacy);
+    REQUIRE(received.m_queryId == 5);
+    REQUIRE(received.m_encoding == SnapshotEncoding::NONE);
+    REQUIRE(received.m_snapshot == result.m_snapshot);
+  }
+
+  TEST_CASE("negotiated_encoding") {
+    REQUIRE(GetSnapshotEncoding(Client{Session{0}}) ==
+      SnapshotEncoding::NONE);
+    REQUIRE(GetSnapshotEncoding(Client{Session{
+      COLUMNAR_SNAPSHOT_CAPABILITY}}) == SnapshotEncoding::COLUMNAR);
+    REQUIRE(GetSnapshotEncoding(0) == SnapshotEncoding::NONE);
+  }
+}
@@ -1,6 +1,7 @@
 #include <vector>
 #include <doctest/doctest.h>
 #include <Viper/Sqlite3/Sqlite3.hpp>
+#include "Beam/Queries/AggregateQuery.hpp"
 #include "Beam/Queries/BasicQuery.hpp"
 #include "Beam/Queries/SqlDataStore.hpp"
 #include "Beam/QueriesTests/TestEntry.hpp"
@@ -11,6 +12,7 @@ using namespace Beam::Queries;
 using namespace Beam::Queries::Tests;
 using namespace Beam::Threading;
 using namespace Beam::TimeService;
+using namespace boost::posix_time;
 using namespace Viper;
 
 namespace {
@@ -71,4 +73,83 @@ TEST_SUITE("SqlDataStore") {
       Ref(threadPool));
     dataStore.Open();
   }
+
+  TEST_CASE("load_aggregates") {
+    auto readerPool = DatabaseConnectionPool<Sqlite3::Connection>();
+    auto writerPool = DatabaseConnectionPool<Sqlite3::Connection>();
+    auto connection = std::make_unique<Sqlite3::Connection>(PATH);
+    connection->open();
+    readerPool.Add(std::move(connection));
+    connection = std::make_unique<Sqlite3::Connection>(PATH);
+    connection->open();
+    writerPool.Add(std::move(connection));
+    auto threadPool = ThreadPool();
+    auto dataStore = DataStore("aggregates", BuildValueRow(), BuildIndexRow(),
+      Ref(readerPool), Ref(writerPool), Ref(threadPool));
+    dataStore.Open();
+    auto base = ptime(boost::gregorian::date(2020, 1, 1), minutes(0));
+    auto sequence = Queries::Sequence(1);
+    for(auto& value : std::vector<std::pair<int, time_duration>>{
+        {10, seconds(1)}, {30, seconds(20)}, {50, seconds(61)}}) {
+      StoreValue(dataStore, "hello", value.first, base + value.second,
+        sequence);
+      sequence = Increment(sequence);
+    }
+    auto query = DataStore::AggregateQuery();
+    query.SetIndex("hello");
+    query.SetRange(Queries::Range::Total());
+    query.SetValue(MemberAccessExpression("value", IntType(),
+      ParameterExpression(0, NativeDataType<TestEntry>())));
+    query.SetBucket(minutes(1));
+    auto buckets = dataStore.LoadAggregates(query);
+    REQUIRE(buckets.size() == 2);
+    REQUIRE(buckets[0].m_timestamp == base);
+    REQUIRE(buckets[0].m_count == 2);
+    REQUIRE(buckets[0].m_min == 10);
+    REQUIRE(buckets[0].m_max == 30);
+    REQUIRE(buckets[1].m_timestamp == base + minutes(1));
+    REQUIRE(buckets[1].m_sum == 50);
+  }
+
+  TEST_CASE("load_unbucketed_aggregates") {
+    auto readerPool = DatabaseConnectionPool<Sqlite3::Connection>();
+    auto writerPool = DatabaseConnectionPool<Sqlite3::Connection>();
+    auto connection = std::make_unique<Sqlite3::Connection>(PATH);
+    connection->open();
+    readerPool.Add(std::move(connection));
+    connection = std::make_unique<Sqlite3::Connection>(PATH);
+    connection->open();
+    writerPool.Add(std::move(connection));
+    auto threadPool = ThreadPool();
+    auto dataStore = DataStore("unbucketed", BuildValueRow(),
+      BuildIndexRow(), Ref(readerPool), Ref(writerPool), Ref(threadPool));
+    dataStore.Open();
+    auto base = ptime(boost::gregorian::date(2020, 1, 1), minutes(0));
+    auto sequence = Queries::Sequence(1);
+    for(auto& value : std::vector<std::pair<int, time_duration>>{
+        {10, seconds(5)}, {30, seconds(20)}, {50, seconds(61)}}) {
+      StoreValue(dataStore, "hello", value.first, base + value.second,
+        sequence);
+      sequence = Increment(sequence);
+    }
+    auto query = DataStore::AggregateQuery();
+    query.SetIndex("hello");
+    query.SetRange(Queries::Range::Total());
+    query.SetValue(MemberAccessExpression("value", IntType(),
+      ParameterExpression(0, NativeDataType<TestEntry>())));
+    auto aggregates = dataStore.LoadAggregates(query);
+    REQUIRE(aggregates.size() == 1);
+    REQUIRE(aggregates[0].m_timestamp == base + seconds(5));
+    REQUIRE(aggregates[0].m_count == 3);
+    REQUIRE(aggregates[0].m_sum == 90);
+    query.SetIndex("goodbye");
+    REQUIRE(dataStore.LoadAggregates(query).empty());
+    query.SetBucket(minutes(1));
+    REQUIRE(dataStore.LoadAggregates(query).empty());
+    query.SetIndex("hello");
+    query.SetRange(base + minutes(5), base + minutes(6));
+    REQUIRE(dataStore.LoadAggregates(query).empty());
+    query.SetBucket(pos_infin);
+    REQUIRE(dataStore.LoadAggregates(query).empty());
+  }
 }
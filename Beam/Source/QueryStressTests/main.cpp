@@ -0,0 +1,107 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Queries/IndexedValue.hpp"
+#include "Beam/Queries/QueryResult.hpp"
+#include "Beam/Queries/SequencedValue.hpp"
+#include "Beam/Serialization/BinaryReceiver.hpp"
+#include "Beam/Serialization/BinarySender.hpp"
+#include "Beam/Serialization/ShuttleDateTime.hpp"
+
+using namespace Beam;
+using namespace Beam::IO;
+using namespace Beam::Queries;
+using namespace Beam::Serialization;
+using namespace boost::posix_time;
+
+namespace {
+  const auto SNAPSHOT_SIZE = 100000;
+  const auto ITERATIONS = 20;
+
+  struct Trade {
+    ptime m_timestamp;
+    double m_price;
+    int m_quantity;
+    std::string m_venue;
+  };
+
+  using Entry = SequencedValue<IndexedValue<Trade, std::string>>;
+}
+
+namespace Beam::Serialization {
+  template<>
+  struct Shuttle<Trade> {
+    template<typename Shuttler>
+    void operator ()(Shuttler& shuttle, Trade& value, unsigned int version) {
+      shuttle.Shuttle("timestamp", value.m_timestamp);
+      shuttle.Shuttle("price", value.m_price);
+      shuttle.Shuttle("quantity", value.m_quantity);
+      shuttle.Shuttle("venue", value.m_venue);
+    }
+  };
+}
+
+namespace {
+  std::vector<Entry> MakeSnapshot() {
+    auto venues = std::vector<std::string>{"XNAS", "XNYS", "ARCX", "BATS"};
+    auto random = std::mt19937(42);
+    auto snapshot = std::vector<Entry>();
+    snapshot.reserve(SNAPSHOT_SIZE);
+    auto timestamp = ptime(boost::gregorian::date(2020, 3, 12), hours(14));
+    auto price = 100.0;
+    for(auto i = 0; i != SNAPSHOT_SIZE; ++i) {
+      timestamp += microseconds(random() % 50000);
+      price += (static_cast<int>(random() % 21) - 10) / 100.0;
+      auto trade = Trade{timestamp, price,
+        100 * static_cast<int>(1 + random() % 10), venues[random() % 4]};
+      snapshot.push_back(SequencedValue(IndexedValue(std::move(trade),
+        std::string("MSFT.NSDQ")), Beam::Queries::Sequence(
+        (std::uint64_t(1) << 32) + i)));
+    }
+    return snapshot;
+  }
+
+  void Report(const std::string& name, const std::vector<Entry>& snapshot,
+      SnapshotEncoding encoding) {
+    auto result = QueryResult(1, snapshot, encoding);
+    auto buffer = SharedBuffer();
+    auto sender = BinarySender<SharedBuffer>();
+    auto start = std::chrono::steady_clock::now();
+    for(auto i = 0; i != ITERATIONS; ++i) {
+      buffer.Reset();
+      sender.SetSink(Ref(buffer));
+      sender.Shuttle(result);
+    }
+    auto encodeTime = std::chrono::steady_clock::now() - start;
+    auto receiver = BinaryReceiver<SharedBuffer>();
+    auto received = QueryResult<Entry>();
+    start = std::chrono::steady_clock::now();
+    for(auto i = 0; i != ITERATIONS; ++i) {
+      receiver.SetSource(Ref(buffer));
+      receiver.Shuttle(received);
+    }
+    auto decodeTime = std::chrono::steady_clock::now() - start;
+    auto rate = [] (auto duration) {
+      auto seconds = std::chrono::duration<double>(duration).count();
+      return static_cast<std::uint64_t>(SNAPSHOT_SIZE * ITERATIONS / seconds);
+    };
+    std::cout << name << ": " << buffer.GetSize() << " bytes, " <<
+      rate(encodeTime) << " values/s encoded, " << rate(decodeTime) <<
+      " values/s decoded" << std::endl;
+  }
+}
+
+int main() {
+  try {
+    auto snapshot = MakeSnapshot();
+    Report("None", snapshot, SnapshotEncoding::NONE);
+    Report("Columnar", snapshot, SnapshotEncoding::COLUMNAR);
+  } catch(const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return -1;
+  }
+  return 0;
+}
@@ -0,0 +1,81 @@
+#include <memory>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Beam/Queues/RoutineTaskQueue.hpp"
+#include "Beam/Routines/Async.hpp"
+
+using namespace Beam;
+using namespace Beam::Routines;
+
+TEST_SUITE("RoutineTaskQueue") {
+  TEST_CASE("push") {
+    auto tasks = RoutineTaskQueue();
+    auto values = std::vector<int>();
+    for(auto i = 0; i < 100; ++i) {
+      tasks.Push(
+        [&, i] {
+          values.push_back(i);
+        });
+    }
+    tasks.Push(std::function<void ()>(
+      [&] {
+        values.push_back(100);
+      }));
+    tasks.Break();
+    tasks.Wait();
+    REQUIRE(values.size() == 101);
+    for(auto i = 0; i < static_cast<int>(values.size()); ++i) {
+      REQUIRE(values[i] == i);
+    }
+  }
+
+  TEST_CASE("move_only") {
+    auto tasks = RoutineTaskQueue();
+    auto result = Async<int>();
+    auto value = std::make_unique<int>(123);
+    tasks.Push(
+      [&, value = std::move(value)] {
+        result.GetEval().SetResult(*value);
+      });
+    REQUIRE(result.Get() == 123);
+  }
+
+  TEST_CASE("batch") {
+    auto tasks = RoutineTaskQueue();
+    auto start = Async<void>();
+    auto values = std::vector<int>();
+    tasks.Push(
+      [&] {
+        start.Get();
+        values.push_back(0);
+      });
+    for(auto i = 1; i < 10; ++i) {
+      tasks.Push(
+        [&, i] {
+          values.push_back(i);
+        });
+    }
+    start.GetEval().SetResult();
+    tasks.Break();
+    tasks.Wait();
+    REQUIRE((values == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+  }
+
+  TEST_CASE("slot") {
+    auto tasks = RoutineTaskQueue();
+    auto result = Async<int>();
+    auto slot = tasks.GetSlot<int>(
+      [&] (int value) {
+        result.GetEval().SetResult(value);
+      });
+    slot->Push(321);
+    REQUIRE(result.Get() == 321);
+  }
+
+  TEST_CASE("break") {
+    auto tasks = RoutineTaskQueue();
+    tasks.Break();
+    tasks.Wait();
+    REQUIRE_THROWS_AS(tasks.Push([] {}), PipeBrokenException);
+  }
+}
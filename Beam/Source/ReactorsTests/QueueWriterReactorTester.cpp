@@ -0,0 +1,110 @@
+#include <Aspen/Trigger.hpp>
+#include <doctest/doctest.h>
+#include "Beam/Queues/Queue.hpp"
+#include "Beam/Reactors/QueueWriterReactor.hpp"
+
+using namespace Aspen;
+using namespace Beam;
+using namespace Beam::Reactors;
+
+TEST_SUITE("QueueWriterReactorTester") {
+  TEST_CASE("empty") {
+    auto commits = Beam::Queue<bool>();
+    auto trigger = Trigger(
+      [&] {
+        commits.Push(true);
+      });
+    Trigger::set_trigger(trigger);
+    auto reactor = QueueWriterReactor<int>();
+    auto writer = reactor.GetWriter();
+    REQUIRE(reactor.commit(0) == State::NONE);
+    writer->Break();
+    commits.Top();
+    REQUIRE(reactor.commit(1) == State::COMPLETE);
+    Trigger::set_trigger(nullptr);
+  }
+  TEST_CASE("immediate_exception") {
+    auto commits = Beam::Queue<bool>();
+    auto trigger = Trigger(
+      [&] {
+        commits.Push(true);
+      });
+    Trigger::set_trigger(trigger);
+    auto reactor = QueueWriterReactor<int>();
+    auto writer = reactor.GetWriter();
+    REQUIRE(reactor.commit(0) == State::NONE);
+    writer->Break(std::runtime_error("Broken."));
+    commits.Top();
+    REQUIRE(reactor.commit(1) == State::COMPLETE_EVALUATED);
+    REQUIRE_THROWS_AS_MESSAGE(reactor.eval(), std::runtime_error, "Broken.");
+    Trigger::set_trigger(nullptr);
+  }
+  TEST_CASE("single_value") {
+    auto commits = Beam::Queue<bool>();
+    auto trigger = Trigger(
+      [&] {
+        commits.Push(true);
+      });
+    Trigger::set_trigger(trigger);
+    auto reactor = QueueWriterReactor<int>();
+    auto writer = reactor.GetWriter();
+    REQUIRE(reactor.commit(0) == State::NONE);
+    writer->Push(123);
+    writer->Break();
+    commits.Top();
+    REQUIRE(reactor.commit(1) == State::COMPLETE_EVALUATED);
+    REQUIRE(reactor.eval() == 123);
+    Trigger::set_trigger(nullptr);
+  }
+  TEST_CASE("single_value_exception") {
+    auto commits = Beam::Queue<bool>();
+    auto trigger = Trigger(
+      [&] {
+        commits.Push(true);
+      });
+    Trigger::set_trigger(trigger);
+    auto reactor = QueueWriterReactor<int>();
+    auto writer = reactor.GetWriter();
+    REQUIRE(reactor.commit(0) == State::NONE);
+    writer->Push(123);
+    writer->Break(std::runtime_error("Broken."));
+    commits.Top();
+    REQUIRE(reactor.commit(1) == State::CONTINUE_EVALUATED);
+    REQUIRE(reactor.eval() == 123);
+    REQUIRE(reactor.commit(2) == State::COMPLETE_EVALUATED);
+    REQUIRE_THROWS_AS_MESSAGE(reactor.eval(), std::runtime_error, "Broken.");
+    Trigger::set_trigger(nullptr);
+  }
+  TEST_CASE("batch") {
+    auto commits = Beam::Queue<bool>();
+    auto trigger = Trigger(
+      [&] {
+        commits.Push(true);
+      });
+    Trigger::set_trigger(trigger);
+    auto reactor = QueueWriterReactor<int>();
+    auto writer = reactor.GetWriter();
+    REQUIRE(reactor.commit(0) == State::NONE);
+    writer->Push(1);
+    writer->Push(2);
+    writer->Push(3);
+    commits.Top();
+    commits.Pop();
+    REQUIRE(commits.IsEmpty());
+    REQUIRE(reactor.commit(1) == State::CONTINUE_EVALUATED);
+    REQUIRE(reactor.eval() == 1);
+    REQUIRE(reactor.commit(2) == State::CONTINUE_EVALUATED);
+    REQUIRE(reactor.eval() == 2);
+    REQUIRE(reactor.commit(3) == State::EVALUATED);
+    REQUIRE(reactor.eval() == 3);
+    Trigger::set_trigger(nullptr);
+  }
+  TEST_CASE("closed") {
+    auto writer = std::shared_ptr<QueueWriter<int>>();
+    {
+      auto reactor = QueueWriterReactor<int>();
+      writer = reactor.GetWriter();
+    }
+    REQUIRE_THROWS_AS(writer->Push(123), PipeBrokenException);
+  }
+}
@@ -0,0 +1,126 @@
+#include <filesystem>
+#include <fstream>
+#include <doctest/doctest.h>
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/RegistryService/LogRegistryDataStore.hpp"
+
+using namespace Beam;
+using namespace Beam::IO;
+using namespace Beam::RegistryService;
+
+namespace {
+  struct Fixture {
+    std::filesystem::path m_root;
+
+    Fixture()
+        : m_root(std::filesystem::temp_directory_path() /
+            "LogRegistryDataStoreTester") {
+      std::filesystem::remove_all(m_root);
+    }
+
+    ~Fixture() {
+      std::filesystem::remove_all(m_root);
+    }
+  };
+
+  auto MakeDirectory(LogRegistryDataStore& dataStore, const std::string& name,
+      const RegistryEntry& parent) {
+    return dataStore.Copy(RegistryEntry(RegistryEntry::Type::DIRECTORY, -1,
+      name, 0), parent);
+  }
+
+  auto MakeValue(LogRegistryDataStore& dataStore, const std::string& name,
+      const std::string& value, const RegistryEntry& parent) {
+    auto entry = dataStore.Copy(RegistryEntry(RegistryEntry::Type::VALUE, -1,
+      name, 0), parent);
+    return dataStore.Store(entry, BufferFromString<SharedBuffer>(value));
+  }
+}
+
+TEST_SUITE("LogRegistryDataStore") {
+  TEST_CASE_FIXTURE(Fixture, "recover") {
+    auto directory = RegistryEntry();
+    auto value = RegistryEntry();
+    {
+      auto dataStore = LogRegistryDataStore(m_root);
+      dataStore.Open();
+      directory = MakeDirectory(dataStore, "directory",
+        RegistryEntry::GetRoot());
+      value = MakeValue(dataStore, "key", "value", directory);
+    }
+    auto dataStore = LogRegistryDataStore(m_root);
+    dataStore.Open();
+    REQUIRE(dataStore.LoadRegistryEntry(directory.m_id) == directory);
+    REQUIRE(dataStore.LoadParent(value) == directory);
+    REQUIRE(dataStore.LoadChildren(directory) ==
+      std::vector<RegistryEntry>{value});
+    REQUIRE(dataStore.Load(value) == BufferFromString<SharedBuffer>("value"));
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "copy_subtree") {
+    auto dataStore = LogRegistryDataStore(m_root);
+    dataStore.Open();
+    auto source = MakeDirectory(dataStore, "source", RegistryEntry::GetRoot());
+    auto child = MakeDirectory(dataStore, "child", source);
+    MakeValue(dataStore, "key", "value", child);
+    auto destination = MakeDirectory(dataStore, "destination",
+      RegistryEntry::GetRoot());
+    auto copy = dataStore.Copy(source, destination);
+    REQUIRE(copy.m_id != source.m_id);
+    REQUIRE(dataStore.LoadParent(copy) == destination);
+    auto copiedChildren = dataStore.LoadChildren(copy);
+    REQUIRE(copiedChildren.size() == 1);
+    REQUIRE(copiedChildren.front().m_id != child.m_id);
+    auto copiedValues = dataStore.LoadChildren(copiedChildren.front());
+    REQUIRE(copiedValues.size() == 1);
+    REQUIRE(dataStore.Load(copiedValues.front()) ==
+      BufferFromString<SharedBuffer>("value"));
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "move_and_delete") {
+    auto directory = RegistryEntry();
+    auto destination = RegistryEntry();
+    {
+      auto dataStore = LogRegistryDataStore(m_root);
+      dataStore.Open();
+      directory = MakeDirectory(dataStore, "directory",
+        RegistryEntry::GetRoot());
+      auto value = MakeValue(dataStore, "key", "value", directory);
+      destination = MakeDirectory(dataStore, "destination",
+        RegistryEntry::GetRoot());
+      dataStore.Move(directory, destination);
+      REQUIRE(dataStore.LoadParent(directory) == destination);
+      dataStore.Delete(destination);
+      REQUIRE_THROWS_AS(dataStore.LoadRegistryEntry(value.m_id),
+        RegistryDataStoreException);
+    }
+    auto dataStore = LogRegistryDataStore(m_root);
+    dataStore.Open();
+    REQUIRE(dataStore.LoadChildren(RegistryEntry::GetRoot()).empty());
+    REQUIRE_THROWS_AS(dataStore.LoadRegistryEntry(directory.m_id),
+      RegistryDataStoreException);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "torn_write") {
+    auto directory = RegistryEntry();
+    {
+      auto dataStore = LogRegistryDataStore(m_root);
+      dataStore.Open();
+      directory = MakeDirectory(dataStore, "directory",
+        RegistryEntry::GetRoot());
+    }
+    {
+      auto log = std::ofstream(m_root / "registry.log",
+        std::ios::binary | std::ios::app);
+      log.write("\x40\x00\x00\x00garbage", 11);
+    }
+    auto dataStore = LogRegistryDataStore(m_root);
+    dataStore.Open();
+    REQUIRE(dataStore.LoadRegistryEntry(directory.m_id) == directory);
+    auto value = MakeValue(dataStore, "key", "value", directory);
+    dataStore.Close();
+    auto reopenedDataStore = LogRegistryDataStore(m_root);
+    reopenedDataStore.Open();
+    REQUIRE(reopenedDataStore.LoadRegistryEntry(value.m_id) == value);
+  }
+}
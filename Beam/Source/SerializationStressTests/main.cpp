@@ -0,0 +1,171 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Json/JsonParser.hpp"
+#include "Beam/Serialization/BinaryReceiver.hpp"
+#include "Beam/Serialization/BinarySender.hpp"
+#include "Beam/Serialization/JsonReceiver.hpp"
+#include "Beam/Serialization/JsonSender.hpp"
+#include "Beam/Serialization/ShuttleDecimal.hpp"
+#include "Beam/Serialization/ShuttleVector.hpp"
+
+using namespace Beam;
+using namespace Beam::IO;
+using namespace Beam::Serialization;
+
+namespace {
+  using Decimal = boost::multiprecision::cpp_dec_float_50;
+  const auto VALUE_COUNT = 100000;
+  const auto ITERATIONS = 10;
+
+  struct Order {
+    std::int64_t m_id;
+    std::string m_symbol;
+    std::string m_side;
+    int m_quantity;
+    double m_price;
+  };
+}
+
+namespace Beam::Serialization {
+  template<>
+  struct Shuttle<Order> {
+    template<typename Shuttler>
+    void operator ()(Shuttler& shuttle, Order& value, unsigned int version) {
+      shuttle.Shuttle("id", value.m_id);
+      shuttle.Shuttle("symbol", value.m_symbol);
+      shuttle.Shuttle("side", value.m_side);
+      shuttle.Shuttle("quantity", value.m_quantity);
+      shuttle.Shuttle("price", value.m_price);
+    }
+  };
+}
+
+namespace {
+  auto GetRate(std::chrono::steady_clock::duration duration) {
+    auto seconds = std::chrono::duration<double>(duration).count();
+    return static_cast<std::uint64_t>(VALUE_COUNT * ITERATIONS / seconds);
+  }
+
+  std::vector<Decimal> MakeValues() {
+    auto random = std::mt19937(42);
+    auto values = std::vector<Decimal>();
+    values.reserve(VALUE_COUNT);
+    for(auto i = 0; i != VALUE_COUNT; ++i) {
+      values.push_back(Decimal(static_cast<int>(random() % 1000000)) / 100);
+    }
+    return values;
+  }
+
+  template<typename S, typename R>
+  void Report(const std::string& name, int protocolVersion,
+      const std::vector<Decimal>& values, S&& send, R&& receive) {
+    auto buffer = SharedBuffer();
+    auto sender = BinarySender<SharedBuffer>();
+    sender.SetProtocolVersion(protocolVersion);
+    auto start = std::chrono::steady_clock::now();
+    for(auto i = 0; i != ITERATIONS; ++i) {
+      buffer.Reset();
+      sender.SetSink(Ref(buffer));
+      for(auto& value : values) {
+        send(sender, value);
+      }
+    }
+    auto sendTime = std::chrono::steady_clock::now() - start;
+    auto receiver = BinaryReceiver<SharedBuffer>();
+    auto received = Decimal();
+    start = std::chrono::steady_clock::now();
+    for(auto i = 0; i != ITERATIONS; ++i) {
+      receiver.SetSource(Ref(buffer));
+      for(auto j = 0; j != VALUE_COUNT; ++j) {
+        receive(receiver, received);
+      }
+    }
+    auto receiveTime = std::chrono::steady_clock::now() - start;
+    std::cout << name << ": " << buffer.GetSize() << " bytes, " <<
+      GetRate(sendTime) << " values/s sent, " << GetRate(receiveTime) <<
+      " values/s received" << std::endl;
+  }
+
+  std::vector<Order> MakeOrders() {
+    auto symbols = std::vector<std::string>{"MSFT.NSDQ", "IBM.NYSE", "RY.TSX"};
+    auto random = std::mt19937(42);
+    auto orders = std::vector<Order>();
+    orders.reserve(VALUE_COUNT);
+    for(auto i = 0; i != VALUE_COUNT; ++i) {
+      orders.push_back(Order{i, symbols[random() % 3],
+        random() % 2 == 0 ? "BID" : "ASK",
+        100 * static_cast<int>(1 + random() % 10),
+        static_cast<int>(random() % 100000) / 100.0});
+    }
+    return orders;
+  }
+
+  void ReportJson(const std::vector<Order>& orders) {
+    auto buffer = SharedBuffer();
+    auto sender = JsonSender<SharedBuffer>();
+    auto start = std::chrono::steady_clock::now();
+    for(auto i = 0; i != ITERATIONS; ++i) {
+      buffer.Reset();
+      sender.SetSink(Ref(buffer));
+      sender.Shuttle(orders);
+    }
+    auto sendTime = std::chrono::steady_clock::now() - start;
+    auto receiver = JsonReceiver<SharedBuffer>();
+    auto received = std::vector<Order>();
+    start = std::chrono::steady_clock::now();
+    for(auto i = 0; i != ITERATIONS; ++i) {
+      receiver.SetSource(Ref(buffer));
+      receiver.Shuttle(received);
+    }
+    auto receiveTime = std::chrono::steady_clock::now() - start;
+    auto parser = JsonParser();
+    start = std::chrono::steady_clock::now();
+    for(auto i = 0; i != ITERATIONS; ++i) {
+      auto stream = Parsers::ReaderParserStream<BufferReader<SharedBuffer>>(
+        buffer);
+      auto value = JsonValue();
+      if(!parser.Read(stream, value)) {
+        throw std::runtime_error("Invalid JSON.");
+      }
+    }
+    auto domTime = std::chrono::steady_clock::now() - start;
+    std::cout << "Json: " << buffer.GetSize() << " bytes, " <<
+      GetRate(sendTime) << " values/s sent, " << GetRate(receiveTime) <<
+      " values/s received, " << GetRate(domTime) <<
+      " values/s parsed into a JsonValue" << std::endl;
+  }
+}
+
+int main() {
+  try {
+    auto values = MakeValues();
+    Report("Text", LEGACY_BINARY_PROTOCOL, values,
+      [] (auto& sender, const Decimal& value) {
+        auto sink = std::stringstream();
+        sink << value;
+        sender.Send(sink.str());
+      },
+      [] (auto& receiver, Decimal& value) {
+        auto input = std::string();
+        receiver.Shuttle(input);
+        value = Decimal(input);
+      });
+    Report("Binary", COMPACT_BINARY_PROTOCOL, values,
+      [] (auto& sender, const Decimal& value) {
+        sender.Send(value);
+      },
+      [] (auto& receiver, Decimal& value) {
+        receiver.Shuttle(value);
+      });
+    ReportJson(MakeOrders());
+  } catch(const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return -1;
+  }
+  return 0;
+}
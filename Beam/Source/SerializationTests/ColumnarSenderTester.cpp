@@ -0,0 +1,106 @@
+#include <doctest/doctest.h>
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Serialization/BinarySender.hpp"
+#include "Beam/Serialization/ColumnarReceiver.hpp"
+#include "Beam/Serialization/ColumnarSender.hpp"
+#include "Beam/Serialization/ShuttleDateTime.hpp"
+#include "Beam/SerializationTests/ShuttleTestTypes.hpp"
+
+using namespace Beam;
+using namespace Beam::IO;
+using namespace Beam::Serialization;
+using namespace Beam::Serialization::Tests;
+using namespace boost::posix_time;
+
+namespace {
+  template<typename T>
+  SharedBuffer Encode(const std::vector<T>& rows) {
+    auto buffer = SharedBuffer();
+    auto sender = ColumnarSender<SharedBuffer>();
+    sender.SetSink(Ref(buffer));
+    for(auto& row : rows) {
+      sender.StartRow();
+      sender.Shuttle(row);
+    }
+    sender.Flush();
+    return buffer;
+  }
+
+  template<typename T>
+  std::vector<T> Decode(const SharedBuffer& buffer, std::size_t count) {
+    auto receiver = ColumnarReceiver<SharedBuffer>();
+    receiver.SetSource(Ref(buffer));
+    auto rows = std::vector<T>();
+    for(auto i = std::size_t(0); i != count; ++i) {
+      receiver.StartRow();
+      receiver.Shuttle(rows.emplace_back());
+    }
+    return rows;
+  }
+}
+
+TEST_SUITE("ColumnarSender") {
+  TEST_CASE("integers") {
+    auto rows = std::vector<std::int64_t>{0, 1, -1, 1000000,
+      std::numeric_limits<std::int64_t>::min(),
+      std::numeric_limits<std::int64_t>::max(), 5};
+    auto buffer = Encode(rows);
+    REQUIRE(Decode<std::int64_t>(buffer, rows.size()) == rows);
+  }
+
+  TEST_CASE("delta_encoding") {
+    auto rows = std::vector<std::uint64_t>();
+    for(auto i = std::uint64_t(0); i != 1000; ++i) {
+      rows.push_back((std::uint64_t(1) << 40) + i);
+    }
+    auto buffer = Encode(rows);
+    REQUIRE(buffer.GetSize() < rows.size() * 2);
+    REQUIRE(Decode<std::uint64_t>(buffer, rows.size()) == rows);
+  }
+
+  TEST_CASE("string_dictionary") {
+    auto rows = std::vector<std::string>();
+    for(auto i = 0; i != 100; ++i) {
+      rows.push_back(i % 2 == 0 ? "XNAS" : "XNYS");
+    }
+    rows.push_back("");
+    auto buffer = Encode(rows);
+    REQUIRE(buffer.GetSize() < 128);
+    REQUIRE(Decode<std::string>(buffer, rows.size()) == rows);
+  }
+
+  TEST_CASE("timestamps") {
+    auto start = ptime(boost::gregorian::date(2020, 3, 12), seconds(1));
+    auto rows = std::vector<ptime>{start, start + microseconds(1),
+      start + hours(5), ptime(boost::gregorian::date(1960, 1, 1)),
+      ptime(not_a_date_time), ptime(pos_infin), ptime(neg_infin), start};
+    auto buffer = Encode(rows);
+    REQUIRE(Decode<ptime>(buffer, rows.size()) == rows);
+    auto durations = std::vector<time_duration>{seconds(5), -minutes(3),
+      time_duration(pos_infin), time_duration(not_a_date_time)};
+    auto durationBuffer = Encode(durations);
+    REQUIRE(Decode<time_duration>(durationBuffer, durations.size()) ==
+      durations);
+  }
+
+  TEST_CASE("structures") {
+    auto rows = std::vector<StructWithFreeShuttle>{{'a', 1, 1.5},
+      {'b', -2, 2.5}, {'c', 3, 3.5}};
+    auto buffer = Encode(rows);
+    auto received = Decode<StructWithFreeShuttle>(buffer, rows.size());
+    REQUIRE(received.size() == rows.size());
+    for(auto i = std::size_t(0); i != rows.size(); ++i) {
+      REQUIRE(received[i] == rows[i]);
+    }
+  }
+
+  TEST_CASE("truncated") {
+    auto rows = std::vector<std::string>{"hello world", "goodbye sky"};
+    auto buffer = Encode(rows);
+    auto truncated = SharedBuffer(buffer.GetData(), buffer.GetSize() - 1);
+    REQUIRE_THROWS_AS(Decode<std::string>(truncated, rows.size()),
+      SerializationException);
+    REQUIRE_THROWS_AS(Decode<std::string>(buffer, rows.size() + 1),
+      SerializationException);
+  }
+}
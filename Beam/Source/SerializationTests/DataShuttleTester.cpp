@@ -5,6 +5,8 @@
 #include "Beam/Serialization/JsonReceiver.hpp"
 #include "Beam/Serialization/JsonSender.hpp"
 #include "Beam/Serialization/ShuttleArray.hpp"
+#include "Beam/Serialization/ShuttleDateTime.hpp"
+#include "Beam/Serialization/ShuttleDecimal.hpp"
 #include "Beam/Serialization/TypeRegistry.hpp"
 #include "Beam/SerializationTests/ShuttleTestTypes.hpp"
 #include "Beam/SerializationTests/ValueShuttleTests.hpp"
@@ -13,8 +15,12 @@ using namespace Beam;
 using namespace Beam::IO;
 using namespace Beam::Serialization;
 using namespace Beam::Serialization::Tests;
+using namespace boost::gregorian;
+using namespace boost::posix_time;
 
 namespace {
+  using Decimal = boost::multiprecision::cpp_dec_float_50;
+
   struct BinaryTest {
     using SenderType = BinarySender<SharedBuffer>;
     using ReceiverType = BinaryReceiver<SharedBuffer>;
@@ -181,6 +187,45 @@ TEST_SUITE("DataShuttle") {
         std::string("hello world"));
     }
 
+    SUBCASE("ptime") {
+      TestShuttlingReference(T::MakeSender(), T::MakeReceiver(),
+        ptime(date(2020, 3, 12), hours(9) + microseconds(123456)));
+      TestShuttlingReference(T::MakeSender(), T::MakeReceiver(),
+        ptime(date(1960, 1, 1), seconds(1)));
+      TestShuttlingReference(T::MakeSender(), T::MakeReceiver(),
+        ptime(pos_infin));
+      TestShuttlingReference(T::MakeSender(), T::MakeReceiver(),
+        ptime(neg_infin));
+      TestShuttlingReference(T::MakeSender(), T::MakeReceiver(), ptime());
+      TestShuttlingConstant(T::MakeSender(), T::MakeReceiver(),
+        ptime(date(2020, 3, 12), hours(9)));
+    }
+
+    SUBCASE("time_duration") {
+      TestShuttlingReference(T::MakeSender(), T::MakeReceiver(),
+        hours(5) + microseconds(7));
+      TestShuttlingReference(T::MakeSender(), T::MakeReceiver(),
+        time_duration(-minutes(3)));
+      TestShuttlingReference(T::MakeSender(), T::MakeReceiver(),
+        time_duration(pos_infin));
+      TestShuttlingReference(T::MakeSender(), T::MakeReceiver(),
+        time_duration(neg_infin));
+      TestShuttlingConstant(T::MakeSender(), T::MakeReceiver(),
+        time_duration(seconds(30)));
+    }
+
+    SUBCASE("decimal") {
+      TestShuttlingReference(T::MakeSender(), T::MakeReceiver(),
+        Decimal("123.45"));
+      TestShuttlingReference(T::MakeSender(), T::MakeReceiver(),
+        Decimal("-0.000000001"));
+      TestShuttlingReference(T::MakeSender(), T::MakeReceiver(), Decimal(0));
+      TestShuttlingReference(T::MakeSender(), T::MakeReceiver(),
+        Decimal("1e-300"));
+      TestShuttlingConstant(T::MakeSender(), T::MakeReceiver(),
+        Decimal("98765432109876543210.0123456789"));
+    }
+
     SUBCASE("sequence") {
       TestShuttlingReference(T::MakeSender(), T::MakeReceiver(),
         std::array<int, 5>{5, 4, 3, 2, 1});
@@ -286,4 +331,131 @@ TEST_SUITE("DataShuttle") {
       TestShuttlingConstant(T::MakeSender(), T::MakeReceiver(), object);
     }
   }
+
+  TEST_CASE("binary_date_time") {
+    auto timestamp = ptime(date(2020, 3, 12), hours(9) + microseconds(5));
+    auto buffer = SharedBuffer();
+    auto sender = BinarySender<SharedBuffer>();
+    sender.SetProtocolVersion(COMPACT_BINARY_PROTOCOL);
+    sender.SetSink(Ref(buffer));
+    sender.Send(timestamp);
+    REQUIRE(buffer.GetSize() == 8);
+    auto receiver = BinaryReceiver<SharedBuffer>();
+    auto received = ptime();
+    receiver.SetSource(Ref(buffer));
+    receiver.Shuttle(received);
+    REQUIRE(received == timestamp);
+  }
+
+  TEST_CASE("legacy_date_time") {
+    auto timestamp = ptime(date(2020, 3, 12), hours(9) + microseconds(5));
+    auto duration = time_duration(minutes(90));
+    auto buffer = SharedBuffer();
+    auto sender = BinarySender<SharedBuffer>();
+    REQUIRE(sender.GetProtocolVersion() == LEGACY_BINARY_PROTOCOL);
+    sender.SetSink(Ref(buffer));
+    sender.Send(timestamp);
+    sender.Send(duration);
+    sender.Send(ptime(pos_infin));
+    REQUIRE(buffer.GetSize() > 16);
+    auto receiver = BinaryReceiver<SharedBuffer>();
+    receiver.SetSource(Ref(buffer));
+    auto receivedTimestamp = ptime();
+    receiver.Shuttle(receivedTimestamp);
+    REQUIRE(receivedTimestamp == timestamp);
+    auto receivedDuration = time_duration();
+    receiver.Shuttle(receivedDuration);
+    REQUIRE(receivedDuration == duration);
+    receiver.Shuttle(receivedTimestamp);
+    REQUIRE(receivedTimestamp.is_pos_infinity());
+  }
+
+  TEST_CASE("invalid_legacy_date_time") {
+    auto buffer = SharedBuffer();
+    auto sender = BinarySender<SharedBuffer>();
+    sender.SetSink(Ref(buffer));
+    sender.Send(std::string("garbage"));
+    auto receiver = BinaryReceiver<SharedBuffer>();
+    receiver.SetSource(Ref(buffer));
+    auto received = ptime();
+    REQUIRE_THROWS_AS(receiver.Shuttle(received), SerializationException);
+  }
+
+  TEST_CASE("binary_decimal") {
+    auto values = std::vector<Decimal>{Decimal("123.45"), Decimal(1) / 3,
+      -Decimal("1e40"), Decimal(0), Decimal("1e-300"), Decimal("12345678"),
+      -Decimal(2) / 7, std::numeric_limits<Decimal>::max(),
+      std::numeric_limits<Decimal>::min(),
+      std::numeric_limits<Decimal>::infinity(),
+      -std::numeric_limits<Decimal>::infinity()};
+    for(auto& value : values) {
+      auto buffer = SharedBuffer();
+      auto sender = BinarySender<SharedBuffer>();
+      sender.SetProtocolVersion(COMPACT_BINARY_PROTOCOL);
+      sender.SetSink(Ref(buffer));
+      sender.Send(value);
+      auto receiver = BinaryReceiver<SharedBuffer>();
+      receiver.SetSource(Ref(buffer));
+      auto received = Decimal();
+      receiver.Shuttle(received);
+      REQUIRE(received == value);
+    }
+  }
+
+  TEST_CASE("legacy_decimal") {
+    auto buffer = SharedBuffer();
+    auto sender = BinarySender<SharedBuffer>();
+    sender.SetSink(Ref(buffer));
+    sender.Send(std::string("-12.5"));
+    auto receiver = BinaryReceiver<SharedBuffer>();
+    receiver.SetSource(Ref(buffer));
+    auto received = Decimal();
+    receiver.Shuttle(received);
+    REQUIRE(received == Decimal("-12.5"));
+  }
+
+  TEST_CASE("binary_decimal_layout") {
+    auto buffer = SharedBuffer();
+    auto sender = BinarySender<SharedBuffer>();
+    sender.SetProtocolVersion(COMPACT_BINARY_PROTOCOL);
+    sender.SetSink(Ref(buffer));
+    sender.Send(Decimal("-123.45"));
+    sender.Send(std::numeric_limits<Decimal>::quiet_NaN());
+    auto receiver = BinaryReceiver<SharedBuffer>();
+    receiver.SetSource(Ref(buffer));
+    auto header = std::uint32_t();
+    auto exponent = std::int32_t();
+    auto high = std::uint32_t();
+    auto low = std::uint32_t();
+    receiver.Shuttle(header);
+    receiver.Shuttle(exponent);
+    receiver.Shuttle(high);
+    receiver.Shuttle(low);
+    REQUIRE(header == 0xC0000002);
+    REQUIRE(exponent == 8);
+    REQUIRE(high == 123);
+    REQUIRE(low == 45000000);
+    auto received = Decimal();
+    receiver.Shuttle(received);
+    REQUIRE(boost::multiprecision::isnan(received));
+    buffer.Reset();
+    sender.SetSink(Ref(buffer));
+    sender.Send(std::uint32_t(0x80000001));
+    sender.Send(std::int32_t(3));
+    sender.Send(std::uint32_t(12345));
+    receiver.SetSource(Ref(buffer));
+    REQUIRE_THROWS_AS(receiver.Shuttle(received), SerializationException);
+  }
+
+  TEST_CASE("default_decimal") {
+    auto buffer = SharedBuffer();
+    auto sender = BinarySender<SharedBuffer>();
+    sender.SetSink(Ref(buffer));
+    sender.Send(Decimal("-12.5"));
+    auto receiver = BinaryReceiver<SharedBuffer>();
+    receiver.SetSource(Ref(buffer));
+    auto received = std::string();
+    receiver.Shuttle(received);
+    REQUIRE(Decimal(received) == Decimal("-12.5"));
+  }
 }
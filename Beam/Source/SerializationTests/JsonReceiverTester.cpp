@@ -0,0 +1,83 @@
+#include <doctest/doctest.h>
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Serialization/JsonReceiver.hpp"
+#include "Beam/Serialization/JsonSender.hpp"
+#include "Beam/Serialization/ShuttleVector.hpp"
+#include "Beam/SerializationTests/ShuttleTestTypes.hpp"
+
+using namespace Beam;
+using namespace Beam::IO;
+using namespace Beam::Serialization;
+using namespace Beam::Serialization::Tests;
+
+namespace {
+  template<typename T>
+  T Parse(const std::string& source) {
+    auto buffer = BufferFromString<SharedBuffer>(source);
+    auto receiver = JsonReceiver<SharedBuffer>();
+    receiver.SetSource(Ref(buffer));
+    auto value = T();
+    receiver.Shuttle(value);
+    return value;
+  }
+}
+
+TEST_SUITE("JsonReceiver") {
+  TEST_CASE("out_of_order_members") {
+    auto value = Parse<StructWithFreeShuttle>(
+      R"( { "c" : 2.5, "b": 7, "a": "x" } )");
+    REQUIRE((value == StructWithFreeShuttle{'x', 7, 2.5}));
+  }
+
+  TEST_CASE("unknown_members") {
+    auto value = Parse<StructWithFreeShuttle>(
+      R"({"z":{"a":[1,{"b":"}"}]},"a":"q","b":-3,"y":null,"c":1e2})");
+    REQUIRE((value == StructWithFreeShuttle{'q', -3, 100}));
+  }
+
+  TEST_CASE("missing_member") {
+    REQUIRE_THROWS_AS(Parse<StructWithFreeShuttle>(R"({"a":"x","c":1})"),
+      SerializationException);
+  }
+
+  TEST_CASE("escapes") {
+    REQUIRE(Parse<std::string>(R"("a\"b\\c\né😀")") ==
+      "a\"b\\c\n\xC3\xA9\xF0\x9F\x98\x80");
+    REQUIRE_THROWS_AS(Parse<std::string>(R"("abc)"), SerializationException);
+  }
+
+  TEST_CASE("integers") {
+    REQUIRE(Parse<std::int64_t>("9007199254740993") == 9007199254740993);
+    REQUIRE(Parse<int>("2.0") == 2);
+    REQUIRE(Parse<int>("-3e2") == -300);
+    REQUIRE(Parse<std::uint8_t>("2.55e2") == 255);
+    REQUIRE_THROWS_AS(Parse<int>("\"1\""), SerializationException);
+    REQUIRE_THROWS_AS(Parse<int>("2.5"), SerializationException);
+    REQUIRE_THROWS_AS(Parse<int>("1e-3"), SerializationException);
+    REQUIRE_THROWS_AS(Parse<int>("3e9"), SerializationException);
+    REQUIRE_THROWS_AS(Parse<std::uint8_t>("2.56e2"), SerializationException);
+    REQUIRE_THROWS_AS(Parse<std::uint32_t>("-1.0"), SerializationException);
+    REQUIRE_THROWS_AS(Parse<std::int64_t>("9.3e18"), SerializationException);
+    REQUIRE_THROWS_AS(Parse<std::int64_t>("1e400"), SerializationException);
+  }
+
+  TEST_CASE("nested_sequences") {
+    auto value = Parse<std::vector<std::vector<int>>>(
+      "[[1, 2], [], [3]]");
+    REQUIRE((value == std::vector<std::vector<int>>{{1, 2}, {}, {3}}));
+  }
+
+  TEST_CASE("round_trip") {
+    auto values = std::vector<StructWithFreeShuttle>{{'a', 1, 0.1},
+      {'"', -2, 1e300}, {'\x01', 3, -0.0}};
+    auto buffer = SharedBuffer();
+    auto sender = JsonSender<SharedBuffer>();
+    sender.SetSink(Ref(buffer));
+    sender.Send(values);
+    auto receiver = JsonReceiver<SharedBuffer>();
+    receiver.SetSource(Ref(buffer));
+    auto received = std::vector<StructWithFreeShuttle>();
+    receiver.Shuttle(received);
+    REQUIRE(received == values);
+  }
+}
@@ -84,4 +84,12 @@ TEST_SUITE("AuthenticationServletAdapter") {
     authenticator(*m_clientProtocol);
     m_clientProtocol->SendRequest<VoidService>(123);
   }
+
+  TEST_CASE_FIXTURE(Fixture, "negotiate_capabilities") {
+    auto authenticator = SessionAuthenticator(Ref(*m_serviceLocatorClient),
+      COMPACT_BINARY_CAPABILITY | 1);
+    authenticator(*m_clientProtocol);
+    m_clientProtocol->SendRequest<VoidService>(123);
+    REQUIRE(m_clientProtocol->SendRequest<SendCapabilitiesService>(1) == 1);
+  }
 }
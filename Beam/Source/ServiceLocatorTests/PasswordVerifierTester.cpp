@@ -0,0 +1,93 @@
+#include <doctest/doctest.h>
+#include "Beam/Routines/RoutineHandlerGroup.hpp"
+#include "Beam/ServiceLocator/PasswordVerifier.hpp"
+
+using namespace Beam;
+using namespace Beam::Routines;
+using namespace Beam::ServiceLocator;
+using namespace Beam::Services;
+using namespace boost::posix_time;
+
+namespace {
+  auto MakeSettings() {
+    auto settings = PasswordVerifier::Settings();
+    settings.m_threadCount = 2;
+    settings.m_maxPendingCount = 16;
+    settings.m_cacheDuration = minutes(1);
+    settings.m_maxCacheSize = 2;
+    return settings;
+  }
+}
+
+TEST_SUITE("PasswordVerifier") {
+  TEST_CASE("validate") {
+    auto verifier = PasswordVerifier(MakeSettings());
+    auto account = DirectoryEntry::MakeAccount(5, "user");
+    auto storedPassword = verifier.Hash(account, "password");
+    REQUIRE(verifier.Validate(account, "password", storedPassword));
+    REQUIRE(!verifier.Validate(account, "1234", storedPassword));
+    auto statistics = verifier.GetStatistics();
+    REQUIRE(statistics.m_validations == 2);
+    REQUIRE(statistics.m_hashes == 3);
+    REQUIRE(statistics.m_cacheHits == 0);
+    REQUIRE(statistics.m_pendingCount == 0);
+  }
+
+  TEST_CASE("cache") {
+    auto verifier = PasswordVerifier(MakeSettings());
+    auto account = DirectoryEntry::MakeAccount(5, "user");
+    auto storedPassword = verifier.Hash(account, "password");
+    REQUIRE(verifier.Validate(account, "password", storedPassword));
+    REQUIRE(verifier.Validate(account, "password", storedPassword));
+    REQUIRE(verifier.GetStatistics().m_cacheHits == 1);
+    REQUIRE(!verifier.Validate(account, "1234", storedPassword));
+    REQUIRE(!verifier.Validate(account, "1234", storedPassword));
+    REQUIRE(verifier.GetStatistics().m_cacheHits == 1);
+    auto changedPassword = verifier.Hash(account, "password");
+    REQUIRE(verifier.Validate(account, "password", changedPassword));
+    REQUIRE(verifier.GetStatistics().m_cacheHits == 1);
+    verifier.Invalidate(account);
+    REQUIRE(verifier.Validate(account, "password", changedPassword));
+    REQUIRE(verifier.GetStatistics().m_cacheHits == 1);
+  }
+
+  TEST_CASE("cache_expiry") {
+    auto settings = MakeSettings();
+    settings.m_cacheDuration = seconds(0);
+    auto verifier = PasswordVerifier(settings);
+    auto account = DirectoryEntry::MakeAccount(5, "user");
+    auto storedPassword = verifier.Hash(account, "password");
+    REQUIRE(verifier.Validate(account, "password", storedPassword));
+    REQUIRE(verifier.Validate(account, "password", storedPassword));
+    REQUIRE(verifier.GetStatistics().m_cacheHits == 0);
+  }
+
+  TEST_CASE("admission_control") {
+    auto settings = MakeSettings();
+    settings.m_threadCount = 1;
+    settings.m_maxPendingCount = 2;
+    auto verifier = PasswordVerifier(settings);
+    auto account = DirectoryEntry::MakeAccount(5, "user");
+    auto storedPassword = verifier.Hash(account, "password");
+    auto rejections = 0;
+    {
+      auto routines = RoutineHandlerGroup();
+      for(auto i = 0; i < 8; ++i) {
+        routines.Spawn(
+          [&, i] {
+            auto user = DirectoryEntry::MakeAccount(100 + i, "user");
+            try {
+              verifier.Validate(user, "password", storedPassword);
+            } catch(const ServiceRequestException&) {
+              ++rejections;
+            }
+          });
+      }
+    }
+    auto statistics = verifier.GetStatistics();
+    REQUIRE(rejections > 0);
+    REQUIRE(statistics.m_rejections == rejections);
+    REQUIRE(statistics.m_maxPendingCount <= 2);
+    REQUIRE(statistics.m_pendingCount == 0);
+  }
+}
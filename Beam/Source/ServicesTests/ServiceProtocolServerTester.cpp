@@ -1,4 +1,7 @@
+#include <atomic>
+#include <vector>
 #include <boost/functional/factory.hpp>
+#include <boost/thread/thread.hpp>
 #include <boost/optional.hpp>
 #include <doctest/doctest.h>
 #include "Beam/Codecs/NullDecoder.hpp"
@@ -6,6 +9,7 @@
 #include "Beam/IO/LocalClientChannel.hpp"
 #include "Beam/IO/LocalServerConnection.hpp"
 #include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Routines/Async.hpp"
 #include "Beam/Routines/RoutineHandler.hpp"
 #include "Beam/ServicesTests/TestServices.hpp"
 #include "Beam/Serialization/BinaryReceiver.hpp"
@@ -33,6 +37,9 @@ namespace {
   using TestServiceProtocolServer = ServiceProtocolServer<
     std::unique_ptr<TestServerConnection>, BinarySender<SharedBuffer>,
     NullEncoder, std::shared_ptr<TriggerTimer>>;
+  using ParallelServiceProtocolServer = ServiceProtocolServer<
+    std::unique_ptr<TestServerConnection>, BinarySender<SharedBuffer>,
+    NullEncoder, std::shared_ptr<TriggerTimer>, NullType, true>;
   using ClientServiceProtocolClient = ServiceProtocolClient<
     MessageProtocol<TestClientChannel, BinarySender<SharedBuffer>, NullEncoder>,
     TriggerTimer>;
@@ -78,4 +85,51 @@ TEST_SUITE("ServiceProtocolServer") {
       }));
     task.Wait();
   }
+
+  TEST_CASE("max_parallel_messages") {
+    const auto REQUEST_COUNT = 4;
+    auto serverConnection = std::make_unique<TestServerConnection>();
+    auto client = ClientServiceProtocolClient(Initialize(std::string("test"),
+      Ref(*serverConnection)), Initialize());
+    RegisterTestServices(Store(client.GetSlots()));
+    auto server = ParallelServiceProtocolServer(std::move(serverConnection),
+      factory<std::shared_ptr<TriggerTimer>>(), NullSlot(), NullSlot(), 2);
+    RegisterTestServices(Store(server.GetSlots()));
+    auto activeCount = std::atomic<int>(0);
+    auto peakCount = std::atomic<int>(0);
+    auto isReleased = Async<void>();
+    IdentityService::AddSlot(Store(server.GetSlots()),
+      [&] (ParallelServiceProtocolServer::ServiceProtocolClient& client,
+          int n) {
+        auto count = ++activeCount;
+        auto peak = peakCount.load();
+        while(count > peak && !peakCount.compare_exchange_weak(peak, count)) {}
+        isReleased.Get();
+        --activeCount;
+        return n;
+      });
+    server.Open();
+    client.Open();
+    auto results = std::vector<int>(REQUEST_COUNT, -1);
+    auto requests = std::vector<RoutineHandler>();
+    for(auto i = 0; i < REQUEST_COUNT; ++i) {
+      requests.emplace_back(Spawn(
+        [&, i] {
+          results[i] = client.SendRequest<IdentityService>(i);
+        }));
+    }
+    while(activeCount != 2) {
+      this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    this_thread::sleep_for(chrono::milliseconds(20));
+    REQUIRE(activeCount == 2);
+    isReleased.GetEval().SetResult();
+    requests.clear();
+    REQUIRE(peakCount == 2);
+    for(auto i = 0; i < REQUEST_COUNT; ++i) {
+      REQUIRE(results[i] == i);
+    }
+    client.Close();
+    server.Close();
+  }
 }
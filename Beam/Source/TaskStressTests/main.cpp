@@ -0,0 +1,85 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Queues/RoutineTaskQueue.hpp"
+#include "Beam/Queues/TaskQueue.hpp"
+#include "Beam/Routines/RoutineHandler.hpp"
+
+using namespace Beam;
+using namespace Beam::IO;
+using namespace Beam::Routines;
+
+namespace {
+  const auto TASK_COUNT = 1000000;
+  std::atomic<std::uint64_t> allocationCount(0);
+
+  void Report(const std::string& name, std::chrono::steady_clock::duration
+      duration, std::uint64_t allocations) {
+    auto seconds = std::chrono::duration<double>(duration).count();
+    std::cout << name << ": " <<
+      static_cast<std::uint64_t>(TASK_COUNT / seconds) << " tasks/s, " <<
+      static_cast<double>(allocations) / TASK_COUNT << " allocations/task" <<
+      std::endl;
+  }
+
+  template<typename F>
+  void Measure(const std::string& name, F&& f) {
+    auto allocations = allocationCount.load();
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto duration = std::chrono::steady_clock::now() - start;
+    Report(name, duration, allocationCount.load() - allocations);
+  }
+}
+
+void* operator new(std::size_t size) {
+  ++allocationCount;
+  if(auto p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+
+int main() {
+  auto buffer = SharedBuffer("0123456789abcdef", 16);
+  auto written = std::size_t(0);
+  Measure("TaskQueue",
+    [&] {
+      auto tasks = TaskQueue();
+      auto routine = RoutineHandler(SpawnTaskRoutine(&tasks));
+      for(auto i = 0; i < TASK_COUNT; ++i) {
+        tasks.Push(
+          [&written, buffer] {
+            written += buffer.GetSize();
+          });
+      }
+      tasks.Break();
+      routine.Wait();
+    });
+  Measure("RoutineTaskQueue",
+    [&] {
+      auto tasks = RoutineTaskQueue();
+      for(auto i = 0; i < TASK_COUNT; ++i) {
+        tasks.Push(
+          [&written, buffer] {
+            written += buffer.GetSize();
+          });
+      }
+      tasks.Break();
+      tasks.Wait();
+    });
+  return written == 2 * TASK_COUNT * buffer.GetSize() ? 0 : 1;
+}
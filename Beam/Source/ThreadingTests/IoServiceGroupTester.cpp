@@ -0,0 +1,115 @@
+#include <set>
+#include <vector>
+#include <boost/thread/thread.hpp>
+#include <doctest/doctest.h>
+#include "Beam/Routines/RoutineHandler.hpp"
+#include "Beam/Threading/IoServiceGroup.hpp"
+
+using namespace Beam;
+using namespace Beam::Routines;
+using namespace Beam::Threading;
+
+namespace {
+  boost::thread::id GetRunningThread(boost::asio::io_service& service) {
+    auto result = Async<boost::thread::id>();
+    auto eval = result.GetEval();
+    service.post(
+      [&] {
+        eval.SetResult(boost::this_thread::get_id());
+      });
+    return result.Get();
+  }
+}
+
+TEST_SUITE("IoServiceGroup") {
+  TEST_CASE("shared") {
+    auto group = IoServiceGroup(4, IoServiceGroup::Assignment::SHARED, false);
+    REQUIRE(group.GetServiceCount() == 1);
+    auto service = group.Acquire();
+    REQUIRE(service.get() == &group.GetService(0));
+    REQUIRE(group.GetLoad(0) == 1);
+    service.reset();
+    REQUIRE(group.GetLoad(0) == 0);
+  }
+
+  TEST_CASE("round_robin") {
+    auto group = IoServiceGroup(4, IoServiceGroup::Assignment::ROUND_ROBIN,
+      false);
+    REQUIRE(group.GetServiceCount() == 4);
+    auto services = std::vector<std::shared_ptr<boost::asio::io_service>>();
+    for(auto i = 0; i < 8; ++i) {
+      services.push_back(group.Acquire());
+    }
+    for(auto i = 0; i < 4; ++i) {
+      REQUIRE(group.GetLoad(i) == 2);
+    }
+    services.clear();
+    for(auto i = 0; i < 4; ++i) {
+      REQUIRE(group.GetLoad(i) == 0);
+    }
+  }
+
+  TEST_CASE("least_loaded") {
+    auto group = IoServiceGroup(3, IoServiceGroup::Assignment::LEAST_LOADED,
+      false);
+    auto first = group.Acquire(0);
+    auto second = group.Acquire(0);
+    auto third = group.Acquire(1);
+    auto fourth = group.Acquire();
+    REQUIRE(fourth.get() == &group.GetService(2));
+    auto fifth = group.Acquire();
+    auto sixth = group.Acquire();
+    REQUIRE(fifth.get() != &group.GetService(0));
+    REQUIRE(sixth.get() != &group.GetService(0));
+    REQUIRE(fifth != sixth);
+    REQUIRE(group.GetLoad(0) == 2);
+    REQUIRE(group.GetLoad(1) == 2);
+    REQUIRE(group.GetLoad(2) == 2);
+  }
+
+  TEST_CASE("thread_per_shard") {
+    auto group = IoServiceGroup(3, IoServiceGroup::Assignment::ROUND_ROBIN,
+      true);
+    auto threads = std::set<boost::thread::id>();
+    for(auto i = 0; i < 3; ++i) {
+      auto thread = GetRunningThread(group.GetService(i));
+      for(auto j = 0; j < 10; ++j) {
+        REQUIRE(GetRunningThread(group.GetService(i)) == thread);
+      }
+      threads.insert(thread);
+    }
+    REQUIRE(threads.size() == 3);
+  }
+
+  TEST_CASE("routine") {
+    auto group = IoServiceGroup(2, IoServiceGroup::Assignment::ROUTINE,
+      false);
+    auto threadCount = static_cast<std::size_t>(
+      boost::thread::hardware_concurrency());
+    for(auto i = std::size_t(0); i < threadCount; ++i) {
+      auto selections = std::vector<std::size_t>();
+      Wait(Spawn(
+        [&] {
+          selections.push_back(group.Select());
+          selections.push_back(group.Select());
+        }, Routines::Details::Scheduler::DEFAULT_STACK_SIZE, i));
+      REQUIRE((selections ==
+        std::vector<std::size_t>{2 * i / threadCount, 2 * i / threadCount}));
+    }
+  }
+
+  TEST_CASE("routine_per_context") {
+    auto threadCount = static_cast<std::size_t>(
+      boost::thread::hardware_concurrency());
+    auto group = IoServiceGroup(threadCount,
+      IoServiceGroup::Assignment::ROUTINE, false);
+    for(auto i = std::size_t(0); i < threadCount; ++i) {
+      auto selection = std::size_t();
+      Wait(Spawn(
+        [&] {
+          selection = group.Select();
+        }, Routines::Details::Scheduler::DEFAULT_STACK_SIZE, i));
+      REQUIRE(selection == i);
+    }
+  }
+}
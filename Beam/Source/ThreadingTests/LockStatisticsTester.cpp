@@ -0,0 +1,38 @@
+#include <chrono>
+#include <doctest/doctest.h>
+#include "Beam/Threading/LockStatistics.hpp"
+
+using namespace Beam;
+using namespace Beam::Threading;
+
+TEST_SUITE("LatencyHistogram") {
+  TEST_CASE("buckets") {
+    auto histogram = LatencyHistogram();
+    REQUIRE(histogram.GetCount() == 0);
+    histogram.Record(std::chrono::nanoseconds(0));
+    histogram.Record(std::chrono::nanoseconds(1));
+    histogram.Record(std::chrono::nanoseconds(3));
+    histogram.Record(std::chrono::nanoseconds(4));
+    histogram.Record(std::chrono::hours(24 * 365));
+    REQUIRE(histogram.GetCount() == 5);
+    REQUIRE(histogram.GetCount(0) == 1);
+    REQUIRE(histogram.GetCount(1) == 1);
+    REQUIRE(histogram.GetCount(2) == 1);
+    REQUIRE(histogram.GetCount(3) == 1);
+    REQUIRE(histogram.GetCount(LatencyHistogram::BUCKET_COUNT - 1) == 1);
+  }
+
+  TEST_CASE("percentile") {
+    auto histogram = LatencyHistogram();
+    REQUIRE(histogram.GetPercentile(50) == std::chrono::nanoseconds(0));
+    for(auto i = 0; i < 99; ++i) {
+      histogram.Record(std::chrono::nanoseconds(100));
+    }
+    histogram.Record(std::chrono::microseconds(100));
+    REQUIRE(histogram.GetPercentile(50) == std::chrono::nanoseconds(128));
+    REQUIRE(histogram.GetPercentile(100) ==
+      std::chrono::nanoseconds(131072));
+    histogram.Reset();
+    REQUIRE(histogram.GetCount() == 0);
+  }
+}
@@ -0,0 +1,55 @@
+#include <vector>
+#include <boost/thread/locks.hpp>
+#include <doctest/doctest.h>
+#include "Beam/Routines/RoutineHandler.hpp"
+#include "Beam/Threading/Mutex.hpp"
+
+using namespace Beam;
+using namespace Beam::Routines;
+using namespace Beam::Threading;
+
+TEST_SUITE("Mutex") {
+  TEST_CASE("try_lock") {
+    auto mutex = Mutex();
+    REQUIRE(mutex.try_lock());
+    REQUIRE(!mutex.try_lock());
+    mutex.unlock();
+    REQUIRE(mutex.try_lock());
+    mutex.unlock();
+  }
+
+  TEST_CASE("contention") {
+    const auto ROUTINE_COUNT = 16;
+    const auto ITERATIONS = 10000;
+    auto mutex = Mutex();
+    auto value = 0;
+    auto routines = std::vector<RoutineHandler>();
+    for(auto i = 0; i < ROUTINE_COUNT; ++i) {
+      routines.emplace_back(Spawn(
+        [&] {
+          for(auto j = 0; j < ITERATIONS; ++j) {
+            auto lock = boost::lock_guard<Mutex>(mutex);
+            ++value;
+          }
+        }));
+    }
+    routines.clear();
+    REQUIRE(value == ROUTINE_COUNT * ITERATIONS);
+  }
+
+  TEST_CASE("suspended_holder") {
+    auto mutex = Mutex();
+    auto value = 0;
+    auto routines = std::vector<RoutineHandler>();
+    for(auto i = 0; i < 8; ++i) {
+      routines.emplace_back(Spawn(
+        [&] {
+          auto lock = boost::lock_guard<Mutex>(mutex);
+          Defer();
+          ++value;
+        }, Routines::Details::Scheduler::DEFAULT_STACK_SIZE, 0));
+    }
+    routines.clear();
+    REQUIRE(value == 8);
+  }
+}
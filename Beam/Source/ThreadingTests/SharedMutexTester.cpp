@@ -0,0 +1,120 @@
+#include <atomic>
+#include <vector>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_lock_guard.hpp>
+#include <boost/thread/thread.hpp>
+#include <doctest/doctest.h>
+#include "Beam/Routines/RoutineHandler.hpp"
+#include "Beam/Threading/SharedMutex.hpp"
+
+using namespace Beam;
+using namespace Beam::Routines;
+using namespace Beam::Threading;
+
+namespace {
+  void WaitForQueuedWriter(SharedMutex& mutex) {
+    while(mutex.try_lock_shared()) {
+      mutex.unlock_shared();
+      boost::this_thread::yield();
+    }
+  }
+}
+
+TEST_SUITE("SharedMutex") {
+  TEST_CASE("shared_readers") {
+    auto mutex = SharedMutex();
+    mutex.lock_shared();
+    REQUIRE(mutex.try_lock_shared());
+    REQUIRE(!mutex.try_lock());
+    mutex.unlock_shared();
+    mutex.unlock_shared();
+    REQUIRE(mutex.try_lock());
+    REQUIRE(!mutex.try_lock_shared());
+    mutex.unlock();
+  }
+
+  TEST_CASE("exclusive_writers") {
+    const auto ROUTINE_COUNT = 16;
+    const auto ITERATIONS = 1000;
+    auto mutex = SharedMutex();
+    auto value = 0;
+    auto mirror = 0;
+    auto isConsistent = std::atomic<bool>(true);
+    auto routines = std::vector<RoutineHandler>();
+    for(auto i = 0; i < ROUTINE_COUNT; ++i) {
+      routines.emplace_back(Spawn(
+        [&, i] {
+          for(auto j = 0; j < ITERATIONS; ++j) {
+            if(i % 2 == 0) {
+              auto lock = boost::lock_guard<SharedMutex>(mutex);
+              ++value;
+              ++mirror;
+            } else {
+              auto lock = boost::shared_lock_guard<SharedMutex>(mutex);
+              if(value != mirror) {
+                isConsistent = false;
+              }
+            }
+          }
+        }));
+    }
+    routines.clear();
+    REQUIRE(isConsistent);
+    REQUIRE(value == ROUTINE_COUNT / 2 * ITERATIONS);
+  }
+
+  TEST_CASE("prefer_writers") {
+    auto mutex = SharedMutex(SharedMutex::Preference::WRITERS);
+    mutex.lock_shared();
+    auto isWriting = std::atomic<bool>(false);
+    auto writer = RoutineHandler(Spawn(
+      [&] {
+        auto lock = boost::lock_guard<SharedMutex>(mutex);
+        isWriting = true;
+      }));
+    WaitForQueuedWriter(mutex);
+    REQUIRE(!isWriting);
+    mutex.unlock_shared();
+    writer.Wait();
+    REQUIRE(isWriting);
+    REQUIRE(mutex.try_lock_shared());
+    mutex.unlock_shared();
+  }
+
+  TEST_CASE("prefer_readers") {
+    auto mutex = SharedMutex(SharedMutex::Preference::READERS);
+    mutex.lock_shared();
+    auto isWriting = std::atomic<bool>(false);
+    auto writer = RoutineHandler(Spawn(
+      [&] {
+        auto lock = boost::lock_guard<SharedMutex>(mutex);
+        isWriting = true;
+      }));
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+    REQUIRE(mutex.try_lock_shared());
+    mutex.unlock_shared();
+    REQUIRE(!isWriting);
+    mutex.unlock_shared();
+    writer.Wait();
+    REQUIRE(isWriting);
+  }
+
+  TEST_CASE("writer_releases_readers") {
+    auto mutex = SharedMutex();
+    mutex.lock();
+    auto readCount = std::atomic<int>(0);
+    auto readers = std::vector<RoutineHandler>();
+    for(auto i = 0; i < 4; ++i) {
+      readers.emplace_back(Spawn(
+        [&] {
+          auto lock = boost::shared_lock_guard<SharedMutex>(mutex);
+          ++readCount;
+        }));
+    }
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+    REQUIRE(readCount == 0);
+    mutex.unlock();
+    readers.clear();
+    REQUIRE(readCount == 4);
+  }
+}
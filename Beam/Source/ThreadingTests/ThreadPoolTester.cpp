@@ -0,0 +1,129 @@
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <doctest/doctest.h>
+#include "Beam/Routines/RoutineHandler.hpp"
+#include "Beam/Threading/ThreadPool.hpp"
+
+using namespace Beam;
+using namespace Beam::Routines;
+using namespace Beam::Threading;
+
+TEST_SUITE("ThreadPool") {
+  TEST_CASE("result") {
+    auto threadPool = ThreadPool();
+    auto result = Async<int>();
+    threadPool.Queue(
+      [] {
+        return 123;
+      }, result.GetEval());
+    REQUIRE(result.Get() == 123);
+  }
+
+  TEST_CASE("exception") {
+    auto threadPool = ThreadPool();
+    auto result = Async<void>();
+    threadPool.Queue(
+      [] {
+        throw std::runtime_error("failure");
+      }, result.GetEval());
+    REQUIRE_THROWS_AS(result.Get(), std::runtime_error);
+  }
+
+  TEST_CASE("priority") {
+    auto threadPool = ThreadPool(1, 1);
+    auto release = std::promise<void>();
+    auto started = std::promise<void>();
+    threadPool.Queue(
+      [&, isReleased = release.get_future()] {
+        started.set_value();
+        isReleased.wait();
+      }, Eval<void>());
+    started.get_future().wait();
+    auto order = std::vector<ThreadPool::Priority>();
+    auto push = [&] (ThreadPool::Priority priority) {
+      threadPool.Queue(
+        [&, priority] {
+          order.push_back(priority);
+        }, Eval<void>(), priority);
+    };
+    push(ThreadPool::Priority::LOW);
+    push(ThreadPool::Priority::NORMAL);
+    push(ThreadPool::Priority::HIGH);
+    push(ThreadPool::Priority::LOW);
+    push(ThreadPool::Priority::HIGH);
+    auto metrics = threadPool.GetMetrics();
+    REQUIRE(metrics.m_threadCount == 1);
+    REQUIRE(metrics.m_queueDepths[0] == 2);
+    REQUIRE(metrics.m_queueDepths[1] == 1);
+    REQUIRE(metrics.m_queueDepths[2] == 2);
+    release.set_value();
+    threadPool.WaitForCompletion();
+    REQUIRE((order == std::vector<ThreadPool::Priority>{
+      ThreadPool::Priority::HIGH, ThreadPool::Priority::HIGH,
+      ThreadPool::Priority::NORMAL, ThreadPool::Priority::LOW,
+      ThreadPool::Priority::LOW}));
+    metrics = threadPool.GetMetrics();
+    REQUIRE(metrics.m_queueDepths[0] == 0);
+    REQUIRE(metrics.m_taskCounts[0] == 2);
+    REQUIRE(metrics.m_taskCounts[1] == 2);
+    REQUIRE(metrics.m_taskCounts[2] == 2);
+    REQUIRE(metrics.m_maxWaitTimes[2] > boost::posix_time::seconds(0));
+  }
+
+  TEST_CASE("max_threads") {
+    const auto THREAD_COUNT = 4;
+    auto threadPool = ThreadPool(THREAD_COUNT);
+    auto running = std::atomic<int>(0);
+    auto peak = std::atomic<int>(0);
+    for(auto i = 0; i < 100; ++i) {
+      threadPool.Queue(
+        [&] {
+          auto count = ++running;
+          auto currentPeak = peak.load();
+          while(count > currentPeak &&
+              !peak.compare_exchange_weak(currentPeak, count)) {}
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          --running;
+        }, Eval<void>());
+    }
+    threadPool.WaitForCompletion();
+    REQUIRE(peak.load() > 1);
+    REQUIRE(peak.load() <= THREAD_COUNT);
+    REQUIRE(threadPool.GetMetrics().m_threadCount <= THREAD_COUNT);
+  }
+
+  TEST_CASE("nested") {
+    const auto TASK_COUNT = 1000;
+    auto threadPool = ThreadPool(4, 4);
+    auto count = std::atomic<int>(0);
+    threadPool.Queue(
+      [&] {
+        for(auto i = 0; i < TASK_COUNT; ++i) {
+          threadPool.Queue(
+            [&] {
+              ++count;
+            }, Eval<void>());
+        }
+      }, Eval<void>());
+    threadPool.WaitForCompletion();
+    REQUIRE(count.load() == TASK_COUNT);
+  }
+
+  TEST_CASE("destructor_drains") {
+    auto count = std::atomic<int>(0);
+    {
+      auto threadPool = ThreadPool(2);
+      for(auto i = 0; i < 100; ++i) {
+        threadPool.Queue(
+          [&] {
+            ++count;
+          }, Eval<void>());
+      }
+    }
+    REQUIRE(count.load() == 100);
+  }
+}
@@ -0,0 +1,112 @@
+#include <atomic>
+#include <thread>
+#include <doctest/doctest.h>
+#include "Beam/TimeService/LocalTimeClient.hpp"
+#include "Beam/TimeService/TimeOrigin.hpp"
+
+using namespace Beam;
+using namespace Beam::TimeService;
+using namespace boost::gregorian;
+using namespace boost::posix_time;
+
+namespace {
+  const auto BASE = ptime(date(2020, 4, 1), hours(12));
+  const auto SECOND = std::int64_t(1000000000);
+}
+
+TEST_SUITE("TimeOrigin") {
+  TEST_CASE("unset") {
+    auto origin = TimeOrigin();
+    REQUIRE(origin.GetTime().is_not_a_date_time());
+  }
+
+  TEST_CASE("set") {
+    auto origin = TimeOrigin();
+    origin.Set(BASE, 5 * SECOND);
+    REQUIRE(origin.GetTime(5 * SECOND) == BASE);
+    REQUIRE(origin.GetTime(5 * SECOND + 1500) ==
+      BASE + microseconds(1));
+    REQUIRE(origin.GetTime(7 * SECOND) == BASE + seconds(2));
+  }
+
+  TEST_CASE("slew") {
+    auto origin = TimeOrigin();
+    origin.Synchronize(BASE, 0);
+    origin.Synchronize(BASE + seconds(10) + milliseconds(5), 10 * SECOND);
+    REQUIRE(origin.GetTime(10 * SECOND) == BASE + seconds(10));
+    auto slewPeriod =
+      static_cast<std::int64_t>(5E6 / TimeOrigin::MAX_SLEW_RATE);
+    auto previous = origin.GetTime(10 * SECOND);
+    for(auto clock = 10 * SECOND; clock < 10 * SECOND + slewPeriod;
+        clock += SECOND) {
+      auto time = origin.GetTime(clock);
+      REQUIRE(time >= previous);
+      REQUIRE(time - previous <= seconds(1) + microseconds(501));
+      previous = time;
+    }
+    REQUIRE(origin.GetTime(10 * SECOND + slewPeriod) ==
+      BASE + seconds(10) + milliseconds(5) + microseconds(slewPeriod / 1000));
+    REQUIRE(origin.GetTime(10 * SECOND + slewPeriod + SECOND) ==
+      BASE + seconds(11) + milliseconds(5) + microseconds(slewPeriod / 1000));
+  }
+
+  TEST_CASE("slew_backward") {
+    auto origin = TimeOrigin();
+    origin.Synchronize(BASE, 0);
+    origin.Synchronize(BASE + seconds(1) - milliseconds(1), SECOND);
+    auto previous = origin.GetTime(SECOND);
+    for(auto clock = SECOND; clock < 5 * SECOND; clock += SECOND / 100) {
+      auto time = origin.GetTime(clock);
+      REQUIRE(time >= previous);
+      previous = time;
+    }
+    REQUIRE(origin.GetTime(SECOND + 2 * SECOND) ==
+      BASE + seconds(3) - milliseconds(1));
+  }
+
+  TEST_CASE("step") {
+    auto origin = TimeOrigin();
+    origin.Synchronize(BASE, 0);
+    origin.Synchronize(BASE + seconds(3), SECOND);
+    REQUIRE(origin.GetTime(SECOND) == BASE + seconds(3));
+    origin.Synchronize(BASE - hours(1), 2 * SECOND);
+    REQUIRE(origin.GetTime(2 * SECOND) == BASE - hours(1));
+  }
+
+  TEST_CASE("concurrent_reads") {
+    auto origin = TimeOrigin();
+    origin.Set(BASE, 0);
+    auto isRunning = std::atomic_bool(true);
+    auto isConsistent = true;
+    auto reader = std::thread(
+      [&] {
+        while(isRunning) {
+          auto time = origin.GetTime(SECOND);
+          if(time < BASE + seconds(1) ||
+              time > BASE + seconds(1) + microseconds(100)) {
+            isConsistent = false;
+          }
+        }
+      });
+    for(auto i = 0; i < 100000; ++i) {
+      origin.Synchronize(BASE + seconds(1) + microseconds(i % 100), SECOND);
+    }
+    isRunning = false;
+    reader.join();
+    REQUIRE(isConsistent);
+  }
+
+  TEST_CASE("tsc_clock") {
+    auto clock = MonotonicClock(MonotonicClock::Source::TSC);
+    auto previous = clock.GetNanoseconds();
+    for(auto i = 0; i < 1000; ++i) {
+      auto current = clock.GetNanoseconds();
+      REQUIRE(current >= previous);
+      previous = current;
+    }
+    auto client = LocalTimeClient(MonotonicClock::Source::TSC);
+    auto difference = client.GetTime() - microsec_clock::universal_time();
+    REQUIRE(difference < milliseconds(10));
+    REQUIRE(difference > -milliseconds(10));
+  }
+}
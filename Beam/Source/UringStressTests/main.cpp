@@ -0,0 +1,135 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Beam/IO/EndOfFileException.hpp"
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Network/SocketThreadPool.hpp"
+#include "Beam/Network/TcpServerSocket.hpp"
+#include "Beam/Network/TcpSocketChannel.hpp"
+#include "Beam/Network/UringTcpServerSocket.hpp"
+#include "Beam/Network/UringTcpSocketChannel.hpp"
+#include "Beam/Routines/RoutineHandler.hpp"
+
+using namespace Beam;
+using namespace Beam::IO;
+using namespace Beam::Network;
+using namespace Beam::Routines;
+
+namespace {
+  const auto SERVER_ADDRESS = IpAddress("127.0.0.1", 42141);
+  const auto URING_SERVER_ADDRESS = IpAddress("127.0.0.1", 42142);
+  const auto ROUND_TRIP_COUNT = 100000;
+  const auto MESSAGE_SIZE = std::size_t(64);
+  const auto STREAM_SIZE = std::size_t(1) << 30;
+  const auto CHUNK_SIZE = std::size_t(64 * 1024);
+
+  // The default 8 KB send buffer stalls on delayed acknowledgements over
+  // loopback and hides the cost of the channel itself.
+  const auto STREAM_WRITE_BUFFER_SIZE = 1024 * 1024;
+
+  //! Echoes every message received on a connection back to its sender.
+  template<typename ServerSocket>
+  RoutineHandler SpawnEcho(ServerSocket& server) {
+    return Spawn(
+      [&server] {
+        auto channel = server.Accept();
+        auto buffer = SharedBuffer();
+        try {
+          while(true) {
+            buffer.Reset();
+            channel->GetReader().Read(Store(buffer));
+            channel->GetWriter().Write(buffer);
+          }
+        } catch(const EndOfFileException&) {}
+      });
+  }
+
+  //! Reads and discards everything received on a connection.
+  template<typename ServerSocket>
+  RoutineHandler SpawnSink(ServerSocket& server) {
+    return Spawn(
+      [&server] {
+        auto channel = server.Accept();
+        auto buffer = SharedBuffer();
+        try {
+          while(true) {
+            buffer.Reset();
+            channel->GetReader().Read(Store(buffer), CHUNK_SIZE);
+          }
+        } catch(const EndOfFileException&) {}
+      });
+  }
+
+  template<typename ServerSocket, typename Channel>
+  void MeasureRoundTrips(const std::string& name, ServerSocket& server,
+      std::unique_ptr<Channel> channel) {
+    auto echo = SpawnEcho(server);
+    channel->GetConnection().Open();
+    auto message = SharedBuffer(std::string(MESSAGE_SIZE, 'x').c_str(),
+      MESSAGE_SIZE);
+    auto reply = SharedBuffer();
+    auto start = std::chrono::steady_clock::now();
+    for(auto i = 0; i < ROUND_TRIP_COUNT; ++i) {
+      channel->GetWriter().Write(message);
+      reply.Reset();
+      while(reply.GetSize() < MESSAGE_SIZE) {
+        channel->GetReader().Read(Store(reply));
+      }
+    }
+    auto duration = std::chrono::steady_clock::now() - start;
+    channel->GetConnection().Close();
+    echo.Wait();
+    auto microseconds = std::chrono::duration<double, std::micro>(
+      duration).count();
+    std::cout << name << " round trip: " << microseconds / ROUND_TRIP_COUNT <<
+      " us" << std::endl;
+  }
+
+  template<typename ServerSocket, typename Channel>
+  void MeasureThroughput(const std::string& name, ServerSocket& server,
+      std::unique_ptr<Channel> channel) {
+    auto sink = SpawnSink(server);
+    channel->GetConnection().SetWriteBufferSize(STREAM_WRITE_BUFFER_SIZE);
+    channel->GetConnection().Open();
+    auto chunk = SharedBuffer(std::vector<char>(CHUNK_SIZE, 'x').data(),
+      CHUNK_SIZE);
+    auto start = std::chrono::steady_clock::now();
+    for(auto written = std::size_t(0); written < STREAM_SIZE;
+        written += CHUNK_SIZE) {
+      channel->GetWriter().Write(chunk);
+    }
+    channel->GetConnection().Close();
+    sink.Wait();
+    auto seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+    std::cout << name << " throughput: " <<
+      STREAM_SIZE / seconds / (1024 * 1024) << " MB/s" << std::endl;
+  }
+}
+
+int main() {
+  auto socketThreadPool = SocketThreadPool(1);
+  auto context = UringContext();
+  auto server = TcpServerSocket(SERVER_ADDRESS, Ref(socketThreadPool));
+  server.Open();
+  auto uringServer = UringTcpServerSocket(URING_SERVER_ADDRESS, Ref(context));
+  uringServer.Open();
+  MeasureRoundTrips("asio", server, std::make_unique<TcpSocketChannel>(
+    SERVER_ADDRESS, Ref(socketThreadPool)));
+  MeasureRoundTrips("io_uring client", server,
+    std::make_unique<UringTcpSocketChannel>(SERVER_ADDRESS, Ref(context)));
+  MeasureRoundTrips("io_uring client and server", uringServer,
+    std::make_unique<UringTcpSocketChannel>(URING_SERVER_ADDRESS,
+      Ref(context)));
+  MeasureThroughput("asio", server, std::make_unique<TcpSocketChannel>(
+    SERVER_ADDRESS, Ref(socketThreadPool)));
+  MeasureThroughput("io_uring client", server,
+    std::make_unique<UringTcpSocketChannel>(SERVER_ADDRESS, Ref(context)));
+  MeasureThroughput("io_uring client and server", uringServer,
+    std::make_unique<UringTcpSocketChannel>(URING_SERVER_ADDRESS,
+      Ref(context)));
+  return 0;
+}
@@ -0,0 +1,177 @@
+#include <atomic>
+#include <vector>
+#include <boost/thread/thread.hpp>
+#include <doctest/doctest.h>
+#include "Beam/Routines/Async.hpp"
+#include "Beam/Routines/RoutineHandler.hpp"
+#include "Beam/Utilities/KeyValueCache.hpp"
+
+using namespace Beam;
+using namespace Beam::Routines;
+using namespace boost;
+using namespace boost::posix_time;
+
+namespace {
+  template<typename F>
+  void WaitUntil(F&& f) {
+    while(!f()) {
+      this_thread::sleep_for(chrono::milliseconds(1));
+    }
+  }
+}
+
+TEST_SUITE("KeyValueCache") {
+  TEST_CASE("single_flight") {
+    const auto ROUTINE_COUNT = 8;
+    auto loadCount = std::atomic<int>(0);
+    auto isReleased = Async<void>();
+    auto cache = KeyValueCache<int, int>(
+      [&] (int key) {
+        ++loadCount;
+        isReleased.Get();
+        return 10 * key;
+      });
+    auto values = std::vector<int>(ROUTINE_COUNT, 0);
+    auto routines = std::vector<RoutineHandler>();
+    for(auto i = 0; i < ROUTINE_COUNT; ++i) {
+      routines.emplace_back(Spawn(
+        [&, i] {
+          values[i] = cache.Load(3);
+        }));
+    }
+    WaitUntil(
+      [&] {
+        return cache.GetStatistics().m_misses == ROUTINE_COUNT;
+      });
+    isReleased.GetEval().SetResult();
+    routines.clear();
+    REQUIRE(loadCount == 1);
+    for(auto value : values) {
+      REQUIRE(value == 30);
+    }
+    REQUIRE(cache.GetStatistics().m_loads == 1);
+  }
+
+  TEST_CASE("lru_eviction") {
+    auto loads = std::vector<int>();
+    auto cache = KeyValueCache<int, int>(
+      [&] (int key) {
+        loads.push_back(key);
+        return key;
+      }, 3);
+    cache.Load(1);
+    cache.Load(2);
+    cache.Load(3);
+    cache.Load(1);
+    cache.Load(4);
+    REQUIRE((loads == std::vector<int>{1, 2, 3, 4}));
+    cache.Load(1);
+    cache.Load(3);
+    cache.Load(4);
+    REQUIRE((loads == std::vector<int>{1, 2, 3, 4}));
+    cache.Load(2);
+    REQUIRE((loads == std::vector<int>{1, 2, 3, 4, 2}));
+    cache.Load(1);
+    REQUIRE((loads == std::vector<int>{1, 2, 3, 4, 2, 1}));
+    REQUIRE(cache.GetStatistics().m_evictions == 3);
+    REQUIRE(cache.GetStatistics().m_size == 3);
+  }
+
+  TEST_CASE("expiry") {
+    auto loadCount = 0;
+    auto cache = KeyValueCache<int, int>(
+      [&] (int key) {
+        ++loadCount;
+        return loadCount;
+      }, 10, milliseconds(50), seconds(0));
+    REQUIRE(cache.Load(1) == 1);
+    REQUIRE(cache.Load(1) == 1);
+    this_thread::sleep_for(chrono::milliseconds(80));
+    REQUIRE(cache.Load(1) == 2);
+    REQUIRE(cache.GetStatistics().m_expirations == 1);
+    REQUIRE(cache.GetStatistics().m_loads == 2);
+  }
+
+  TEST_CASE("refresh_ahead") {
+    auto loadCount = std::atomic<int>(0);
+    auto cache = KeyValueCache<int, int>(
+      [&] (int key) {
+        return ++loadCount;
+      }, 10, seconds(10), milliseconds(9950));
+    REQUIRE(cache.Load(1) == 1);
+    this_thread::sleep_for(chrono::milliseconds(80));
+
+    // The stale value is still served while the refresh runs in the
+    // background.
+    REQUIRE(cache.Load(1) == 1);
+    WaitUntil(
+      [&] {
+        return cache.GetStatistics().m_loads == 2;
+      });
+    WaitUntil(
+      [&] {
+        return cache.Load(1) == 2;
+      });
+    REQUIRE(cache.GetStatistics().m_refreshes >= 1);
+    REQUIRE(cache.GetStatistics().m_expirations == 0);
+  }
+
+  TEST_CASE("statistics") {
+    auto cache = KeyValueCache<int, int>(
+      [] (int key) {
+        return key;
+      }, 2);
+    cache.Load(1);
+    cache.Load(1);
+    cache.Load(2);
+    cache.Load(1);
+    cache.Load(3);
+    auto statistics = cache.GetStatistics();
+    REQUIRE(statistics.m_hits == 2);
+    REQUIRE(statistics.m_misses == 3);
+    REQUIRE(statistics.m_loads == 3);
+    REQUIRE(statistics.m_evictions == 1);
+    REQUIRE(statistics.m_expirations == 0);
+    REQUIRE(statistics.m_refreshes == 0);
+    REQUIRE(statistics.m_size == 2);
+    cache.Invalidate(1);
+    REQUIRE(cache.GetStatistics().m_size == 1);
+    cache.Clear();
+    REQUIRE(cache.GetStatistics().m_size == 0);
+  }
+
+  TEST_CASE("non_standard_exception") {
+    const auto ROUTINE_COUNT = 4;
+    auto loadCount = std::atomic<int>(0);
+    auto isReleased = Async<void>();
+    auto cache = KeyValueCache<int, int>(
+      [&] (int key) {
+        if(++loadCount == 1) {
+          isReleased.Get();
+          throw 5;
+        }
+        return key;
+      });
+    auto failures = std::atomic<int>(0);
+    auto routines = std::vector<RoutineHandler>();
+    for(auto i = 0; i < ROUTINE_COUNT; ++i) {
+      routines.emplace_back(Spawn(
+        [&] {
+          try {
+            cache.Load(7);
+          } catch(int) {
+            ++failures;
+          }
+        }));
+    }
+    WaitUntil(
+      [&] {
+        return cache.GetStatistics().m_misses == ROUTINE_COUNT;
+      });
+    isReleased.GetEval().SetResult();
+    routines.clear();
+    REQUIRE(failures == ROUTINE_COUNT);
+    REQUIRE(cache.Load(7) == 7);
+    REQUIRE(loadCount == 2);
+  }
+}
@@ -0,0 +1,153 @@
+#include <filesystem>
+#include <fstream>
+#include <doctest/doctest.h>
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/WebServices/FileStore.hpp"
+
+using namespace Beam;
+using namespace Beam::IO;
+using namespace Beam::WebServices;
+
+namespace {
+  struct Fixture {
+    std::filesystem::path m_root;
+
+    Fixture()
+        : m_root(std::filesystem::temp_directory_path() / "FileStoreTester") {
+      std::filesystem::remove_all(m_root);
+      std::filesystem::create_directories(m_root);
+      auto file = std::ofstream(m_root / "index.html", std::ios::binary);
+      file << "0123456789";
+    }
+
+    ~Fixture() {
+      std::filesystem::remove_all(m_root);
+    }
+
+    auto MakeRequest(const std::string& header, const std::string& value) {
+      auto request = HttpRequest(HttpMethod::GET, Uri("/index.html"));
+      request.Add(HttpHeader(header, value));
+      return request;
+    }
+  };
+
+  SharedBuffer ReadStream(const HttpResponse& response) {
+    auto body = SharedBuffer();
+    while(response.GetBodyStream()(Store(body))) {}
+    return body;
+  }
+}
+
+TEST_SUITE("FileStore") {
+  TEST_CASE_FIXTURE(Fixture, "serve") {
+    auto fileStore = FileStore(m_root);
+    auto response = fileStore.Serve(
+      HttpRequest(HttpMethod::GET, Uri("/index.html")));
+    REQUIRE(response.GetStatusCode() == HttpStatusCode::OK);
+    REQUIRE(response.GetBody() == BufferFromString<SharedBuffer>("0123456789"));
+    REQUIRE(response.GetHeader("ETag").is_initialized());
+    REQUIRE(response.GetHeader("Last-Modified").is_initialized());
+    auto missing = fileStore.Serve(
+      HttpRequest(HttpMethod::GET, Uri("/missing.html")));
+    REQUIRE(missing.GetStatusCode() == HttpStatusCode::NOT_FOUND);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "not_modified") {
+    auto fileStore = FileStore(m_root);
+    auto response = fileStore.Serve(
+      HttpRequest(HttpMethod::GET, Uri("/index.html")));
+    auto entityTag = *response.GetHeader("ETag");
+    auto lastModified = *response.GetHeader("Last-Modified");
+    auto cachedResponse = fileStore.Serve(
+      MakeRequest("If-None-Match", entityTag));
+    REQUIRE(cachedResponse.GetStatusCode() == HttpStatusCode::NOT_MODIFIED);
+    REQUIRE(cachedResponse.GetBody().IsEmpty());
+    cachedResponse = fileStore.Serve(
+      MakeRequest("If-Modified-Since", lastModified));
+    REQUIRE(cachedResponse.GetStatusCode() == HttpStatusCode::NOT_MODIFIED);
+    auto modifiedResponse = fileStore.Serve(
+      MakeRequest("If-None-Match", "\"stale\""));
+    REQUIRE(modifiedResponse.GetStatusCode() == HttpStatusCode::OK);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "if_modified_since") {
+    auto fileStore = FileStore(m_root);
+    auto lastModified = std::chrono::system_clock::to_time_t(
+      std::chrono::system_clock::now()) - 3600;
+    std::filesystem::last_write_time(m_root / "index.html",
+      std::filesystem::last_write_time(m_root / "index.html") -
+      std::chrono::hours(1));
+    auto serve = [&] (const std::string& date) {
+      return fileStore.Serve(
+        MakeRequest("If-Modified-Since", date)).GetStatusCode();
+    };
+    REQUIRE(serve("Fri, 01 Jan 2100 00:00:00 GMT") ==
+      HttpStatusCode::NOT_MODIFIED);
+    REQUIRE(serve("Friday, 01-Jan-99 00:00:00 GMT") == HttpStatusCode::OK);
+    REQUIRE(serve("Sun Nov  6 08:49:37 1994") == HttpStatusCode::OK);
+    REQUIRE(serve("Sat, 01 Jan 2000 00:00:00 GMT") == HttpStatusCode::OK);
+    REQUIRE(serve("yesterday") == HttpStatusCode::OK);
+    auto date = WebServices::Details::FormatExpiration(
+      boost::posix_time::from_time_t(lastModified + 60));
+    REQUIRE(serve(date) == HttpStatusCode::NOT_MODIFIED);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "modified_file") {
+    auto fileStore = FileStore(m_root);
+    auto response = fileStore.Serve(
+      HttpRequest(HttpMethod::GET, Uri("/index.html")));
+    {
+      auto file = std::ofstream(m_root / "index.html", std::ios::binary);
+      file << "abc";
+    }
+    std::filesystem::last_write_time(m_root / "index.html",
+      std::filesystem::last_write_time(m_root / "index.html") +
+      std::chrono::seconds(1));
+    auto modifiedResponse = fileStore.Serve(
+      MakeRequest("If-None-Match", *response.GetHeader("ETag")));
+    REQUIRE(modifiedResponse.GetStatusCode() == HttpStatusCode::OK);
+    REQUIRE(modifiedResponse.GetBody() == BufferFromString<SharedBuffer>("abc"));
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "range") {
+    auto fileStore = FileStore(m_root, ContentTypePatterns::GetDefaultPatterns(),
+      FileStore::DEFAULT_CACHE_CAPACITY, FileStore::DEFAULT_MAX_CACHED_FILE_SIZE,
+      4);
+    auto response = fileStore.Serve(MakeRequest("Range", "bytes=2-5"));
+    REQUIRE(response.GetStatusCode() == HttpStatusCode::PARTIAL_CONTENT);
+    REQUIRE(*response.GetHeader("Content-Range") == "bytes 2-5/10");
+    REQUIRE(response.GetBody() == BufferFromString<SharedBuffer>("2345"));
+    response = fileStore.Serve(MakeRequest("Range", "bytes=-3"));
+    REQUIRE(response.GetBody() == BufferFromString<SharedBuffer>("789"));
+    response = fileStore.Serve(MakeRequest("Range", "bytes=5-"));
+    REQUIRE(*response.GetHeader("Content-Range") == "bytes 5-8/10");
+    REQUIRE(response.GetBody() == BufferFromString<SharedBuffer>("5678"));
+    response = fileStore.Serve(MakeRequest("Range", "bytes=10-"));
+    REQUIRE(response.GetStatusCode() ==
+      HttpStatusCode::REQUESTED_RANGE_NOT_SATISFIABLE);
+    REQUIRE(*response.GetHeader("Content-Range") == "bytes */10");
+    response = fileStore.Serve(MakeRequest("Range", "lines=1-2"));
+    REQUIRE(response.GetStatusCode() == HttpStatusCode::OK);
+    REQUIRE(response.GetBody() == BufferFromString<SharedBuffer>("0123456789"));
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "stream_large_file") {
+    auto fileStore = FileStore(m_root, ContentTypePatterns::GetDefaultPatterns(),
+      FileStore::DEFAULT_CACHE_CAPACITY, 4, 4);
+    auto response = fileStore.Serve(
+      HttpRequest(HttpMethod::GET, Uri("/index.html")));
+    REQUIRE(response.GetStatusCode() == HttpStatusCode::OK);
+    REQUIRE(response.GetBody().IsEmpty());
+    REQUIRE(*response.GetHeader("Content-Length") == "10");
+    REQUIRE(ReadStream(response) ==
+      BufferFromString<SharedBuffer>("0123456789"));
+    response = fileStore.Serve(MakeRequest("Range", "bytes=1-8"));
+    REQUIRE(response.GetStatusCode() == HttpStatusCode::PARTIAL_CONTENT);
+    REQUIRE(*response.GetHeader("Content-Length") == "8");
+    REQUIRE(ReadStream(response) ==
+      BufferFromString<SharedBuffer>("12345678"));
+    response = fileStore.Serve(MakeRequest("Range", "bytes=2-4"));
+    REQUIRE(!response.GetBodyStream());
+    REQUIRE(response.GetBody() == BufferFromString<SharedBuffer>("234"));
+  }
+}
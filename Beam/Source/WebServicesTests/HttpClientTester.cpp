@@ -0,0 +1,184 @@
+#include <doctest/doctest.h>
+#include "Beam/IO/LocalClientChannel.hpp"
+#include "Beam/IO/LocalServerConnection.hpp"
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Routines/RoutineHandler.hpp"
+#include "Beam/Routines/RoutineHandlerGroup.hpp"
+#include "Beam/WebServices/HttpClient.hpp"
+#include "Beam/WebServices/HttpServer.hpp"
+
+using namespace Beam;
+using namespace Beam::IO;
+using namespace Beam::Routines;
+using namespace Beam::WebServices;
+
+namespace {
+  using TestServerConnection = LocalServerConnection<SharedBuffer>;
+  using TestClientChannel = LocalClientChannel<SharedBuffer>;
+  using TestHttpClient = HttpClient<std::unique_ptr<TestClientChannel>>;
+
+  struct Fixture {
+    TestServerConnection m_serverConnection;
+    HttpServer<TestServerConnection*> m_server;
+
+    Fixture()
+        : m_server(&m_serverConnection, MakeSlots()) {
+      m_server.Open();
+    }
+
+    static std::vector<HttpRequestSlot> MakeSlots() {
+      auto slots = std::vector<HttpRequestSlot>();
+      slots.emplace_back(HttpRequestSlot::Route{HttpMethod::GET, "/close"},
+        [] (const HttpRequest& request) {
+          auto response = HttpResponse();
+          response.SetHeader({"Connection", "close"});
+          return response;
+        });
+      slots.emplace_back(HttpRequestSlot::Route{HttpMethod::GET, "/**"},
+        [] (const HttpRequest& request) {
+          auto response = HttpResponse();
+          response.SetBody(BufferFromString<SharedBuffer>(
+            request.GetUri().GetPath()));
+          return response;
+        });
+      return slots;
+    }
+
+    TestHttpClient::ChannelBuilder MakeChannelBuilder() {
+      return [=] (const Uri& uri) {
+        return std::make_unique<TestClientChannel>(uri.GetHostname(),
+          Ref(m_serverConnection));
+      };
+    }
+  };
+
+  auto CountRequests(const std::string& source, const std::string& method) {
+    auto count = 0;
+    auto position = source.find(method);
+    while(position != std::string::npos) {
+      ++count;
+      position = source.find(method, position + method.size());
+    }
+    return count;
+  }
+
+  auto Get(TestHttpClient& client, const std::string& path) {
+    auto response = client.Send(HttpRequest(HttpMethod::GET,
+      Uri("http://localhost" + path)));
+    REQUIRE(response.GetStatusCode() == HttpStatusCode::OK);
+    return std::string(response.GetBody().GetData(),
+      response.GetBody().GetSize());
+  }
+}
+
+TEST_SUITE("HttpClient") {
+  TEST_CASE_FIXTURE(Fixture, "keep_alive") {
+    auto client = TestHttpClient(MakeChannelBuilder());
+    REQUIRE(Get(client, "/a") == "/a");
+    REQUIRE(Get(client, "/b") == "/b");
+    auto statistics = client.GetStatistics();
+    REQUIRE(statistics.m_requests == 2);
+    REQUIRE(statistics.m_connectionsOpened == 1);
+    REQUIRE(statistics.m_reusedRequests == 1);
+    REQUIRE(statistics.m_openConnections == 1);
+    REQUIRE(statistics.m_idleConnections == 1);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "connection_close") {
+    auto client = TestHttpClient(MakeChannelBuilder());
+    client.Send(HttpRequest(HttpMethod::GET, Uri("http://localhost/close")));
+    REQUIRE(Get(client, "/a") == "/a");
+    auto statistics = client.GetStatistics();
+    REQUIRE(statistics.m_connectionsOpened == 2);
+    REQUIRE(statistics.m_connectionsClosed == 1);
+    REQUIRE(statistics.m_openConnections == 1);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "idle_expiry") {
+    auto client = TestHttpClient(MakeChannelBuilder(), 1,
+      boost::posix_time::seconds(0), 1);
+    REQUIRE(Get(client, "/a") == "/a");
+    REQUIRE(Get(client, "/b") == "/b");
+    auto statistics = client.GetStatistics();
+    REQUIRE(statistics.m_connectionsOpened == 2);
+    REQUIRE(statistics.m_connectionsExpired == 1);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "concurrent") {
+    auto client = TestHttpClient(MakeChannelBuilder(), 2,
+      boost::posix_time::minutes(1), 1);
+    {
+      auto routines = RoutineHandlerGroup();
+      for(auto i = 0; i < 16; ++i) {
+        routines.Spawn(
+          [&, i] {
+            auto path = "/" + std::to_string(i);
+            REQUIRE(Get(client, path) == path);
+          });
+      }
+    }
+    auto statistics = client.GetStatistics();
+    REQUIRE(statistics.m_requests == 16);
+    REQUIRE(statistics.m_connectionsOpened <= 2);
+    REQUIRE(statistics.m_idleConnections == statistics.m_openConnections);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "pipelining") {
+    auto client = TestHttpClient(MakeChannelBuilder(), 1,
+      boost::posix_time::minutes(1), 4);
+    {
+      auto routines = RoutineHandlerGroup();
+      for(auto i = 0; i < 16; ++i) {
+        routines.Spawn(
+          [&, i] {
+            auto path = "/" + std::to_string(i);
+            REQUIRE(Get(client, path) == path);
+          });
+      }
+    }
+    auto statistics = client.GetStatistics();
+    REQUIRE(statistics.m_requests == 16);
+    REQUIRE(statistics.m_connectionsOpened == 1);
+    REQUIRE(statistics.m_reusedRequests == 15);
+    REQUIRE(statistics.m_pipelinedRequests > 0);
+  }
+
+  TEST_CASE("post_not_resent") {
+    auto serverConnection = TestServerConnection();
+    auto received = std::string();
+    auto server = RoutineHandler(Spawn(
+      [&] {
+        while(true) {
+          auto channel = std::unique_ptr<TestServerConnection::Channel>();
+          try {
+            channel = serverConnection.Accept();
+          } catch(const std::exception&) {
+            return;
+          }
+          auto buffer = SharedBuffer();
+          channel->GetReader().Read(Store(buffer));
+          received.append(buffer.GetData(), buffer.GetSize());
+          if(received.find("POST") == std::string::npos) {
+            channel->GetWriter().Write(BufferFromString<SharedBuffer>(
+              "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n"));
+            buffer.Reset();
+            channel->GetReader().Read(Store(buffer));
+            received.append(buffer.GetData(), buffer.GetSize());
+          }
+          channel->GetConnection().Close();
+        }
+      }));
+    auto client = TestHttpClient(
+      [&] (const Uri& uri) {
+        return std::make_unique<TestClientChannel>(uri.GetHostname(),
+          Ref(serverConnection));
+      });
+    client.Send(HttpRequest(HttpMethod::GET, Uri("http://localhost/a")));
+    REQUIRE_THROWS(client.Send(HttpRequest(HttpMethod::POST,
+      Uri("http://localhost/b"), BufferFromString<SharedBuffer>("body"))));
+    serverConnection.Close();
+    server.Wait();
+    REQUIRE(CountRequests(received, "POST") == 1);
+    REQUIRE(client.GetStatistics().m_retriedRequests == 0);
+  }
+}
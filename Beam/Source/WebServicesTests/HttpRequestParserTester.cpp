@@ -22,4 +22,49 @@ TEST_SUITE("HttpRequestParser") {
     REQUIRE(request->GetCookie("theme")->GetValue() == "light");
     REQUIRE(request->GetCookie("sessionToken")->GetValue() == "abc123");
   }
+
+  TEST_CASE("split_headers") {
+    auto parser = HttpRequestParser();
+    auto requestString = std::string(
+      "GET /index.html HTTP/1.1\r\n"
+      "Accept: text/html\r\n"
+      "X-Request-Id: 42\r\n"
+      "Content-Length: 0\r\n"
+      "\r\n");
+    auto split = requestString.find("Request-Id");
+    parser.Feed(requestString.c_str(), split);
+    parser.Feed(requestString.c_str() + split, requestString.size() - split);
+    auto request = parser.GetNextRequest();
+    REQUIRE(request.is_initialized());
+    REQUIRE(request->GetHeaders().size() == 2);
+    REQUIRE(*request->GetHeader("Accept") == "text/html");
+    REQUIRE(*request->GetHeader("x-request-id") == "42");
+    REQUIRE(*request->GetHeader("content-length") == "0");
+    REQUIRE(!request->GetHeader("Accept-Encoding").is_initialized());
+    request->Add(HttpHeader("Accept-Encoding", "gzip"));
+    REQUIRE(request->GetHeaders().size() == 3);
+    REQUIRE(request->GetHeaders()[1].GetName() == "X-Request-Id");
+    REQUIRE(*request->GetHeader("accept-encoding") == "gzip");
+  }
+
+  TEST_CASE("pipelined_headers") {
+    auto parser = HttpRequestParser();
+    auto requestString =
+      "GET /a HTTP/1.1\r\n"
+      "Accept: text/html\r\n"
+      "\r\n"
+      "GET /b HTTP/1.1\r\n"
+      "Accept: text/plain\r\n"
+      "X-Request-Id: 7\r\n"
+      "\r\n";
+    parser.Feed(requestString, std::strlen(requestString));
+    auto first = parser.GetNextRequest();
+    auto second = parser.GetNextRequest();
+    REQUIRE(first.is_initialized());
+    REQUIRE(second.is_initialized());
+    REQUIRE(*first->GetHeader("Accept") == "text/html");
+    REQUIRE(!first->GetHeader("X-Request-Id").is_initialized());
+    REQUIRE(*second->GetHeader("Accept") == "text/plain");
+    REQUIRE(*second->GetHeader("X-Request-Id") == "7");
+  }
 }
@@ -0,0 +1,69 @@
+#include <doctest/doctest.h>
+#include "Beam/WebServices/HttpRequestRouter.hpp"
+#include "Beam/WebServices/HttpResponse.hpp"
+#include "Beam/WebServices/HttpServerPredicates.hpp"
+
+using namespace Beam;
+using namespace Beam::WebServices;
+
+namespace {
+  auto MakeSlot(HttpMethod method, std::string path) {
+    return HttpRequestSlot(HttpRequestSlot::Route{method, std::move(path)},
+      [] (const HttpRequest& request) {
+        return HttpResponse();
+      });
+  }
+
+  auto Route(const HttpRequestRouter& router, HttpMethod method,
+      std::string path) {
+    auto request = HttpRequest(method, Uri("http://localhost" + path));
+    auto slot = router.Find(request);
+    if(slot == nullptr) {
+      return -1;
+    }
+    return static_cast<int>(slot - router.GetSlots().data());
+  }
+}
+
+TEST_SUITE("HttpRequestRouter") {
+  TEST_CASE("exact") {
+    auto slots = std::vector<HttpRequestSlot>();
+    slots.push_back(MakeSlot(HttpMethod::GET, "/api/status"));
+    slots.push_back(MakeSlot(HttpMethod::POST, "/api/status"));
+    slots.push_back(MakeSlot(HttpMethod::GET, "/api/load"));
+    auto router = HttpRequestRouter(std::move(slots));
+    REQUIRE(Route(router, HttpMethod::GET, "/api/status") == 0);
+    REQUIRE(Route(router, HttpMethod::POST, "/api/status") == 1);
+    REQUIRE(Route(router, HttpMethod::GET, "/api/load") == 2);
+    REQUIRE(Route(router, HttpMethod::PUT, "/api/status") == -1);
+    REQUIRE(Route(router, HttpMethod::GET, "/api") == -1);
+    REQUIRE(Route(router, HttpMethod::GET, "/api/status/extra") == -1);
+  }
+
+  TEST_CASE("wildcard") {
+    auto slots = std::vector<HttpRequestSlot>();
+    slots.push_back(MakeSlot(HttpMethod::GET, "/users/*/name"));
+    slots.push_back(MakeSlot(HttpMethod::GET, "/files/**"));
+    slots.push_back(MakeSlot(HttpMethod::GET, "/users/admin/name"));
+    auto router = HttpRequestRouter(std::move(slots));
+    REQUIRE(Route(router, HttpMethod::GET, "/users/bob/name") == 0);
+    REQUIRE(Route(router, HttpMethod::GET, "/users/admin/name") == 0);
+    REQUIRE(Route(router, HttpMethod::GET, "/users/bob") == -1);
+    REQUIRE(Route(router, HttpMethod::GET, "/files") == 1);
+    REQUIRE(Route(router, HttpMethod::GET, "/files/a/b/c.txt") == 1);
+  }
+
+  TEST_CASE("predicate_order") {
+    auto slots = std::vector<HttpRequestSlot>();
+    slots.push_back(MakeSlot(HttpMethod::GET, "/index.html"));
+    slots.emplace_back(MatchAny(HttpMethod::GET),
+      [] (const HttpRequest& request) {
+        return HttpResponse();
+      });
+    slots.push_back(MakeSlot(HttpMethod::GET, "/**"));
+    auto router = HttpRequestRouter(std::move(slots));
+    REQUIRE(Route(router, HttpMethod::GET, "/index.html") == 0);
+    REQUIRE(Route(router, HttpMethod::GET, "/main.js") == 1);
+    REQUIRE(Route(router, HttpMethod::POST, "/main.js") == -1);
+  }
+}
@@ -0,0 +1,205 @@
+#include <doctest/doctest.h>
+#include "Beam/IO/LocalClientChannel.hpp"
+#include "Beam/IO/LocalServerConnection.hpp"
+#include "Beam/IO/SharedBuffer.hpp"
+#include "Beam/Routines/RoutineHandler.hpp"
+#include "Beam/WebServices/HttpServer.hpp"
+#include "Beam/WebServices/HttpServerPredicates.hpp"
+#include "Beam/WebServices/PerMessageDeflate.hpp"
+#include "Beam/WebServices/WebSocket.hpp"
+
+using namespace Beam;
+using namespace Beam::IO;
+using namespace Beam::Routines;
+using namespace Beam::WebServices;
+
+namespace {
+  using TestServerConnection = LocalServerConnection<SharedBuffer>;
+  using TestClientChannel = LocalClientChannel<SharedBuffer>;
+  using TestServer = HttpServer<TestServerConnection*>;
+  using TestWebSocket = WebSocket<std::unique_ptr<TestClientChannel>>;
+
+  struct Fixture {
+    TestServerConnection m_serverConnection;
+    TestServer m_server;
+
+    Fixture()
+        : m_server(&m_serverConnection, {}, MakeWebSocketSlots()) {
+      m_server.Open();
+    }
+
+    static std::vector<TestServer::WebSocketSlot> MakeWebSocketSlots() {
+      auto slots = std::vector<TestServer::WebSocketSlot>();
+      slots.emplace_back(MatchAny(HttpMethod::GET),
+        [] (const HttpRequest& request,
+            std::unique_ptr<TestServer::WebSocketChannel> channel) {
+          Spawn([channel = std::shared_ptr<TestServer::WebSocketChannel>(
+              std::move(channel))] {
+            try {
+              while(true) {
+                auto message = channel->GetSocket().Read();
+                channel->GetSocket().Write(message);
+              }
+            } catch(const std::exception&) {}
+          });
+        });
+      return slots;
+    }
+
+    std::unique_ptr<TestWebSocket> MakeWebSocket(bool isCompressed,
+        std::size_t maxMessageSize =
+          WebSocketConfig::DEFAULT_MAX_MESSAGE_SIZE) {
+      auto config = WebSocketConfig();
+      config.SetUri(Uri("ws://localhost/echo"));
+      config.SetCompression(isCompressed);
+      config.SetMaxMessageSize(maxMessageSize);
+      auto webSocket = std::make_unique<TestWebSocket>(std::move(config),
+        [=] (const Uri& uri) {
+          return std::make_unique<TestClientChannel>("client",
+            Ref(m_serverConnection));
+        });
+      webSocket->Open();
+      return webSocket;
+    }
+  };
+
+  auto MakeMessage(std::size_t size) {
+    auto message = std::string();
+    for(auto i = std::size_t(0); i != size; ++i) {
+      message += static_cast<char>('a' + (i * 7 + i / 13) % 26);
+    }
+    return message;
+  }
+
+  auto ToString(const SharedBuffer& buffer) {
+    return std::string(buffer.GetData(), buffer.GetSize());
+  }
+}
+
+TEST_SUITE("WebSocket") {
+  TEST_CASE("mask") {
+    auto maskingKey = std::uint32_t(0x12345678);
+    auto key = reinterpret_cast<const char*>(&maskingKey);
+    for(auto size = std::size_t(0); size != 40; ++size) {
+      auto message = MakeMessage(size);
+      auto expected = message;
+      for(auto i = std::size_t(0); i != size; ++i) {
+        expected[i] ^= key[i % 4];
+      }
+      WebServices::Details::ApplyMask(message.data(), message.size(),
+        maskingKey);
+      REQUIRE(message == expected);
+    }
+  }
+
+  TEST_CASE("deflate_parameters") {
+    auto parameters = PerMessageDeflate::Parse(
+      "x-webkit-deflate-frame, permessage-deflate; server_max_window_bits=8, "
+      "permessage-deflate; client_max_window_bits; server_max_window_bits=10;"
+      " client_no_context_takeover");
+    REQUIRE(parameters.is_initialized());
+    REQUIRE(parameters->m_serverMaxWindowBits == 10);
+    REQUIRE(parameters->m_clientMaxWindowBits == 15);
+    REQUIRE(parameters->m_clientNoContextTakeover);
+    REQUIRE(!parameters->m_serverNoContextTakeover);
+    REQUIRE(PerMessageDeflate::Format(*parameters) == "permessage-deflate; "
+      "client_no_context_takeover; server_max_window_bits=10");
+    REQUIRE(!PerMessageDeflate::Parse("permessage-deflate; unknown").
+      is_initialized());
+  }
+
+  TEST_CASE("deflate_round_trip") {
+    for(auto noContextTakeover : {false, true}) {
+      auto parameters = PerMessageDeflate::Parameters();
+      parameters.m_clientNoContextTakeover = noContextTakeover;
+      auto client = PerMessageDeflate(parameters, false);
+      auto server = PerMessageDeflate(parameters, true);
+      auto message = MakeMessage(10000);
+      auto firstSize = std::size_t(0);
+      for(auto i = 0; i < 3; ++i) {
+        auto compressed = SharedBuffer();
+        client.Compress(message.data(), 4000, false, Store(compressed));
+        client.Compress(message.data() + 4000, message.size() - 4000, true,
+          Store(compressed));
+        REQUIRE(compressed.GetSize() < message.size());
+        if(i == 0) {
+          firstSize = compressed.GetSize();
+        } else if(noContextTakeover) {
+          REQUIRE(compressed.GetSize() == firstSize);
+        } else {
+          REQUIRE(compressed.GetSize() < firstSize);
+        }
+        auto decompressed = SharedBuffer();
+        server.Decompress(compressed.GetData(), 7, false, message.size(),
+          Store(decompressed));
+        server.Decompress(compressed.GetData() + 7, compressed.GetSize() - 7,
+          true, message.size() - decompressed.GetSize(), Store(decompressed));
+        REQUIRE(ToString(decompressed) == message);
+      }
+    }
+  }
+
+  TEST_CASE("deflate_max_size") {
+    auto parameters = PerMessageDeflate::Parameters();
+    auto client = PerMessageDeflate(parameters, false);
+    auto server = PerMessageDeflate(parameters, true);
+    auto message = std::string(100000, 'a');
+    auto compressed = SharedBuffer();
+    client.Compress(message.data(), message.size(), true, Store(compressed));
+    auto decompressed = SharedBuffer();
+    server.Decompress(compressed.GetData(), compressed.GetSize(), true,
+      message.size(), Store(decompressed));
+    REQUIRE(ToString(decompressed) == message);
+    compressed.Reset();
+    client.Compress(message.data(), message.size(), true, Store(compressed));
+    decompressed.Reset();
+    REQUIRE_THROWS_AS(server.Decompress(compressed.GetData(),
+      compressed.GetSize(), true, message.size() - 1, Store(decompressed)),
+      MessageTooLargeException);
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "echo") {
+    auto webSocket = MakeWebSocket(false);
+    REQUIRE(!webSocket->IsCompressed());
+    for(auto size : {0, 1, 125, 126, 65535, 65536, 200000}) {
+      auto message = MakeMessage(size);
+      webSocket->Write(message.data(), message.size());
+      REQUIRE(ToString(webSocket->Read()) == message);
+    }
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "echo_compressed") {
+    auto webSocket = MakeWebSocket(true);
+    REQUIRE(webSocket->IsCompressed());
+    for(auto size : {0, 1, 125, 65536, 200000}) {
+      auto message = MakeMessage(size);
+      webSocket->Write(message.data(), message.size());
+      REQUIRE(ToString(webSocket->Read()) == message);
+    }
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "fragments") {
+    for(auto isCompressed : {false, true}) {
+      auto webSocket = MakeWebSocket(isCompressed);
+      auto message = MakeMessage(3000);
+      webSocket->WriteFragment(message.data(), 1000, false);
+      webSocket->WriteFragment(message.data() + 1000, 1000, false);
+      webSocket->WriteFragment(message.data() + 2000, 1000, true);
+      auto received = SharedBuffer();
+      while(!webSocket->ReadFragment(Store(received))) {}
+      REQUIRE(ToString(received) == message);
+    }
+  }
+
+  TEST_CASE_FIXTURE(Fixture, "max_message_size") {
+    for(auto isCompressed : {false, true}) {
+      auto webSocket = MakeWebSocket(isCompressed, 1000);
+      auto message = MakeMessage(1000);
+      webSocket->Write(message.data(), message.size());
+      REQUIRE(ToString(webSocket->Read()) == message);
+      message = MakeMessage(1001);
+      webSocket->Write(message.data(), message.size());
+      REQUIRE_THROWS_AS(webSocket->Read(), MessageTooLargeException);
+    }
+  }
+}
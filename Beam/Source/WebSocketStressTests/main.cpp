@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/format.hpp>
+#include "Beam/Network/SocketThreadPool.hpp"
+#include "Beam/Network/TcpSocketChannel.hpp"
+#include "Beam/WebServices/WebSocket.hpp"
+
+using namespace Beam;
+using namespace Beam::IO;
+using namespace Beam::Network;
+using namespace Beam::WebServices;
+
+namespace {
+  using BenchmarkWebSocket = WebSocket<std::unique_ptr<TcpSocketChannel>>;
+  const auto MASK_BYTES = std::size_t(1) << 30;
+  const auto TRANSFER_BYTES = std::size_t(64) << 20;
+  const auto MAX_MESSAGES = std::size_t(100000);
+  const auto WINDOW_BYTES = std::size_t(128) << 10;
+
+  template<typename F>
+  double Measure(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  }
+
+  void MeasureMask() {
+    static auto payload = std::vector<char>(64 * 1024, 'x');
+    auto maskingKey = std::uint32_t(0xDEADBEEF);
+    auto key = reinterpret_cast<const char*>(&maskingKey);
+    auto byteDuration = Measure(
+      [&] {
+        for(auto i = std::size_t(0); i < MASK_BYTES; i += payload.size()) {
+          for(auto j = std::size_t(0); j != payload.size(); ++j) {
+            payload[j] ^= key[j % sizeof(maskingKey)];
+          }
+        }
+      });
+    auto wordDuration = Measure(
+      [&] {
+        for(auto i = std::size_t(0); i < MASK_BYTES; i += payload.size()) {
+          WebServices::Details::ApplyMask(payload.data(), payload.size(), maskingKey);
+        }
+      });
+    std::cout << boost::format("mask: bytewise %1% MB/s, wordwise %2% MB/s\n") %
+      static_cast<std::uint64_t>(MASK_BYTES / byteDuration / (1 << 20)) %
+      static_cast<std::uint64_t>(MASK_BYTES / wordDuration / (1 << 20));
+  }
+
+  void MeasureEcho(SocketThreadPool& socketThreadPool, const Uri& uri,
+      bool isCompressed, std::size_t messageSize) {
+    auto config = WebSocketConfig();
+    config.SetUri(uri);
+    config.SetCompression(isCompressed);
+    auto webSocket = BenchmarkWebSocket(std::move(config),
+      [&] (const Uri& uri) {
+        return std::make_unique<TcpSocketChannel>(
+          IpAddress(uri.GetHostname(), uri.GetPort()),
+          Ref(socketThreadPool));
+      });
+    webSocket.Open();
+    auto message = std::string();
+    for(auto i = std::size_t(0); i != messageSize; ++i) {
+      message += static_cast<char>('a' + (i * 7 + i / 13) % 26);
+    }
+    auto messages = std::clamp<std::size_t>(TRANSFER_BYTES / messageSize,
+      1, MAX_MESSAGES);
+    auto window = std::max(WINDOW_BYTES, messageSize);
+    auto duration = Measure(
+      [&] {
+        auto receivedBytes = std::size_t(0);
+        auto sentMessages = std::size_t(0);
+        auto buffer = SharedBuffer();
+        while(sentMessages != messages &&
+            sentMessages * messageSize - receivedBytes <
+            window) {
+          webSocket.Write(message.data(), message.size());
+          ++sentMessages;
+          while(sentMessages == messages ||
+              sentMessages * messageSize - receivedBytes >=
+              window) {
+            if(receivedBytes == messages * messageSize) {
+              return;
+            }
+            buffer.Reset();
+            webSocket.Read(Store(buffer));
+            receivedBytes += buffer.GetSize();
+          }
+        }
+      });
+    std::cout << boost::format("echo compressed=%1% size=%2%: "
+      "%3% messages/s, %4% MB/s\n") % isCompressed % messageSize %
+      static_cast<std::uint64_t>(messages / duration) %
+      static_cast<std::uint64_t>(messages * messageSize / duration /
+      (1 << 20));
+    webSocket.Close();
+  }
+}
+
+int main(int argc, const char** argv) {
+  MeasureMask();
+  auto uri = Uri([&] {
+    if(argc > 1) {
+      return std::string(argv[1]);
+    }
+    return std::string("ws://127.0.0.1:8080/");
+  }());
+  auto socketThreadPool = SocketThreadPool();
+  for(auto isCompressed : {false, true}) {
+    for(auto messageSize : {64, 4096, 65536, 1 << 20}) {
+      try {
+        MeasureEcho(socketThreadPool, uri, isCompressed, messageSize);
+      } catch(const std::exception& e) {
+        std::cerr << "Unable to reach WebSocketEchoServer at " << uri <<
+          ": " << e.what() << '\n';
+        return -1;
+      }
+    }
+  }
+  return 0;
+}